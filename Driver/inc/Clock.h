@@ -3,6 +3,11 @@
 
 #include "Clock_Registers.h"
 
+#define SCG_SOSC_FREQ_HZ             (8000000U)   /*!< External crystal on the board  */
+#define SCG_FIRC_FREQ_HZ             (48000000U)  /*!< Fast IRC nominal frequency     */
+#define SCG_SIRC_HIGH_FREQ_HZ        (8000000U)   /*!< Slow IRC, high range           */
+#define SCG_SIRC_LOW_FREQ_HZ         (2000000U)   /*!< Slow IRC, low range            */
+
 typedef enum {
 	SOSC_CLK                     = 1u,       /*!< SOSC clock                     */
 	SIRC_CLK                     = 2u,       /*!< SIRC clock                     */
@@ -62,6 +67,7 @@ typedef enum {
 typedef enum {
     /* PCC clocks */
 		LPIT0_CLK                    = 55U,       /*!< LPIT0 clock source             */
+		FTM0_CLK                     = 56U,       /*!< FTM0 clock source              */
     PORTA_CLK                    = 73U,       /*!< PORTA clock source             */
     PORTB_CLK                    = 74U,       /*!< PORTB clock source             */
     PORTC_CLK                    = 75U,       /*!< PORTC clock source             */
@@ -73,7 +79,11 @@ typedef enum {
     LPUART0_CLK                  = 106U,      /*!< LPUART0 clock source           */
     LPUART1_CLK                  = 107U,      /*!< LPUART1 clock source           */
     LPUART2_CLK                  = 108U,      /*!< LPUART2 clock source           */
-		ADC0_CLK										 = 59
+		ADC0_CLK										 = 59,
+    /* SCG system clocks (not PCC indices, only valid for Clock_GetFrequency) */
+    CORE_CLK                     = 256U,      /*!< Core/system clock              */
+    BUS_CLK                      = 257U,      /*!< Bus clock                      */
+    SLOW_CLK                     = 258U       /*!< Slow/flash clock               */
 } clock_names_t;
 
 typedef enum {
@@ -163,4 +173,18 @@ void Clock_SetScgSpllConfig(const Scg_Spll_ConfigType * ConfigPtr);
 
 void Clock_SetScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr);
 
+/**
+ * @brief   Returns the current frequency of a clock in Hz.
+ *
+ * @details The value is computed from the live SCG and PCC register state:
+ *          for a PCC clock the selected source (PCC[PCS]) and its DIV2 divider,
+ *          for CORE_CLK/BUS_CLK/SLOW_CLK the RUN mode source and dividers.
+ *          PORTx clocks run from the bus clock.
+ *
+ * @param[in] clockName   Clock to query.
+ *
+ * @return  Frequency in Hz, or 0 if the clock is gated, unselected or disabled.
+ */
+unsigned int Clock_GetFrequency(clock_names_t clockName);
+
 #endif
@@ -10,12 +10,13 @@
 #define SCG_SIRCCSR_SIRCVLD_SHIFT           (24U)
 #define SCG_SPLLCSR_SPLLVLD_SHIFT           (24U)
 #define SCG_SOSCCSR_SOSCVLD_SHIFT           (24U)
+#define SCG_FIRCCSR_FIRCVLD_SHIFT           (24U)
 #define SCG_SOSCCFG_RANGE_SHIFT             (4U)
 #define SCG_SOSCCFG_EREFS_SHIFT             (2U)
 #define SCG_SOSCDIV_SOSCDIV1_SHIFT          (0U)
 #define SCG_SOSCDIV_SOSCDIV2_SHIFT          (8U)
 #define SCG_SPLLDIV_SPLLDIV1_SHIFT          (0U)
-#define SCG_SPLLDIV_SPLLDIV2_SHIFT          (0U)
+#define SCG_SPLLDIV_SPLLDIV2_SHIFT          (8U)
 #define SCG_RCCR_SCS_SHIFT                  (24U)
 #define SCG_RCCR_DIVSLOW_SHIFT              (0U)
 #define SCG_RCCR_DIVBUS_SHIFT               (4U)
@@ -31,6 +32,16 @@
 #define SCG_SOSCCFG_RANGE_HIGHFREQ          (3U)
 #define SCG_SOSCCFG_EREFS_INTERNAL_CRYSTAL  (1U)
 #define SCG_SOSCCSR_ENABLE_SHIFT            (0U)
+#define SCG_CSR_SCS_SHIFT                   (24U)
+#define SCG_CSR_DIVCORE_SHIFT               (16U)
+#define SCG_CSR_DIVBUS_SHIFT                (4U)
+#define SCG_CSR_DIVSLOW_SHIFT               (0U)
+#define SCG_DIV_FIELD_MASK                  (0x7U)
+#define SCG_CSR_DIV_MASK                    (0xFU)
+#define SCG_SIRCCFG_RANGE_HIGH              (1U)
+#define SCG_SPLLCFG_PREDIV_MASK             (0x7U)
+#define SCG_SPLLCFG_MULT_MASK               (0x1FU)
+#define PCC_PCS_MASK                        (0x7U)
 #define SMC_BASE_ADDRESS 0x4007E000	
 #define SMC_PMSTAT	(*((volatile unsigned int*)(SMC_BASE_ADDRESS+0x14)))
 typedef struct {
@@ -0,0 +1,44 @@
+/**
+ * @file    Compiler.h
+ * @brief   Compiler specific placement macros
+ * @details CODE_RAM puts a function in the .code_ram section, which the scatter
+ *          file collects into RW_m_code in SRAM_L, right after the initialised
+ *          data. __main copies it there from flash before main() runs, like RW data.
+ *          SRAM_L sits on the code bus, so these functions fetch without flash
+ *          wait states or prefetch misses. Calls between RAM and flash go through
+ *          linker generated long-branch veneers, so mark whole hot call chains.
+ *          Build with CODE_RAM_ENABLE = 0 to keep everything in flash; comparing
+ *          the LPIT/SYSTICK max and average cycles of "GET STATS" between the two
+ *          builds gives the gain (Tools/benchstats.py captures and compares them,
+ *          "CODE RAM" in the report tells the builds apart).
+ *          HOST_TEST is defined by the host builds of Tools/hosttest.py, which
+ *          compile the portable modules with the PC's gcc (see Tests/Host.h):
+ *          no RAM placement there, and the few core register accesses in
+ *          Nvic.h go to plain variables.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef COMPILER_H
+#define COMPILER_H
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#if defined(HOST_TEST)
+#define CODE_RAM_ENABLE 					0
+#endif
+
+#ifndef CODE_RAM_ENABLE
+#define CODE_RAM_ENABLE 					1          /* Set to 0 to run everything from flash */
+#endif
+
+#if (CODE_RAM_ENABLE == 1)
+#define CODE_RAM 									__attribute__((section(".code_ram")))
+#else
+#define CODE_RAM
+#endif
+
+#endif
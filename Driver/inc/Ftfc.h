@@ -0,0 +1,102 @@
+/**
+ * @file    Ftfc.h
+ * @brief   FTFC flash driver interface.
+ * @details Sector erase and phrase program on the FlexNVM data flash, used as
+ *          plain D-Flash (device not partitioned for EEPROM emulation).
+ *          Commands are queued and return at once; the command complete
+ *          interrupt (FTFC_IRQ) reports the result to the callback and launches
+ *          the next one, so a 2 KB erase never holds up the caller.
+ *          Callbacks run in FTFC_IRQHandler context and may queue commands.
+ *          Addresses are CPU addresses (FTFC_DFLASH_BASE ...). FlexNVM is not
+ *          cached (Lmem_Init), reads after a command see the new contents
+ *          without a cache maintenance operation.
+ *          Ftfc_ReadPhrase() reads a phrase that may hold an uncorrectable ECC
+ *          error, e.g. one whose program or erase a power loss cut short,
+ *          without the BusFault a plain load would take.
+ *          Commands are written and launched with PRIMASK set, so the brownout
+ *          handler can use Ftfc_ProgramPhraseNow() at any point of a command.
+ *          The launch and completion paths run from SRAM_L (CODE_RAM): they do
+ *          not fetch from a flash block while it is busy.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FTFC_H
+#define FTFC_H
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftfc_Register.h"
+#include "Compiler.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define FTFC_DFLASH_BASE            (0x10000000u)
+#define FTFC_DFLASH_SIZE            (0x00010000u)      /* 64 KB */
+#define FTFC_DFLASH_SECTOR_SIZE     (2048u)
+#define FTFC_PHRASE_SIZE            (8u)
+#define FTFC_QUEUE_SIZE             (4u)               /* Power of 2 */
+/*==================================================================================================
+*                                STRUCTURES AND ENUM
+==================================================================================================*/
+typedef enum
+{
+	FTFC_OK = 0U,
+	FTFC_ERROR_PARAM,                /*!< Outside D-Flash or misaligned              */
+	FTFC_ERROR_ACCESS,               /*!< ACCERR: illegal command or address         */
+	FTFC_ERROR_PROTECTION,           /*!< FPVIOL: region protected                   */
+	FTFC_ERROR_VERIFY,               /*!< MGSTAT0: erase/program verify failed       */
+	FTFC_ERROR_BUSY,                 /*!< Queue full, or a command is running        */
+	FTFC_ERROR_ECC                   /*!< Read: uncorrectable ECC error, no data     */
+} Ftfc_StatusType;
+
+/* Called from FTFC_IRQHandler when a queued command has completed */
+typedef void (*Ftfc_CallbackType)(Ftfc_StatusType status, void *arg);
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief   Queues the erase of the D-Flash sector at address (sector aligned).
+ * @return  FTFC_OK if queued, FTFC_ERROR_PARAM or FTFC_ERROR_BUSY otherwise (no callback then).
+ */
+Ftfc_StatusType Ftfc_EraseSector(unsigned int address, Ftfc_CallbackType callback, void *arg);
+
+/**
+ * @brief   Queues the program of 8 bytes at address (phrase aligned, erased beforehand).
+ * @details data is copied, it does not need to live until the callback.
+ * @return  FTFC_OK if queued, FTFC_ERROR_PARAM or FTFC_ERROR_BUSY otherwise (no callback then).
+ */
+Ftfc_StatusType Ftfc_ProgramPhrase(unsigned int address, const unsigned char *data,
+                                   Ftfc_CallbackType callback, void *arg);
+
+/**
+ * @brief   Copies the 8 bytes at address (phrase aligned) with bus errors caught.
+ * @details The loads run under NVIC_EnterFaultProbe(): a phrase with an
+ *          uncorrectable ECC error is reported, not faulted on.
+ * @return  FTFC_OK, FTFC_ERROR_ECC (data undefined), FTFC_ERROR_PARAM, or
+ *          FTFC_ERROR_BUSY while a command runs (the read would collide).
+ */
+Ftfc_StatusType Ftfc_ReadPhrase(unsigned int address, unsigned char *data);
+
+/**
+ * @brief   Returns 1 while a queued command is pending or running.
+ */
+unsigned char Ftfc_IsBusy(void);
+
+/**
+ * @brief   Completes the running command and launches the next. Called from FTFC_IRQHandler.
+ */
+void Ftfc_IrqHandler(void);
+
+/**
+ * @brief   Programs 8 bytes as fast as possible and waits, for use from the brownout handler.
+ * @details A running sector erase is suspended, the phrase programmed and the
+ *          erase launched again before returning; a running program is waited for
+ *          and its result kept, so its callback still gets its own status.
+ */
+Ftfc_StatusType Ftfc_ProgramPhraseNow(unsigned int address, const unsigned char *data);
+
+#endif
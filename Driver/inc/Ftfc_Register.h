@@ -0,0 +1,65 @@
+/**
+ * @file    Ftfc_Register.h
+ * @brief   Register Definitions for the Flash Memory Module (FTFC).
+ * @details This file contains register definitions and macros for launching
+ *          flash commands. The command object registers are byte wide and
+ *          stored big-endian within each word (FCCOB3 at the lowest address);
+ *          FTFC_FCCOB(n) maps command byte n to its position in FCCOB[].
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FTFC_REG_H
+#define FTFC_REG_H
+/*==================================================================================================
+*                                MACRO DEFINE
+==================================================================================================*/
+#define FTFC_FSTAT_MGSTAT0_SHIFT    (0u)
+#define FTFC_FSTAT_FPVIOL_SHIFT     (4u)
+#define FTFC_FSTAT_ACCERR_SHIFT     (5u)
+#define FTFC_FSTAT_RDCOLERR_SHIFT   (6u)
+#define FTFC_FSTAT_CCIF_SHIFT       (7u)
+#define FTFC_FCNFG_ERSSUSP_SHIFT    (4u)
+#define FTFC_FCNFG_CCIE_SHIFT       (7u)
+#define FTFC_FERSTAT_DFDIF_SHIFT    (1u)
+/* Flash commands (FCCOB0) */
+#define FTFC_CMD_PROGRAM_PHRASE     (0x07u)
+#define FTFC_CMD_ERASE_SECTOR       (0x09u)
+/* FlexNVM in the command address space */
+#define FTFC_DFLASH_CMD_ADDRESS     (0x00800000u)
+
+#define FTFC_FCCOB_COUNT            (12u)
+#define FTFC_FCCOB(n)               ((((n) & ~3u) + 3u) - ((n) & 3u))
+/** Peripheral FTFC base address */
+#define FTFC_BASE_ADDRESS                               (0x40020000u)
+/** Peripheral FTFC base pointer */
+#define FTFC                                     ((FTFC_Type *)FTFC_BASE_ADDRESS)
+/*==================================================================================================
+*                                STRUCTURES AND ENUM
+==================================================================================================*/
+/**
+ * @struct FTFC_Type
+ * @brief Structure defining the register layout of the FTFC peripheral.
+ */
+typedef struct
+{
+	volatile unsigned char FSTAT;                        /*!< Flash status               */
+	volatile unsigned char FCNFG;                        /*!< Flash configuration        */
+	volatile unsigned char FSEC;                         /*!< Flash security             */
+	volatile unsigned char FOPT;                         /*!< Flash option               */
+	volatile unsigned char FCCOB[FTFC_FCCOB_COUNT];      /*!< Command object, FTFC_FCCOB */
+	volatile unsigned char FPROT[4];                     /*!< Program flash protection   */
+	unsigned char          RESERVED_0[2];
+	volatile unsigned char FEPROT;                       /*!< EEPROM protection          */
+	volatile unsigned char FDPROT;                       /*!< Data flash protection      */
+	unsigned char          RESERVED_1[20];
+	volatile unsigned char FCSESTAT;                     /*!< CSEc status                */
+	unsigned char          RESERVED_2;
+	volatile unsigned char FERSTAT;                      /*!< Flash error status         */
+	volatile unsigned char FERCNFG;                      /*!< Flash error configuration  */
+} FTFC_Type;
+
+#endif
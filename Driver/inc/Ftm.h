@@ -0,0 +1,109 @@
+/**
+ * @file    Ftm.h
+ * @brief   FlexTimer Module (FTM) input capture driver interface.
+ * @details The counter runs free over 16 bits from the system clock through
+ *          the prescaler. A capture channel latches the counter on an edge of
+ *          its pin, independent of interrupt latency: the time since the edge
+ *          is the counter now minus the capture, modulo 2^16.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FTM_H
+#define FTM_H
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftm_Register.h"
+/*==================================================================================================
+*                                STRUCTURES AND ENUM
+==================================================================================================*/
+typedef enum
+{
+	FTM_PRESCALER_DIV_1   = 0u,
+	FTM_PRESCALER_DIV_2   = 1u,
+	FTM_PRESCALER_DIV_4   = 2u,
+	FTM_PRESCALER_DIV_8   = 3u,
+	FTM_PRESCALER_DIV_16  = 4u,
+	FTM_PRESCALER_DIV_32  = 5u,
+	FTM_PRESCALER_DIV_64  = 6u,
+	FTM_PRESCALER_DIV_128 = 7u
+} Ftm_PrescalerType;
+
+typedef enum
+{
+	FTM_EDGE_RISING  = 1u,                      /*!< ELSB:ELSA = 01 */
+	FTM_EDGE_FALLING = 2u,                      /*!< ELSB:ELSA = 10 */
+	FTM_EDGE_BOTH    = 3u                       /*!< ELSB:ELSA = 11 */
+} Ftm_EdgeType;
+
+/**
+ * @struct Ftm_CaptureConfigType
+ * @brief  Configuration of one FTM and one of its channels in input capture.
+ */
+typedef struct
+{
+	FTM_Type *pFTMx;
+	unsigned char prescaler;                    /*!< Ftm_PrescalerType                          */
+	unsigned char channel;                      /*!< 0..7                                       */
+	unsigned char edge;                         /*!< Ftm_EdgeType                               */
+	unsigned char filter;                       /*!< Glitch filter 0..15 (x4 clocks), ch 0..3   */
+	unsigned char isInterruptEnabled;           /*!< Channel interrupt on capture               */
+	unsigned char padding[3];
+} Ftm_CaptureConfigType;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief   Configures the counter (free running, 16 bits, system clock) and
+ *          one channel in input capture, then starts the counter.
+ *
+ * @param[in] ConfigPtr   Pointer to the capture configuration.
+ *
+ * @return  None.
+ */
+void Ftm_InitCapture(const Ftm_CaptureConfigType *ConfigPtr);
+
+/**
+ * @brief   Counter frequency in Hz: Clock_GetFrequency(CORE_CLK) divided by the prescaler.
+ */
+unsigned int Ftm_GetFrequency(const FTM_Type *pFTMx);
+/*==================================================================================================
+*                                    INLINE FUNCTIONS
+==================================================================================================*/
+/**
+* @brief          Current counter value.
+*/
+static inline unsigned short Ftm_GetCounter(const FTM_Type *pFTMx)
+{
+	return (unsigned short)pFTMx->CNT;
+}
+
+/**
+* @brief          Returns 1 when the channel captured an edge.
+*/
+static inline unsigned char Ftm_IsCaptured(const FTM_Type *pFTMx, unsigned char channel)
+{
+	return (unsigned char)((pFTMx->CONTROLS[channel].CnSC >> FTM_CnSC_CHF_SHIFT) & 0x01u);
+}
+
+/**
+* @brief          Counter value latched at the last edge.
+*/
+static inline unsigned short Ftm_GetCapture(const FTM_Type *pFTMx, unsigned char channel)
+{
+	return (unsigned short)pFTMx->CONTROLS[channel].CnV;
+}
+
+/**
+* @brief          Clears CHF: CnSC is read with CHF set, then CHF written with 0.
+*/
+static inline void Ftm_ClearCapture(FTM_Type *pFTMx, unsigned char channel)
+{
+	pFTMx->CONTROLS[channel].CnSC &= ~(1u<<FTM_CnSC_CHF_SHIFT);
+}
+
+#endif
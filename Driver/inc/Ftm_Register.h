@@ -0,0 +1,89 @@
+/**
+ * @file    Ftm_Register.h
+ * @brief   Register Definitions for the FlexTimer Module (FTM).
+ * @details This file contains register definitions and macros for the FTM
+ *          counter and its channels, as used for input capture. A channel in
+ *          input capture latches CNT into CnV on the selected edge and sets
+ *          CHF. An edge before CHF is cleared overwrites CnV with no flag of
+ *          its own (CnSC bit 10, CHOV, is the channel output value).
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FTM_REG_H
+#define FTM_REG_H
+/*==================================================================================================
+*                                MACRO DEFINE
+==================================================================================================*/
+/* SC: status and control */
+#define FTM_SC_PS_SHIFT             (0u)
+#define FTM_SC_PS_MASK              (7u)
+#define FTM_SC_CLKS_SHIFT           (3u)
+#define FTM_SC_CLKS_MASK            (3u)
+#define FTM_SC_CLKS_SYSTEM          (1u)
+#define FTM_SC_CPWMS_SHIFT          (5u)
+#define FTM_SC_TOIE_SHIFT           (8u)
+/* CnSC: channel status and control */
+#define FTM_CnSC_ELSA_SHIFT         (2u)
+#define FTM_CnSC_ELSB_SHIFT         (3u)
+#define FTM_CnSC_MSA_SHIFT          (4u)
+#define FTM_CnSC_MSB_SHIFT          (5u)
+#define FTM_CnSC_CHIE_SHIFT         (6u)
+#define FTM_CnSC_CHF_SHIFT          (7u)
+/* MODE */
+#define FTM_MODE_WPDIS_SHIFT        (2u)
+/* FILTER: 4-bit value per channel 0..3 */
+#define FTM_FILTER_CHnFVAL_SHIFT(channel)  (4u * (channel))
+#define FTM_FILTER_CHnFVAL_MASK     (0xFu)
+
+#define FTM_CHANNEL_COUNT           (8u)
+#define FTM_FILTER_CHANNEL_COUNT    (4u)
+#define FTM_COUNTER_MAX             (0xFFFFu)
+/** Peripheral FTM base addresses */
+#define FTM0_BASE_ADDRESS                               (0x40038000u)
+#define FTM1_BASE_ADDRESS                               (0x40039000u)
+#define FTM2_BASE_ADDRESS                               (0x4003A000u)
+#define FTM3_BASE_ADDRESS                               (0x40026000u)
+/** Peripheral FTM base pointers */
+#define FTM0                                     ((FTM_Type *)FTM0_BASE_ADDRESS)
+#define FTM1                                     ((FTM_Type *)FTM1_BASE_ADDRESS)
+#define FTM2                                     ((FTM_Type *)FTM2_BASE_ADDRESS)
+#define FTM3                                     ((FTM_Type *)FTM3_BASE_ADDRESS)
+/*==================================================================================================
+*                                STRUCTURES AND ENUM
+==================================================================================================*/
+/**
+ * @struct FTM_Type
+ * @brief Structure defining the register layout of the FTM peripheral, up to CONF.
+ */
+typedef struct
+{
+	volatile unsigned int SC;                    /*!< Status and control          */
+	volatile unsigned int CNT;                   /*!< Counter                     */
+	volatile unsigned int MOD;                   /*!< Modulo                      */
+	struct
+	{
+		volatile unsigned int CnSC;              /*!< Channel status and control  */
+		volatile unsigned int CnV;               /*!< Channel value               */
+	} CONTROLS[FTM_CHANNEL_COUNT];
+	volatile unsigned int CNTIN;                 /*!< Counter initial value       */
+	volatile unsigned int STATUS;                /*!< Capture and compare status  */
+	volatile unsigned int MODE;                  /*!< Features mode selection     */
+	volatile unsigned int SYNC;                  /*!< Synchronization             */
+	volatile unsigned int OUTINIT;               /*!< Initial state for outputs   */
+	volatile unsigned int OUTMASK;               /*!< Output mask                 */
+	volatile unsigned int COMBINE;               /*!< Channel pair functions      */
+	volatile unsigned int DEADTIME;              /*!< Deadtime configuration      */
+	volatile unsigned int EXTTRIG;               /*!< External trigger            */
+	volatile unsigned int POL;                   /*!< Channels polarity           */
+	volatile unsigned int FMS;                   /*!< Fault mode status           */
+	volatile unsigned int FILTER;                /*!< Input capture filter        */
+	volatile unsigned int FLTCTRL;               /*!< Fault control               */
+	volatile unsigned int QDCTRL;                /*!< Quadrature decoder control  */
+	volatile unsigned int CONF;                  /*!< Configuration               */
+} FTM_Type;
+
+#endif
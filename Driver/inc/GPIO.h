@@ -61,9 +61,130 @@ typedef struct __attribute__((packed))
 *                                    FUNCTION PROTOTYPES
 ==================================================================================================*/
 extern void GPIO_Init(GPIO_Type* ConfigPtr, unsigned char PinNumber,unsigned char Mode);
-extern void GPIO_WriteToOutputPin (GPIO_Type *pGPIOx, unsigned char PinNumber, unsigned char value);
-extern void GPIO_SetOutputPin (GPIO_Type *pGPIOx, unsigned char PinNumber);
-extern void GPIO_ResetOutputPin (GPIO_Type *pGPIOx, unsigned char PinNumber);
-extern void GPIO_TogglePin (GPIO_Type *pGPIOx, unsigned char PinNumber);
-extern unsigned char GPIO_ReadStateInputPin (GPIO_Type *pGPIOx, unsigned char PinNumber);
+
+/*==================================================================================================
+*                                    INLINE FUNCTIONS
+==================================================================================================*/
+/*
+ * PSOR/PCOR/PTOR are write-only "write 1 to act" registers: a single store
+ * changes exactly the pins whose bits are 1 and leaves every other pin alone.
+ * None of the functions below reads PDOR, so they are atomic with respect to
+ * interrupts and can be called from any ISR without a critical section.
+ */
+
+/**
+* @brief          Drives all pins in PinMask high.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+* @param[in]      PinMask        Bit n set = pin n is set.
+*
+* @pre            The pins must be configured as outputs using GPIO_Init.
+*/
+static inline void GPIO_SetPins (GPIO_Type *pGPIOx, unsigned int PinMask)
+{
+    pGPIOx->PSOR = PinMask;
+}
+
+/**
+* @brief          Drives all pins in PinMask low.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+* @param[in]      PinMask        Bit n set = pin n is cleared.
+*
+* @pre            The pins must be configured as outputs using GPIO_Init.
+*/
+static inline void GPIO_ClearPins (GPIO_Type *pGPIOx, unsigned int PinMask)
+{
+    pGPIOx->PCOR = PinMask;
+}
+
+/**
+* @brief          Toggles all pins in PinMask.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+* @param[in]      PinMask        Bit n set = pin n is toggled.
+*
+* @pre            The pins must be configured as outputs using GPIO_Init.
+*/
+static inline void GPIO_TogglePins (GPIO_Type *pGPIOx, unsigned int PinMask)
+{
+    pGPIOx->PTOR = PinMask;
+}
+
+/**
+* @brief          Reads the input level of all 32 pins of a port.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+*
+* @return         unsigned int   PDIR, bit n = level of pin n.
+*/
+static inline unsigned int GPIO_ReadPort (GPIO_Type *pGPIOx)
+{
+    return pGPIOx->PDIR;
+}
+
+/**
+* @brief          Setting high-level ouput of the specific GPIO pin.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+* @param[in]      PinNumber      The specific pin number, from 0 to 31.
+*/
+static inline void GPIO_SetOutputPin (GPIO_Type *pGPIOx, unsigned char PinNumber)
+{
+    pGPIOx->PSOR = (1u << PinNumber);
+}
+
+/**
+* @brief          Resetting ouput of the specific GPIO pin to low-level.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+* @param[in]      PinNumber      The specific pin number, from 0 to 31.
+*/
+static inline void GPIO_ResetOutputPin (GPIO_Type *pGPIOx, unsigned char PinNumber)
+{
+    pGPIOx->PCOR = (1u << PinNumber);
+}
+
+/**
+* @brief          Toggles the output level of the specified GPIO pin.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+* @param[in]      PinNumber      The specific pin number, from 0 to 31.
+*/
+static inline void GPIO_TogglePin (GPIO_Type *pGPIOx, unsigned char PinNumber)
+{
+    pGPIOx->PTOR = (1u << PinNumber);
+}
+
+/**
+* @brief          Set ouput level of the specific GPIO pin.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+* @param[in]      PinNumber      The specific pin number, from 0 to 31.
+* @param[in]      value          GPIO_HIGH_OUTPUT_PIN or GPIO_LOW_OUTPUT_PIN.
+*/
+static inline void GPIO_WriteToOutputPin (GPIO_Type *pGPIOx, unsigned char PinNumber, unsigned char value)
+{
+    if (value == GPIO_HIGH_OUTPUT_PIN)
+    {
+        pGPIOx->PSOR = (1u << PinNumber);
+    }
+    else
+    {
+        pGPIOx->PCOR = (1u << PinNumber);
+    }
+}
+
+/**
+* @brief          Reads the state of the specified GPIO input pin.
+*
+* @param[in]      pGPIOx         Pointer to the GPIO peripheral (GPIOA to GPIOE).
+* @param[in]      PinNumber      The specific pin number, from 0 to 31.
+*
+* @return         unsigned char  0: Pin is at a low level, 1: Pin is at a high level.
+*/
+static inline unsigned char GPIO_ReadStateInputPin (GPIO_Type *pGPIOx, unsigned char PinNumber)
+{
+    return (unsigned char)((pGPIOx->PDIR >> PinNumber) & 0x01u);
+}
 #endif
@@ -0,0 +1,85 @@
+/**
+ * @file    Lmem.h
+ * @brief   LMEM code cache driver interface.
+ * @details Lmem_Init() is called from SystemInit() before scatter loading, so the
+ *          driver uses no initialised data. Region policies can only change
+ *          while the cache is off; Lmem_SetRegionMode() handles that.
+ *          Anything that erases or programs flash (or FlexNVM while it is
+ *          cacheable) must call Lmem_InvalidateRange() on the touched range
+ *          afterwards, or the core may execute stale lines.
+ *          The gain shows in the per-IRQ cycles of "GET STATS" of a build with
+ *          LMEM_CACHE_ENABLE = 0 against the default one ("CODE CACHE" in the
+ *          report); Tools/benchstats.py captures and compares them.
+ *          The header has no register include: it is also pulled into
+ *          system_S32K144.c next to the SDK device headers.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LMEM_H
+#define LMEM_H
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#ifndef LMEM_CACHE_ENABLE
+#define LMEM_CACHE_ENABLE 					1          /* Set to 0 to leave the cache off (reset state) */
+#endif
+/* Code bus regions (PCCRMR) */
+#define LMEM_REGION_PFLASH 					(0u)       /* 0x0000_0000 - 0x07FF_FFFF program flash   */
+#define LMEM_REGION_FLEXNVM 				(2u)       /* 0x1000_0000 - 0x17FF_FFFF FlexNVM/FlexRAM */
+#define LMEM_REGION_SRAM_L 					(3u)       /* 0x1800_0000 - 0x1FFF_FFFF SRAM_L          */
+/*==================================================================================================
+*                                STRUCTURES AND ENUM
+==================================================================================================*/
+typedef enum
+{
+	LMEM_MODE_NON_CACHEABLE = 0U,
+	LMEM_MODE_WRITE_THROUGH = 2U,
+	LMEM_MODE_WRITE_BACK    = 3U
+} Lmem_ModeType;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief   Sets the region policies, invalidates and enables the cache.
+ * @details Program flash is cached write-through. FlexNVM stays non-cacheable
+ *          since it is written behind the cache by the flash controller, and
+ *          SRAM_L has no wait states so caching it only evicts flash lines.
+ */
+void Lmem_Init(void);
+
+/**
+ * @brief   Invalidates both ways and turns the cache on.
+ */
+void Lmem_Enable(void);
+
+/**
+ * @brief   Turns the cache off, accesses go straight to the memories.
+ */
+void Lmem_Disable(void);
+
+/**
+ * @brief   Returns 1 if the cache is on.
+ */
+unsigned char Lmem_IsEnabled(void);
+
+/**
+ * @brief   Invalidates the whole cache.
+ */
+void Lmem_InvalidateAll(void);
+
+/**
+ * @brief   Invalidates the lines holding [address, address + size).
+ * @details One line command per 16 bytes; a large range is cheaper with Lmem_InvalidateAll().
+ */
+void Lmem_InvalidateRange(unsigned int address, unsigned int size);
+
+/**
+ * @brief   Sets the policy of one region, the cache is disabled meanwhile.
+ */
+void Lmem_SetRegionMode(unsigned char region, Lmem_ModeType mode);
+
+#endif
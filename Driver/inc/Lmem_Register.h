@@ -0,0 +1,57 @@
+/**
+ * @file    Lmem_Register.h
+ * @brief   Register Definitions for the Local Memory Controller (LMEM) code cache.
+ * @details This file contains register definitions and macros for the processor
+ *          code bus cache: 4 KB, 2-way set associative, 16-byte lines. It caches
+ *          code bus accesses (0x0000_0000 - 0x1FFF_FFFF) per region mode.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LMEM_REG_H
+#define LMEM_REG_H
+/*==================================================================================================
+*                                MACRO DEFINE
+==================================================================================================*/
+/* PCCCR: cache control */
+#define LMEM_PCCCR_ENCACHE_SHIFT    (0u)
+#define LMEM_PCCCR_INVW0_SHIFT      (24u)
+#define LMEM_PCCCR_INVW1_SHIFT      (26u)
+#define LMEM_PCCCR_GO_SHIFT         (31u)
+/* PCCLCR: line command */
+#define LMEM_PCCLCR_LCMD_SHIFT      (24u)
+#define LMEM_PCCLCR_LADSEL_SHIFT    (26u)
+#define LMEM_PCCLCR_LCMD_INVALIDATE (1u)
+/* PCCSAR: line address, physical address with the go bit */
+#define LMEM_PCCSAR_LGO_SHIFT       (0u)
+/* PCCRMR: region n mode in bits [31 - 2n : 30 - 2n] */
+#define LMEM_PCCRMR_MODE_MASK       (3u)
+#define LMEM_PCCRMR_SHIFT(region)   (30u - (2u * (region)))
+
+#define LMEM_LINE_SIZE              (16u)
+#define LMEM_REGION_COUNT           (16u)
+/** Peripheral LMEM base address */
+#define LMEM_BASE_ADDRESS                               (0xE0082000u)
+/** Peripheral LMEM base pointer */
+#define LMEM                                     ((LMEM_Type *)LMEM_BASE_ADDRESS)
+/*==================================================================================================
+*                                STRUCTURES AND ENUM
+==================================================================================================*/
+/**
+ * @struct LMEM_Type
+ * @brief Structure defining the register layout of the LMEM code cache controller.
+ */
+typedef struct
+{
+	volatile unsigned int PCCCR;                 /*!< Cache control              */
+	volatile unsigned int PCCLCR;                /*!< Cache line control         */
+	volatile unsigned int PCCSAR;                /*!< Cache search address       */
+	volatile unsigned int PCCCVR;                /*!< Cache read/write value     */
+	volatile unsigned int RESERVED_0[4];
+	volatile unsigned int PCCRMR;                /*!< Cache regions mode         */
+} LMEM_Type;
+
+#endif
@@ -34,9 +34,11 @@
  */
 typedef struct
 {
-    unsigned int period;                        /*!< Period of timer channel                     */
+    unsigned int period;                        /*!< Period of timer channel (raw TVAL)          */
+    unsigned int periodUs;                      /*!< Period in microseconds, overrides period    */
     unsigned char isInterruptEnabled;           /*!< Timer channel interrupt generation enable   */
-		unsigned char padding[3];
+    unsigned char isChained;                    /*!< Decrement on timeout of channel - 1         */
+		unsigned char padding[2];
 } Lpit_ChannelConfigType;
 
 /**
@@ -54,6 +56,10 @@ void Lpit_Init( void );
  * 
  * @details This function initializes a timer channel of the LPIT with the provided 
  *          configuration settings, such as the period and interrupt enable state.
+ *          When periodUs is set, TVAL = f_lpit * periodUs / 1000000 - 1 is computed from
+ *          Clock_GetFrequency(LPIT0_CLK) (the timeout is TVAL + 1 clock cycles).
+ *          A chained channel counts timeouts of the channel below it instead of
+ *          clock cycles; channel 0 cannot be chained.
  *
  * @param[in] channel     Channel number to initialize.
  * @param[in] ConfigPtr   Pointer to the configuration structure for the channel.
@@ -74,6 +80,19 @@ void Lpit_InitChannel(unsigned char channel, const Lpit_ChannelConfigType* Confi
  */
 void Lpit_StartChannel(unsigned char channel);
 
+/**
+ * @brief   Changes the reload value of a running LPIT channel.
+ * 
+ * @details The counter is not restarted: the new TVAL is loaded at the next
+ *          timeout, so it sets the length of the period after the current one.
+ *
+ * @param[in] channel     Channel number.
+ * @param[in] value       New TVAL, the period is value + 1 clock cycles.
+ *
+ * @return  None.
+ */
+void Lpit_SetPeriod(unsigned char channel, unsigned int value);
+
 /**
  * @brief   Stops a specific LPIT timer channel.
  * 
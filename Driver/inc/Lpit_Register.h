@@ -26,6 +26,7 @@
 #define LPIT_MCR_DBG_EN_SHIFT       (3u)
 #define LPIT_TMR_TCTRL_T_EN_SHIFT   (0u)
 #define LPIT_TMR_TCTRL_MODE_SHIFT   (2u)
+#define LPIT_TMR_TCTRL_CHAIN_SHIFT  (1u)
 #define LPIT_TMR_COUNT              (4u)
 #define LPIT_CHANNEL_0              (0u)
 #define LPIT_CHANNEL_1              (1u)
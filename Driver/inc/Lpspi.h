@@ -15,6 +15,7 @@
 *                                       INCLUDE FILE
 ==================================================================================================*/
 #include "Lpspi_Register.h"
+#include "Compiler.h"
 /*==================================================================================================
 *                                    ENUMERATIONS
 ==================================================================================================*/
@@ -97,8 +98,8 @@ typedef enum
  */
 typedef struct
 {
-unsigned int                  F_lpspi;      /* Clock supply for LPSPI */
-unsigned int                  spi_speed; 
+unsigned int                  F_lpspi;      /* Clock supply for LPSPI (Hz), 0 = read from Clock_GetFrequency() */
+unsigned int                  spi_speed;    /* Target SCK (Hz), 0 = use spi_sck_div/spi_prescaler as given */
 unsigned int                  spi_sck_div; 
 spi_prescaler_t               spi_prescaler;
 spi_type_transfer_t     	  	spi_type_transfer;
@@ -106,7 +107,8 @@ spi_frame_size_t              spi_frame;
 spi_clock_polarity_t          spi_cpol;
 spi_clock_phase_t             spi_cpha;
 spi_peripheral_chip_select_t  spi_pcs;
-unsigned char padding[2]; 
+unsigned char                 spi_dbt;      /* Delay between transfers (PCS high time) = DBT + 2 LPSPI clocks */
+unsigned char padding[1]; 
 }LPSPIT_InitType;
 
 /**
@@ -130,18 +132,45 @@ typedef struct
 ==================================================================================================*/
 /**
  * @brief  Initializes the LPSPI peripheral with the specified configuration.
+ * @details When Init.spi_speed is set, the smallest prescaler and the SCKDIV giving
+ *          SCK = f_lpspi / (2^PRESCALE * (SCKDIV + 2)) <= spi_speed are computed here.
  * @param[in] ConfigPtr Pointer to the configuration structure (Lpspi_ConfigType).
  * @return None.
  */
 void Lpspi_Init (const Lpspi_ConfigType* ConfigPtr);
 /**
  * @brief  Transmits data via the LPSPI peripheral.
+ * @details Same as Lpspi_TransmitBurst().
  * @param[in] pLpspi Pointer to the LPSPI peripheral.
  * @param[in] pTxBuffer Pointer to the data buffer to be transmitted.
  * @param[in] Size Size of the data to be transmitted.
  * @return None.
  */
 void Lpspi_Transmit(LPSPI_Type *pLpspi, unsigned short *pTxBuffer, unsigned short Size);
+/**
+ * @brief  Transmits data, filling every free TX FIFO entry after each status poll
+ *         instead of waiting for TDF before each word.
+ * @param[in] pLpspi Pointer to the LPSPI peripheral.
+ * @param[in] pTxBuffer Pointer to the data buffer to be transmitted.
+ * @param[in] Size Number of frames to be transmitted.
+ * @return None.
+ */
+void Lpspi_TransmitBurst(LPSPI_Type *pLpspi, const unsigned short *pTxBuffer, unsigned short Size);
+/**
+ * @brief  Transmits all words under one chip select assertion (TCR CONT/CONTC).
+ * @details Used for daisy-chained devices that latch on the rising edge of CS.
+ * @param[in] pLpspi Pointer to the LPSPI peripheral.
+ * @param[in] pTxBuffer Pointer to the data buffer to be transmitted.
+ * @param[in] Size Number of frames to be transmitted.
+ * @return None.
+ */
+void Lpspi_TransmitContinuous(LPSPI_Type *pLpspi, const unsigned short *pTxBuffer, unsigned short Size);
+/**
+ * @brief  Waits until the TX FIFO is empty and the last frame has left the shifter.
+ * @param[in] pLpspi Pointer to the LPSPI peripheral.
+ * @return None.
+ */
+void Lpspi_WaitIdle(LPSPI_Type *pLpspi);
 
 
 #endif /* LPSPI_H */
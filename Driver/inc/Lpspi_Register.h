@@ -24,8 +24,13 @@
 #define LPSPI_TCR_PRESCALE_SHIFT                 (27u)
 #define LPSPI_TCR_FRAMESZ_SHIFT                  (0u)
 #define LPSPI_TCR_LSBF_SHIFT                     (23u)
+#define LPSPI_TCR_CONT_SHIFT                     (21u)
+#define LPSPI_TCR_CONTC_SHIFT                    (20u)
 #define LPSPI_TCR_PCS_SHIFT                      (24u)
 #define LPSPI_CCR_SCKDIV_SHIFT                   (0u)
+#define LPSPI_CCR_SCKDIV_MAX                     (0xFFu)
+#define LPSPI_CCR_DBT_SHIFT                      (8u)
+#define LPSPI_CCR_DBT_MAX                        (0xFFu)
 #define LPSPI_FCR_RXWATER_SHIFT                  (16u)
 #define LPSPI_FCR_TXWATER_SHIFT                  (0u)
 #define LPSPI_CFGR1_NOSTALL_SHIFT                (3u)
@@ -34,6 +39,9 @@
 #define LPSPI_CR_MEN_SHIFT                       (0u)
 #define TRANSMIT_IS_REQUESTED                    (1u)
 #define LPSPI_SR_TDF_SHIFT                       (0u)
+#define LPSPI_SR_MBF_SHIFT                       (24u)
+#define LPSPI_FSR_TXCOUNT_MASK                   (0x7u)
+#define LPSPI_TX_FIFO_SIZE                       (4u)
 #define LPSPI_TCR_FRAMESZ_MASK   								 (0xFFF)  
 /** Peripheral LPSPI base address */
 #define LPSPI0_base_address  (0x4002C000u)
@@ -3,6 +3,12 @@
  * @brief   LPUART Driver for Initialization and Data Transmission.
  * @details This header file contains the necessary data structures and function 
  *          declarations for configuring and operating the LPUART.
+ *          One instance, initialized with lpuart_enable_int_TX, gets a TX queue:
+ *          Lpuart_Write() copies the bytes and returns, the TDRE interrupt
+ *          (Lpuart_TxIrqHandler() from the instance's handler) sends them. The
+ *          queue is locked by masking that interrupt (BASEPRI at its own
+ *          priority, which must not be 0) for the copy only, never while a
+ *          byte is on the wire.
  *
  * @version 1.0
  * @date    2024-10-20
@@ -17,6 +23,10 @@
 ==================================================================================================*/
 #include "Lpuart_Register.h"
 /*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define LPUART_TX_QUEUE_SIZE 			(512U)     /* Bytes, power of 2: a whole GET STATS report */
+/*==================================================================================================
 *                                    ENUMERATIONS
 ==================================================================================================*/
 /**
@@ -126,11 +136,12 @@ typedef enum
  */
 typedef struct
 {
-    unsigned char lpuart_enable_int_TX; /*reserve*/
+    unsigned char lpuart_enable_int_TX; /* TX queue sent from the TDRE interrupt, one instance only */
     unsigned char lpuart_enable_int_RX;
     unsigned char lpuart_enable_idl;
 	unsigned char padding_1;
-    unsigned int lpuart_baudrate_modulo_divisor;
+    unsigned int lpuart_baudrate_modulo_divisor;   /* Raw SBR, used only when lpuart_baudrate is 0 */
+    unsigned int lpuart_baudrate;                  /* Target baud rate (bps), SBR is derived from the clock tree */
     uart_oversampling_ratio_t lpuart_oversampling;
     unsigned char padding_2[2];
     uart_stop_bit_number_t lpuart_stop_bit;
@@ -159,6 +170,8 @@ typedef struct
  *
  * Configures the LPUART according to the parameters specified in the configuration structure.
  * Sets up baud rate, oversampling ratio, stop bits, frame size, parity, and interrupt settings.
+ * When lpuart_baudrate is set, SBR = round(f_lpuart / ((OSR + 1) * baudrate)) where f_lpuart
+ * is read back with Clock_GetFrequency(), so the PCC clock must be configured first.
  *
  * @param ConfigPtr Pointer to the configuration structure containing the initialization parameters.
  */
@@ -175,6 +188,41 @@ void Lpuart_Init (const Lpuart_ConfigType* ConfigPtr);
  */
 void Lpuart_Transmit(LPUART_Type *pUartx, unsigned char *pTxBuffer, unsigned char size);
 
+/**
+ * @brief Queues data for the TDRE interrupt and returns.
+ *
+ * Waits only while the queue is full; called from the instance's own interrupt,
+ * which the TX interrupt cannot preempt, it sends the bytes that make room itself.
+ * An instance without TX queue is written with Lpuart_Transmit().
+ *
+ * @param pUartx Pointer to the LPUART peripheral.
+ * @param pTxBuffer Pointer to the data buffer to be transmitted, copied.
+ * @param size Size of the data buffer.
+ */
+void Lpuart_Write(LPUART_Type *pUartx, const unsigned char *pTxBuffer, unsigned char size);
+
+/**
+ * @brief Free bytes in the TX queue, 0 for an instance without TX queue.
+ */
+unsigned int Lpuart_GetTxSpace(LPUART_Type *pUartx);
+
+/**
+ * @brief Waits until every queued byte has left the shift register (STAT[TC]).
+ */
+void Lpuart_Flush(LPUART_Type *pUartx);
+
+/**
+ * @brief Sends the next queued byte on TDRE, clears TIE once the queue is empty.
+ *        Called from the instance's interrupt handler.
+ */
+void Lpuart_TxIrqHandler(LPUART_Type *pUartx);
+
+/**
+ * @brief Clears a receiver overrun (STAT[OR]), the receiver takes no data while it is set.
+ * @return 1 if a byte was lost since the last call, 0 otherwise.
+ */
+unsigned char Lpuart_ClearOverrun(LPUART_Type *pUartx);
+
 /**
  * @brief Receives data using the LPUART.
  *
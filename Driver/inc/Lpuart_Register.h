@@ -22,9 +22,11 @@
 /* LPUART Register Shift Bit*/
 #define LPUART_BAUD_OSR_SHIFT 			(24U)
 #define LPUART_BAUD_SBR_SHIFT 			(0U)
+#define LPUART_BAUD_SBR_MAX 			  (0x1FFFU)
 #define LPUART_BAUD_SBNS_SHIFT 		  (13U)
 #define LPUART_CTRL_M_SHIFT 				(4U)
 #define LPUART_CTRL_PE_SHIFT 			  (1U)
+#define LPUART_CTRL_TIE_SHIFT 			(23U)
 #define LPUART_CTRL_RIE_SHIFT 			(21U)
 #define LPUART_CTRL_ILIE_SHIFT 		  (20U)
 #define LPUART_CTRL_IDLECFG_SHIFT 	(8U)
@@ -34,6 +36,9 @@
 #define LPUART_STAT_IDLE_SHIFT 		  (20U)
 #define LPUART_STAT_TDRE_SHIFT 		  (23U)
 #define LPUART_STAT_RDRF_SHIFT 		  (21U)
+#define LPUART_STAT_TC_SHIFT 			  (22U)
+#define LPUART_STAT_OR_SHIFT 			  (19U)
+#define LPUART_STAT_W1C_MASK 			  (0xC01FC000U)   /* LBKDIF, RXEDGIF, IDLE, OR, NF, FE, PF, MA1F, MA2F */
 /** Peripheral LPSPI base address */
 #define LPUART0_base_address (0x4006A000U)
 #define LPUART1_base_address (0x4006B000U)
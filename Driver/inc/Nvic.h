@@ -171,16 +171,301 @@ typedef enum
   FTM3_Ovf_Reload_IRQ      = 122u,
 } IRQn_Type;                            /*NVIC Interrupt ID*/        
 
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+/**
+* @brief        Statistics of BASEPRI critical sections
+* @details      Only outermost sections are timed, in core clock cycles (DWT CYCCNT).
+*/
+typedef struct
+{
+  unsigned long long totalCycles;       /*!< Total time spent with BASEPRI raised */
+  unsigned int       maxCycles;         /*!< Longest single section               */
+  unsigned int       count;             /*!< Number of outermost sections         */
+} Nvic_CriticalStatsType;
+
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+#ifndef NVIC_CRITICAL_STATS
+#define NVIC_CRITICAL_STATS 1          /* Set to 0 to compile the instrumentation out */
+#endif
+
+#if (NVIC_CRITICAL_STATS == 1)
+extern volatile Nvic_CriticalStatsType Nvic_CriticalStats;
+extern volatile unsigned int Nvic_CriticalStart;
+#endif
+
 /*==================================================================================================
 *                                    FUNCTION PROTOTYPES
 ==================================================================================================*/
+/**
+* @brief        Starts the DWT cycle counter used to time critical sections
+*/
+void NVIC_CriticalStatsInit(void);
+
+/**
+* @brief        Resets the critical section statistics
+*/
+void NVIC_CriticalStatsReset(void);
+
+/*==================================================================================================
+*                                    INLINE FUNCTIONS
+==================================================================================================*/
+/*
+ * Every function below is a single register access on a local value: no
+ * file-static scratch storage, so they are reentrant from any priority.
+ */
+
+/**
+* @brief        Enable Interrupt of IRQn pin (ISER is write-1-to-set)
+*/
+static inline void NVIC_EnableInterrupt(IRQn_Type IRQ_number)
+{
+  NVIC->ISER[IRQ_number / 32u] = (1u << (IRQ_number % 32u));
+}
+
+/**
+* @brief        Disable Interrupt of IRQn pin (ICER is write-1-to-clear)
+*/
+static inline void NVIC_DisableInterrupt(IRQn_Type IRQ_number)
+{
+  NVIC->ICER[IRQ_number / 32u] = (1u << (IRQ_number % 32u));
+}
+
+/**
+* @brief        Set pending flag of IRQn pin
+*/
+static inline void NVIC_SetPendingFlag(IRQn_Type IRQ_number)
+{
+  NVIC->ISPR[IRQ_number / 32u] = (1u << (IRQ_number % 32u));
+}
+
+/**
+* @brief        Clear the pending flag of IRQn pin
+*/
+static inline void NVIC_ClearPendingFlag(IRQn_Type IRQ_number)
+{
+  NVIC->ICPR[IRQ_number / 32u] = (1u << (IRQ_number % 32u));
+}
+
+/**
+* @brief        Read the state of the pending flag of IRQn pin
+* @return       ACTIVE if pending, NOT_ACTIVE otherwise
+*/
+static inline unsigned char NVIC_GetPendingInterrupt(IRQn_Type IRQ_number)
+{
+  return (unsigned char)((NVIC->ISPR[IRQ_number / 32u] >> (IRQ_number % 32u)) & 0x01u);
+}
+
+/**
+* @brief        Set priority for IRQn pin
+* @details      IPR is byte addressable: one byte store, no read-modify-write of the
+*               neighbouring IRQs. Values above 15 are ignored.
+*
+* @param[in]    priority     0 (highest) to 15 (lowest), see NVIC_EncodePriority()
+*/
+static inline void NVIC_SetPriority(IRQn_Type IRQ_number, unsigned int priority)
+{
+  if (priority < (1u << NVIC_PRIO_BITS))
+  {
+    ((volatile unsigned char *)NVIC->IPR)[IRQ_number] = (unsigned char)(priority << (8u - NVIC_PRIO_BITS));
+  }
+}
+
+/**
+* @brief        Priority set for IRQn, 0 (highest) to 15 (lowest)
+*/
+static inline unsigned int NVIC_GetPriority(IRQn_Type IRQ_number)
+{
+  return (unsigned int)((volatile unsigned char *)NVIC->IPR)[IRQ_number] >> (8u - NVIC_PRIO_BITS);
+}
+
+/**
+* @brief        Set the preemption/sub-priority split (AIRCR[PRIGROUP])
+* @details      With 4 priority bits, PRIGROUP 0..3 give 16 preemption levels,
+*               4 gives 8 preempt x 2 sub, ..., 7 gives 16 sub-priorities only.
+*/
+static inline void NVIC_SetPriorityGrouping(unsigned int group)
+{
+  unsigned int reg = SCB_AIRCR & ~((0xFFFFu << 16) | SCB_AIRCR_PRIGROUP_MASK);
+
+  SCB_AIRCR = reg | SCB_AIRCR_VECTKEY | ((group & 0x7u) << SCB_AIRCR_PRIGROUP_SHIFT);
+}
+
+static inline unsigned int NVIC_GetPriorityGrouping(void)
+{
+  return (SCB_AIRCR & SCB_AIRCR_PRIGROUP_MASK) >> SCB_AIRCR_PRIGROUP_SHIFT;
+}
+
+/**
+* @brief        Builds a 4-bit priority value from preemption and sub-priority
+*               for the given grouping, ready for NVIC_SetPriority()
+*/
+static inline unsigned int NVIC_EncodePriority(unsigned int group, unsigned int preempt, unsigned int sub)
+{
+  unsigned int subBits = ((group & 0x7u) + NVIC_PRIO_BITS > 7u) ? ((group & 0x7u) + NVIC_PRIO_BITS - 7u) : 0u;
+  unsigned int preBits = NVIC_PRIO_BITS - subBits;
+
+  return ((preempt & ((1u << preBits) - 1u)) << subBits) | (sub & ((1u << subBits) - 1u));
+}
+
+static inline unsigned int NVIC_GetBasePri(void)
+{
+  unsigned int value;
+
+#if defined(HOST_TEST)
+  value = Host_BasePri;
+#else
+  __asm volatile ("mrs %0, basepri" : "=r" (value));
+#endif
+  return value;
+}
+
+/**
+* @brief        Enters a critical section masking IRQs of priority >= `priority`
+* @details      Uses BASEPRI_MAX, which only ever raises the mask, so sections nest
+*               freely and higher-priority IRQs keep running. Priority 0 IRQs can
+*               never be masked this way.
+*
+* @param[in]    priority     1 (mask almost everything) to 15 (mask only the lowest)
+* @return       Previous BASEPRI, to be passed to NVIC_ExitCritical()
+*/
+static inline unsigned int NVIC_EnterCritical(unsigned int priority)
+{
+  unsigned int previous = NVIC_GetBasePri();
+  unsigned int level = (priority << (8u - NVIC_PRIO_BITS)) & 0xFFu;
+
+#if defined(HOST_TEST)
+  if ((level != 0u) && ((previous == 0u) || (level < previous)))
+  {
+    Host_BasePri = level;
+  }
+#else
+  __asm volatile ("msr basepri_max, %0" : : "r" (level) : "memory");
+#endif
+#if (NVIC_CRITICAL_STATS == 1)
+  if (previous == 0u)
+  {
+    Nvic_CriticalStart = DWT_CYCCNT;
+  }
+#endif
+  return previous;
+}
+
+/**
+* @brief        Leaves a critical section, restoring the mask returned by NVIC_EnterCritical()
+*/
+static inline void NVIC_ExitCritical(unsigned int previous)
+{
+#if (NVIC_CRITICAL_STATS == 1)
+  unsigned int elapsed;
+
+  if (previous == 0u)
+  {
+    elapsed = DWT_CYCCNT - Nvic_CriticalStart;
+    Nvic_CriticalStats.totalCycles += elapsed;
+    Nvic_CriticalStats.count++;
+    if (elapsed > Nvic_CriticalStats.maxCycles)
+    {
+      Nvic_CriticalStats.maxCycles = elapsed;
+    }
+  }
+#endif
+#if defined(HOST_TEST)
+  Host_BasePri = previous;
+#else
+  __asm volatile ("msr basepri, %0" : : "r" (previous) : "memory");
+#endif
+}
+
+/**
+* @brief        Masks every configurable interrupt, priority 0 included (PRIMASK)
+* @details      For the few sections the brownout handler must not preempt. Nests.
+* @return       Previous PRIMASK, to be passed to NVIC_ExitExclusive()
+*/
+static inline unsigned int NVIC_EnterExclusive(void)
+{
+  unsigned int previous;
+
+#if defined(HOST_TEST)
+  previous = Host_Primask;
+  Host_Primask = 1u;
+#else
+  __asm volatile ("mrs %0, primask" : "=r" (previous));
+  __asm volatile ("cpsid i" : : : "memory");
+#endif
+  return previous;
+}
+
+/**
+* @brief        Restores the PRIMASK returned by NVIC_EnterExclusive()
+*/
+static inline void NVIC_ExitExclusive(unsigned int previous)
+{
+#if defined(HOST_TEST)
+  Host_Primask = previous;
+#else
+  __asm volatile ("msr primask, %0" : : "r" (previous) : "memory");
+#endif
+}
+
+/**
+* @brief        Starts reading memory that may answer with a bus error
+* @details      Sets FAULTMASK, and CCR BFHFNMIGN which makes precise data bus
+*               errors at that level complete without a BusFault: the load returns
+*               undefined data and only CFSR records the error. Keep the probe to
+*               a few loads, NMI aside nothing else runs meanwhile.
+* @return       Previous FAULTMASK, to be passed to NVIC_ExitFaultProbe()
+*/
+static inline unsigned int NVIC_EnterFaultProbe(void)
+{
+  unsigned int errors = (1u << SCB_CFSR_PRECISERR_SHIFT) | (1u << SCB_CFSR_IMPRECISERR_SHIFT)
+                      | (1u << SCB_CFSR_BFARVALID_SHIFT);
+  unsigned int previous;
+
+#if defined(HOST_TEST)
+  previous = Host_FaultMask;
+  Host_FaultMask = 1u;
+  SCB_CFSR &= ~errors;
+  SCB_CCR |= (1u << SCB_CCR_BFHFNMIGN_SHIFT);
+#else
+  __asm volatile ("mrs %0, faultmask" : "=r" (previous));
+  __asm volatile ("cpsid f" : : : "memory");
+  /* Older errors are not this probe's (write 1 to clear) */
+  SCB_CFSR = errors;
+  SCB_CCR |= (1u << SCB_CCR_BFHFNMIGN_SHIFT);
+  __asm volatile ("dsb\n\tisb" : : : "memory");
+#endif
+  return previous;
+}
+
+/**
+* @brief        Ends the probe started by NVIC_EnterFaultProbe()
+* @return       1 if a load since then got a bus error (its data is not valid), 0 otherwise
+*/
+static inline unsigned char NVIC_ExitFaultProbe(unsigned int previous)
+{
+  unsigned int errors = (1u << SCB_CFSR_PRECISERR_SHIFT) | (1u << SCB_CFSR_IMPRECISERR_SHIFT)
+                      | (1u << SCB_CFSR_BFARVALID_SHIFT);
+  unsigned char faulted;
 
-void NVIC_EnableInterrupt(IRQn_Type IRQ_number);
-void NVIC_DisableInterrupt(IRQn_Type IRQ_number);
-void NVIC_SetPendingFlag(IRQn_Type IRQ_number);
-void NVIC_ClearPendingFlag(IRQn_Type IRQ_number);
-unsigned char NVIC_GetPendingInterrupt(IRQn_Type IRQ_number);
-void NVIC_SetPriority(IRQn_Type IRQ_number, unsigned int priority);
+#if defined(HOST_TEST)
+  faulted = ((SCB_CFSR & errors) != 0u) ? 1u : 0u;
+  SCB_CFSR &= ~errors;
+  SCB_CCR &= ~(1u << SCB_CCR_BFHFNMIGN_SHIFT);
+  Host_FaultMask = previous;
+#else
+  __asm volatile ("dsb" : : : "memory");
+  faulted = ((SCB_CFSR & errors) != 0u) ? 1u : 0u;
+  SCB_CFSR = errors;
+  SCB_CCR &= ~(1u << SCB_CCR_BFHFNMIGN_SHIFT);
+  __asm volatile ("isb" : : : "memory");
+  __asm volatile ("msr faultmask, %0" : : "r" (previous) : "memory");
+#endif
+  return faulted;
+}
 
 #endif /* NVIC_H */
 
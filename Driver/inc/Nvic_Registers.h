@@ -61,4 +61,35 @@ typedef struct {
 /** Peripheral S32_NVIC base pointer */
 #define NVIC                                 ((NVIC_Type *)NVIC_BASE_ADDRESS)
 
+/** Number of implemented priority bits on S32K144 (priority lives in IPR[7:4]) */
+#define NVIC_PRIO_BITS                       (4U)
+
+/** SCB Application Interrupt and Reset Control Register */
+#define SCB_AIRCR                            (*((volatile unsigned int*)0xE000ED0Cu))
+#define SCB_AIRCR_VECTKEY                    (0x05FAu << 16)
+#define SCB_AIRCR_PRIGROUP_SHIFT             (8U)
+#define SCB_AIRCR_PRIGROUP_MASK              (0x7u << SCB_AIRCR_PRIGROUP_SHIFT)
+
+/** SCB Configuration and Control Register */
+#define SCB_CCR                              (*((volatile unsigned int*)0xE000ED14u))
+#define SCB_CCR_BFHFNMIGN_SHIFT              (8U)
+
+/** SCB Configurable Fault Status Register, BusFault status in [15:8] (write 1 to clear) */
+#define SCB_CFSR                             (*((volatile unsigned int*)0xE000ED28u))
+#define SCB_CFSR_PRECISERR_SHIFT             (9U)
+#define SCB_CFSR_IMPRECISERR_SHIFT           (10U)
+#define SCB_CFSR_BFARVALID_SHIFT             (15U)
+
+/** SCB System Handler Priority Register 3, SysTick priority in [31:24] */
+#define SCB_SHPR3                            (*((volatile unsigned int*)0xE000ED20u))
+#define SCB_SHPR3_SYSTICK_SHIFT              (24U)
+#define SCB_SHPR3_SYSTICK_MASK               (0xFFu << SCB_SHPR3_SYSTICK_SHIFT)
+
+/** Debug Exception and Monitor Control Register / DWT cycle counter */
+#define CoreDebug_DEMCR                      (*((volatile unsigned int*)0xE000EDFCu))
+#define CoreDebug_DEMCR_TRCENA_SHIFT         (24U)
+#define DWT_CTRL                             (*((volatile unsigned int*)0xE0001000u))
+#define DWT_CTRL_CYCCNTENA_SHIFT             (0U)
+#define DWT_CYCCNT                           (*((volatile unsigned int*)0xE0001004u))
+
 #endif
@@ -0,0 +1,39 @@
+/**
+ * @file    Pmc.h
+ * @brief   PMC low voltage warning driver.
+ * @details The warning trips above the reset threshold (LVD), leaving the time
+ *          the supply capacitance holds the MCU up to save state. Thresholds
+ *          are fixed by the device and only meaningful on a 5 V supply.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef PMC_H
+#define PMC_H
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Pmc_Register.h"
+/*==================================================================================================
+*                                    INLINE FUNCTIONS
+==================================================================================================*/
+/**
+* @brief          Clears a latched warning and enables or disables its interrupt.
+*/
+static inline void Pmc_SetLowVoltageWarning(unsigned char enable)
+{
+	PMC->LVDSC2 = (unsigned char)((1u<<PMC_LVDSC2_LVWACK_SHIFT) | ((enable != 0u) ? (1u<<PMC_LVDSC2_LVWIE_SHIFT) : 0u));
+}
+
+/**
+* @brief          Returns 1 while the warning flag is latched.
+*/
+static inline unsigned char Pmc_IsLowVoltageWarning(void)
+{
+	return (unsigned char)((PMC->LVDSC2 >> PMC_LVDSC2_LVWF_SHIFT) & 0x01u);
+}
+
+#endif
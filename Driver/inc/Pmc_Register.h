@@ -0,0 +1,46 @@
+/**
+ * @file    Pmc_Register.h
+ * @brief   Register Definitions for the Power Management Controller (PMC).
+ * @details This file contains register definitions and macros for the low
+ *          voltage detect (LVD) and low voltage warning (LVW) on the 5 V supply.
+ *          LVWF is latched: it stays set until acknowledged with LVWACK.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef PMC_REG_H
+#define PMC_REG_H
+/*==================================================================================================
+*                                MACRO DEFINE
+==================================================================================================*/
+#define PMC_LVDSC1_LVDRE_SHIFT      (4u)
+#define PMC_LVDSC1_LVDIE_SHIFT      (5u)
+#define PMC_LVDSC1_LVDACK_SHIFT     (6u)
+#define PMC_LVDSC1_LVDF_SHIFT       (7u)
+#define PMC_LVDSC2_LVWIE_SHIFT      (5u)
+#define PMC_LVDSC2_LVWACK_SHIFT     (6u)
+#define PMC_LVDSC2_LVWF_SHIFT       (7u)
+/** Peripheral PMC base address */
+#define PMC_BASE_ADDRESS                                (0x4007D000u)
+/** Peripheral PMC base pointer */
+#define PMC                                      ((PMC_Type *)PMC_BASE_ADDRESS)
+/*==================================================================================================
+*                                STRUCTURES AND ENUM
+==================================================================================================*/
+/**
+ * @struct PMC_Type
+ * @brief Structure defining the register layout of the PMC peripheral.
+ */
+typedef struct
+{
+	volatile unsigned char LVDSC1;                       /*!< Low voltage detect status and control 1 */
+	volatile unsigned char LVDSC2;                       /*!< Low voltage detect status and control 2 */
+	volatile unsigned char REGSC;                        /*!< Regulator status and control            */
+	unsigned char          RESERVED_0;
+	volatile unsigned char LPOTRIM;                      /*!< Low power oscillator trim               */
+} PMC_Type;
+
+#endif
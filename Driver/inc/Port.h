@@ -24,7 +24,7 @@
 *                                      DEFINES AND MACROS
 ==================================================================================================*/
 #define PULL_ENABLE 1U
-#define NUM_OF_PINS_PER_PORT 31
+#define NUM_OF_PINS_PER_PORT PORT_PCR_COUNT
 /*==================================================================================================
 *                                STRUCTURES AND ENUM
 ==================================================================================================*/
@@ -107,6 +107,20 @@ typedef struct
     Port_interrupt_config_t  intConfig;     /*!< 4. Interrupt generation condition.           */
 } Port_ConfigType;
 
+/**
+ * @struct Port_MultiConfigType
+ * @brief Structure to hold one configuration shared by several pins of a port.
+ */
+typedef struct
+{
+    PORT_Type         *      base;          /*!< Port base pointer.                           */
+    unsigned int             pinMask;       /*!< Bit n set = pin n takes these settings.      */
+    Port_pull_config_t       pullConfig;    /*!< 1. Internal resistor pull feature selection. */
+    Port_drive_strength_t    driveSelect;   /*!< 2. Configures the drive strength.            */
+    Port_mux_t               mux;           /*!< 3. mux selection.                            */
+    Port_interrupt_config_t  intConfig;     /*!< 4. Interrupt generation condition.           */
+} Port_MultiConfigType;
+
 /*==================================================================================================
 *                                FUNCTION PROTOTYPES
 ==================================================================================================*/
@@ -123,4 +137,16 @@ typedef struct
  */
 Port_ret_t Port_Init(const Port_ConfigType* ConfigPtr);
 
+/*!
+ * @brief Initializes a group of pins of one port with identical settings
+ *
+ * Uses the global pin/interrupt control registers (GPCLR/GPCHR, GICLR/GICHR), so
+ * any number of pins is configured with at most four register writes and no
+ * read-modify-write. Other PCR bits of the selected pins (e.g. PFE) are cleared.
+ *
+ * @param[in] ConfigPtr The group configuration structure
+ * @return PORT_OK, or PORT_ERR_PARA if a setting is out of range or pinMask is 0
+ */
+Port_ret_t Port_InitMulti(const Port_MultiConfigType* ConfigPtr);
+
 #endif 
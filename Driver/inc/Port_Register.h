@@ -24,6 +24,16 @@
 /** PORT - Size of Registers Arrays */
 #define PORT_PCR_COUNT                           32u
 
+/** PORT - PCR interrupt configuration and w1c status flag */
+#define PORT_PCR_IRQC_SHIFT                      16u
+#define PORT_PCR_IRQC_MASK                       (0xFu << PORT_PCR_IRQC_SHIFT)
+#define PORT_PCR_ISF_SHIFT                       24u
+
+/** PORT - Global Pin/Interrupt Control: [31:16] write enable per pin, [15:0] data */
+#define PORT_GPC_WE_SHIFT                        16u
+#define PORT_GPC_DATA_MASK                       0xFFFFu
+#define PORT_PINS_PER_GPC_REG                    16u
+
 /** Peripheral PORTA base address */
 #define PORTA_BASE                               (0x40049000u)
 /** Peripheral PORTA base pointer */
@@ -68,6 +78,12 @@
 
 typedef struct {
   volatile unsigned int PCR[PORT_PCR_COUNT];  /**< Pin Control Register n, array offset: 0x0, array step: 0x4 */
+  volatile unsigned int GPCLR;                /**< Global Pin Control Low Register, offset: 0x80 */
+  volatile unsigned int GPCHR;                /**< Global Pin Control High Register, offset: 0x84 */
+  volatile unsigned int GICLR;                /**< Global Interrupt Control Low Register, offset: 0x88 */
+  volatile unsigned int GICHR;                /**< Global Interrupt Control High Register, offset: 0x8C */
+  unsigned char RESERVED_0[16];
+  volatile unsigned int ISFR;                 /**< Interrupt Status Flag Register, offset: 0xA0 */
 } PORT_Type;
 
 /**
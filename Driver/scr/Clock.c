@@ -16,6 +16,96 @@
 ==================================================================================================*/
 #include "Clock.h"
 /*==================================================================================================
+*                                   LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned int Clock_DecodeAsyncDiv(unsigned int divField);
+static unsigned int Clock_GetSourceFrequency(unsigned int source);
+static unsigned int Clock_GetDiv2Frequency(unsigned int source);
+static unsigned int Clock_GetCoreFrequency(void);
+/*==================================================================================================
+*                                        LOCAL FUNCTIONS
+==================================================================================================*/
+static unsigned int Clock_DecodeAsyncDiv(unsigned int divField)
+{
+	/* 0 means the divided output is disabled, n means divide by 2^(n-1) */
+	if (divField == (unsigned int)SCG_CLOCK_DISABLE)
+	{
+		return 0U;
+	}
+	return (1U << (divField - 1U));
+}
+
+static unsigned int Clock_GetSourceFrequency(unsigned int source)
+{
+	unsigned int freq = 0U;
+	unsigned int prediv;
+	unsigned int mult;
+
+	switch (source)
+	{
+		case SOSC_CLK:
+			if ((SCG->SOSCCSR >> SCG_SOSCCSR_SOSCVLD_SHIFT) & 0x01U)
+			{
+				freq = SCG_SOSC_FREQ_HZ;
+			}
+			break;
+		case SIRC_CLK:
+			if ((SCG->SIRCCSR >> SCG_SIRCCSR_SIRCVLD_SHIFT) & 0x01U)
+			{
+				freq = ((SCG->SIRCCFG & 0x01U) == SCG_SIRCCFG_RANGE_HIGH) ? SCG_SIRC_HIGH_FREQ_HZ : SCG_SIRC_LOW_FREQ_HZ;
+			}
+			break;
+		case FIRC_CLK:
+			if ((SCG->FIRCCSR >> SCG_FIRCCSR_FIRCVLD_SHIFT) & 0x01U)
+			{
+				freq = SCG_FIRC_FREQ_HZ;
+			}
+			break;
+		case SPLL_CLK:
+			if ((SCG->SPLLCSR >> SCG_SPLLCSR_SPLLVLD_SHIFT) & 0x01U)
+			{
+				/* SPLL_CLK = (SOSC / (PREDIV + 1)) * (MULT + 16) / 2 */
+				prediv = ((SCG->SPLLCFG >> SCG_SPLLCFG_SPLLPREDIV_SHIFT) & SCG_SPLLCFG_PREDIV_MASK) + 1U;
+				mult   = ((SCG->SPLLCFG >> SCG_SPLLCFG_SPLLMULT_SHIFT) & SCG_SPLLCFG_MULT_MASK) + 16U;
+				freq   = ((SCG_SOSC_FREQ_HZ / prediv) * mult) / 2U;
+			}
+			break;
+		default:
+			/*do not thing*/
+			break;
+	}
+	return freq;
+}
+
+static unsigned int Clock_GetDiv2Frequency(unsigned int source)
+{
+	unsigned int divReg;
+	unsigned int div;
+
+	switch (source)
+	{
+		case SOSC_CLK: divReg = SCG->SOSCDIV; break;
+		case SIRC_CLK: divReg = SCG->SIRCDIV; break;
+		case FIRC_CLK: divReg = SCG->FIRCDIV; break;
+		case SPLL_CLK: divReg = SCG->SPLLDIV; break;
+		default:       return 0U;
+	}
+	div = Clock_DecodeAsyncDiv((divReg >> SCG_FIRCDIV_FIRCDIV2_SHIFT) & SCG_DIV_FIELD_MASK);
+	if (div == 0U)
+	{
+		return 0U;
+	}
+	return Clock_GetSourceFrequency(source) / div;
+}
+
+static unsigned int Clock_GetCoreFrequency(void)
+{
+	unsigned int csr = SCG->CSR;
+	unsigned int divCore = ((csr >> SCG_CSR_DIVCORE_SHIFT) & SCG_CSR_DIV_MASK) + 1U;
+
+	return Clock_GetSourceFrequency((csr >> SCG_CSR_SCS_SHIFT) & SCG_CSR_DIV_MASK) / divCore;
+}
+/*==================================================================================================
 *                                        GLOBAL FUNCTIONS
 ==================================================================================================*/   
 void Clock_SetPccConfig(const Pcc_ConfigType* ConfigPtr)
@@ -130,3 +220,39 @@ void Clock_SetScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr)
 	/* Step 2. cormfirm: System Clock Source as config */
 	while(!((SMC_PMSTAT>>0)&0x01));
 }
+
+unsigned int Clock_GetFrequency(clock_names_t clockName)
+{
+	unsigned int csr = SCG->CSR;
+	unsigned int pcc;
+
+	/* Step 1. SCG system clocks: slow and bus clocks are divided from the core clock */
+	switch (clockName)
+	{
+		case CORE_CLK:
+			return Clock_GetCoreFrequency();
+		case BUS_CLK:
+			return Clock_GetCoreFrequency() / (((csr >> SCG_CSR_DIVBUS_SHIFT) & SCG_CSR_DIV_MASK) + 1U);
+		case SLOW_CLK:
+			return Clock_GetCoreFrequency() / (((csr >> SCG_CSR_DIVSLOW_SHIFT) & SCG_CSR_DIV_MASK) + 1U);
+		default:
+			/*do not thing*/
+			break;
+	}
+
+	/* Step 2. A gated peripheral has no clock */
+	pcc = PCC->PCCn[clockName];
+	if (((pcc >> PCC_CGC_SHIFT) & 0x01U) == 0U)
+	{
+		return 0U;
+	}
+
+	/* Step 3. PORT modules have no PCS field and are clocked from the bus clock */
+	if (clockName >= PORTA_CLK && clockName <= PORTE_CLK)
+	{
+		return Clock_GetFrequency(BUS_CLK);
+	}
+
+	/* Step 4. Functional clock = DIV2 output of the source selected by PCC[PCS] */
+	return Clock_GetDiv2Frequency((pcc >> PCC_PCS_SHIFT) & PCC_PCS_MASK);
+}
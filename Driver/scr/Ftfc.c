@@ -0,0 +1,345 @@
+/**
+ * @file    Ftfc.c
+ * @brief   FTFC flash driver implementation.
+ * @details A command is launched by writing the command object and clearing
+ *          CCIF; CCIF sets again when the controller has finished. The queue
+ *          is a ring of copied requests; the head is the running command.
+ *          CCIE is only set while the queue is not empty: the interrupt is
+ *          level sensitive and CCIF stays set when the controller is idle.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftfc.h"
+#include "Nvic.h"
+/*==================================================================================================
+*                                      LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	unsigned int      address;
+	Ftfc_CallbackType callback;
+	void             *arg;
+	unsigned char     command;
+	unsigned char     data[FTFC_PHRASE_SIZE];
+} Ftfc_RequestType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+/* Last launched command, to relaunch an erase suspended by Ftfc_ProgramPhraseNow() */
+static volatile unsigned char Ftfc_Command;
+static volatile unsigned int Ftfc_Address;
+static Ftfc_RequestType Ftfc_Queue[FTFC_QUEUE_SIZE];
+static volatile unsigned int Ftfc_Head;
+static volatile unsigned int Ftfc_Count;
+static volatile unsigned char Ftfc_Running;                 /* Head launched, CCIE set */
+/* Result of the head, taken by Ftfc_ProgramPhraseNow() before its own command overwrote FSTAT */
+static volatile unsigned char Ftfc_Saved;
+static volatile Ftfc_StatusType Ftfc_SavedStatus;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned char Ftfc_IsDFlash(unsigned int address, unsigned int align);
+static void Ftfc_Start(unsigned char command, unsigned int address, const unsigned char *data);
+static Ftfc_StatusType Ftfc_Result(void);
+static Ftfc_StatusType Ftfc_Wait(void);
+static void Ftfc_Launch(void);
+static Ftfc_StatusType Ftfc_Push(unsigned char command, unsigned int address, const unsigned char *data,
+                                 Ftfc_CallbackType callback, void *arg);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+CODE_RAM static unsigned char Ftfc_IsDFlash(unsigned int address, unsigned int align)
+{
+	if ((address < FTFC_DFLASH_BASE) || (address >= (FTFC_DFLASH_BASE + FTFC_DFLASH_SIZE)))
+	{
+		return 0u;
+	}
+	return ((address & (align - 1u)) == 0u) ? 1u : 0u;
+}
+
+/* data: 8 bytes for a program, NULL for an erase */
+CODE_RAM static void Ftfc_Start(unsigned char command, unsigned int address, const unsigned char *data)
+{
+	unsigned int cmdAddress = (address - FTFC_DFLASH_BASE) | FTFC_DFLASH_CMD_ADDRESS;
+	unsigned int primask;
+	unsigned int i;
+	/* Step 1. Wait for any previous command, then lock. The brownout handler may have
+	 * relaunched an erase in between: check again with interrupts masked. */
+	for (;;)
+	{
+		while ((FTFC->FSTAT & (1u<<FTFC_FSTAT_CCIF_SHIFT)) == 0u)
+		{
+		}
+		primask = NVIC_EnterExclusive();
+		if ((FTFC->FSTAT & (1u<<FTFC_FSTAT_CCIF_SHIFT)) != 0u)
+		{
+			break;
+		}
+		NVIC_ExitExclusive(primask);
+	}
+	/* Step 2. Command object and launch in one piece */
+	/* Clear the error flags of the previous command (write 1 to clear) */
+	FTFC->FSTAT = (unsigned char)((1u<<FTFC_FSTAT_ACCERR_SHIFT) | (1u<<FTFC_FSTAT_FPVIOL_SHIFT));
+	FTFC->FCCOB[FTFC_FCCOB(0u)] = command;
+	FTFC->FCCOB[FTFC_FCCOB(1u)] = (unsigned char)(cmdAddress >> 16);
+	FTFC->FCCOB[FTFC_FCCOB(2u)] = (unsigned char)(cmdAddress >> 8);
+	FTFC->FCCOB[FTFC_FCCOB(3u)] = (unsigned char)(cmdAddress);
+	if (data != (const unsigned char *)0)
+	{
+		/* Byte 0 goes to the lowest address */
+		for (i = 0u; i < FTFC_PHRASE_SIZE; i++)
+		{
+			FTFC->FCCOB[FTFC_FCCOB(4u + i)] = data[i];
+		}
+	}
+	Ftfc_Command = command;
+	Ftfc_Address = address;
+	/* Clearing CCIF starts the command */
+	FTFC->FSTAT = (unsigned char)(1u<<FTFC_FSTAT_CCIF_SHIFT);
+	NVIC_ExitExclusive(primask);
+}
+
+/* Result of the completed command */
+CODE_RAM static Ftfc_StatusType Ftfc_Result(void)
+{
+	unsigned char status = FTFC->FSTAT;
+
+	if ((status & (1u<<FTFC_FSTAT_ACCERR_SHIFT)) != 0u)
+	{
+		return FTFC_ERROR_ACCESS;
+	}
+	else if ((status & (1u<<FTFC_FSTAT_FPVIOL_SHIFT)) != 0u)
+	{
+		return FTFC_ERROR_PROTECTION;
+	}
+	else if ((status & (1u<<FTFC_FSTAT_MGSTAT0_SHIFT)) != 0u)
+	{
+		return FTFC_ERROR_VERIFY;
+	}
+	else
+	{
+		return FTFC_OK;
+	}
+}
+
+CODE_RAM static Ftfc_StatusType Ftfc_Wait(void)
+{
+	while ((FTFC->FSTAT & (1u<<FTFC_FSTAT_CCIF_SHIFT)) == 0u)
+	{
+	}
+	return Ftfc_Result();
+}
+
+/* Launches the head of the queue. Called with PRIMASK set */
+CODE_RAM static void Ftfc_Launch(void)
+{
+	const Ftfc_RequestType *request = &Ftfc_Queue[Ftfc_Head];
+
+	Ftfc_Running = 1u;
+	Ftfc_Start(request->command, request->address,
+	           (request->command == FTFC_CMD_PROGRAM_PHRASE) ? request->data : (const unsigned char *)0);
+	FTFC->FCNFG |= (unsigned char)(1u<<FTFC_FCNFG_CCIE_SHIFT);
+}
+
+static Ftfc_StatusType Ftfc_Push(unsigned char command, unsigned int address, const unsigned char *data,
+                                 Ftfc_CallbackType callback, void *arg)
+{
+	Ftfc_RequestType *request;
+	unsigned int primask;
+	unsigned int i;
+	/* Step 1. Lock, callbacks queue commands from FTFC_IRQHandler */
+	primask = NVIC_EnterExclusive();
+	if (Ftfc_Count == FTFC_QUEUE_SIZE)
+	{
+		NVIC_ExitExclusive(primask);
+		return FTFC_ERROR_BUSY;
+	}
+	/* Step 2. Copy the request to the tail */
+	request = &Ftfc_Queue[(Ftfc_Head + Ftfc_Count) & (FTFC_QUEUE_SIZE - 1u)];
+	request->command = command;
+	request->address = address;
+	request->callback = callback;
+	request->arg = arg;
+	if (data != (const unsigned char *)0)
+	{
+		for (i = 0u; i < FTFC_PHRASE_SIZE; i++)
+		{
+			request->data[i] = data[i];
+		}
+	}
+	Ftfc_Count++;
+	/* Step 3. Controller idle: start now, otherwise the interrupt will */
+	if (Ftfc_Running == 0u)
+	{
+		Ftfc_Launch();
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	NVIC_ExitExclusive(primask);
+	return FTFC_OK;
+}
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+Ftfc_StatusType Ftfc_EraseSector(unsigned int address, Ftfc_CallbackType callback, void *arg)
+{
+	/* Step 1. Check parameter */
+	if (Ftfc_IsDFlash(address, FTFC_DFLASH_SECTOR_SIZE) == 0u)
+	{
+		return FTFC_ERROR_PARAM;
+	}
+	/* Step 2. Queue */
+	return Ftfc_Push(FTFC_CMD_ERASE_SECTOR, address, (const unsigned char *)0, callback, arg);
+}
+
+Ftfc_StatusType Ftfc_ProgramPhrase(unsigned int address, const unsigned char *data,
+                                   Ftfc_CallbackType callback, void *arg)
+{
+	/* Step 1. Check parameter */
+	if ((data == (const unsigned char *)0) || (Ftfc_IsDFlash(address, FTFC_PHRASE_SIZE) == 0u))
+	{
+		return FTFC_ERROR_PARAM;
+	}
+	/* Step 2. Queue */
+	return Ftfc_Push(FTFC_CMD_PROGRAM_PHRASE, address, data, callback, arg);
+}
+
+Ftfc_StatusType Ftfc_ReadPhrase(unsigned int address, unsigned char *data)
+{
+	const volatile unsigned int *flash = (const volatile unsigned int *)address;
+	unsigned int word[FTFC_PHRASE_SIZE / 4u];
+	unsigned int faultmask;
+	unsigned char faulted;
+	unsigned int i;
+	/* Step 1. Check parameter, and no read while the block is busy */
+	if ((data == (unsigned char *)0) || (Ftfc_IsDFlash(address, FTFC_PHRASE_SIZE) == 0u))
+	{
+		return FTFC_ERROR_PARAM;
+	}
+	if ((FTFC->FSTAT & (1u<<FTFC_FSTAT_CCIF_SHIFT)) == 0u)
+	{
+		return FTFC_ERROR_BUSY;
+	}
+	/* Step 2. Load the phrase with bus errors ignored, clear an older ECC flag first */
+	FTFC->FERSTAT = (unsigned char)(1u<<FTFC_FERSTAT_DFDIF_SHIFT);
+	faultmask = NVIC_EnterFaultProbe();
+	word[0] = flash[0];
+	word[1] = flash[1];
+	faulted = NVIC_ExitFaultProbe(faultmask);
+	/* Step 3. Either the core or the controller saw the double-bit error */
+	if ((faulted == 1u) || ((FTFC->FERSTAT & (1u<<FTFC_FERSTAT_DFDIF_SHIFT)) != 0u))
+	{
+		FTFC->FERSTAT = (unsigned char)(1u<<FTFC_FERSTAT_DFDIF_SHIFT);
+		return FTFC_ERROR_ECC;
+	}
+	for (i = 0u; i < FTFC_PHRASE_SIZE; i++)
+	{
+		data[i] = (unsigned char)(word[i / 4u] >> (8u * (i % 4u)));
+	}
+	return FTFC_OK;
+}
+
+unsigned char Ftfc_IsBusy(void)
+{
+	return (Ftfc_Count != 0u) ? 1u : 0u;
+}
+
+CODE_RAM void Ftfc_IrqHandler(void)
+{
+	Ftfc_CallbackType callback;
+	Ftfc_StatusType status;
+	unsigned int primask;
+	void *arg;
+	/* Step 1. Nothing to complete: an erase relaunched by Ftfc_ProgramPhraseNow() is running,
+	 * or the interrupt was pended by a command of Ftfc_ProgramPhraseNow() */
+	if ((FTFC->FSTAT & (1u<<FTFC_FSTAT_CCIF_SHIFT)) == 0u)
+	{
+		return;
+	}
+	primask = NVIC_EnterExclusive();
+	if (Ftfc_Running == 0u)
+	{
+		FTFC->FCNFG &= (unsigned char)~(1u<<FTFC_FCNFG_CCIE_SHIFT);
+		NVIC_ExitExclusive(primask);
+		return;
+	}
+	/* Step 2. Dequeue the head */
+	status = (Ftfc_Saved == 1u) ? Ftfc_SavedStatus : Ftfc_Result();
+	Ftfc_Saved = 0u;
+	callback = Ftfc_Queue[Ftfc_Head].callback;
+	arg = Ftfc_Queue[Ftfc_Head].arg;
+	Ftfc_Head = (Ftfc_Head + 1u) & (FTFC_QUEUE_SIZE - 1u);
+	Ftfc_Count--;
+	/* Step 3. Keep the controller busy, the callback comes after */
+	if (Ftfc_Count != 0u)
+	{
+		Ftfc_Launch();
+	}
+	else
+	{
+		Ftfc_Running = 0u;
+		FTFC->FCNFG &= (unsigned char)~(1u<<FTFC_FCNFG_CCIE_SHIFT);
+	}
+	NVIC_ExitExclusive(primask);
+	/* Step 4. Report */
+	if (callback != (Ftfc_CallbackType)0)
+	{
+		callback(status, arg);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
+
+CODE_RAM Ftfc_StatusType Ftfc_ProgramPhraseNow(unsigned int address, const unsigned char *data)
+{
+	Ftfc_StatusType status;
+	unsigned char suspended = 0u;
+	unsigned char command = Ftfc_Command;
+	unsigned int erase = Ftfc_Address;
+	/* Step 1. Check parameter */
+	if ((data == (const unsigned char *)0) || (Ftfc_IsDFlash(address, FTFC_PHRASE_SIZE) == 0u))
+	{
+		return FTFC_ERROR_PARAM;
+	}
+	/* Step 2. A sector erase takes milliseconds: suspend it. A program ends within tens of us */
+	if (((FTFC->FSTAT & (1u<<FTFC_FSTAT_CCIF_SHIFT)) == 0u) && (command == FTFC_CMD_ERASE_SECTOR))
+	{
+		FTFC->FCNFG |= (unsigned char)(1u<<FTFC_FCNFG_ERSSUSP_SHIFT);
+		suspended = 1u;
+	}
+	/* Step 3. Otherwise the queue head runs to its end (or has ended): keep its result for
+	 * FTFC_IRQHandler, the next launch clears the flags it would read */
+	if ((suspended == 0u) && (Ftfc_Running == 1u) && (Ftfc_Saved == 0u))
+	{
+		Ftfc_SavedStatus = Ftfc_Wait();
+		Ftfc_Saved = 1u;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 4. Program */
+	Ftfc_Start(FTFC_CMD_PROGRAM_PHRASE, address, data);
+	status = Ftfc_Wait();
+	/* Step 5. Relaunch the erase, its completion interrupt still belongs to the queue head.
+	 * If it had completed before the suspend took effect, the sector is just erased twice. */
+	if (suspended == 1u)
+	{
+		FTFC->FCNFG &= (unsigned char)~(1u<<FTFC_FCNFG_ERSSUSP_SHIFT);
+		Ftfc_Start(FTFC_CMD_ERASE_SECTOR, erase, (const unsigned char *)0);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	return status;
+}
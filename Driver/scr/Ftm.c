@@ -0,0 +1,61 @@
+/**
+ * @file    Ftm.c
+ * @brief   FlexTimer Module (FTM) input capture driver implementation.
+ * @details Input capture: CPWMS = 0, no channel pair combined, MSB:MSA = 00
+ *          and ELSB:ELSA selecting the edge. The counter counts up from CNTIN
+ *          = 0 to MOD = 0xFFFF and wraps.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftm.h"
+#include "Clock.h"
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+void Ftm_InitCapture(const Ftm_CaptureConfigType *ConfigPtr)
+{
+	FTM_Type *ftm = ConfigPtr->pFTMx;
+	unsigned char channel = ConfigPtr->channel;
+
+	/* Step 1. Check parameter */
+	if ((channel >= FTM_CHANNEL_COUNT) || (ConfigPtr->edge == 0u))
+	{
+		return;
+	}
+	else
+	{
+		/*do not thing */
+	}
+	/* Step 2. Stop the counter, write protection off */
+	ftm->SC = 0u;
+	ftm->MODE |= (1u<<FTM_MODE_WPDIS_SHIFT);
+	/* Step 3. Free running 16-bit up counter */
+	ftm->CNTIN = 0u;
+	ftm->MOD = FTM_COUNTER_MAX;
+	ftm->CNT = 0u;
+	ftm->COMBINE = 0u;
+	/* Step 4. Input capture on the selected edge, optional glitch filter */
+	ftm->CONTROLS[channel].CnSC = ((unsigned int)ConfigPtr->edge << FTM_CnSC_ELSA_SHIFT)
+	                            | ((ConfigPtr->isInterruptEnabled == 1u) ? (1u<<FTM_CnSC_CHIE_SHIFT) : 0u);
+	if (channel < FTM_FILTER_CHANNEL_COUNT)
+	{
+		ftm->FILTER = (ftm->FILTER & ~(FTM_FILTER_CHnFVAL_MASK << FTM_FILTER_CHnFVAL_SHIFT(channel)))
+		            | (((unsigned int)ConfigPtr->filter & FTM_FILTER_CHnFVAL_MASK) << FTM_FILTER_CHnFVAL_SHIFT(channel));
+	}
+	else
+	{
+		/*do not thing */
+	}
+	/* Step 5. Start: system clock through the prescaler */
+	ftm->SC = (FTM_SC_CLKS_SYSTEM << FTM_SC_CLKS_SHIFT) | ((unsigned int)ConfigPtr->prescaler & FTM_SC_PS_MASK);
+}
+
+unsigned int Ftm_GetFrequency(const FTM_Type *pFTMx)
+{
+	return Clock_GetFrequency(CORE_CLK) >> ((pFTMx->SC >> FTM_SC_PS_SHIFT) & FTM_SC_PS_MASK);
+}
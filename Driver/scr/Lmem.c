@@ -0,0 +1,129 @@
+/**
+ * @file    Lmem.c
+ * @brief   LMEM code cache driver implementation.
+ * @details Cache wide commands (PCCCR) and line commands (PCCLCR/PCCSAR) both
+ *          start with a go bit that the hardware clears when the command is done.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lmem.h"
+#include "Lmem_Register.h"
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned int Lmem_RegionMode(unsigned int modes, unsigned char region, Lmem_ModeType mode);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+static unsigned int Lmem_RegionMode(unsigned int modes, unsigned char region, Lmem_ModeType mode)
+{
+	modes &= ~(LMEM_PCCRMR_MODE_MASK << LMEM_PCCRMR_SHIFT(region));
+	modes |= (((unsigned int)mode & LMEM_PCCRMR_MODE_MASK) << LMEM_PCCRMR_SHIFT(region));
+	return modes;
+}
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+void Lmem_Init(void)
+{
+#if (LMEM_CACHE_ENABLE == 1)
+	unsigned int modes;
+	/* Step 1. Region modes may only change with the cache off */
+	Lmem_Disable();
+	/* Step 2. Cache program flash only */
+	modes = LMEM->PCCRMR;
+	modes = Lmem_RegionMode(modes, LMEM_REGION_PFLASH, LMEM_MODE_WRITE_THROUGH);
+	modes = Lmem_RegionMode(modes, LMEM_REGION_FLEXNVM, LMEM_MODE_NON_CACHEABLE);
+	modes = Lmem_RegionMode(modes, LMEM_REGION_SRAM_L, LMEM_MODE_NON_CACHEABLE);
+	LMEM->PCCRMR = modes;
+	/* Step 3. Drop whatever the ways hold since reset and turn on */
+	Lmem_Enable();
+#endif
+}
+
+void Lmem_Enable(void)
+{
+	Lmem_InvalidateAll();
+	LMEM->PCCCR |= (1u<<LMEM_PCCCR_ENCACHE_SHIFT);
+	/* Following fetches go through the cache */
+	__asm volatile ("isb" : : : "memory");
+}
+
+void Lmem_Disable(void)
+{
+	LMEM->PCCCR &= ~(1u<<LMEM_PCCCR_ENCACHE_SHIFT);
+	__asm volatile ("isb" : : : "memory");
+}
+
+unsigned char Lmem_IsEnabled(void)
+{
+	return (unsigned char)((LMEM->PCCCR >> LMEM_PCCCR_ENCACHE_SHIFT) & 0x01u);
+}
+
+void Lmem_InvalidateAll(void)
+{
+	/* Step 1. Invalidate both ways, keep ENCACHE as it is */
+	LMEM->PCCCR |= (1u<<LMEM_PCCCR_INVW0_SHIFT) | (1u<<LMEM_PCCCR_INVW1_SHIFT) | (1u<<LMEM_PCCCR_GO_SHIFT);
+	/* Step 2. Wait for the command to complete */
+	while ((LMEM->PCCCR & (1u<<LMEM_PCCCR_GO_SHIFT)) != 0u)
+	{
+	}
+	LMEM->PCCCR &= ~((1u<<LMEM_PCCCR_INVW0_SHIFT) | (1u<<LMEM_PCCCR_INVW1_SHIFT));
+}
+
+void Lmem_InvalidateRange(unsigned int address, unsigned int size)
+{
+	unsigned int line;
+	unsigned int end;
+	/* Step 1. Check parameter */
+	if (size == 0u)
+	{
+		return;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 2. Invalidate command, addressed by physical address */
+	LMEM->PCCLCR = (LMEM_PCCLCR_LCMD_INVALIDATE<<LMEM_PCCLCR_LCMD_SHIFT) | (1u<<LMEM_PCCLCR_LADSEL_SHIFT);
+	/* Step 3. One command per line */
+	end = address + size;
+	for (line = address & ~(LMEM_LINE_SIZE - 1u); line < end; line += LMEM_LINE_SIZE)
+	{
+		LMEM->PCCSAR = line | (1u<<LMEM_PCCSAR_LGO_SHIFT);
+		while ((LMEM->PCCSAR & (1u<<LMEM_PCCSAR_LGO_SHIFT)) != 0u)
+		{
+		}
+	}
+}
+
+void Lmem_SetRegionMode(unsigned char region, Lmem_ModeType mode)
+{
+	unsigned char enabled;
+	/* Step 1. Check parameter */
+	if (region >= LMEM_REGION_COUNT)
+	{
+		return;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 2. Change the mode with the cache off, lines cached under the old mode are dropped */
+	enabled = Lmem_IsEnabled();
+	Lmem_Disable();
+	LMEM->PCCRMR = Lmem_RegionMode(LMEM->PCCRMR, region, mode);
+	if (enabled == 1u)
+	{
+		Lmem_Enable();
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
@@ -16,6 +16,7 @@
 *                                        INCLUDE FILES
 ==================================================================================================*/
 #include "Lpit.h"
+#include "Clock.h"
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
@@ -30,6 +31,7 @@ void Lpit_Init( void )
 }
 void Lpit_InitChannel(unsigned char channel, const Lpit_ChannelConfigType* ConfigPtr)
 {
+	unsigned long long ticks;
 	/* Step 1. Check parameter */
 	if (channel > LPIT_CHANNEL_3 || channel < LPIT_CHANNEL_0)
 	{
@@ -43,7 +45,16 @@ void Lpit_InitChannel(unsigned char channel, const Lpit_ChannelConfigType* Confi
 	LPIT0->TMR[channel].TCTRL &=~ (3u<<LPIT_TMR_TCTRL_MODE_SHIFT);
 	
 	/* Step 3. Set Timer Value Register */
-	if(ConfigPtr->period != 0 )
+	if(ConfigPtr->periodUs != 0 )
+	{
+		ticks = ((unsigned long long)Clock_GetFrequency(LPIT0_CLK) * ConfigPtr->periodUs) / 1000000U;
+		if (ticks == 0U || ticks > ((unsigned long long)MAX_TAVL_VALUE + 1U))
+		{
+			return;
+		}
+		LPIT0->TMR[channel].TVAL = (unsigned int)(ticks - 1U);
+	}
+	else if(ConfigPtr->period != 0 )
 	{
 		LPIT0->TMR[channel].TVAL = ConfigPtr->period;
 	} 
@@ -51,7 +62,20 @@ void Lpit_InitChannel(unsigned char channel, const Lpit_ChannelConfigType* Confi
 	{
 		LPIT0->TMR[channel].TVAL = MAX_TAVL_VALUE;
 	}
-	/* Step 4. Check whether timeout interrupt is set ?*/
+	/* Step 4. Chain to the previous channel */
+	if (ConfigPtr->isChained == 1)
+	{
+		if (channel == LPIT_CHANNEL_0)
+		{
+			return;
+		}
+		LPIT0->TMR[channel].TCTRL |= (1u<<LPIT_TMR_TCTRL_CHAIN_SHIFT);
+	}
+	else
+	{
+		LPIT0->TMR[channel].TCTRL &= ~(1u<<LPIT_TMR_TCTRL_CHAIN_SHIFT);
+	}
+	/* Step 5. Check whether timeout interrupt is set ?*/
 	if(ConfigPtr->isInterruptEnabled == 1)
 	{
 		LPIT0->MIER |=(1u<<channel);
@@ -74,6 +98,20 @@ void Lpit_StartChannel(unsigned char channel)
 	
 }
 
+void Lpit_SetPeriod(unsigned char channel, unsigned int value)
+{
+	/* Step 1. Check parameter */
+	if (channel > LPIT_CHANNEL_3 || channel < LPIT_CHANNEL_0)
+	{
+		return;
+	}
+	else 
+	{
+		/*do not thing */
+	}
+	/* Step 2. Loaded into the counter on the next timeout */
+	LPIT0->TMR[channel].TVAL = value;
+}
 
 void Lpit_StopChannel(unsigned char channel)
 {
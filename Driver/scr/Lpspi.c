@@ -12,6 +12,70 @@
 *                                        INCLUDE FILES
 ==================================================================================================*/
 #include "Lpspi.h" 
+#include "Clock.h"
+/*==================================================================================================
+*                                   LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned int Lpspi_GetClockFrequency(const Lpspi_ConfigType* ConfigPtr);
+static void Lpspi_CalculateSck(unsigned int freq, unsigned int speed, unsigned int *pSckDiv, spi_prescaler_t *pPrescaler);
+static unsigned int Lpspi_WaitTxFree(LPSPI_Type *pLpspi);
+/*==================================================================================================
+*                                        LOCAL FUNCTIONS
+==================================================================================================*/
+static unsigned int Lpspi_GetClockFrequency(const Lpspi_ConfigType* ConfigPtr)
+{
+	if (ConfigPtr->Init.F_lpspi != 0U)
+	{
+		return ConfigPtr->Init.F_lpspi;
+	}
+	else if (ConfigPtr->pSPIx == LPSPI0)
+	{
+		return Clock_GetFrequency(LPSPI0_CLK);
+	}
+	else if (ConfigPtr->pSPIx == LPSPI1)
+	{
+		return Clock_GetFrequency(LPSPI1_CLK);
+	}
+	else
+	{
+		return Clock_GetFrequency(LPSPI2_CLK);
+	}
+}
+
+static void Lpspi_CalculateSck(unsigned int freq, unsigned int speed, unsigned int *pSckDiv, spi_prescaler_t *pPrescaler)
+{
+	unsigned int prescaler;
+	unsigned int total;
+
+	for (prescaler = (unsigned int)LPSPI_PRE_DIV_BY_1; prescaler <= (unsigned int)LPSPI_PRE_DIV_BY_128; prescaler++)
+	{
+		/* Round the divider up so SCK never exceeds the requested speed */
+		total = ((freq >> prescaler) + speed - 1U) / speed;
+		if (total < 2U)
+		{
+			total = 2U;
+		}
+		if ((total - 2U) <= LPSPI_CCR_SCKDIV_MAX)
+		{
+			*pSckDiv = total - 2U;
+			*pPrescaler = (spi_prescaler_t)prescaler;
+			return;
+		}
+	}
+	/* Slowest possible SCK */
+	*pSckDiv = LPSPI_CCR_SCKDIV_MAX;
+	*pPrescaler = LPSPI_PRE_DIV_BY_128;
+}
+/* Polls until the TX FIFO has room, returns the number of free entries */
+CODE_RAM static unsigned int Lpspi_WaitTxFree(LPSPI_Type *pLpspi)
+{
+	unsigned int count;
+	do
+	{
+		count = pLpspi->FSR & LPSPI_FSR_TXCOUNT_MASK;
+	} while (count >= LPSPI_TX_FIFO_SIZE);
+	return LPSPI_TX_FIFO_SIZE - count;
+}
 /*==================================================================================================
 *                                        GLOBAL FUNCTIONS
 ==================================================================================================*/ 
@@ -19,6 +83,8 @@ void Lpspi_Init (const Lpspi_ConfigType* ConfigPtr )
 {
 	unsigned int SCK_diver = 0;
 	unsigned int TCR_value = 0;
+	unsigned int freq;
+	spi_prescaler_t prescaler;
 	/* Step 1. Check parameter */
 	if ( (ConfigPtr->pSPIx == (void*)0) 
 	|| ConfigPtr->Init.spi_prescaler > LPSPI_PRE_DIV_BY_128 
@@ -32,7 +98,19 @@ void Lpspi_Init (const Lpspi_ConfigType* ConfigPtr )
     }
 	/* Step 2. Set divide ratio of the SCK pin*/
 	SCK_diver = ConfigPtr->Init.spi_sck_div;
-	ConfigPtr->pSPIx->CCR |= (SCK_diver);
+	prescaler = ConfigPtr->Init.spi_prescaler;
+	if (ConfigPtr->Init.spi_speed != 0U)
+	{
+		freq = Lpspi_GetClockFrequency(ConfigPtr);
+		if (freq == 0U)
+		{
+			return;  // LPSPI functional clock is not running
+		}
+		Lpspi_CalculateSck(freq, ConfigPtr->Init.spi_speed, &SCK_diver, &prescaler);
+	}
+	ConfigPtr->pSPIx->CCR &= ~((LPSPI_CCR_SCKDIV_MAX << LPSPI_CCR_SCKDIV_SHIFT) | (LPSPI_CCR_DBT_MAX << LPSPI_CCR_DBT_SHIFT));
+	ConfigPtr->pSPIx->CCR |= (SCK_diver << LPSPI_CCR_SCKDIV_SHIFT)
+	                       | ((unsigned int)ConfigPtr->Init.spi_dbt << LPSPI_CCR_DBT_SHIFT);
 	/* Step 3. 	Configures Clock Phase and Polarity    */
 	/* Step 4.  Set Prescaler Value                    */
 	/* Step 5.  Configures Clock Phase and Polarity    */
@@ -40,7 +118,7 @@ void Lpspi_Init (const Lpspi_ConfigType* ConfigPtr )
 	/* Step 7.  Configures the peripheral chip select  */
 	TCR_value =  ((unsigned int)(ConfigPtr->Init.spi_cpha) << LPSPI_TCR_CPHA_SHIFT)
 				|((unsigned int)(ConfigPtr->Init.spi_cpol) << LPSPI_TCR_CPOL_SHIFT)
-				|((unsigned int)(ConfigPtr->Init.spi_prescaler) << LPSPI_TCR_PRESCALE_SHIFT)
+				|((unsigned int)(prescaler) << LPSPI_TCR_PRESCALE_SHIFT)
 				|((unsigned int)(ConfigPtr->Init.spi_frame) << LPSPI_TCR_FRAMESZ_SHIFT)
 				|((unsigned int)(ConfigPtr->Init.spi_type_transfer) << LPSPI_TCR_LSBF_SHIFT)
 				|((unsigned int)(ConfigPtr->Init.spi_pcs) << LPSPI_TCR_PCS_SHIFT);
@@ -63,18 +141,59 @@ void Lpspi_Init (const Lpspi_ConfigType* ConfigPtr )
 	
 }
 
-void Lpspi_Transmit(LPSPI_Type *pLpspi, unsigned short *pTxBuffer, unsigned short Size)
+CODE_RAM void Lpspi_Transmit(LPSPI_Type *pLpspi, unsigned short *pTxBuffer, unsigned short Size)
+{
+	Lpspi_TransmitBurst(pLpspi, pTxBuffer, Size);
+}
+
+CODE_RAM void Lpspi_TransmitBurst(LPSPI_Type *pLpspi, const unsigned short *pTxBuffer, unsigned short Size)
 {
+	unsigned int free = 0U;
 	while(Size > 0)
 	{
-		/* Wait until the Transmit Data Flag (TDF) is set */
-		while((((pLpspi->SR)>>0)&0x01)==0);
+		/* Poll the FIFO only when the entries known to be free are used up */
+		if (free == 0U)
+		{
+			free = Lpspi_WaitTxFree(pLpspi);
+		}
 		/* Write data to Transmit Data Register (TDR) */
 		pLpspi->TDR = *pTxBuffer;
-		/* Increment the buffer address */
 		pTxBuffer+=1;
-		/* Decrease the size count */
 		Size -= 1;
+		free -= 1U;
+	}
+}
+
+CODE_RAM void Lpspi_TransmitContinuous(LPSPI_Type *pLpspi, const unsigned short *pTxBuffer, unsigned short Size)
+{
+	unsigned int TCR_value;
+	unsigned int free;
+	/* Step 1. Base command without continuous bits, TCR writes go through the TX FIFO */
+	TCR_value = pLpspi->TCR & ~((1U << LPSPI_TCR_CONT_SHIFT) | (1U << LPSPI_TCR_CONTC_SHIFT));
+	free = Lpspi_WaitTxFree(pLpspi);
+	pLpspi->TCR = TCR_value | (1U << LPSPI_TCR_CONT_SHIFT);
+	free -= 1U;
+	/* Step 2. Data frames, PCS stays asserted between them */
+	while(Size > 0)
+	{
+		if (free == 0U)
+		{
+			free = Lpspi_WaitTxFree(pLpspi);
+		}
+		pLpspi->TDR = *pTxBuffer;
+		pTxBuffer+=1;
+		Size -= 1;
+		free -= 1U;
+	}
+	/* Step 3. Clearing CONT ends the transfer and negates PCS */
+	if (free == 0U)
+	{
+		free = Lpspi_WaitTxFree(pLpspi);
 	}
+	pLpspi->TCR = TCR_value;
 }
 
+void Lpspi_WaitIdle(LPSPI_Type *pLpspi)
+{
+	while(((pLpspi->FSR & LPSPI_FSR_TXCOUNT_MASK) != 0U) || (((pLpspi->SR)>>LPSPI_SR_MBF_SHIFT)&0x01));
+}
@@ -3,6 +3,9 @@
  * @brief   LPUART driver implementation for initialization, transmit, and receive functions.
  * @details This file provides functions to initialize the LPUART peripheral, 
  *          transmit data, and receive data using the provided configuration structure.
+ *          The TX queue is a ring of bytes, head moved by the writers under the
+ *          lock, tail by the TDRE interrupt. TIE is only set while bytes are
+ *          queued: TDRE stays set when the transmitter is idle.
  *
  * @note    The user needs to ensure the configuration structure is set up correctly before calling the initialization function.
  *
@@ -14,16 +17,91 @@
 *                                        INCLUDE FILES
 ==================================================================================================*/
 #include "Lpuart.h"
+#include "Clock.h"
+#include "Nvic.h"
+/*==================================================================================================
+*                                        LOCAL VARIABLES
+==================================================================================================*/
+/* TX queue of the instance initialized with lpuart_enable_int_TX */
+static LPUART_Type *Lpuart_TxPort;
+static IRQn_Type Lpuart_TxIrq;
+static unsigned char Lpuart_TxQueue[LPUART_TX_QUEUE_SIZE];
+static volatile unsigned int Lpuart_TxHead;        /* Next byte to queue */
+static volatile unsigned int Lpuart_TxTail;        /* Next byte to send  */
+/*==================================================================================================
+*                                   LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned int Lpuart_CalculateSbr(const Lpuart_ConfigType* ConfigPtr);
+static unsigned int Lpuart_TxLock(void);
+static void Lpuart_TxSend(void);
+/*==================================================================================================
+*                                        LOCAL FUNCTIONS
+==================================================================================================*/
+static unsigned int Lpuart_CalculateSbr(const Lpuart_ConfigType* ConfigPtr)
+{
+	unsigned int freq;
+	unsigned int divisor;
+
+	/* Step 1. No target baud rate: keep the raw divisor from the configuration */
+	if (ConfigPtr->Init.lpuart_baudrate == 0U)
+	{
+		return ConfigPtr->Init.lpuart_baudrate_modulo_divisor;
+	}
+
+	/* Step 2. Functional clock of this instance */
+	if (ConfigPtr->pUARTx == LPUART0)
+	{
+		freq = Clock_GetFrequency(LPUART0_CLK);
+	}
+	else if (ConfigPtr->pUARTx == LPUART1)
+	{
+		freq = Clock_GetFrequency(LPUART1_CLK);
+	}
+	else
+	{
+		freq = Clock_GetFrequency(LPUART2_CLK);
+	}
+
+	/* Step 3. baud = f / ((OSR + 1) * SBR), rounded to the nearest SBR */
+	divisor = ((unsigned int)ConfigPtr->Init.lpuart_oversampling + 1U) * ConfigPtr->Init.lpuart_baudrate;
+	return (freq + (divisor / 2U)) / divisor;
+}
+
+/* Masks the interrupt that takes bytes from the queue, returns the mask to restore */
+static unsigned int Lpuart_TxLock(void)
+{
+	return NVIC_EnterCritical(NVIC_GetPriority(Lpuart_TxIrq));
+}
+
+/* Moves one queued byte to DATA if it is empty, clears TIE when nothing is left.
+ * Called with the lock held or from the instance's interrupt. */
+static void Lpuart_TxSend(void)
+{
+	if (Lpuart_TxTail == Lpuart_TxHead)
+	{
+		Lpuart_TxPort->CTRL &= ~(1U << LPUART_CTRL_TIE_SHIFT);
+	}
+	else if (((Lpuart_TxPort->STAT >> LPUART_STAT_TDRE_SHIFT) & 0x01U) != 0U)
+	{
+		Lpuart_TxPort->DATA = Lpuart_TxQueue[Lpuart_TxTail & (LPUART_TX_QUEUE_SIZE - 1U)];
+		Lpuart_TxTail++;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
 /*==================================================================================================
 *                                        GLOBAL FUNCTIONS
 ==================================================================================================*/     
 void Lpuart_Init (const Lpuart_ConfigType* ConfigPtr)
 {
 	unsigned int BAUD_Reg_Value=0;
+	unsigned int sbr;
 
 	/*1. Check parameter */
 	if (ConfigPtr == ((void*)0)
-	|| ConfigPtr->Init.lpuart_baudrate_modulo_divisor == 0
+	|| (ConfigPtr->Init.lpuart_baudrate_modulo_divisor == 0 && ConfigPtr->Init.lpuart_baudrate == 0)
 	|| ConfigPtr->Init.lpuart_oversampling < oversampling_ratio_4 
 	|| ConfigPtr->Init.lpuart_oversampling > oversampling_ratio_17
 	|| (ConfigPtr->Init.lpuart_stop_bit != ONE_STOP_BIT && ConfigPtr->Init.lpuart_stop_bit != TWO_STOP_BIT)
@@ -57,7 +135,16 @@ void Lpuart_Init (const Lpuart_ConfigType* ConfigPtr)
 		/*do not thing*/
 	}
 	/*2. Setting baud rate */
-	BAUD_Reg_Value |= (((unsigned int)(ConfigPtr->Init.lpuart_baudrate_modulo_divisor)<<LPUART_BAUD_SBR_SHIFT))
+	sbr = Lpuart_CalculateSbr(ConfigPtr);
+	if (sbr == 0U || sbr > LPUART_BAUD_SBR_MAX)
+	{
+		return;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	BAUD_Reg_Value |= ((sbr<<LPUART_BAUD_SBR_SHIFT))
 					|((unsigned int)(ConfigPtr->Init.lpuart_oversampling)<<LPUART_BAUD_OSR_SHIFT);
 	ConfigPtr->pUARTx->BAUD = BAUD_Reg_Value;
 
@@ -91,6 +178,29 @@ void Lpuart_Init (const Lpuart_ConfigType* ConfigPtr)
 	{
 		/*do not thing*/
 	}
+	/*TX queue: TIE is set by Lpuart_Write() while bytes are queued*/
+	if ((ConfigPtr->Init.lpuart_enable_int_TX) > 0)
+	{
+		Lpuart_TxPort = ConfigPtr->pUARTx;
+		if (ConfigPtr->pUARTx == LPUART0)
+		{
+			Lpuart_TxIrq = LPUART0_RxTx_IRQ;
+		}
+		else if (ConfigPtr->pUARTx == LPUART1)
+		{
+			Lpuart_TxIrq = LPUART1_RxTx_IRQn;
+		}
+		else
+		{
+			Lpuart_TxIrq = LPUART2_RxTx_IRQ;
+		}
+		Lpuart_TxHead = 0U;
+		Lpuart_TxTail = 0U;
+	}
+	else 
+	{
+		/*do not thing*/
+	}
 	/*Enable transmitter, receiver Transmitter Enable: CTRL[TE] & Receiver Enable: CTRL[RE]*/
 	ConfigPtr ->pUARTx ->CTRL |= (1U<< LPUART_CTRL_TE_SHIFT) | (1U<< LPUART_CTRL_RE_SHIFT);
 }
@@ -107,7 +217,94 @@ void Lpuart_Transmit(LPUART_Type *pUartx, unsigned char *pTxBuffer, unsigned cha
 	}
 }
 
+void Lpuart_Write(LPUART_Type *pUartx, const unsigned char *pTxBuffer, unsigned char size)
+{
+	unsigned int critical;
+	unsigned int room;
+	unsigned int i;
+
+	/* Step 1. No queue on this instance */
+	if (pUartx != Lpuart_TxPort)
+	{
+		Lpuart_Transmit(pUartx, (unsigned char *)pTxBuffer, size);
+		return;
+	}
+	while (size > 0U)
+	{
+		/* Step 2. Full: wait for DATA outside the lock, Step 3 then sends a byte if the
+		 * TX interrupt could not (the caller is the instance's own handler) */
+		while (((Lpuart_TxHead - Lpuart_TxTail) >= LPUART_TX_QUEUE_SIZE)
+		    && (((pUartx->STAT >> LPUART_STAT_TDRE_SHIFT) & 0x01U) == 0U))
+		{
+		}
+		/* Step 3. Copy what fits, start at once if DATA is empty, the interrupt sends the rest */
+		critical = Lpuart_TxLock();
+		room = LPUART_TX_QUEUE_SIZE - (Lpuart_TxHead - Lpuart_TxTail);
+		for (i = 0U; (i < room) && (i < size); i++)
+		{
+			Lpuart_TxQueue[(Lpuart_TxHead + i) & (LPUART_TX_QUEUE_SIZE - 1U)] = pTxBuffer[i];
+		}
+		Lpuart_TxHead += i;
+		Lpuart_TxSend();
+		pUartx->CTRL |= (1U << LPUART_CTRL_TIE_SHIFT);
+		NVIC_ExitCritical(critical);
+		pTxBuffer += i;
+		size = (unsigned char)(size - i);
+	}
+}
+
+unsigned int Lpuart_GetTxSpace(LPUART_Type *pUartx)
+{
+	if (pUartx != Lpuart_TxPort) return 0U;
+	return LPUART_TX_QUEUE_SIZE - (Lpuart_TxHead - Lpuart_TxTail);
+}
+
+void Lpuart_Flush(LPUART_Type *pUartx)
+{
+	unsigned int critical;
+
+	/* Step 1. Queued bytes, sent here too when called from the instance's handler */
+	while ((pUartx == Lpuart_TxPort) && (Lpuart_TxTail != Lpuart_TxHead))
+	{
+		while (((pUartx->STAT >> LPUART_STAT_TDRE_SHIFT) & 0x01U) == 0U)
+		{
+		}
+		critical = Lpuart_TxLock();
+		Lpuart_TxSend();
+		NVIC_ExitCritical(critical);
+	}
+	/* Step 2. Last byte out of the shift register */
+	while (((pUartx->STAT >> LPUART_STAT_TC_SHIFT) & 0x01U) == 0U)
+	{
+	}
+}
+
+void Lpuart_TxIrqHandler(LPUART_Type *pUartx)
+{
+	if ((pUartx == Lpuart_TxPort) && (((pUartx->CTRL >> LPUART_CTRL_TIE_SHIFT) & 0x01U) != 0U))
+	{
+		Lpuart_TxSend();
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
+
 void Lpuart_Receive(LPUART_Type *pUartx, unsigned char *pRxBuffer)
 {
 	*(pRxBuffer) = (unsigned char) pUartx->DATA;
 }
+
+unsigned char Lpuart_ClearOverrun(LPUART_Type *pUartx)
+{
+	unsigned int stat = pUartx->STAT;
+
+	if (((stat >> LPUART_STAT_OR_SHIFT) & 0x01U) == 0U)
+	{
+		return 0U;
+	}
+	/* Write 1 to OR alone: the other flags stay, the control bits are written back as read */
+	pUartx->STAT = (stat & ~LPUART_STAT_W1C_MASK) | (1U << LPUART_STAT_OR_SHIFT);
+	return 1U;
+}
@@ -2,7 +2,8 @@
 *   @file    	Nvic.c
 *   @brief   	This file contains the implementation of NVIC-related functions. 
 *   @details 	This file provides functions for configuring and controlling the Nested Vectored Interrupt Controller (NVIC) 
-*               on ARM Cortex-M microcontrollers. Functions include enabling/disabling interrupts, setting priorities, and more.
+*               on ARM Cortex-M microcontrollers. The register accessors and critical sections are inline in Nvic.h;
+*               this file holds the critical section statistics and their DWT setup.
 
 *   @authors 	Mai Anh Tuan
 *   @date 		10/09/2024
@@ -17,153 +18,51 @@
 #include "Nvic.h"
 
 /*==================================================================================================
-*                                      LOCAL VARIABLES
+*                                      GLOBAL VARIABLES
 ==================================================================================================*/
-
-static unsigned char offset;
-static unsigned int shiftAmount;
-static unsigned int mask;
+#if (NVIC_CRITICAL_STATS == 1)
+volatile Nvic_CriticalStatsType Nvic_CriticalStats;
+volatile unsigned int Nvic_CriticalStart;
+#endif
 
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
 
 /**
-* @brief        Enable Interrupt of IRQn pin
-* @details      This function enable the interrupt in the NVIC corresponding to the given IRQ_number parameter
-*				To advoid malfunction, the IRQ number must be matched with NVIC Interrupt ID in DMA_Interrupt_Mapping_Table
-*
-* @param[in]    IRQn_Type 
-*                             
-* @return       void
-*
-* @pre          The IRQ_number must be valid and within the range supported by the NVIC 
-* @post         The interrupt corresponding to IRQ_number will be enabled.
-*
-* @api			This function is apart of API to control NVIC
-*
-*/
-void NVIC_EnableInterrupt(IRQn_Type IRQ_number)
-{
-	NVIC->ISER[IRQ_number/32]= ((1<< (IRQ_number%32)));
-}
-
-/**
-* @brief        Disnable Interrupt of IRQn pin
-* @details      This function disable the interrupt in the NVIC corresponding to the given IRQ_number parameter
-*				To advoid malfunction, the IRQ number must be matched with NVIC Interrupt ID in DMA_Interrupt_Mapping_Table
+* @brief        Starts the DWT cycle counter used to time critical sections
+* @details      Enables trace (DEMCR[TRCENA]) and DWT_CTRL[CYCCNTENA]. Harmless when a
+*               debugger has already enabled them.
 *
-* @param[in]    IRQn_Type 
-*                             
 * @return       void
 *
-* @pre          The IRQ_number must be valid and within the range supported by the NVIC 
-* @post         The interrupt corresponding to IRQ_number will be disabled.
-*
-* @api			This function is apart of API to control NVIC
-*
-*/
-void NVIC_DisableInterrupt(IRQn_Type IRQ_number)
-{
-	NVIC->ICER[IRQ_number/32]= ((1<< (IRQ_number%32)));
-}
-
-/**
-* @brief        Set pendding flag of IRQn pin
-* @details      This function sets the pending flag of the interrupt in the NVIC corresponding to the given IRQ_number parameter
-*				To advoid malfunction, the IRQ number must be matched with NVIC Interrupt ID in DMA_Interrupt_Mapping_Table
-*
-* @param[in]    IRQn_Type 
-*                             
-* @return       void
-*
-* @pre          The IRQ_number must be valid and within the range supported by the NVIC 
-* @post         The pending flag of the interrupt corresponding to IRQ_number will be enabled.
-*
 * @api			This function is apart of API to control NVIC
-*
 */
-void NVIC_SetPendingFlag(IRQn_Type IRQ_number)
+void NVIC_CriticalStatsInit(void)
 {
-	NVIC->ISPR[IRQ_number/32]= ((1<< (IRQ_number%32)));
+	CoreDebug_DEMCR |= (1u << CoreDebug_DEMCR_TRCENA_SHIFT);
+	DWT_CYCCNT = 0u;
+	DWT_CTRL |= (1u << DWT_CTRL_CYCCNTENA_SHIFT);
+	NVIC_CriticalStatsReset();
 }
 
 /**
-* @brief        Clear the pendding flag of IRQn pin
-* @details      This function clears the pending flag of the interrupt in the NVIC corresponding to the given IRQ_number parameter
-*				To advoid malfunction, the IRQ number must be matched with NVIC Interrupt ID in DMA_Interrupt_Mapping_Table
+* @brief        Resets the critical section statistics
 *
-* @param[in]    IRQn_Type 
-*                             
 * @return       void
 *
-* @pre          The IRQ_number must be valid and within the range supported by the NVIC 
-* @post         The pending flag of the interrupt corresponding to IRQ_number will be cleared.
-*
-* @api			This function is apart of API to control NVIC
-*
-*/
-void NVIC_ClearPendingFlag(IRQn_Type IRQ_number)
-{
-	NVIC->ICPR[IRQ_number/32]= ((1<< (IRQ_number%32)));
-}
-
-/**
-* @brief        Read the state of the pendding flag of IRQn pin
-* @details      This function reads the state of the pending flag of the interrupt in the NVIC corresponding to the given IRQ_number parameter
-*				To advoid malfunction, the IRQ number must be matched with NVIC Interrupt ID in DMA_Interrupt_Mapping_Table
-*
-* @param[in]    IRQn_Type 
-*                             
-* @return       unsigned char
-*
-* @pre          The IRQ_number must be valid and within the range supported by the NVIC 
-* @post         The state of the pending flag of the interrupt corresponding to IRQ_number will be read.
-*
 * @api			This function is apart of API to control NVIC
-*
 */
-unsigned char NVIC_GetPendingInterrupt(IRQn_Type IRQ_number)
+void NVIC_CriticalStatsReset(void)
 {
-	if ((NVIC_IABR(IRQ_number)>>IRQ_number)&0x01)
-	{
-		return ACTIVE;
-	}
-	else
-	{
-		return NOT_ACTIVE;
-	}
-}
-
-/**
-* @brief        Set priority for  IRQn pin
-* @details      This function set priority of the interrupt in the NVIC corresponding to the given IRQ_number parameter
-*				To advoid malfunction, the IRQ number must be matched with NVIC Interrupt ID in DMA_Interrupt_Mapping_Table
-*				and the priority value must be below 15.
-*
-* @param[in]    IRQn_Type 
-*                             
-* @return       void
-*
-* @pre          The IRQ_number must be valid and within the range supported by the NVIC 
-* @post         The preemption of the interrupt corresponding to IRQ_number will be set.
-*
-* @api			This function is apart of API to control NVIC
-*/
+#if (NVIC_CRITICAL_STATS == 1)
+	unsigned int previous = NVIC_GetBasePri();
 
-void NVIC_SetPriority(IRQn_Type IRQ_number, unsigned int priority)
-{
-	/*Check valid of priority value*/
-  	if (priority > 15) 
-	{
-     return;
-  	}
-	offset = IRQ_number%4;
-	shiftAmount = offset*8;
-	/*Clear previous priority value of IRQn*/
-	mask = (unsigned int)(0xFF << shiftAmount);
-	NVIC->IPR[IRQ_number / 4] &= ~mask;
-	/*Set new priority value for IRQn*/
-	NVIC->IPR[IRQ_number / 4] |= (priority<<(shiftAmount+4));
+	/* Mask like a critical section but without timing this one */
+	__asm volatile ("msr basepri_max, %0" : : "r" (1u << (8u - NVIC_PRIO_BITS)) : "memory");
+	Nvic_CriticalStats.totalCycles = 0u;
+	Nvic_CriticalStats.maxCycles = 0u;
+	Nvic_CriticalStats.count = 0u;
+	__asm volatile ("msr basepri, %0" : : "r" (previous) : "memory");
+#endif
 }
-
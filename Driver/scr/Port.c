@@ -34,8 +34,8 @@
  */
 Port_ret_t Port_Init(const Port_ConfigType* ConfigPtr)
 {
-		static Port_ret_t ret = PORT_OK;
-		static unsigned int regValue;
+		Port_ret_t ret = PORT_OK;
+		unsigned int regValue;
     /* Check if pinPortIdx is within a valid range */
     if (ConfigPtr->pinPortIdx >= NUM_OF_PINS_PER_PORT) 
     {
@@ -89,3 +89,62 @@ Port_ret_t Port_Init(const Port_ConfigType* ConfigPtr)
     ConfigPtr->base->PCR[ConfigPtr->pinPortIdx] = regValue;
 	return ret;	
 }
+
+/**
+ * @brief Initializes a group of pins of one port with identical settings.
+ *
+ * The lower half of the PCR (pull, drive strength, mux) is written through
+ * GPCLR/GPCHR and the upper half (IRQC) through GICLR/GICHR. Each register
+ * carries a 16-bit pin write-enable mask, so a whole group costs at most four
+ * writes instead of one read-modify-write per pin.
+ *
+ * @param[in] ConfigPtr Pointer to the group configuration structure.
+ * @return Port_ret_t   Status of the operation.
+ *                      - PORT_OK: Initialization was successful.
+ *                      - PORT_ERR_PARA: Error due to incorrect parameter.
+ */
+Port_ret_t Port_InitMulti(const Port_MultiConfigType* ConfigPtr)
+{
+	unsigned int lowMask;
+	unsigned int highMask;
+	unsigned int pcrLow = 0;
+	unsigned int pcrHigh;
+
+	if (ConfigPtr->pinMask == 0 || ConfigPtr->pullConfig > PORT_PULL_UP || ConfigPtr->driveSelect > PORT_HIGH_DRV_STRENGTH || ConfigPtr->mux > PORT_MUX_ALT7 || ConfigPtr->intConfig > PORT_INT_LOGIC_ONE)
+	{
+		return PORT_ERR_PARA; /*!< Return error if any configuration parameter is out of range */
+	}
+	/* 1. Internal resistor pull feature selection. */
+	if (ConfigPtr->pullConfig == PORT_PULL_DOWN)
+	{
+		pcrLow |= (PULL_ENABLE<<1);
+	}
+	else if (ConfigPtr->pullConfig == PORT_PULL_UP)
+	{
+		pcrLow |= (PULL_ENABLE<<1) | (PULL_ENABLE<<0);
+	}
+	/* 2. Configures the drive strength.*/
+	if (ConfigPtr->driveSelect == PORT_HIGH_DRV_STRENGTH)
+	{
+		pcrLow |= (1u<<6);
+	}
+	/* 3. mux selection. */
+	pcrLow |= (unsigned int) ((ConfigPtr->mux)<<8);
+	/* 4. Interrupt generation condition, PCR[19:16] = GIxR data bits [3:0]. */
+	pcrHigh = (unsigned int) (ConfigPtr->intConfig);
+
+	/* 5. One write per half-port: [31:16] selects the pins, [15:0] is the data. */
+	lowMask  = ConfigPtr->pinMask & PORT_GPC_DATA_MASK;
+	highMask = ConfigPtr->pinMask >> PORT_PINS_PER_GPC_REG;
+	if (lowMask != 0)
+	{
+		ConfigPtr->base->GPCLR = (lowMask << PORT_GPC_WE_SHIFT) | pcrLow;
+		ConfigPtr->base->GICLR = (lowMask << PORT_GPC_WE_SHIFT) | pcrHigh;
+	}
+	if (highMask != 0)
+	{
+		ConfigPtr->base->GPCHR = (highMask << PORT_GPC_WE_SHIFT) | pcrLow;
+		ConfigPtr->base->GICHR = (highMask << PORT_GPC_WE_SHIFT) | pcrHigh;
+	}
+	return PORT_OK;
+}
@@ -43,6 +43,7 @@
 #include "device_registers.h"
 #include "system_S32K144.h"
 #include "stdbool.h"
+#include "Lmem.h"
 
 /* ----------------------------------------------------------------------------
    -- Core clock
@@ -55,7 +56,7 @@ uint32_t SystemCoreClock = DEFAULT_SYSTEM_CLOCK;
  * Function Name : SystemInit
  * Description   : This function disables the watchdog, enables FPU
  * and the power mode protection if the corresponding feature macro
- * is enabled. SystemInit is called from startup_device file.
+ * is enabled, and sets up the LMEM code cache. SystemInit is called from startup_device file.
  *
  * Implements    : SystemInit_Activity
  *END**************************************************************************/
@@ -100,10 +101,9 @@ void SystemInit(void)
 /**************************************************************************/
             /* ENABLE CACHE */
 /**************************************************************************/
-#if defined(I_CACHE) && (ICACHE_ENABLE == 1)
-  /* Invalidate and enable code cache */
-  LMEM->PCCCR = LMEM_PCCCR_INVW0(1) | LMEM_PCCCR_INVW1(1) | LMEM_PCCCR_GO(1) | LMEM_PCCCR_ENCACHE(1);
-#endif /* defined(I_CACHE) && (ICACHE_ENABLE == 1) */
+  /* Region policies, invalidate and enable the code cache (Driver/scr/Lmem.c),
+   * LMEM_CACHE_ENABLE = 0 leaves it in its reset state */
+  Lmem_Init();
 }
 
 /*FUNCTION**********************************************************************
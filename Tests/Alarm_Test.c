@@ -0,0 +1,186 @@
+/**
+ * @file    Alarm_Test.c
+ * @brief   Host test of the alarm next firing across calendar boundaries
+ * @details Sets alarms with Alarm_Add(), reads the next firing
+ *          (Alarm_NextFiring()) from the heap root and moves on with
+ *          Alarm_Fire(), the way the LPIT tick does. Expected epochs come from
+ *          Test_Epoch(), a days-from-civil count independent of
+ *          ProcessDateTime.c. Checked:
+ *          - month and year ends, 28 February of leap and common years, 2100,
+ *          - a firing exactly at now goes to the next day,
+ *          - weekday alarms skip Saturday and Sunday, also across a month and
+ *            a year end and over 29 February,
+ *          - a one-shot alarm is removed once fired, alarms due in the same
+ *            second all fire,
+ *          - a daily and a weekday alarm run through 2024: 366 and 262 firings.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include "Alarm.h"
+#include "ProcessDateTime.h"
+#include "Log.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define TEST_HMS(h, m, s) 			(((h) * 3600U) + ((m) * 60U) + (s))
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+/* Seconds since 1970-01-01 of a civil date, 0 = Sunday for Test_Weekday() */
+static unsigned int Test_Epoch(unsigned int year, unsigned int month, unsigned int day, unsigned int seconds)
+{
+	unsigned int y = (month <= 2U) ? (year - 1U) : year;
+	unsigned int era = y / 400U;
+	unsigned int yoe = y - (era * 400U);
+	unsigned int doy = ((153U * ((month > 2U) ? (month - 3U) : (month + 9U))) + 2U) / 5U + day - 1U;
+	unsigned int doe = (yoe * 365U) + (yoe / 4U) - (yoe / 100U) + doy;
+	unsigned int days = (era * 146097U) + doe - 719468U;
+
+	return (days * (unsigned int)SECONDS_PER_DAY) + seconds;
+}
+
+static unsigned int Test_Weekday(unsigned int epoch)
+{
+	return ((epoch / (unsigned int)SECONDS_PER_DAY) + 4U) % 7U;
+}
+
+/* Next firing of a lone alarm set at now */
+static unsigned int Test_Next(unsigned int timeOfDay, Alarm_RepeatType repeat, unsigned int now)
+{
+	Alarm_Clear();
+	HOST_CHECK(Alarm_Add(timeOfDay, repeat, now) != 0U);
+	return Alarm_Heap[0].next;
+}
+
+static void Test_Daily(void)
+{
+	unsigned int next;
+
+	/* Step 1. Month, year, leap day */
+	HOST_CHECK(Test_Next(TEST_HMS(7U, 0U, 0U), ALARM_DAILY, Test_Epoch(2024U, 1U, 31U, TEST_HMS(8U, 0U, 0U)))
+	           == Test_Epoch(2024U, 2U, 1U, TEST_HMS(7U, 0U, 0U)));
+	HOST_CHECK(Test_Next(TEST_HMS(7U, 0U, 0U), ALARM_DAILY, Test_Epoch(2024U, 4U, 30U, TEST_HMS(8U, 0U, 0U)))
+	           == Test_Epoch(2024U, 5U, 1U, TEST_HMS(7U, 0U, 0U)));
+	HOST_CHECK(Test_Next(TEST_HMS(6U, 30U, 0U), ALARM_DAILY, Test_Epoch(2023U, 12U, 31U, TEST_HMS(23U, 59U, 59U)))
+	           == Test_Epoch(2024U, 1U, 1U, TEST_HMS(6U, 30U, 0U)));
+	HOST_CHECK(Test_Next(0U, ALARM_DAILY, Test_Epoch(2024U, 2U, 28U, TEST_HMS(12U, 0U, 0U)))
+	           == Test_Epoch(2024U, 2U, 29U, 0U));
+	HOST_CHECK(Test_Next(0U, ALARM_DAILY, Test_Epoch(2023U, 2U, 28U, TEST_HMS(12U, 0U, 0U)))
+	           == Test_Epoch(2023U, 3U, 1U, 0U));
+	HOST_CHECK(Test_Next(TEST_HMS(9U, 0U, 0U), ALARM_DAILY, Test_Epoch(2100U, 2U, 28U, TEST_HMS(10U, 0U, 0U)))
+	           == Test_Epoch(2100U, 3U, 1U, TEST_HMS(9U, 0U, 0U)));
+	/* Step 2. Strictly after now */
+	HOST_CHECK(Test_Next(TEST_HMS(7U, 0U, 0U), ALARM_DAILY, Test_Epoch(2024U, 6U, 10U, TEST_HMS(6U, 59U, 59U)))
+	           == Test_Epoch(2024U, 6U, 10U, TEST_HMS(7U, 0U, 0U)));
+	HOST_CHECK(Test_Next(TEST_HMS(7U, 0U, 0U), ALARM_DAILY, Test_Epoch(2024U, 6U, 10U, TEST_HMS(7U, 0U, 0U)))
+	           == Test_Epoch(2024U, 6U, 11U, TEST_HMS(7U, 0U, 0U)));
+	/* Step 3. Firing on the leap day moves to 1 March */
+	next = Test_Next(TEST_HMS(23U, 59U, 59U), ALARM_DAILY, Test_Epoch(2024U, 2U, 29U, 0U));
+	Alarm_Fire(next);
+	HOST_CHECK(Host_LogArgs[LOG_ALARM_FIRED][1] == next);
+	HOST_CHECK(Alarm_Heap[0].next == Test_Epoch(2024U, 3U, 1U, TEST_HMS(23U, 59U, 59U)));
+}
+
+static void Test_Weekdays(void)
+{
+	unsigned int seven = TEST_HMS(7U, 0U, 0U);
+	unsigned int next;
+
+	/* Step 1. Friday 3 May 2024 after the time, Saturday, Sunday: Monday 6 May */
+	HOST_CHECK(Test_Weekday(Test_Epoch(2024U, 5U, 3U, 0U)) == 5U);
+	HOST_CHECK(Test_Next(seven, ALARM_WEEKDAYS, Test_Epoch(2024U, 5U, 3U, TEST_HMS(8U, 0U, 0U)))
+	           == Test_Epoch(2024U, 5U, 6U, seven));
+	HOST_CHECK(Test_Next(seven, ALARM_WEEKDAYS, Test_Epoch(2024U, 5U, 4U, TEST_HMS(6U, 0U, 0U)))
+	           == Test_Epoch(2024U, 5U, 6U, seven));
+	HOST_CHECK(Test_Next(seven, ALARM_WEEKDAYS, Test_Epoch(2024U, 5U, 5U, TEST_HMS(23U, 0U, 0U)))
+	           == Test_Epoch(2024U, 5U, 6U, seven));
+	HOST_CHECK(Test_Next(seven, ALARM_WEEKDAYS, Test_Epoch(2024U, 5U, 3U, TEST_HMS(6U, 0U, 0U)))
+	           == Test_Epoch(2024U, 5U, 3U, seven));
+	/* Step 2. Weekend across a month end and a year end */
+	HOST_CHECK(Test_Next(seven, ALARM_WEEKDAYS, Test_Epoch(2024U, 5U, 31U, TEST_HMS(8U, 0U, 0U)))
+	           == Test_Epoch(2024U, 6U, 3U, seven));
+	HOST_CHECK(Test_Next(seven, ALARM_WEEKDAYS, Test_Epoch(2021U, 12U, 31U, TEST_HMS(8U, 0U, 0U)))
+	           == Test_Epoch(2022U, 1U, 3U, seven));
+	/* Step 3. 29 February 2020 was a Saturday, 2024 a Thursday */
+	HOST_CHECK(Test_Next(seven, ALARM_WEEKDAYS, Test_Epoch(2020U, 2U, 28U, TEST_HMS(8U, 0U, 0U)))
+	           == Test_Epoch(2020U, 3U, 2U, seven));
+	next = Test_Next(seven, ALARM_WEEKDAYS, Test_Epoch(2024U, 2U, 28U, TEST_HMS(8U, 0U, 0U)));
+	HOST_CHECK(next == Test_Epoch(2024U, 2U, 29U, seven));
+	Alarm_Fire(next);
+	HOST_CHECK(Alarm_Heap[0].next == Test_Epoch(2024U, 3U, 1U, seven));
+	Alarm_Fire(Alarm_Heap[0].next);
+	HOST_CHECK(Alarm_Heap[0].next == Test_Epoch(2024U, 3U, 4U, seven));
+}
+
+static void Test_Once(void)
+{
+	unsigned int now = Test_Epoch(2024U, 12U, 31U, TEST_HMS(22U, 0U, 0U));
+	unsigned int fired = Host_LogCount[LOG_ALARM_FIRED];
+
+	Alarm_Clear();
+	HOST_CHECK(Alarm_Add(TEST_HMS(21U, 0U, 0U), ALARM_ONCE, now) != 0U);
+	HOST_CHECK(Alarm_Add(TEST_HMS(21U, 0U, 0U), ALARM_DAILY, now) != 0U);
+	HOST_CHECK(Alarm_Add(TEST_HMS(23U, 0U, 0U), ALARM_ONCE, now) != 0U);
+	HOST_CHECK(Alarm_Heap[0].next == Test_Epoch(2024U, 12U, 31U, TEST_HMS(23U, 0U, 0U)));
+	Alarm_Check(Alarm_Heap[0].next - 1U);
+	HOST_CHECK(Host_LogCount[LOG_ALARM_FIRED] == fired);
+	Alarm_Check(Alarm_Heap[0].next);
+	HOST_CHECK(Alarm_Count == 2U);
+	/* Two due in the same second, into the new year: one left, the daily one */
+	Alarm_Check(Test_Epoch(2025U, 1U, 1U, TEST_HMS(21U, 0U, 0U)));
+	HOST_CHECK(Host_LogCount[LOG_ALARM_FIRED] == fired + 3U);
+	HOST_CHECK(Alarm_Count == 1U);
+	HOST_CHECK(Alarm_Heap[0].repeat == ALARM_DAILY);
+	HOST_CHECK(Alarm_Heap[0].next == Test_Epoch(2025U, 1U, 2U, TEST_HMS(21U, 0U, 0U)));
+	(void)Alarm_Stop();
+}
+
+/* Every firing of 2024 */
+static unsigned int Test_Year(Alarm_RepeatType repeat)
+{
+	unsigned int end = Test_Epoch(2025U, 1U, 1U, 0U);
+	unsigned int next;
+	unsigned int count = 0U;
+
+	next = Test_Next(TEST_HMS(6U, 15U, 0U), repeat, Test_Epoch(2024U, 1U, 1U, 0U));
+	while (next < end)
+	{
+		HOST_CHECK(next % (unsigned int)SECONDS_PER_DAY == TEST_HMS(6U, 15U, 0U));
+		if (repeat == ALARM_WEEKDAYS)
+		{
+			HOST_CHECK((Test_Weekday(next) != 0U) && (Test_Weekday(next) != 6U));
+		}
+		count++;
+		Alarm_Fire(next);
+		HOST_CHECK(Alarm_Heap[0].next > next);
+		next = Alarm_Heap[0].next;
+	}
+	(void)Alarm_Stop();
+	return count;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	unsigned int daily;
+	unsigned int weekdays;
+
+	Host_Reset();
+	Alarm_Init();
+	Test_Daily();
+	Test_Weekdays();
+	Test_Once();
+	daily = Test_Year(ALARM_DAILY);
+	weekdays = Test_Year(ALARM_WEEKDAYS);
+	printf("2024: %u daily firings, %u weekday firings\n", daily, weekdays);
+	HOST_CHECK(daily == 366U);
+	HOST_CHECK(weekdays == 262U);
+	return Host_Result("Alarm_Test");
+}
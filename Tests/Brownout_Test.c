@@ -0,0 +1,199 @@
+/**
+ * @file    Brownout_Test.c
+ * @brief   Host model of the brownout snapshot latency
+ * @details Runs Brownout_IrqHandler() -> Journal_Snapshot() ->
+ *          Ftfc_ProgramPhraseNow() on the flash model (see FlashModel.h) and
+ *          reads the time it took from Brownout_Stats, as GET STATS does on
+ *          the board. The warning comes
+ *          - with the controller idle,
+ *          - at every microsecond of a record program queued by
+ *            Journal_Append(): the snapshot waits for the program first,
+ *          - every TEST_SWITCH_STEP_US of a sector switch, erase, header and
+ *            record: the erase is suspended, then relaunched.
+ *          Each warning is a forked process on its own copy of the flash.
+ *          Checked: every snapshot within BROWNOUT_BUDGET_US, written, and the
+ *          queued write still completes after it.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "Brownout.h"
+#include "Clock.h"
+#include "FlashModel.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define VALID 						(1U<<SCG_FIRCCSR_FIRCVLD_SHIFT)
+#define CSR(scs, core, bus, slow) 	(((unsigned int)(scs)<<SCG_CSR_SCS_SHIFT) | ((unsigned int)(core)<<SCG_CSR_DIVCORE_SHIFT) \
+									| ((unsigned int)(bus)<<SCG_CSR_DIVBUS_SHIFT) | ((unsigned int)(slow)<<SCG_CSR_DIVSLOW_SHIFT))
+#define TEST_US 					(FLASHMODEL_CORE_HZ / 1000000U)
+#define TEST_PROGRAM_US 			(FLASHMODEL_PROGRAM_CYCLES / TEST_US + 20U)
+#define TEST_SWITCH_STEP_US 		(50U)
+#define TEST_SWITCH_US 				((FLASHMODEL_ERASE_CYCLES + (2U * FLASHMODEL_PROGRAM_CYCLES)) / TEST_US + 20U)
+#define TEST_EPOCH 					(1700000000U)
+/*==================================================================================================
+*                                    LOCAL TYPES
+==================================================================================================*/
+/* Results of the forked warnings */
+typedef struct
+{
+	unsigned int count;
+	unsigned int minCycles;
+	unsigned int maxCycles;
+	unsigned int maxAtUs;                /* Warning time of the slowest snapshot */
+	unsigned int overBudget;
+	unsigned int suspends;
+} Test_ResultType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static Test_ResultType *Test_Result;
+static unsigned int Test_Epoch = TEST_EPOCH;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Test_Source(Journal_RecordType *record)
+{
+	Test_Epoch++;
+	record->epoch = Test_Epoch;
+	record->type = JOURNAL_TYPE_SNAPSHOT;
+	record->settings = JOURNAL_SETTING_DISPLAY_ON;
+}
+
+/* Queues a periodic record and lets it complete */
+static void Test_Append(void)
+{
+	Journal_RecordType record;
+	unsigned int writes = Journal_Stats.writes;
+
+	Test_Epoch++;
+	record.epoch = Test_Epoch;
+	record.type = JOURNAL_TYPE_PERIODIC;
+	record.settings = JOURNAL_SETTING_DISPLAY_ON;
+	HOST_CHECK(Journal_Append(&record) == FTFC_OK);
+	while ((Journal_Stats.writes == writes) && (Journal_Stats.errors == 0U))
+	{
+		FlashModel_Run(TEST_US);
+	}
+}
+
+/* The warning us after an append was queued, on a copy of the flash */
+static void Test_Warning(unsigned int us)
+{
+	Journal_RecordType record;
+	unsigned int writes;
+	unsigned int epoch;
+	unsigned int cycles;
+	pid_t pid;
+	int status;
+
+	fflush(stdout);
+	pid = fork();
+	if (pid != 0)
+	{
+		waitpid(pid, &status, 0);
+		HOST_CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+		return;
+	}
+	/* Step 1. Append, then the warning preempts whatever the FTFC driver is doing */
+	FlashModel_Detach();
+	writes = Journal_Stats.writes;
+	Test_Epoch++;
+	record.epoch = Test_Epoch;
+	record.type = JOURNAL_TYPE_PERIODIC;
+	record.settings = JOURNAL_SETTING_DISPLAY_ON;
+	HOST_CHECK(Journal_Append(&record) == FTFC_OK);
+	FlashModel_Run(us * TEST_US);
+	Brownout_IrqHandler();
+	epoch = Test_Epoch;
+	cycles = Brownout_Stats.lastCycles;
+	/* Step 2. The queued write goes on, both records are there */
+	FlashModel_Run((2U * FLASHMODEL_ERASE_CYCLES) + (4U * FLASHMODEL_PROGRAM_CYCLES));
+	HOST_CHECK(Brownout_Stats.errors == 0U);
+	HOST_CHECK(Journal_Stats.errors == 0U);
+	HOST_CHECK(Journal_Stats.writes == writes + 2U);
+	HOST_CHECK(Journal_Init(&record) == 1U);
+	HOST_CHECK((record.epoch == epoch) || (record.epoch == epoch - 1U));
+	/* Step 3. Report */
+	Test_Result->count++;
+	Test_Result->minCycles = (cycles < Test_Result->minCycles) ? cycles : Test_Result->minCycles;
+	if (cycles > Test_Result->maxCycles)
+	{
+		Test_Result->maxCycles = cycles;
+		Test_Result->maxAtUs = us;
+	}
+	Test_Result->overBudget += Brownout_Stats.overBudget;
+	Test_Result->suspends += FlashModel_Stats->suspends;
+	fflush(stdout);
+	_exit((Host_Failures == 0U) ? 0 : 1);
+}
+
+static void Test_Sweep(const char *name, unsigned int lastUs, unsigned int stepUs)
+{
+	unsigned int us;
+
+	Test_Result->count = 0U;
+	Test_Result->minCycles = 0xFFFFFFFFU;
+	Test_Result->maxCycles = 0U;
+	Test_Result->overBudget = 0U;
+	Test_Result->suspends = 0U;
+	for (us = 0U; us <= lastUs; us += stepUs)
+	{
+		Test_Warning(us);
+	}
+	printf("%-30s %4u warnings, snapshot %3u..%3u us, slowest %u us into the write, %u erase suspends\n",
+	       name, Test_Result->count, Brownout_CyclesToUs(Test_Result->minCycles),
+	       Brownout_CyclesToUs(Test_Result->maxCycles), Test_Result->maxAtUs, Test_Result->suspends);
+	HOST_CHECK(Test_Result->count == (lastUs / stepUs) + 1U);
+	HOST_CHECK(Test_Result->overBudget == 0U);
+	HOST_CHECK(Brownout_CyclesToUs(Test_Result->maxCycles) <= BROWNOUT_BUDGET_US);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	Journal_RecordType record;
+	unsigned int i;
+
+	/* Step 1. FIRC 48MHz core, an empty journal formatted by the first append */
+	Host_Reset();
+	SCG->FIRCCSR = VALID;
+	SCG->CSR = CSR(FIRC_CLK, CORE_CLK_DIV_BY_1, BUS_CLK_DIV_BY_1, SLOW_CLK_DIV_BY_2);
+	FlashModel_Map();
+	FlashModel_Start(Ftfc_IrqHandler);
+	Test_Result = (Test_ResultType *)mmap(NULL, sizeof(Test_ResultType), PROT_READ | PROT_WRITE,
+	                                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	HOST_CHECK(Journal_Init(&record) == 0U);
+	Brownout_SetSource(Test_Source);
+	Brownout_Init();
+	Test_Append();
+
+	/* Step 2. Controller idle: one phrase program */
+	Brownout_IrqHandler();
+	printf("%-30s snapshot %3u us (budget %u us)\n", "controller idle:",
+	       Brownout_CyclesToUs(Brownout_Stats.lastCycles), BROWNOUT_BUDGET_US);
+	HOST_CHECK(Brownout_Stats.errors == 0U);
+	HOST_CHECK(Brownout_Stats.overBudget == 0U);
+
+	/* Step 3. During a record program, room left for one more record after it */
+	for (i = 3U; i < JOURNAL_RECORDS_PER_SECTOR - 1U; i++)
+	{
+		Test_Append();
+	}
+	Test_Sweep("during a record program:", TEST_PROGRAM_US, 1U);
+
+	/* Step 4. The sector is full: the next append erases the next sector */
+	Test_Append();
+	Test_Sweep("during a sector switch:", TEST_SWITCH_US, TEST_SWITCH_STEP_US);
+	FlashModel_Stop();
+	return Host_Result("Brownout_Test");
+}
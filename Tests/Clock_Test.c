@@ -0,0 +1,180 @@
+/**
+ * @file    Clock_Test.c
+ * @brief   Host test of Clock_GetFrequency() and the dividers derived from it
+ * @details Fills SCG/PCC for several clock trees and checks the frequencies
+ *          read back, then the LPUART SBR, the LPSPI SCKDIV/PRESCALE and the
+ *          LPIT TVAL each driver computes from them.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Clock.h"
+#include "Lpit.h"
+#include "Lpspi.h"
+#include "Lpuart.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define VALID 						(1U<<SCG_FIRCCSR_FIRCVLD_SHIFT)
+#define DIV2(div) 					((unsigned int)(div)<<SCG_FIRCDIV_FIRCDIV2_SHIFT)
+#define CSR(scs, core, bus, slow) 	(((unsigned int)(scs)<<SCG_CSR_SCS_SHIFT) | ((unsigned int)(core)<<SCG_CSR_DIVCORE_SHIFT) \
+									| ((unsigned int)(bus)<<SCG_CSR_DIVBUS_SHIFT) | ((unsigned int)(slow)<<SCG_CSR_DIVSLOW_SHIFT))
+#define PCC_ON(pcs) 				((1U<<PCC_CGC_SHIFT) | ((unsigned int)(pcs)<<PCC_PCS_SHIFT))
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static unsigned int Test_Sbr(LPUART_Type *uart, unsigned int baudrate, uart_oversampling_ratio_t osr)
+{
+	Lpuart_ConfigType config = {0};
+
+	config.pUARTx = uart;
+	config.Init.lpuart_baudrate = baudrate;
+	config.Init.lpuart_oversampling = osr;
+	uart->BAUD = 0U;
+	Lpuart_Init(&config);
+	return uart->BAUD & LPUART_BAUD_SBR_MAX;
+}
+
+static void Test_Sck(unsigned int speed, unsigned int sckdiv, unsigned int prescaler)
+{
+	Lpspi_ConfigType config = {0};
+
+	config.pSPIx = LPSPI1;
+	config.Init.spi_speed = speed;
+	config.Init.spi_frame = LPSPI_FRAME_16;
+	LPSPI1->CCR = 0U;
+	LPSPI1->TCR = 0U;
+	Lpspi_Init(&config);
+	HOST_CHECK(((LPSPI1->CCR >> LPSPI_CCR_SCKDIV_SHIFT) & LPSPI_CCR_SCKDIV_MAX) == sckdiv);
+	HOST_CHECK(((LPSPI1->TCR >> LPSPI_TCR_PRESCALE_SHIFT) & 0x7U) == prescaler);
+}
+
+static unsigned int Test_Tval(unsigned int periodUs)
+{
+	Lpit_ChannelConfigType config = {0};
+
+	config.periodUs = periodUs;
+	LPIT0->TMR[LPIT_CHANNEL_0].TVAL = 0xA5A5A5A5U;
+	Lpit_InitChannel(LPIT_CHANNEL_0, &config);
+	return LPIT0->TMR[LPIT_CHANNEL_0].TVAL;
+}
+
+/* The board: FIRC 48MHz runs the core, SOSC 8MHz / 8 clocks the LPIT */
+static void Test_Firc(void)
+{
+	Host_Reset();
+	SCG->FIRCCSR = VALID;
+	SCG->SOSCCSR = VALID;
+	SCG->FIRCDIV = DIV2(SCG_CLOCK_DIV_BY_1);
+	SCG->SOSCDIV = DIV2(SCG_CLOCK_DIV_BY_8);
+	SCG->CSR = CSR(FIRC_CLK, CORE_CLK_DIV_BY_1, BUS_CLK_DIV_BY_1, SLOW_CLK_DIV_BY_2);
+	PCC->PCCn[LPUART1_CLK] = PCC_ON(CLK_SRC_OP_3);
+	PCC->PCCn[LPSPI1_CLK] = PCC_ON(CLK_SRC_OP_3);
+	PCC->PCCn[LPIT0_CLK] = PCC_ON(CLK_SRC_OP_1);
+	PCC->PCCn[PORTC_CLK] = PCC_ON(CLK_SRC_OFF);
+
+	HOST_CHECK(Clock_GetFrequency(CORE_CLK) == 48000000U);
+	HOST_CHECK(Clock_GetFrequency(BUS_CLK) == 48000000U);
+	HOST_CHECK(Clock_GetFrequency(SLOW_CLK) == 24000000U);
+	HOST_CHECK(Clock_GetFrequency(LPUART1_CLK) == 48000000U);
+	HOST_CHECK(Clock_GetFrequency(LPIT0_CLK) == 1000000U);
+	HOST_CHECK(Clock_GetFrequency(PORTC_CLK) == 48000000U);
+	/* Gated: no clock, whatever PCS says */
+	HOST_CHECK(Clock_GetFrequency(LPUART0_CLK) == 0U);
+	PCC->PCCn[LPUART0_CLK] = (unsigned int)CLK_SRC_OP_3 << PCC_PCS_SHIFT;
+	HOST_CHECK(Clock_GetFrequency(LPUART0_CLK) == 0U);
+	HOST_CHECK(Clock_GetFrequency(PORTA_CLK) == 0U);
+
+	/* 48MHz / (16 * 9600) = 312.5 and 48MHz / (16 * 115200) = 26.04 */
+	HOST_CHECK(Test_Sbr(LPUART1, 9600U, oversampling_ratio_16) == 313U);
+	HOST_CHECK(Test_Sbr(LPUART1, 115200U, oversampling_ratio_16) == 26U);
+	HOST_CHECK(Test_Sbr(LPUART1, 115200U, oversampling_ratio_8) == 52U);
+	/* No clock: BAUD is left alone */
+	HOST_CHECK(Test_Sbr(LPUART0, 9600U, oversampling_ratio_16) == 0U);
+
+	/* 48 LPSPI clocks per SCK bit at 1MHz, 4.8 rounds up to 5 at 10MHz */
+	Test_Sck(1000000U, 46U, LPSPI_PRE_DIV_BY_1);
+	Test_Sck(10000000U, 3U, LPSPI_PRE_DIV_BY_1);
+	/* Above 2 clocks per bit SCKDIV stops at 0 */
+	Test_Sck(48000000U, 0U, LPSPI_PRE_DIV_BY_1);
+	/* 480 clocks per bit at 100kHz need the prescaler: 240 / 2 */
+	Test_Sck(100000U, 238U, LPSPI_PRE_DIV_BY_2);
+
+	HOST_CHECK(Test_Tval(250000U) == 249999U);
+	HOST_CHECK(Test_Tval(1U) == 0U);
+}
+
+/* SOSC 8MHz through the SPLL: 8 / 1 * 40 / 2 = 160MHz, core / 2, bus / 2 */
+static void Test_Spll(void)
+{
+	Host_Reset();
+	SCG->SOSCCSR = VALID;
+	SCG->SPLLCSR = VALID;
+	SCG->SPLLCFG = (0U<<SCG_SPLLCFG_SPLLPREDIV_SHIFT) | (24U<<SCG_SPLLCFG_SPLLMULT_SHIFT);
+	SCG->SPLLDIV = DIV2(SCG_CLOCK_DIV_BY_2);
+	SCG->SOSCDIV = DIV2(SCG_CLOCK_DIV_BY_1);
+	SCG->CSR = CSR(SPLL_CLK, CORE_CLK_DIV_BY_2, BUS_CLK_DIV_BY_2, SLOW_CLK_DIV_BY_3);
+	PCC->PCCn[LPUART1_CLK] = PCC_ON(CLK_SRC_OP_6);
+	PCC->PCCn[LPSPI1_CLK] = PCC_ON(CLK_SRC_OP_6);
+	PCC->PCCn[LPIT0_CLK] = PCC_ON(CLK_SRC_OP_1);
+
+	HOST_CHECK(Clock_GetFrequency(CORE_CLK) == 80000000U);
+	HOST_CHECK(Clock_GetFrequency(BUS_CLK) == 40000000U);
+	HOST_CHECK(Clock_GetFrequency(SLOW_CLK) == 26666666U);
+	HOST_CHECK(Clock_GetFrequency(LPUART1_CLK) == 80000000U);
+	HOST_CHECK(Clock_GetFrequency(LPIT0_CLK) == 8000000U);
+
+	/* 80MHz / (16 * 115200) = 43.4 */
+	HOST_CHECK(Test_Sbr(LPUART1, 115200U, oversampling_ratio_16) == 43U);
+	Test_Sck(10000000U, 6U, LPSPI_PRE_DIV_BY_1);
+	/* 800 clocks per bit: 800 / 4 = 200 */
+	Test_Sck(100000U, 198U, LPSPI_PRE_DIV_BY_4);
+	/* Slower than 128 * 257 clocks per bit: slowest SCK */
+	Test_Sck(1000U, LPSPI_CCR_SCKDIV_MAX, LPSPI_PRE_DIV_BY_128);
+
+	HOST_CHECK(Test_Tval(250000U) == 1999999U);
+	/* 2^32 clocks is the longest period, past it TVAL is left alone */
+	HOST_CHECK(Test_Tval(536870912U) == MAX_TAVL_VALUE);
+	HOST_CHECK(Test_Tval(536870913U) == 0xA5A5A5A5U);
+	/* Lost lock or disabled divider: no clock */
+	SCG->SPLLCSR = 0U;
+	HOST_CHECK(Clock_GetFrequency(CORE_CLK) == 0U);
+	HOST_CHECK(Clock_GetFrequency(LPUART1_CLK) == 0U);
+	SCG->SPLLCSR = VALID;
+	SCG->SPLLDIV = DIV2(SCG_CLOCK_DISABLE);
+	HOST_CHECK(Clock_GetFrequency(LPUART1_CLK) == 0U);
+}
+
+/* SIRC in both ranges, with the deepest DIV2 */
+static void Test_Sirc(void)
+{
+	Host_Reset();
+	SCG->SIRCCSR = VALID;
+	SCG->SIRCCFG = SCG_SIRCCFG_RANGE_HIGH;
+	SCG->SIRCDIV = DIV2(SCG_CLOCK_DIV_BY_64);
+	SCG->CSR = CSR(SIRC_CLK, CORE_CLK_DIV_BY_1, BUS_CLK_DIV_BY_1, SLOW_CLK_DIV_BY_1);
+	PCC->PCCn[LPIT0_CLK] = PCC_ON(CLK_SRC_OP_2);
+
+	HOST_CHECK(Clock_GetFrequency(CORE_CLK) == 8000000U);
+	HOST_CHECK(Clock_GetFrequency(LPIT0_CLK) == 125000U);
+	HOST_CHECK(Test_Tval(250000U) == 31249U);
+	SCG->SIRCCFG = 0U;
+	HOST_CHECK(Clock_GetFrequency(CORE_CLK) == 2000000U);
+	HOST_CHECK(Clock_GetFrequency(LPIT0_CLK) == 31250U);
+	/* 7.8 clocks round down to 7 */
+	HOST_CHECK(Test_Tval(250U) == 6U);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	Test_Firc();
+	Test_Spll();
+	Test_Sirc();
+	return Host_Result("Clock_Test");
+}
@@ -0,0 +1,607 @@
+/**
+ * @file    FlashModel.c
+ * @brief   Host model of the FTFC controller and the FlexNVM D-Flash
+ * @details A register access faults on the protected page. The handler brings
+ *          the controller up to the current time, opens the page and sets the
+ *          trap flag; after the single instruction SIGTRAP takes what was
+ *          written and closes the page again. For FSTAT and FERSTAT writes the
+ *          register reads 0 during the instruction, so the written 1s show.
+ *          D-Flash pages are readable, except while a command runs and where a
+ *          phrase holds an ECC error: such a read faults the same way and is
+ *          turned into a bus error.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "FlashModel.h"
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "FlashModel needs x86-64 Linux: page fault error code and trap flag"
+#endif
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define MODEL_EFLAGS_TF 			(0x100)
+#define MODEL_FAULT_WRITE 			(0x2)
+#define MODEL_PAGE_SIZE 			(4096U)
+#define MODEL_PAGE_COUNT 			(FTFC_DFLASH_SIZE / MODEL_PAGE_SIZE)
+#define MODEL_PHRASE_COUNT 			(FTFC_DFLASH_SIZE / FTFC_PHRASE_SIZE)
+#define MODEL_PHRASES_PER_SECTOR 	(FTFC_DFLASH_SECTOR_SIZE / FTFC_PHRASE_SIZE)
+#define MODEL_CCIF 					(1U<<FTFC_FSTAT_CCIF_SHIFT)
+#define MODEL_FSTAT_ERRORS 			((1U<<FTFC_FSTAT_ACCERR_SHIFT) | (1U<<FTFC_FSTAT_FPVIOL_SHIFT))
+#define MODEL_FSTAT_W1C 			(MODEL_FSTAT_ERRORS | (1U<<FTFC_FSTAT_RDCOLERR_SHIFT))
+#define MODEL_ERSSUSP 				(1U<<FTFC_FCNFG_ERSSUSP_SHIFT)
+#define MODEL_CCIE 					(1U<<FTFC_FCNFG_CCIE_SHIFT)
+#define MODEL_DFDIF 				(1U<<FTFC_FERSTAT_DFDIF_SHIFT)
+#define MODEL_CFSR_BUS_ERROR 		((1U<<SCB_CFSR_PRECISERR_SHIFT) | (1U<<SCB_CFSR_BFARVALID_SHIFT))
+/* Interrupt entries without the controller moving before the model calls it a storm */
+#define MODEL_IRQ_STORM 			(1000U)
+/*==================================================================================================
+*                                    LOCAL TYPES
+==================================================================================================*/
+typedef enum
+{
+	MODEL_ACCESS_REGISTER = 0,
+	MODEL_ACCESS_FLASH
+} Model_AccessType;
+
+/* In the shared mapping, after the D-Flash */
+typedef struct
+{
+	FlashModel_StatsType stats;
+	unsigned char broken[MODEL_PHRASE_COUNT];      /* 1 = uncorrectable ECC error */
+} Model_SharedType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static unsigned char *Model_Flash;
+static Model_SharedType *Model_Shared;
+static void (*Model_Irq)(void);
+static unsigned long long Model_Now;
+/* Running command, FTFC_CMD_*; 0 = idle */
+static unsigned char Model_Command;
+static unsigned int Model_Address;                 /* Offset in the D-Flash       */
+static unsigned char Model_Data[FTFC_PHRASE_SIZE];
+static unsigned long long Model_Started;
+static unsigned long long Model_End;
+static unsigned char Model_Suspending;
+/* Suspended erase: sector + 1 (0 = none), and the erase time still to run */
+static unsigned int Model_Suspended;
+static unsigned long long Model_Left;
+/* Protection of each D-Flash page, while Model_PagesValid */
+static int Model_Pages[MODEL_PAGE_COUNT];
+static unsigned char Model_PagesValid;
+/* Access being single-stepped */
+static Model_AccessType Model_Access;
+static unsigned int Model_Offset;
+static unsigned char Model_IsWrite;
+static unsigned char Model_OldFstat;
+static unsigned char Model_OldFcnfg;
+static unsigned char Model_OldFerstat;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+FlashModel_StatsType *FlashModel_Stats;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Model_Protect(void *address, unsigned int size, int protection)
+{
+	if (address == (void *)Model_Flash)
+	{
+		Model_PagesValid = 0U;
+	}
+	if (mprotect(address, size, protection) != 0)
+	{
+		perror("FlashModel: mprotect");
+		_exit(2);
+	}
+}
+
+/* Readable, except while a command runs and where a phrase is broken */
+static void Model_ProtectFlash(void)
+{
+	unsigned int page;
+	unsigned int phrase;
+	int protection;
+
+	/* Model_Protect() of the whole flash forgets the page settings */
+	if (Model_PagesValid == 0U)
+	{
+		memset(Model_Pages, 0xFF, sizeof(Model_Pages));
+		Model_PagesValid = 1U;
+	}
+
+	for (page = 0U; page < MODEL_PAGE_COUNT; page++)
+	{
+		protection = (Model_Command == 0U) ? PROT_READ : PROT_NONE;
+		for (phrase = 0U; phrase < (MODEL_PAGE_SIZE / FTFC_PHRASE_SIZE); phrase++)
+		{
+			if (Model_Shared->broken[(page * (MODEL_PAGE_SIZE / FTFC_PHRASE_SIZE)) + phrase] == 1U)
+			{
+				protection = PROT_NONE;
+			}
+		}
+		if (Model_Pages[page] != protection)
+		{
+			Model_Protect(&Model_Flash[page * MODEL_PAGE_SIZE], MODEL_PAGE_SIZE, protection);
+			Model_Pages[page] = protection;
+		}
+	}
+}
+
+static void Model_Break(unsigned int phrase)
+{
+	if (Model_Shared->broken[phrase] == 0U)
+	{
+		Model_Shared->broken[phrase] = 1U;
+		Model_Shared->stats.brokenPhrases++;
+	}
+}
+
+static void Model_Erase(unsigned int sector)
+{
+	unsigned int phrase = sector * MODEL_PHRASES_PER_SECTOR;
+
+	memset(&Model_Flash[sector * FTFC_DFLASH_SECTOR_SIZE], 0xFF, FTFC_DFLASH_SECTOR_SIZE);
+	for (; phrase < ((sector + 1U) * MODEL_PHRASES_PER_SECTOR); phrase++)
+	{
+		if (Model_Shared->broken[phrase] == 1U)
+		{
+			Model_Shared->broken[phrase] = 0U;
+			Model_Shared->stats.brokenPhrases--;
+		}
+	}
+}
+
+/* ANDs the data in; a phrase that was not erased gets an ECC error */
+static unsigned char Model_Program(unsigned int address, const unsigned char *data)
+{
+	unsigned char erased = 0xFFU;
+	unsigned int i;
+
+	for (i = 0U; i < FTFC_PHRASE_SIZE; i++)
+	{
+		erased &= Model_Flash[address + i];
+		Model_Flash[address + i] &= data[i];
+	}
+	if ((erased != 0xFFU) || (Model_Shared->broken[address / FTFC_PHRASE_SIZE] == 1U))
+	{
+		Model_Break(address / FTFC_PHRASE_SIZE);
+		return 1U;
+	}
+	return 0U;
+}
+
+/* The running command completes, or its suspension takes effect */
+static void Model_Complete(void)
+{
+	Model_Protect(Model_Flash, FTFC_DFLASH_SIZE, PROT_READ | PROT_WRITE);
+	if (Model_Suspending == 1U)
+	{
+		Model_Suspended = (Model_Address / FTFC_DFLASH_SECTOR_SIZE) + 1U;
+		Model_Shared->stats.suspends++;
+	}
+	else if (Model_Command == FTFC_CMD_ERASE_SECTOR)
+	{
+		Model_Erase(Model_Address / FTFC_DFLASH_SECTOR_SIZE);
+	}
+	else if (Model_Program(Model_Address, Model_Data) == 1U)
+	{
+		FTFC->FSTAT |= (unsigned char)(1U<<FTFC_FSTAT_MGSTAT0_SHIFT);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	Model_Command = 0U;
+	Model_Suspending = 0U;
+	FTFC->FSTAT |= (unsigned char)MODEL_CCIF;
+}
+
+/* Time passes up to now */
+static void Model_Advance(void)
+{
+	if ((Model_Command != 0U) && (Model_Now >= Model_End))
+	{
+		Model_Complete();
+	}
+}
+
+static void Model_Launch(void)
+{
+	unsigned int address = ((unsigned int)FTFC->FCCOB[FTFC_FCCOB(1U)] << 16)
+	                     | ((unsigned int)FTFC->FCCOB[FTFC_FCCOB(2U)] << 8)
+	                     | (unsigned int)FTFC->FCCOB[FTFC_FCCOB(3U)];
+	unsigned char command = FTFC->FCCOB[FTFC_FCCOB(0U)];
+	unsigned int sector;
+	unsigned int align;
+	unsigned int i;
+
+	/* Step 1. D-Flash commands only, aligned, and not into a suspended erase */
+	align = (command == FTFC_CMD_ERASE_SECTOR) ? FTFC_DFLASH_SECTOR_SIZE : FTFC_PHRASE_SIZE;
+	address -= FTFC_DFLASH_CMD_ADDRESS;
+	sector = address / FTFC_DFLASH_SECTOR_SIZE;
+	if (((command != FTFC_CMD_ERASE_SECTOR) && (command != FTFC_CMD_PROGRAM_PHRASE))
+	    || (address >= FTFC_DFLASH_SIZE) || ((address & (align - 1U)) != 0U)
+	    || ((command == FTFC_CMD_PROGRAM_PHRASE) && (Model_Suspended == sector + 1U)))
+	{
+		FTFC->FSTAT |= (unsigned char)(1U<<FTFC_FSTAT_ACCERR_SHIFT);
+		return;
+	}
+	/* Step 2. Busy from now on */
+	FTFC->FSTAT &= (unsigned char)~(MODEL_CCIF | (1U<<FTFC_FSTAT_MGSTAT0_SHIFT));
+	Model_Command = command;
+	Model_Address = address;
+	Model_Started = Model_Now;
+	if (command == FTFC_CMD_PROGRAM_PHRASE)
+	{
+		for (i = 0U; i < FTFC_PHRASE_SIZE; i++)
+		{
+			Model_Data[i] = FTFC->FCCOB[FTFC_FCCOB(4U + i)];
+		}
+		Model_End = Model_Now + FLASHMODEL_PROGRAM_CYCLES;
+		Model_Shared->stats.programs++;
+	}
+	else if (Model_Suspended == sector + 1U)
+	{
+		/* Resume */
+		Model_Started = Model_Now - (FLASHMODEL_ERASE_CYCLES - Model_Left);
+		Model_End = Model_Now + Model_Left;
+		Model_Suspended = 0U;
+	}
+	else
+	{
+		Model_End = Model_Now + FLASHMODEL_ERASE_CYCLES;
+		Model_Suspended = 0U;
+		Model_Shared->stats.erases[sector]++;
+	}
+}
+
+/* ERSSUSP set while an erase runs: it stops after the suspend latency */
+static void Model_Suspend(void)
+{
+	unsigned long long stop = Model_Now + FLASHMODEL_SUSPEND_CYCLES;
+
+	if ((Model_Command != FTFC_CMD_ERASE_SECTOR) || (Model_Suspending == 1U) || (stop >= Model_End))
+	{
+		return;
+	}
+	Model_Left = Model_End - stop;
+	Model_End = stop;
+	Model_Suspending = 1U;
+}
+
+/* A bus error: ignored by a fault probe, a BusFault otherwise */
+static void Model_BusError(unsigned char ecc)
+{
+	if ((Host_FaultMask == 0U) || ((SCB_CCR & (1U<<SCB_CCR_BFHFNMIGN_SHIFT)) == 0U))
+	{
+		fprintf(stderr, "FlashModel: BusFault reading the D-Flash (%s)\n", (ecc == 1U) ? "ECC error" : "read collision");
+		fflush(stdout);
+		_exit(FLASHMODEL_BUSFAULT_EXIT);
+	}
+	SCB_CFSR |= MODEL_CFSR_BUS_ERROR;
+	Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_READ | PROT_WRITE);
+	if (ecc == 1U)
+	{
+		FTFC->FERSTAT |= (unsigned char)MODEL_DFDIF;
+	}
+	else
+	{
+		FTFC->FSTAT |= (unsigned char)(1U<<FTFC_FSTAT_RDCOLERR_SHIFT);
+	}
+	Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_NONE);
+	Model_Shared->stats.busErrors++;
+}
+
+static void Model_Fault(int signal, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	unsigned char *address = (unsigned char *)info->si_addr;
+
+	(void)signal;
+	Model_IsWrite = ((uc->uc_mcontext.gregs[REG_ERR] & MODEL_FAULT_WRITE) != 0) ? 1U : 0U;
+	if ((address >= Host_Ftfc.page) && (address < &Host_Ftfc.page[sizeof(Host_Ftfc)]))
+	{
+		/* Step 1. The access takes bus time, the controller runs meanwhile */
+		Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_READ | PROT_WRITE);
+		Model_Now += (unsigned int)(Host_Cycles - (unsigned int)Model_Now) + FLASHMODEL_ACCESS_CYCLES;
+		Host_Cycles = (unsigned int)Model_Now;
+		Model_Advance();
+		/* Step 2. Write 1 to clear registers read 0 for the one instruction */
+		Model_Access = MODEL_ACCESS_REGISTER;
+		Model_Offset = (unsigned int)(address - Host_Ftfc.page);
+		Model_OldFstat = FTFC->FSTAT;
+		Model_OldFcnfg = FTFC->FCNFG;
+		Model_OldFerstat = FTFC->FERSTAT;
+		if ((Model_IsWrite == 1U) && (address == (unsigned char *)&FTFC->FSTAT))
+		{
+			FTFC->FSTAT = 0U;
+		}
+		if ((Model_IsWrite == 1U) && (address == (unsigned char *)&FTFC->FERSTAT))
+		{
+			FTFC->FERSTAT = 0U;
+		}
+	}
+	else if ((Model_Flash != NULL) && (address >= Model_Flash) && (address < &Model_Flash[FTFC_DFLASH_SIZE])
+	         && (Model_IsWrite == 0U))
+	{
+		/* Step 1. Collision with the running command, or an ECC error */
+		Model_Access = MODEL_ACCESS_FLASH;
+		if (Model_Command != 0U)
+		{
+			Model_BusError(0U);
+		}
+		else if (Model_Shared->broken[(unsigned int)(address - Model_Flash) / FTFC_PHRASE_SIZE] == 1U)
+		{
+			Model_BusError(1U);
+		}
+		else
+		{
+			/*do not thing*/
+		}
+		Model_Protect(Model_Flash, FTFC_DFLASH_SIZE, PROT_READ);
+	}
+	else
+	{
+		/* A real fault, or a store to the flash */
+		fprintf(stderr, "FlashModel: segmentation fault at %p\n", (void *)address);
+		_exit(3);
+	}
+	/* Step 3. Run the one instruction */
+	uc->uc_mcontext.gregs[REG_EFL] |= MODEL_EFLAGS_TF;
+}
+
+static void Model_Step(int signal, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	unsigned char written;
+
+	(void)signal;
+	(void)info;
+	uc->uc_mcontext.gregs[REG_EFL] &= ~MODEL_EFLAGS_TF;
+	if (Model_Access == MODEL_ACCESS_FLASH)
+	{
+		Model_ProtectFlash();
+		return;
+	}
+	if ((Model_IsWrite == 1U) && (Model_Offset == 0U))
+	{
+		/* FSTAT: error flags clear, CCIF launches while idle and error free */
+		written = FTFC->FSTAT;
+		FTFC->FSTAT = (unsigned char)(Model_OldFstat & ~(written & MODEL_FSTAT_W1C));
+		if (((written & MODEL_CCIF) != 0U) && ((Model_OldFstat & MODEL_CCIF) != 0U)
+		    && ((FTFC->FSTAT & MODEL_FSTAT_ERRORS) == 0U))
+		{
+			Model_Launch();
+		}
+	}
+	else if ((Model_IsWrite == 1U) && (Model_Offset == (unsigned int)((unsigned char *)&FTFC->FERSTAT - Host_Ftfc.page)))
+	{
+		written = FTFC->FERSTAT;
+		FTFC->FERSTAT = (unsigned char)(Model_OldFerstat & ~written);
+	}
+	else if ((Model_IsWrite == 1U) && ((FTFC->FCNFG & ~Model_OldFcnfg & MODEL_ERSSUSP) != 0U))
+	{
+		Model_Suspend();
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	Model_ProtectFlash();
+	Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_NONE);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void FlashModel_Map(void)
+{
+	void *flash;
+	void *shared;
+
+	flash = mmap((void *)(unsigned long)FTFC_DFLASH_BASE, FTFC_DFLASH_SIZE, PROT_READ | PROT_WRITE,
+	             MAP_SHARED | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	shared = mmap(NULL, sizeof(Model_SharedType), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if ((flash != (void *)(unsigned long)FTFC_DFLASH_BASE) || (shared == MAP_FAILED))
+	{
+		perror("FlashModel: mmap");
+		exit(2);
+	}
+	Model_Flash = (unsigned char *)flash;
+	Model_Shared = (Model_SharedType *)shared;
+	memset(Model_Flash, 0xFF, FTFC_DFLASH_SIZE);
+	memset(Model_Shared, 0, sizeof(Model_SharedType));
+	FlashModel_Stats = &Model_Shared->stats;
+}
+
+void FlashModel_Detach(void)
+{
+	static unsigned char flash[FTFC_DFLASH_SIZE];
+	static Model_SharedType shared;
+
+	Model_Protect(Model_Flash, FTFC_DFLASH_SIZE, PROT_READ);
+	memcpy(flash, Model_Flash, FTFC_DFLASH_SIZE);
+	shared = *Model_Shared;
+	if (mmap(Model_Flash, FTFC_DFLASH_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0)
+	    != (void *)Model_Flash)
+	{
+		perror("FlashModel: mmap");
+		exit(2);
+	}
+	memcpy(Model_Flash, flash, FTFC_DFLASH_SIZE);
+	Model_Shared = &shared;
+	FlashModel_Stats = &Model_Shared->stats;
+	Model_ProtectFlash();
+}
+
+void FlashModel_Start(void (*irq)(void))
+{
+	struct sigaction action;
+
+	Model_Irq = irq;
+	Model_Now = Host_Cycles;
+	Model_Command = 0U;
+	Model_Suspending = 0U;
+	Model_Suspended = 0U;
+	FTFC->FSTAT = (unsigned char)MODEL_CCIF;
+
+	memset(&action, 0, sizeof(action));
+	action.sa_flags = SA_SIGINFO;
+	action.sa_sigaction = Model_Fault;
+	sigaction(SIGSEGV, &action, NULL);
+	action.sa_sigaction = Model_Step;
+	sigaction(SIGTRAP, &action, NULL);
+	Model_ProtectFlash();
+	Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_NONE);
+}
+
+void FlashModel_Run(unsigned int cycles)
+{
+	unsigned long long end = Model_Now + cycles;
+	unsigned char fcnfg;
+	unsigned char fstat;
+	unsigned int entries = 0U;
+
+	for (;;)
+	{
+		/* Step 1. Controller as of now */
+		Host_Cycles = (unsigned int)Model_Now;
+		Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_READ | PROT_WRITE);
+		Model_Advance();
+		Model_ProtectFlash();
+		fcnfg = FTFC->FCNFG;
+		fstat = FTFC->FSTAT;
+		Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_NONE);
+		/* Step 2. Level sensitive interrupt, taken as long as it is pending; its accesses take time */
+		if ((Model_Irq != NULL) && ((fcnfg & MODEL_CCIE) != 0U) && ((fstat & MODEL_CCIF) != 0U)
+		    && (Host_Primask == 0U))
+		{
+			entries++;
+			if (entries > MODEL_IRQ_STORM)
+			{
+				fprintf(stderr, "FlashModel: FTFC interrupt never cleared\n");
+				_exit(4);
+			}
+			Model_Irq();
+			Model_Now += (unsigned int)(Host_Cycles - (unsigned int)Model_Now);
+			continue;
+		}
+		/* Step 3. On to the next completion, or to the end */
+		if (Model_Now >= end)
+		{
+			break;
+		}
+		Model_Now = ((Model_Command != 0U) && (Model_End < end)) ? Model_End : end;
+		entries = 0U;
+	}
+}
+
+void FlashModel_PowerCut(void)
+{
+	unsigned long long ran;
+	unsigned int sector;
+	unsigned int phrase;
+	unsigned int first;
+	unsigned int mask;
+	unsigned int i;
+	unsigned int roll;
+
+	Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_READ | PROT_WRITE);
+	Model_Advance();
+	Model_Protect(Model_Flash, FTFC_DFLASH_SIZE, PROT_READ | PROT_WRITE);
+	/* Step 1. An erase, running or suspended: each phrase erased, unchanged or broken */
+	if ((Model_Command == FTFC_CMD_ERASE_SECTOR) || (Model_Suspended != 0U))
+	{
+		if (Model_Command == FTFC_CMD_ERASE_SECTOR)
+		{
+			ran = Model_Now - Model_Started;
+			sector = Model_Address / FTFC_DFLASH_SECTOR_SIZE;
+		}
+		else
+		{
+			ran = FLASHMODEL_ERASE_CYCLES - Model_Left;
+			sector = Model_Suspended - 1U;
+		}
+		first = sector * MODEL_PHRASES_PER_SECTOR;
+		Model_Shared->stats.erasesCut[sector]++;
+		for (phrase = first; phrase < first + MODEL_PHRASES_PER_SECTOR; phrase++)
+		{
+			roll = (unsigned int)rand() % FLASHMODEL_ERASE_CYCLES;
+			if (roll < ran)
+			{
+				memset(&Model_Flash[phrase * FTFC_PHRASE_SIZE], 0xFF, FTFC_PHRASE_SIZE);
+				if (Model_Shared->broken[phrase] == 1U)
+				{
+					Model_Shared->broken[phrase] = 0U;
+					Model_Shared->stats.brokenPhrases--;
+				}
+			}
+			else if ((roll - ran) < ((FLASHMODEL_ERASE_CYCLES - ran) / 2U))
+			{
+				/* Not reached yet */
+			}
+			else
+			{
+				for (i = 0U; i < FTFC_PHRASE_SIZE; i++)
+				{
+					Model_Flash[(phrase * FTFC_PHRASE_SIZE) + i] |= (unsigned char)rand();
+				}
+				Model_Break(phrase);
+			}
+		}
+		Model_Shared->stats.cuts++;
+	}
+	/* Step 2. A program: some of the bits, mostly with a broken ECC */
+	if (Model_Command == FTFC_CMD_PROGRAM_PHRASE)
+	{
+		for (i = 0U; i < FTFC_PHRASE_SIZE; i++)
+		{
+			mask = (unsigned int)rand();
+			Model_Flash[Model_Address + i] &= (unsigned char)(Model_Data[i] | mask);
+		}
+		if (((unsigned int)rand() % 4U) != 0U)
+		{
+			Model_Break(Model_Address / FTFC_PHRASE_SIZE);
+		}
+		Model_Shared->stats.cuts++;
+	}
+	Model_Command = 0U;
+	Model_Suspended = 0U;
+	Model_Protect(Model_Flash, FTFC_DFLASH_SIZE, PROT_READ);
+}
+
+void FlashModel_Stop(void)
+{
+	Model_Protect(&Host_Ftfc, sizeof(Host_Ftfc), PROT_READ | PROT_WRITE);
+	Model_Protect(Model_Flash, FTFC_DFLASH_SIZE, PROT_READ);
+	signal(SIGSEGV, SIG_DFL);
+	signal(SIGTRAP, SIG_DFL);
+}
+
+unsigned int FlashModel_BrokenPhrase(void)
+{
+	unsigned int phrase;
+
+	for (phrase = 0U; phrase < MODEL_PHRASE_COUNT; phrase++)
+	{
+		if (Model_Shared->broken[phrase] == 1U)
+		{
+			return FTFC_DFLASH_BASE + (phrase * FTFC_PHRASE_SIZE);
+		}
+	}
+	return 0U;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file    FlashModel.h
+ * @brief   Host model of the FTFC controller and the FlexNVM D-Flash
+ * @details The D-Flash is an anonymous shared mapping at FTFC_DFLASH_BASE, so
+ *          it outlives a forked process: a test forks one process per boot and
+ *          ends it with FlashModel_PowerCut(). The FTFC register page
+ *          (Host_Ftfc) is made inaccessible the way SpiModel.h does it for
+ *          LPSPI; every register access costs FLASHMODEL_ACCESS_CYCLES core
+ *          cycles and moves Host_Cycles on, so polling CCIF lets time pass.
+ *          Modelled:
+ *          - FSTAT and FERSTAT write 1 to clear; writing CCIF launches the
+ *            command in FCCOB: Program Phrase (0x07) or Erase Sector (0x09) of
+ *            D-Flash, anything else, misaligned or outside sets ACCERR,
+ *          - a program of a phrase that is not erased ANDs the data in, sets
+ *            MGSTAT0 and leaves an uncorrectable ECC error in the phrase,
+ *          - FCNFG ERSSUSP suspends a running erase; launching the erase of
+ *            the same sector again resumes it. A program into the suspended
+ *            sector sets ACCERR,
+ *          - a D-Flash read while a command runs, or of a phrase with an ECC
+ *            error, is a bus error: with FAULTMASK and CCR BFHFNMIGN set (see
+ *            NVIC_EnterFaultProbe()) it sets CFSR PRECISERR and, for an ECC
+ *            error, FERSTAT DFDIF; otherwise it is a BusFault: the process
+ *            prints "BusFault" and exits with FLASHMODEL_BUSFAULT_EXIT,
+ *          - a power cut during an erase leaves each phrase of the sector
+ *            erased, unchanged or broken (ECC error) in proportion to the
+ *            time the erase ran; one during a program leaves part of the bits
+ *            programmed, most often with an ECC error.
+ *          The command complete interrupt is only taken in FlashModel_Run(),
+ *          when CCIE and CCIF are set and Host_Primask is 0.
+ *          Times are the typical ones of the S32K1 data sheet; the suspend
+ *          latency is an assumption. Only for x86-64 Linux.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FLASHMODEL_H
+#define FLASHMODEL_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Ftfc.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define FLASHMODEL_CORE_HZ 					(48000000U)
+#define FLASHMODEL_PROGRAM_CYCLES 	(90U * (FLASHMODEL_CORE_HZ / 1000000U))      /* 90us */
+#define FLASHMODEL_ERASE_CYCLES 		(12000U * (FLASHMODEL_CORE_HZ / 1000000U))   /* 12ms */
+#define FLASHMODEL_SUSPEND_CYCLES 	(20U * (FLASHMODEL_CORE_HZ / 1000000U))      /* 20us */
+#define FLASHMODEL_ACCESS_CYCLES 		(4U)
+#define FLASHMODEL_SECTOR_COUNT 		(FTFC_DFLASH_SIZE / FTFC_DFLASH_SECTOR_SIZE)
+#define FLASHMODEL_BUSFAULT_EXIT 		(5)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef struct
+{
+	unsigned int erases[FLASHMODEL_SECTOR_COUNT];     /* Erases started, cut ones too */
+	unsigned int erasesCut[FLASHMODEL_SECTOR_COUNT];  /* Of them, cut by the power    */
+	unsigned int programs;                         /* Programs started                */
+	unsigned int suspends;                         /* Erases suspended                */
+	unsigned int cuts;                             /* Power cuts during a command     */
+	unsigned int brokenPhrases;                    /* Phrases left with an ECC error  */
+	unsigned int busErrors;                        /* Bus errors taken by a probe     */
+} FlashModel_StatsType;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Shared with the processes forked after FlashModel_Map() */
+extern FlashModel_StatsType *FlashModel_Stats;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Maps an erased D-Flash and clears the statistics. Once, before any fork.
+ */
+void FlashModel_Map(void);
+
+/**
+ * @brief Gives this process its own copy of the D-Flash and the statistics.
+ * @details For a forked process that must leave the flash as it found it.
+ */
+void FlashModel_Detach(void);
+
+/**
+ * @brief Starts trapping the FTFC registers with the controller idle (CCIF set).
+ * @param irq FTFC interrupt handler taken by FlashModel_Run(), or NULL.
+ */
+void FlashModel_Start(void (*irq)(void));
+
+/**
+ * @brief Lets cycles core cycles pass, taking the FTFC interrupt when it is pending.
+ */
+void FlashModel_Run(unsigned int cycles);
+
+/**
+ * @brief Cuts the power: breaks the running or suspended command, the process must end.
+ */
+void FlashModel_PowerCut(void);
+
+/**
+ * @brief Stops trapping, the registers stay as they are.
+ */
+void FlashModel_Stop(void);
+
+/**
+ * @brief Address of the first phrase with an ECC error, 0 if there is none.
+ */
+unsigned int FlashModel_BrokenPhrase(void);
+
+#endif
@@ -0,0 +1,250 @@
+/**
+ * @file    Ftfc_Test.c
+ * @brief   Host test of the FTFC command queue on the flash model
+ * @details Runs Ftfc.c on the flash model (see FlashModel.h) and checks
+ *          - ordering and timing: queued commands complete in order, one
+ *            callback each, back to back, and queuing returns in microseconds,
+ *          - error paths: bad parameters, a full queue, a program over written
+ *            data (MGSTAT0 and an ECC error read back), a read while busy,
+ *            a program into the sector whose erase is suspended (ACCERR),
+ *          - Ftfc_ProgramPhraseNow() during an erase: suspended, programmed,
+ *            relaunched, and the erase still completes once,
+ *          - Ftfc_ProgramPhraseNow() during a queued program: each of the two
+ *            gets its own status, the queued one in its callback.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include "Ftfc.h"
+#include "FlashModel.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define TEST_US 					(FLASHMODEL_CORE_HZ / 1000000U)
+#define TEST_SECTOR(n) 				(FTFC_DFLASH_BASE + ((n) * FTFC_DFLASH_SECTOR_SIZE))
+#define TEST_EVENTS 				(16U)
+/* Queuing a command: a few register accesses, no waiting */
+#define TEST_QUEUE_US 				(5U)
+/*==================================================================================================
+*                                    LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	unsigned int tag;
+	Ftfc_StatusType status;
+	unsigned int cycles;                 /* Host_Cycles at the callback */
+} Test_EventType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static Test_EventType Test_Events[TEST_EVENTS];
+static unsigned int Test_Count;
+static const unsigned char Test_Ones[FTFC_PHRASE_SIZE] = { 0x01U, 0x23U, 0x45U, 0x67U, 0x89U, 0xABU, 0xCDU, 0xEFU };
+static const unsigned char Test_Zeros[FTFC_PHRASE_SIZE] = { 0U };
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Test_Callback(Ftfc_StatusType status, void *arg)
+{
+	if (Test_Count < TEST_EVENTS)
+	{
+		Test_Events[Test_Count].tag = (unsigned int)(unsigned long)arg;
+		Test_Events[Test_Count].status = status;
+		Test_Events[Test_Count].cycles = Host_Cycles;
+	}
+	Test_Count++;
+}
+
+static void Test_Idle(void)
+{
+	unsigned int waited = 0U;
+
+	while ((Ftfc_IsBusy() == 1U) && (waited < 100U))
+	{
+		FlashModel_Run(1000U * TEST_US);
+		waited++;
+	}
+	HOST_CHECK(Ftfc_IsBusy() == 0U);
+}
+
+static unsigned int Test_Us(unsigned int cycles)
+{
+	return cycles / TEST_US;
+}
+
+static unsigned char Test_IsErased(unsigned int sector)
+{
+	unsigned char phrase[FTFC_PHRASE_SIZE];
+	unsigned int address;
+	unsigned int i;
+
+	for (address = TEST_SECTOR(sector); address < TEST_SECTOR(sector + 1U); address += FTFC_PHRASE_SIZE)
+	{
+		if (Ftfc_ReadPhrase(address, phrase) != FTFC_OK) return 0U;
+		for (i = 0U; i < FTFC_PHRASE_SIZE; i++)
+		{
+			if (phrase[i] != 0xFFU) return 0U;
+		}
+	}
+	return 1U;
+}
+
+/* Erase and three programs queued at once */
+static void Test_Order(void)
+{
+	unsigned char phrase[FTFC_PHRASE_SIZE];
+	unsigned int start;
+	unsigned int queued;
+	unsigned int i;
+
+	Test_Count = 0U;
+	start = Host_Cycles;
+	HOST_CHECK(Ftfc_EraseSector(TEST_SECTOR(1U), Test_Callback, (void *)0UL) == FTFC_OK);
+	queued = Host_Cycles - start;
+	for (i = 1U; i < FTFC_QUEUE_SIZE; i++)
+	{
+		HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(1U) + (i * FTFC_PHRASE_SIZE), Test_Ones, Test_Callback,
+		                              (void *)(unsigned long)i) == FTFC_OK);
+	}
+	HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(1U), Test_Ones, Test_Callback, NULL) == FTFC_ERROR_BUSY);
+	HOST_CHECK(Ftfc_IsBusy() == 1U);
+	Test_Idle();
+	printf("queue an erase: %u us; erase done after %u us, then programs after %u, %u, %u us\n",
+	       Test_Us(queued), Test_Us(Test_Events[0].cycles - start), Test_Us(Test_Events[1].cycles - Test_Events[0].cycles),
+	       Test_Us(Test_Events[2].cycles - Test_Events[1].cycles), Test_Us(Test_Events[3].cycles - Test_Events[2].cycles));
+	HOST_CHECK(Test_Us(queued) <= TEST_QUEUE_US);
+	HOST_CHECK(Test_Count == FTFC_QUEUE_SIZE);
+	for (i = 0U; i < FTFC_QUEUE_SIZE; i++)
+	{
+		HOST_CHECK(Test_Events[i].tag == i);
+		HOST_CHECK(Test_Events[i].status == FTFC_OK);
+	}
+	HOST_CHECK(Test_Events[0].cycles - start >= FLASHMODEL_ERASE_CYCLES);
+	HOST_CHECK(Test_Events[0].cycles - start <= FLASHMODEL_ERASE_CYCLES + (TEST_QUEUE_US * TEST_US));
+	for (i = 1U; i < FTFC_QUEUE_SIZE; i++)
+	{
+		HOST_CHECK(Test_Events[i].cycles - Test_Events[i - 1U].cycles >= FLASHMODEL_PROGRAM_CYCLES);
+		HOST_CHECK(Test_Events[i].cycles - Test_Events[i - 1U].cycles <= FLASHMODEL_PROGRAM_CYCLES + (TEST_QUEUE_US * TEST_US));
+	}
+	HOST_CHECK(Ftfc_ReadPhrase(TEST_SECTOR(1U) + FTFC_PHRASE_SIZE, phrase) == FTFC_OK);
+	HOST_CHECK(phrase[0] == Test_Ones[0]);
+	HOST_CHECK(phrase[7] == Test_Ones[7]);
+}
+
+static void Test_Errors(void)
+{
+	unsigned char phrase[FTFC_PHRASE_SIZE];
+
+	/* Step 1. Refused before queuing, no callback */
+	Test_Count = 0U;
+	HOST_CHECK(Ftfc_EraseSector(TEST_SECTOR(1U) + FTFC_PHRASE_SIZE, Test_Callback, NULL) == FTFC_ERROR_PARAM);
+	HOST_CHECK(Ftfc_EraseSector(FTFC_DFLASH_BASE + FTFC_DFLASH_SIZE, Test_Callback, NULL) == FTFC_ERROR_PARAM);
+	HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(1U) + 4U, Test_Ones, Test_Callback, NULL) == FTFC_ERROR_PARAM);
+	HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(1U), NULL, Test_Callback, NULL) == FTFC_ERROR_PARAM);
+	HOST_CHECK(Ftfc_ProgramPhraseNow(FTFC_DFLASH_BASE - FTFC_PHRASE_SIZE, Test_Ones) == FTFC_ERROR_PARAM);
+	HOST_CHECK(Ftfc_ReadPhrase(TEST_SECTOR(1U) + 1U, phrase) == FTFC_ERROR_PARAM);
+	HOST_CHECK(Test_Count == 0U);
+
+	/* Step 2. Program over written data: MGSTAT0, and the phrase reads back as an ECC error */
+	HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(1U) + FTFC_PHRASE_SIZE, Test_Zeros, Test_Callback, (void *)1UL) == FTFC_OK);
+	HOST_CHECK(Ftfc_ReadPhrase(TEST_SECTOR(1U), phrase) == FTFC_ERROR_BUSY);
+	/* The next command runs as usual */
+	HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(1U) + (8U * FTFC_PHRASE_SIZE), Test_Ones, Test_Callback, (void *)2UL) == FTFC_OK);
+	Test_Idle();
+	HOST_CHECK(Test_Count == 2U);
+	HOST_CHECK(Test_Events[0].status == FTFC_ERROR_VERIFY);
+	HOST_CHECK(Test_Events[1].status == FTFC_OK);
+	HOST_CHECK(Ftfc_ReadPhrase(TEST_SECTOR(1U) + FTFC_PHRASE_SIZE, phrase) == FTFC_ERROR_ECC);
+	HOST_CHECK(Ftfc_ReadPhrase(TEST_SECTOR(1U) + (8U * FTFC_PHRASE_SIZE), phrase) == FTFC_OK);
+	/* Both word loads of the phrase fault */
+	HOST_CHECK(FlashModel_Stats->busErrors == 2U);
+	printf("program over data: callback status %u, read back status %u\n", Test_Events[0].status, FTFC_ERROR_ECC);
+}
+
+/* The brownout handler during an erase */
+static void Test_Suspend(void)
+{
+	unsigned char phrase[FTFC_PHRASE_SIZE];
+	unsigned int start;
+	unsigned int now;
+	Ftfc_StatusType status;
+
+	Test_Count = 0U;
+	start = Host_Cycles;
+	HOST_CHECK(Ftfc_EraseSector(TEST_SECTOR(1U), Test_Callback, (void *)7UL) == FTFC_OK);
+	FlashModel_Run(3000U * TEST_US);
+	/* Step 1. Into another sector: suspend, program, relaunch */
+	now = Host_Cycles;
+	status = Ftfc_ProgramPhraseNow(TEST_SECTOR(2U), Test_Ones);
+	now = Host_Cycles - now;
+	HOST_CHECK(status == FTFC_OK);
+	HOST_CHECK(FlashModel_Stats->suspends == 1U);
+	HOST_CHECK(now <= FLASHMODEL_SUSPEND_CYCLES + FLASHMODEL_PROGRAM_CYCLES + (TEST_QUEUE_US * TEST_US));
+	/* Step 2. Into the sector being erased: ACCERR, the erase goes on */
+	FlashModel_Run(3000U * TEST_US);
+	HOST_CHECK(Ftfc_ProgramPhraseNow(TEST_SECTOR(1U), Test_Ones) == FTFC_ERROR_ACCESS);
+	HOST_CHECK(FlashModel_Stats->suspends == 2U);
+	Test_Idle();
+	printf("program during an erase: %u us; erase done once after %u us, %u suspends\n",
+	       Test_Us(now), Test_Us(Test_Events[0].cycles - start), FlashModel_Stats->suspends);
+	HOST_CHECK(Test_Count == 1U);
+	HOST_CHECK(Test_Events[0].tag == 7U);
+	HOST_CHECK(Test_Events[0].status == FTFC_OK);
+	HOST_CHECK(Test_Events[0].cycles - start >= FLASHMODEL_ERASE_CYCLES);
+	HOST_CHECK(Test_IsErased(1U) == 1U);
+	HOST_CHECK(Ftfc_ReadPhrase(TEST_SECTOR(2U), phrase) == FTFC_OK);
+	HOST_CHECK(phrase[3] == Test_Ones[3]);
+}
+
+/* The brownout handler during a queued program: no status goes to the wrong command */
+static void Test_Steal(void)
+{
+	Test_Count = 0U;
+	/* Step 1. The queued program fails, the urgent one succeeds */
+	HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(2U), Test_Zeros, Test_Callback, (void *)1UL) == FTFC_OK);
+	FlashModel_Run(10U * TEST_US);
+	HOST_CHECK(Ftfc_ProgramPhraseNow(TEST_SECTOR(2U) + FTFC_PHRASE_SIZE, Test_Ones) == FTFC_OK);
+	Test_Idle();
+	HOST_CHECK(Test_Count == 1U);
+	HOST_CHECK(Test_Events[0].status == FTFC_ERROR_VERIFY);
+	/* Step 2. The other way round */
+	HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(2U) + (2U * FTFC_PHRASE_SIZE), Test_Ones, Test_Callback, (void *)2UL) == FTFC_OK);
+	FlashModel_Run(10U * TEST_US);
+	HOST_CHECK(Ftfc_ProgramPhraseNow(TEST_SECTOR(2U) + FTFC_PHRASE_SIZE, Test_Zeros) == FTFC_ERROR_VERIFY);
+	Test_Idle();
+	HOST_CHECK(Test_Count == 2U);
+	HOST_CHECK(Test_Events[1].status == FTFC_OK);
+	/* Step 3. A failing queued program has completed, its interrupt still masked, when the
+	 * urgent program comes (phrase 2 is written already) */
+	HOST_CHECK(Ftfc_ProgramPhrase(TEST_SECTOR(2U) + (2U * FTFC_PHRASE_SIZE), Test_Ones, Test_Callback, (void *)3UL) == FTFC_OK);
+	Host_Primask = 1U;
+	FlashModel_Run(200U * TEST_US);
+	HOST_CHECK(Test_Count == 2U);
+	HOST_CHECK(Ftfc_ProgramPhraseNow(TEST_SECTOR(2U) + (3U * FTFC_PHRASE_SIZE), Test_Ones) == FTFC_OK);
+	Host_Primask = 0U;
+	Test_Idle();
+	printf("program during a queued program: callbacks %u, %u, %u (urgent ones %u, %u, %u)\n",
+	       Test_Events[0].status, Test_Events[1].status, Test_Events[2].status, FTFC_OK, FTFC_ERROR_VERIFY, FTFC_OK);
+	HOST_CHECK(Test_Count == 3U);
+	HOST_CHECK(Test_Events[2].status == FTFC_ERROR_VERIFY);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	Host_Reset();
+	FlashModel_Map();
+	FlashModel_Start(Ftfc_IrqHandler);
+	Test_Order();
+	Test_Errors();
+	Test_Suspend();
+	Test_Steal();
+	FlashModel_Stop();
+	return Host_Result("Ftfc_Test");
+}
@@ -0,0 +1,223 @@
+/**
+ * @file    GPIO_Test.c
+ * @brief   Host test of the inline pin access in GPIO.h, access by access
+ * @details The host GPIO page (Host_Gpio) is made inaccessible while a call
+ *          runs. Every register access faults, the test notes the register and
+ *          whether it is a read, lets the one instruction run and takes the
+ *          value written. It then plays the hardware: a PSOR/PCOR/PTOR write
+ *          sets, clears or toggles those bits of PDOR and the register reads 0
+ *          again. Each call must be exactly the accesses listed for it: one
+ *          write of the full mask to PSOR, PCOR or PTOR, one read of PDIR, and
+ *          never a read-modify-write of PDOR.
+ *          Only for x86-64 Linux, where the fault tells reads from writes.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "GPIO.h"
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "GPIO_Test needs x86-64 Linux: page fault error code and trap flag"
+#endif
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define TEST_EFLAGS_TF 				(0x100)
+#define TEST_FAULT_WRITE 			(0x2)
+#define TEST_ACCESS_MAX 			(8U)
+/*==================================================================================================
+*                                      LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	const volatile unsigned int *reg;
+	unsigned char isWrite;
+	unsigned int value;                  /* Written, or read */
+} Test_AccessType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static Test_AccessType Test_Access[TEST_ACCESS_MAX];
+static unsigned int Test_Count;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Test_Protect(int protection)
+{
+	if (mprotect(&Host_Gpio, sizeof(Host_Gpio), protection) != 0)
+	{
+		perror("GPIO_Test: mprotect");
+		exit(2);
+	}
+}
+
+static void Test_Fault(int signal, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	unsigned char *address = (unsigned char *)info->si_addr;
+
+	(void)signal;
+	if ((address < Host_Gpio.page) || (address >= &Host_Gpio.page[sizeof(Host_Gpio)])
+	 || (Test_Count == TEST_ACCESS_MAX))
+	{
+		fprintf(stderr, "GPIO_Test: segmentation fault at %p\n", (void *)address);
+		_exit(3);
+	}
+	Test_Protect(PROT_READ | PROT_WRITE);
+	Test_Access[Test_Count].reg = (const volatile unsigned int *)((unsigned long)address & ~3UL);
+	Test_Access[Test_Count].isWrite = ((uc->uc_mcontext.gregs[REG_ERR] & TEST_FAULT_WRITE) != 0) ? 1U : 0U;
+	Test_Access[Test_Count].value = *Test_Access[Test_Count].reg;
+	uc->uc_mcontext.gregs[REG_EFL] |= TEST_EFLAGS_TF;
+}
+
+static void Test_Step(int signal, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	Test_AccessType *access = &Test_Access[Test_Count];
+	GPIO_Type *gpio = &Host_Gpio.regs[((unsigned char *)access->reg - Host_Gpio.page) / sizeof(GPIO_Type)];
+
+	(void)signal;
+	(void)info;
+	uc->uc_mcontext.gregs[REG_EFL] &= ~TEST_EFLAGS_TF;
+	if (access->isWrite == 1U)
+	{
+		access->value = *access->reg;
+		/* Write 1 to act, the register itself reads 0 */
+		if (access->reg == &gpio->PSOR)
+		{
+			gpio->PDOR |= access->value;
+		}
+		else if (access->reg == &gpio->PCOR)
+		{
+			gpio->PDOR &= ~access->value;
+		}
+		else if (access->reg == &gpio->PTOR)
+		{
+			gpio->PDOR ^= access->value;
+		}
+		else
+		{
+			/*do not thing*/
+		}
+		gpio->PSOR = 0U;
+		gpio->PCOR = 0U;
+		gpio->PTOR = 0U;
+	}
+	Test_Count++;
+	Test_Protect(PROT_NONE);
+}
+
+static void Test_Trap(void)
+{
+	Test_Count = 0U;
+	Test_Protect(PROT_NONE);
+}
+
+static void Test_Release(void)
+{
+	Test_Protect(PROT_READ | PROT_WRITE);
+}
+
+/* The call made exactly one access, to reg, of that kind and value */
+static void Test_One(const volatile unsigned int *reg, unsigned char isWrite, unsigned int value)
+{
+	HOST_CHECK(Test_Count == 1U);
+	HOST_CHECK(Test_Access[0].reg == reg);
+	HOST_CHECK(Test_Access[0].isWrite == isWrite);
+	HOST_CHECK(Test_Access[0].value == value);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	struct sigaction action;
+	unsigned int value;
+	unsigned char level;
+
+	Host_Reset();
+	memset(&action, 0, sizeof(action));
+	action.sa_flags = SA_SIGINFO;
+	action.sa_sigaction = Test_Fault;
+	sigaction(SIGSEGV, &action, NULL);
+	action.sa_sigaction = Test_Step;
+	sigaction(SIGTRAP, &action, NULL);
+	GPIOB->PDOR = 0x00F0000FU;
+
+	/* Multi-pin calls: one write of the whole mask, PDOR changes only where the mask has a 1 */
+	Test_Trap();
+	GPIO_SetPins(GPIOB, 0x80000101U);
+	Test_Release();
+	Test_One(&GPIOB->PSOR, 1U, 0x80000101U);
+	HOST_CHECK(GPIOB->PDOR == 0x80F0010FU);
+
+	Test_Trap();
+	GPIO_ClearPins(GPIOB, 0x00300003U);
+	Test_Release();
+	Test_One(&GPIOB->PCOR, 1U, 0x00300003U);
+	HOST_CHECK(GPIOB->PDOR == 0x80C0010CU);
+
+	Test_Trap();
+	GPIO_TogglePins(GPIOB, 0xFFFF0000U);
+	Test_Release();
+	Test_One(&GPIOB->PTOR, 1U, 0xFFFF0000U);
+	HOST_CHECK(GPIOB->PDOR == 0x7F3F010CU);
+
+	/* Single pins: the same single write, pin 31 included */
+	Test_Trap();
+	GPIO_WriteToOutputPin(GPIOD, 31U, GPIO_HIGH_OUTPUT_PIN);
+	Test_Release();
+	Test_One(&GPIOD->PSOR, 1U, 0x80000000U);
+
+	Test_Trap();
+	GPIO_WriteToOutputPin(GPIOD, 31U, GPIO_LOW_OUTPUT_PIN);
+	Test_Release();
+	Test_One(&GPIOD->PCOR, 1U, 0x80000000U);
+	HOST_CHECK(GPIOD->PDOR == 0U);
+
+	Test_Trap();
+	GPIO_SetOutputPin(GPIOD, 0U);
+	Test_Release();
+	Test_One(&GPIOD->PSOR, 1U, 0x1U);
+
+	Test_Trap();
+	GPIO_ResetOutputPin(GPIOD, 0U);
+	Test_Release();
+	Test_One(&GPIOD->PCOR, 1U, 0x1U);
+
+	Test_Trap();
+	GPIO_TogglePin(GPIOD, 5U);
+	Test_Release();
+	Test_One(&GPIOD->PTOR, 1U, 0x20U);
+	HOST_CHECK(GPIOD->PDOR == 0x20U);
+
+	/* Reads: PDIR once, never PDOR */
+	*(volatile unsigned int *)&GPIOC->PDIR = 0x00003000U;
+	GPIOC->PDOR = 0xFFFFFFFFU;
+	Test_Trap();
+	value = GPIO_ReadPort(GPIOC);
+	Test_Release();
+	Test_One(&GPIOC->PDIR, 0U, 0x00003000U);
+	HOST_CHECK(value == 0x00003000U);
+
+	Test_Trap();
+	level = GPIO_ReadStateInputPin(GPIOC, 13U);
+	Test_Release();
+	Test_One(&GPIOC->PDIR, 0U, 0x00003000U);
+	HOST_CHECK(level == 1U);
+
+	signal(SIGSEGV, SIG_DFL);
+	signal(SIGTRAP, SIG_DFL);
+	return Host_Result("GPIO_Test");
+}
@@ -0,0 +1,118 @@
+/**
+ * @file    Host.c
+ * @brief   Host build support for the unit tests and models in Tests/
+ * @details Register copies, interrupt masks, Log_Write() and the check
+ *          helpers shared by every host test. See Host.h.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include "Log.h"
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static void Host_WfiReturn(void);
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+SCG_Type Host_Scg;
+PCC_Type Host_Pcc;
+volatile unsigned int Host_SmcPmstat;
+Host_FtfcPageType Host_Ftfc __attribute__((aligned(4096)));
+FTM_Type Host_Ftm[4];
+Host_GpioPageType Host_Gpio __attribute__((aligned(4096)));
+LMEM_Type Host_Lmem;
+Host_LpitPageType Host_Lpit __attribute__((aligned(4096)));
+Host_LpspiPageType Host_Lpspi __attribute__((aligned(4096)));
+LPUART_Type Host_Lpuart[3];
+NVIC_Type Host_Nvic;
+PMC_Type Host_Pmc;
+PORT_Type Host_Port[5];
+SYST_Type Host_Syst;
+volatile unsigned int Host_ScbAircr;
+volatile unsigned int Host_ScbShpr3;
+volatile unsigned int Host_ScbCcr;
+volatile unsigned int Host_ScbCfsr;
+volatile unsigned int Host_Demcr;
+volatile unsigned int Host_DwtCtrl;
+volatile unsigned int Host_Cycles;
+volatile unsigned int Host_BasePri;
+volatile unsigned int Host_Primask;
+volatile unsigned int Host_FaultMask;
+void (*Host_Wfi)(void) = Host_WfiReturn;
+unsigned int Host_LogCount[LOG_ID_NUMBER];
+unsigned int Host_LogArgs[LOG_ID_NUMBER][3];
+unsigned int Host_Failures;
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+/* A pending interrupt at once: no time passes */
+static void Host_WfiReturn(void)
+{
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Host_Reset(void)
+{
+	memset(&Host_Scg, 0, sizeof(Host_Scg));
+	memset(&Host_Pcc, 0, sizeof(Host_Pcc));
+	memset(&Host_Ftfc, 0, sizeof(Host_Ftfc));
+	memset(Host_Ftm, 0, sizeof(Host_Ftm));
+	memset(&Host_Gpio, 0, sizeof(Host_Gpio));
+	memset(&Host_Lmem, 0, sizeof(Host_Lmem));
+	memset(&Host_Lpit, 0, sizeof(Host_Lpit));
+	memset(&Host_Lpspi, 0, sizeof(Host_Lpspi));
+	memset(Host_Lpuart, 0, sizeof(Host_Lpuart));
+	memset(&Host_Nvic, 0, sizeof(Host_Nvic));
+	memset(&Host_Pmc, 0, sizeof(Host_Pmc));
+	memset(Host_Port, 0, sizeof(Host_Port));
+	memset(&Host_Syst, 0, sizeof(Host_Syst));
+	memset(Host_LogCount, 0, sizeof(Host_LogCount));
+	memset(Host_LogArgs, 0, sizeof(Host_LogArgs));
+	Host_SmcPmstat = 0U;
+	Host_ScbAircr = 0U;
+	Host_ScbShpr3 = 0U;
+	Host_ScbCcr = 0U;
+	Host_ScbCfsr = 0U;
+	Host_Demcr = 0U;
+	Host_DwtCtrl = 0U;
+	Host_Cycles = 0U;
+	Host_BasePri = 0U;
+	Host_Primask = 0U;
+	Host_FaultMask = 0U;
+	Host_Wfi = Host_WfiReturn;
+}
+
+void Log_Write(Log_IdType id, unsigned int count, unsigned int arg0, unsigned int arg1, unsigned int arg2)
+{
+	(void)count;
+	if ((unsigned int)id < LOG_ID_NUMBER)
+	{
+		Host_LogCount[id]++;
+		Host_LogArgs[id][0] = arg0;
+		Host_LogArgs[id][1] = arg1;
+		Host_LogArgs[id][2] = arg2;
+	}
+}
+
+void Host_Check(unsigned int passed, const char *condition, const char *file, int line)
+{
+	if (passed == 0U)
+	{
+		Host_Failures++;
+		printf("%s:%d: check failed: %s\n", file, line, condition);
+	}
+}
+
+int Host_Result(const char *name)
+{
+	printf("%s: %s (%u failed checks)\n", name, (Host_Failures == 0U) ? "PASS" : "FAIL", Host_Failures);
+	return (Host_Failures == 0U) ? 0 : 1;
+}
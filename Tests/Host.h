@@ -0,0 +1,200 @@
+/**
+ * @file    Host.h
+ * @brief   Host build support for the unit tests and models in Tests/
+ * @details Tools/hosttest.py compiles the portable firmware modules with the
+ *          PC's gcc, -DHOST_TEST and this file force-included (-include) in
+ *          front of every translation unit. It pulls in the register headers
+ *          first and points every peripheral base at a plain RAM copy
+ *          (Host_Scg, Host_Lpit, ...) defined in Host.c, so the drivers run
+ *          unchanged against registers the test fills in and checks.
+ *          BASEPRI, PRIMASK and FAULTMASK are the variables Host_BasePri,
+ *          Host_Primask and Host_FaultMask (see Nvic.h); the DWT cycle counter
+ *          is Host_Cycles, which only the test moves. WFI calls Host_Wfi, a
+ *          test sets it to let the sleep take time (Stats_Idle()).
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef HOST_H
+#define HOST_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Clock_Registers.h"
+#include "Ftfc_Register.h"
+#include "Ftm_Register.h"
+#include "GPIO_Register.h"
+#include "Lmem_Register.h"
+#include "Lpit_Register.h"
+#include "Lpspi_Register.h"
+#include "Lpuart_Register.h"
+#include "Nvic_Registers.h"
+#include "Pmc_Register.h"
+#include "Port_Register.h"
+#include "Systick_Register.h"
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+extern SCG_Type Host_Scg;
+extern PCC_Type Host_Pcc;
+extern volatile unsigned int Host_SmcPmstat;
+/* FTFC alone on a page, so a model can trap every access (Tests/FlashModel.c) */
+typedef union
+{
+	FTFC_Type regs;
+	unsigned char page[4096];
+} Host_FtfcPageType;
+extern Host_FtfcPageType Host_Ftfc;
+extern FTM_Type Host_Ftm[4];
+/* GPIO, LPIT and LPSPI alone on a page each, so a test or model can trap every
+   access (Tests/GPIO_Test.c, Tests/LpitModel.c, Tests/SpiModel.c) */
+typedef union
+{
+	GPIO_Type regs[5];
+	unsigned char page[4096];
+} Host_GpioPageType;
+extern Host_GpioPageType Host_Gpio;
+extern LMEM_Type Host_Lmem;
+typedef union
+{
+	LPIT_Type regs;
+	unsigned char page[4096];
+} Host_LpitPageType;
+extern Host_LpitPageType Host_Lpit;
+typedef union
+{
+	LPSPI_Type regs[3];
+	unsigned char page[4096];
+} Host_LpspiPageType;
+extern Host_LpspiPageType Host_Lpspi;
+extern LPUART_Type Host_Lpuart[3];
+extern NVIC_Type Host_Nvic;
+extern PMC_Type Host_Pmc;
+extern PORT_Type Host_Port[5];
+extern SYST_Type Host_Syst;
+extern volatile unsigned int Host_ScbAircr;
+extern volatile unsigned int Host_ScbShpr3;
+extern volatile unsigned int Host_ScbCcr;
+extern volatile unsigned int Host_ScbCfsr;
+extern volatile unsigned int Host_Demcr;
+extern volatile unsigned int Host_DwtCtrl;
+extern volatile unsigned int Host_Cycles;
+/* Interrupt masks: 0 = nothing masked, as after reset */
+extern volatile unsigned int Host_BasePri;
+extern volatile unsigned int Host_Primask;
+extern volatile unsigned int Host_FaultMask;
+/* Stands for WFI, returns at once unless a test sets it */
+extern void (*Host_Wfi)(void);
+/* LOGn() records by Log_IdType, and the arguments of the last one of each */
+extern unsigned int Host_LogCount[];
+extern unsigned int Host_LogArgs[][3];
+/* Failed HOST_CHECKs */
+extern unsigned int Host_Failures;
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#undef SCG
+#define SCG                 (&Host_Scg)
+#undef PCC
+#define PCC                 (&Host_Pcc)
+#undef SMC_PMSTAT
+#define SMC_PMSTAT          (Host_SmcPmstat)
+#undef FTFC
+#define FTFC                (&Host_Ftfc.regs)
+#undef FTM0
+#define FTM0                (&Host_Ftm[0])
+#undef FTM1
+#define FTM1                (&Host_Ftm[1])
+#undef FTM2
+#define FTM2                (&Host_Ftm[2])
+#undef FTM3
+#define FTM3                (&Host_Ftm[3])
+#undef GPIOA
+#define GPIOA               (&Host_Gpio.regs[0])
+#undef GPIOB
+#define GPIOB               (&Host_Gpio.regs[1])
+#undef GPIOC
+#define GPIOC               (&Host_Gpio.regs[2])
+#undef GPIOD
+#define GPIOD               (&Host_Gpio.regs[3])
+#undef GPIOE
+#define GPIOE               (&Host_Gpio.regs[4])
+#undef LMEM
+#define LMEM                (&Host_Lmem)
+#undef LPIT0
+#define LPIT0               (&Host_Lpit.regs)
+#undef LPSPI0
+#define LPSPI0              (&Host_Lpspi.regs[0])
+#undef LPSPI1
+#define LPSPI1              (&Host_Lpspi.regs[1])
+#undef LPSPI2
+#define LPSPI2              (&Host_Lpspi.regs[2])
+#undef LPUART0
+#define LPUART0             (&Host_Lpuart[0])
+#undef LPUART1
+#define LPUART1             (&Host_Lpuart[1])
+#undef LPUART2
+#define LPUART2             (&Host_Lpuart[2])
+#undef NVIC
+#define NVIC                (&Host_Nvic)
+#undef SCB_AIRCR
+#define SCB_AIRCR           (Host_ScbAircr)
+#undef SCB_SHPR3
+#define SCB_SHPR3           (Host_ScbShpr3)
+#undef SCB_CCR
+#define SCB_CCR             (Host_ScbCcr)
+#undef SCB_CFSR
+#define SCB_CFSR            (Host_ScbCfsr)
+#undef CoreDebug_DEMCR
+#define CoreDebug_DEMCR     (Host_Demcr)
+#undef DWT_CTRL
+#define DWT_CTRL            (Host_DwtCtrl)
+#undef DWT_CYCCNT
+#define DWT_CYCCNT          (Host_Cycles)
+#undef PMC
+#define PMC                 (&Host_Pmc)
+#undef PORTA
+#define PORTA               (&Host_Port[0])
+#undef PORTB
+#define PORTB               (&Host_Port[1])
+#undef PORTC
+#define PORTC               (&Host_Port[2])
+#undef PORTD
+#define PORTD               (&Host_Port[3])
+#undef PORTE
+#define PORTE               (&Host_Port[4])
+#undef PORTA_PCR
+#define PORTA_PCR           ((PORT_PCR_REG *)&Host_Port[0])
+#undef PORTB_PCR
+#define PORTB_PCR           ((PORT_PCR_REG *)&Host_Port[1])
+#undef PORTC_PCR
+#define PORTC_PCR           ((PORT_PCR_REG *)&Host_Port[2])
+#undef PORTD_PCR
+#define PORTD_PCR           ((PORT_PCR_REG *)&Host_Port[3])
+#undef PORTE_PCR
+#define PORTE_PCR           ((PORT_PCR_REG *)&Host_Port[4])
+#undef SYST
+#define SYST                (&Host_Syst)
+
+/* Counts a failure and prints where, the test goes on */
+#define HOST_CHECK(condition) 		Host_Check((condition) ? 1U : 0U, #condition, __FILE__, __LINE__)
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Clears every register copy and the interrupt masks.
+ */
+void Host_Reset(void);
+
+void Host_Check(unsigned int passed, const char *condition, const char *file, int line);
+
+/**
+ * @brief Prints the verdict of the test.
+ * @return Exit status for main(): 0 if every check passed, 1 otherwise.
+ */
+int Host_Result(const char *name);
+
+#endif
@@ -0,0 +1,230 @@
+/**
+ * @file    Journal_Test.c
+ * @brief   Host test of journal recovery across random power cuts
+ * @details Runs Journal.c and Ftfc.c on the flash model (see FlashModel.h).
+ *          Every boot is a forked process with fresh driver state on the
+ *          D-Flash the previous boots left: Journal_Init(), a check of the
+ *          record it recovered, appends back to back and a power cut at a
+ *          random time during them, sometimes right after a Journal_Snapshot().
+ *          Checked at every boot:
+ *          - no BusFault, although cuts leave phrases with ECC errors,
+ *          - the record recovered is the last one acknowledged, or the one in
+ *            flight at the cut; time never goes back,
+ *          - the erase count in a sector header never goes down.
+ *          At the end the erase counts of the headers are printed against the
+ *          erases the model counted: completed erases go evenly round the ring
+ *          and no header counts fewer. A raw load of a broken phrase, without
+ *          the probe, must take the BusFault.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "Journal.h"
+#include "FlashModel.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define TEST_BOOTS 					(300U)
+#define TEST_SEED 					(20241020U)
+#define TEST_APPENDS_MAX 			(40U)      /* Appends per boot, at most */
+#define TEST_STEP 					(FLASHMODEL_CORE_HZ / 100000U)   /* 10us between main loop passes */
+#define TEST_EPOCH 					(1700000000U)
+/*==================================================================================================
+*                                    LOCAL TYPES
+==================================================================================================*/
+/* Shared by the boots */
+typedef struct
+{
+	unsigned int epoch;                              /* Last epoch handed out       */
+	unsigned int acked;                              /* Last one confirmed written  */
+	unsigned int inFlight;                           /* Written when the power went */
+	unsigned int eraseCount[JOURNAL_SECTOR_COUNT];   /* Highest seen in the headers */
+	unsigned int snapshots;
+	unsigned int badReads;                           /* Journal_Stats.badPhrases    */
+} Test_SharedType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static Test_SharedType *Test_Shared;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Test_Record(Journal_RecordType *record, unsigned char type)
+{
+	Test_Shared->epoch += 1U + ((unsigned int)rand() % 60U);
+	record->epoch = Test_Shared->epoch;
+	record->type = type;
+	record->settings = JOURNAL_SETTING_DISPLAY_ON;
+}
+
+/* Header erase count of a sector, 0 if the header is not readable */
+static unsigned int Test_EraseCount(unsigned int sector)
+{
+	unsigned char header[FTFC_PHRASE_SIZE];
+
+	if (Ftfc_ReadPhrase(JOURNAL_BASE + (sector * FTFC_DFLASH_SECTOR_SIZE), header) != FTFC_OK) return 0U;
+	if ((header[0] & header[1] & header[2] & header[3]) == 0xFFU) return 0U;
+	return (unsigned int)header[4] | ((unsigned int)header[5] << 8);
+}
+
+/* One boot, from reset to the power cut */
+static void Test_Boot(void)
+{
+	Journal_RecordType record;
+	unsigned int appends;
+	unsigned int writes;
+	unsigned int pending;
+	unsigned int cut;
+	unsigned int count;
+	unsigned int sector;
+
+	Host_Reset();
+	FlashModel_Start(Ftfc_IrqHandler);
+	/* Step 1. Recover: the last acknowledged record or the one in flight, never older */
+	if (Journal_Init(&record) == 1U)
+	{
+		HOST_CHECK((record.epoch == Test_Shared->acked) || (record.epoch == Test_Shared->inFlight));
+		HOST_CHECK((int)(record.epoch - Test_Shared->acked) >= 0);
+		HOST_CHECK(record.crc != 0xFFFFU);
+	}
+	else
+	{
+		HOST_CHECK(Test_Shared->acked == 0U);
+	}
+	for (sector = 0U; sector < JOURNAL_SECTOR_COUNT; sector++)
+	{
+		count = Test_EraseCount(sector);
+		if (count != 0U)
+		{
+			HOST_CHECK(count >= Test_Shared->eraseCount[sector]);
+			Test_Shared->eraseCount[sector] = count;
+		}
+	}
+	Test_Shared->badReads += Journal_Stats.badPhrases;
+	/* Step 2. Appends back to back, the power goes at a random time: mostly during an erase
+	 * when the boot moves to the next sector, else during a program or after the last one */
+	appends = 1U + ((unsigned int)rand() % TEST_APPENDS_MAX);
+	cut = Host_Cycles + ((unsigned int)rand() % ((appends * 2U * FLASHMODEL_PROGRAM_CYCLES) + FLASHMODEL_ERASE_CYCLES));
+	writes = Journal_Stats.writes;
+	pending = 0U;
+	while ((int)(cut - Host_Cycles) > 0)
+	{
+		if ((pending == 0U) && (appends > 0U))
+		{
+			Test_Record(&record, JOURNAL_TYPE_PERIODIC);
+			Test_Shared->inFlight = record.epoch;
+			HOST_CHECK(Journal_Append(&record) == FTFC_OK);
+			pending = 1U;
+			appends--;
+		}
+		FlashModel_Run(((cut - Host_Cycles) < TEST_STEP) ? (cut - Host_Cycles) : TEST_STEP);
+		if (Journal_Stats.writes != writes)
+		{
+			writes = Journal_Stats.writes;
+			Test_Shared->acked = Test_Shared->inFlight;
+			pending = 0U;
+		}
+	}
+	HOST_CHECK(Journal_Stats.errors == 0U);
+	/* Step 3. Sometimes the low voltage warning comes first */
+	if (((unsigned int)rand() % 4U) == 0U)
+	{
+		Test_Record(&record, JOURNAL_TYPE_SNAPSHOT);
+		if (Journal_Snapshot(&record) == FTFC_OK)
+		{
+			Test_Shared->acked = record.epoch;
+			Test_Shared->snapshots++;
+		}
+	}
+	FlashModel_PowerCut();
+}
+
+static int Test_Fork(void (*boot)(void))
+{
+	int status;
+	pid_t pid;
+
+	fflush(stdout);
+	pid = fork();
+	if (pid == 0)
+	{
+		boot();
+		fflush(stdout);
+		_exit((Host_Failures == 0U) ? 0 : 1);
+	}
+	waitpid(pid, &status, 0);
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* What Journal_ReadPhrase() did before: a plain load */
+static void Test_RawRead(void)
+{
+	Host_Reset();
+	FlashModel_Start(Ftfc_IrqHandler);
+	(void)*(volatile unsigned int *)(unsigned long)FlashModel_BrokenPhrase();
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	unsigned int failed = 0U;
+	unsigned int boot;
+	unsigned int sector;
+	unsigned int completed;
+	unsigned int lowest = 0xFFFFFFFFU;
+	unsigned int highest = 0U;
+
+	FlashModel_Map();
+	Test_Shared = (Test_SharedType *)mmap(NULL, sizeof(Test_SharedType), PROT_READ | PROT_WRITE,
+	                                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	Test_Shared->epoch = TEST_EPOCH;
+
+	/* Step 1. Boots, each with its own random stream */
+	for (boot = 0U; boot < TEST_BOOTS; boot++)
+	{
+		srand(TEST_SEED + boot);
+		if (Test_Fork(Test_Boot) != 0)
+		{
+			printf("boot %u failed\n", boot);
+			failed++;
+		}
+	}
+	HOST_CHECK(failed == 0U);
+	printf("%u boots, %u power cuts during a command, %u snapshots, %u phrases broken now, "
+	       "%u bus errors taken by the probe, %u phrases read as broken\n",
+	       TEST_BOOTS, FlashModel_Stats->cuts, Test_Shared->snapshots, FlashModel_Stats->brokenPhrases,
+	       FlashModel_Stats->busErrors, Test_Shared->badReads);
+	HOST_CHECK(FlashModel_Stats->cuts != 0U);
+	HOST_CHECK(FlashModel_Stats->busErrors != 0U);
+
+	/* Step 2. Wear: completed erases go round the ring; a header never counts fewer, it takes
+	 * the highest known count + 1 after a cut erase left it unreadable */
+	for (sector = 0U; sector < JOURNAL_SECTOR_COUNT; sector++)
+	{
+		completed = FlashModel_Stats->erases[sector] - FlashModel_Stats->erasesCut[sector];
+		printf("sector %u: %3u erases, %3u of them cut, header erase count %3u\n", sector,
+		       FlashModel_Stats->erases[sector], FlashModel_Stats->erasesCut[sector], Test_Shared->eraseCount[sector]);
+		lowest = (completed < lowest) ? completed : lowest;
+		highest = (completed > highest) ? completed : highest;
+		HOST_CHECK(Test_Shared->eraseCount[sector] >= completed);
+	}
+	HOST_CHECK(lowest != 0U);
+	HOST_CHECK(highest - lowest <= 1U);
+
+	/* Step 3. Without the probe the same phrase is a BusFault */
+	if (FlashModel_BrokenPhrase() != 0U)
+	{
+		HOST_CHECK(Test_Fork(Test_RawRead) == FLASHMODEL_BUSFAULT_EXIT);
+	}
+	return Host_Result("Journal_Test");
+}
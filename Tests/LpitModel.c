@@ -0,0 +1,165 @@
+/**
+ * @file    LpitModel.c
+ * @brief   Host model of the LPIT counters, for code that reads CVAL
+ * @details A read or write of the protected page raises SIGSEGV. The handler
+ *          advances time for a CVAL read, refreshes every CVAL, opens the page
+ *          and sets the trap flag; after the single instruction SIGTRAP notes
+ *          channels that were just enabled and closes the page again.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "LpitModel.h"
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "LpitModel needs x86-64 Linux: trap flag"
+#endif
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define MODEL_EFLAGS_TF 			(0x100)
+#define MODEL_TCTRL_T_EN 			(1U<<LPIT_TMR_TCTRL_T_EN_SHIFT)
+#define MODEL_TCTRL_CHAIN 			(1U<<LPIT_TMR_TCTRL_CHAIN_SHIFT)
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static unsigned long long Model_StartAt[LPIT_TMR_COUNT];
+static unsigned char Model_Running[LPIT_TMR_COUNT];
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+volatile unsigned long long LpitModel_Now;
+volatile unsigned int LpitModel_TicksPerRead;
+unsigned int LpitModel_Reads;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Model_Protect(int protection)
+{
+	if (mprotect(&Host_Lpit, sizeof(Host_Lpit), protection) != 0)
+	{
+		perror("LpitModel: mprotect");
+		exit(2);
+	}
+}
+
+/* Decrements of each channel since it started, and CVAL from them */
+static void Model_Refresh(void)
+{
+	unsigned long long counted[LPIT_TMR_COUNT];
+	unsigned long long period;
+	unsigned int channel;
+
+	for (channel = 0U; channel < LPIT_TMR_COUNT; channel++)
+	{
+		period = (unsigned long long)LPIT0->TMR[channel].TVAL + 1ULL;
+		if (Model_Running[channel] == 0U)
+		{
+			counted[channel] = 0U;
+			continue;
+		}
+		if (((LPIT0->TMR[channel].TCTRL & MODEL_TCTRL_CHAIN) != 0U) && (channel > 0U))
+		{
+			/* Timeouts of the channel below */
+			counted[channel] = counted[channel - 1U] / ((unsigned long long)LPIT0->TMR[channel - 1U].TVAL + 1ULL);
+		}
+		else
+		{
+			counted[channel] = LpitModel_Now - Model_StartAt[channel];
+		}
+		LPIT0->TMR[channel].CVAL = (unsigned int)(period - 1ULL - (counted[channel] % period));
+	}
+}
+
+static void Model_Fault(int signal, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	unsigned char *address = (unsigned char *)info->si_addr;
+	unsigned int channel;
+
+	(void)signal;
+	if ((address < Host_Lpit.page) || (address >= &Host_Lpit.page[sizeof(Host_Lpit)]))
+	{
+		/* A real fault */
+		fprintf(stderr, "LpitModel: segmentation fault at %p\n", (void *)address);
+		_exit(3);
+	}
+	Model_Protect(PROT_READ | PROT_WRITE);
+	/* Step 1. Time passes with each counter read */
+	for (channel = 0U; channel < LPIT_TMR_COUNT; channel++)
+	{
+		if ((void *)address == (void *)&LPIT0->TMR[channel].CVAL)
+		{
+			LpitModel_Now += LpitModel_TicksPerRead;
+			LpitModel_Reads++;
+		}
+	}
+	/* Step 2. Counters as of now, then run the one instruction */
+	Model_Refresh();
+	uc->uc_mcontext.gregs[REG_EFL] |= MODEL_EFLAGS_TF;
+}
+
+static void Model_Step(int signal, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	unsigned int channel;
+	unsigned char running;
+
+	(void)signal;
+	(void)info;
+	uc->uc_mcontext.gregs[REG_EFL] &= ~MODEL_EFLAGS_TF;
+	for (channel = 0U; channel < LPIT_TMR_COUNT; channel++)
+	{
+		running = ((LPIT0->TMR[channel].TCTRL & MODEL_TCTRL_T_EN) != 0U) ? 1U : 0U;
+		if ((running == 1U) && (Model_Running[channel] == 0U))
+		{
+			Model_StartAt[channel] = LpitModel_Now;
+		}
+		Model_Running[channel] = running;
+	}
+	Model_Refresh();
+	Model_Protect(PROT_NONE);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void LpitModel_Start(void)
+{
+	struct sigaction action;
+	unsigned int channel;
+
+	LpitModel_Now = 0U;
+	LpitModel_Reads = 0U;
+	for (channel = 0U; channel < LPIT_TMR_COUNT; channel++)
+	{
+		Model_StartAt[channel] = 0U;
+		Model_Running[channel] = ((LPIT0->TMR[channel].TCTRL & MODEL_TCTRL_T_EN) != 0U) ? 1U : 0U;
+	}
+	Model_Refresh();
+
+	memset(&action, 0, sizeof(action));
+	action.sa_flags = SA_SIGINFO;
+	action.sa_sigaction = Model_Fault;
+	sigaction(SIGSEGV, &action, NULL);
+	action.sa_sigaction = Model_Step;
+	sigaction(SIGTRAP, &action, NULL);
+	Model_Protect(PROT_NONE);
+}
+
+void LpitModel_Stop(void)
+{
+	Model_Protect(PROT_READ | PROT_WRITE);
+	signal(SIGSEGV, SIG_DFL);
+	signal(SIGTRAP, SIG_DFL);
+}
@@ -0,0 +1,44 @@
+/**
+ * @file    LpitModel.h
+ * @brief   Host model of the LPIT counters, for code that reads CVAL
+ * @details The host register page of LPIT (Host_Lpit) is made inaccessible
+ *          while the model runs, the same way SpiModel.h does it for LPSPI.
+ *          Every access faults; a CVAL read first moves LpitModel_Now on by
+ *          LpitModel_TicksPerRead, then every CVAL is refreshed from it:
+ *          a running channel counts down from TVAL and reloads after TVAL + 1
+ *          clocks, a channel with TCTRL CHAIN counts the timeouts of the
+ *          channel below it instead. Setting TCTRL T_EN starts a channel at
+ *          the current time; TVAL is taken as fixed while a channel runs.
+ *          Time is in LPIT functional clocks. Only for x86-64 Linux.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LPITMODEL_H
+#define LPITMODEL_H
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* LPIT clocks since LpitModel_Start(); volatile, the driver reads move it */
+extern volatile unsigned long long LpitModel_Now;
+/* LPIT clocks that pass with each CVAL read */
+extern volatile unsigned int LpitModel_TicksPerRead;
+/* CVAL reads so far */
+extern unsigned int LpitModel_Reads;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Starts trapping at time 0. Channels already enabled start now.
+ */
+void LpitModel_Start(void);
+
+/**
+ * @brief Stops trapping, the registers stay as last refreshed.
+ */
+void LpitModel_Stop(void);
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file    Lpspi_Test.c
+ * @brief   Host model of the MAX7219 refresh bus time and of TX FIFO polling
+ * @details Runs MAX7219_Refresh() for one device on the LPSPI model (see
+ *          SpiModel.h) with the 1MHz SCK used before and the ~10MHz SCK with
+ *          DBT = 1 of Config_Spi1, and reads the bus time MAX7219_Stats keeps.
+ *          Then sends one long burst with Lpspi_TransmitBurst() and with the
+ *          former loop that waited for TDF before every word. At this SCK both
+ *          are bus bound: the bus time and the status reads come out the same,
+ *          the gain of the refresh is the faster SCK, not the FIFO loop.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include "MAX7219.h"
+#include "Stats.h"
+#include "SpiModel.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define TEST_CORE_HZ 				(48000000U)
+#define TEST_BURST 					(64U)
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Stats.c is target only (WFI), MAX7219.c just counts SPI words here */
+volatile Stats_CounterType Stats_Counter;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static unsigned int Test_Us(unsigned int cycles)
+{
+	return (unsigned int)(((unsigned long long)cycles * 1000000ULL + TEST_CORE_HZ / 2U) / TEST_CORE_HZ);
+}
+
+static void Test_Init(unsigned int speed, unsigned char dbt)
+{
+	Lpspi_ConfigType config = {0};
+
+	config.pSPIx = LPSPI1;
+	config.Init.F_lpspi = TEST_CORE_HZ;
+	config.Init.spi_speed = speed;
+	config.Init.spi_frame = LPSPI_FRAME_16;
+	config.Init.spi_pcs = LPSPI_PCS_3;
+	config.Init.spi_dbt = dbt;
+	Host_Reset();
+	Lpspi_Init(&config);
+	SpiModel_Start(LPSPI1, 1U, NULL, NULL);
+}
+
+/* Refresh time in core cycles; digit frame = PCSSCK + 16 bits + SCKPCS, then DBT + 2 */
+static unsigned int Test_Refresh(unsigned int speed, unsigned char dbt, unsigned int clocksPerBit)
+{
+	unsigned int expected = MAX7219_DIGITS * (1U + (16U * clocksPerBit) + 1U + dbt + 2U);
+	unsigned int cycles;
+
+	Test_Init(speed, dbt);
+	MAX7219_Refresh();
+	SpiModel_Stop();
+	cycles = MAX7219_Stats.lastBusCycles;
+	printf("refresh at %8u Hz SCK: %5u cycles = %3u us (shifting alone %5u cycles), %u status reads\n",
+	       TEST_CORE_HZ / clocksPerBit, cycles, Test_Us(cycles), expected, SpiModel_Stats.polls);
+	HOST_CHECK(SpiModel_Stats.overflows == 0U);
+	HOST_CHECK(SpiModel_Stats.words == MAX7219_DIGITS);
+	HOST_CHECK(cycles >= expected - dbt - 2U);
+	HOST_CHECK(cycles <= expected + (expected / 20U));
+	return cycles;
+}
+
+/* The transmit loop before the FIFO was filled per status read */
+static void Test_TransmitPerWord(LPSPI_Type *pLpspi, const unsigned short *pTxBuffer, unsigned short Size)
+{
+	while(Size > 0)
+	{
+		while((((pLpspi->SR)>>LPSPI_SR_TDF_SHIFT)&0x01)==0);
+		pLpspi->TDR = *pTxBuffer;
+		pTxBuffer+=1;
+		Size -= 1;
+	}
+}
+
+static unsigned int Test_Burst(unsigned char perWord)
+{
+	unsigned short words[TEST_BURST];
+	unsigned int i;
+	unsigned int start;
+	unsigned int cycles;
+
+	for (i = 0U; i < TEST_BURST; i++)
+	{
+		words[i] = (unsigned short)(0x0100U + i);
+	}
+	Test_Init(10000000U, 1U);
+	start = Host_Cycles;
+	if (perWord == 1U)
+	{
+		Test_TransmitPerWord(LPSPI1, words, TEST_BURST);
+	}
+	else
+	{
+		Lpspi_TransmitBurst(LPSPI1, words, TEST_BURST);
+	}
+	Lpspi_WaitIdle(LPSPI1);
+	SpiModel_Stop();
+	cycles = Host_Cycles - start;
+	printf("%u-word burst, %s: %u cycles, %u status reads\n", TEST_BURST,
+	       (perWord == 1U) ? "TDF per word    " : "FIFO per status ", cycles, SpiModel_Stats.polls);
+	HOST_CHECK(SpiModel_Stats.overflows == 0U);
+	HOST_CHECK(SpiModel_Stats.words == TEST_BURST);
+	/* One frame per word: PCSSCK + 16 bits * 5 clocks + SCKPCS, then DBT + 2 */
+	HOST_CHECK(cycles <= (TEST_BURST * (1U + 80U + 1U + 3U)) + (TEST_BURST * 5U));
+	return cycles;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	unsigned int before;
+	unsigned int after;
+
+	/* 48MHz / 1MHz = 48 clocks per bit; 48MHz / 10MHz rounds up to 5 (9.6MHz) */
+	before = Test_Refresh(1000000U, 0U, 48U);
+	after = Test_Refresh(10000000U, 1U, 5U);
+	HOST_CHECK(Test_Us(before) >= 125U);
+	HOST_CHECK(Test_Us(after) <= 16U);
+
+	before = Test_Burst(1U);
+	after = Test_Burst(0U);
+	/* Neither loop starves the shifter */
+	HOST_CHECK(after == before);
+	return Host_Result("Lpspi_Test");
+}
@@ -0,0 +1,121 @@
+/**
+ * @file    Lpuart_Test.c
+ * @brief   Host test of the LPUART TX queue and the receiver overrun clear
+ * @details The host LPUART copy keeps only the last DATA write and STAT as
+ *          written, so the test plays the transmitter: it sets STAT[TDRE] and
+ *          STAT[TC] when DATA may take a byte and runs Lpuart_TxIrqHandler()
+ *          the way LPUART1_RxTx_IRQHandler does, one byte per call.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include "Lpuart.h"
+#include "Nvic.h"
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define TEST_TDRE 				(1U << LPUART_STAT_TDRE_SHIFT)
+#define TEST_TC 					(1U << LPUART_STAT_TC_SHIFT)
+#define TEST_TIE 					(1U << LPUART_CTRL_TIE_SHIFT)
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static unsigned char Test_Data[LPUART_TX_QUEUE_SIZE + 3U];
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Test_Init(LPUART_Type *uart, unsigned char queued)
+{
+	Lpuart_ConfigType config = {0};
+
+	config.pUARTx = uart;
+	config.Init.lpuart_enable_int_TX = queued;
+	config.Init.lpuart_enable_int_RX = 1U;
+	config.Init.lpuart_baudrate_modulo_divisor = 250U;
+	config.Init.lpuart_oversampling = oversampling_ratio_10;
+	Lpuart_Init(&config);
+}
+
+/* One TX interrupt with DATA empty, returns the byte sent or -1 */
+static int Test_Irq(void)
+{
+	unsigned int space = Lpuart_GetTxSpace(LPUART1);
+
+	LPUART1->STAT |= TEST_TDRE;
+	Lpuart_TxIrqHandler(LPUART1);
+	return (Lpuart_GetTxSpace(LPUART1) == space + 1U) ? (int)(LPUART1->DATA & 0xFFU) : -1;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	unsigned int i;
+
+	Host_Reset();
+	NVIC_SetPriority(LPUART1_RxTx_IRQn, 9U);
+	Test_Init(LPUART1, 1U);
+	HOST_CHECK(Lpuart_GetTxSpace(LPUART1) == LPUART_TX_QUEUE_SIZE);
+	HOST_CHECK(Lpuart_GetTxSpace(LPUART0) == 0U);
+
+	/* Transmitter busy: queued, TIE set, the mask is back when Lpuart_Write() returns */
+	Lpuart_Write(LPUART1, (const unsigned char *)"AB", 2U);
+	HOST_CHECK(Lpuart_GetTxSpace(LPUART1) == LPUART_TX_QUEUE_SIZE - 2U);
+	HOST_CHECK((LPUART1->CTRL & TEST_TIE) != 0U);
+	HOST_CHECK(Host_BasePri == 0U);
+	/* One byte per TDRE, in order, TIE cleared once nothing is left */
+	HOST_CHECK(Test_Irq() == 'A');
+	HOST_CHECK(Test_Irq() == 'B');
+	HOST_CHECK(Test_Irq() == -1);
+	HOST_CHECK((LPUART1->CTRL & TEST_TIE) == 0U);
+
+	/* Transmitter idle: the first byte goes to DATA at once */
+	LPUART1->STAT = TEST_TDRE;
+	Lpuart_Write(LPUART1, (const unsigned char *)"C", 1U);
+	HOST_CHECK(LPUART1->DATA == 'C');
+	HOST_CHECK(Lpuart_GetTxSpace(LPUART1) == LPUART_TX_QUEUE_SIZE);
+	HOST_CHECK(Test_Irq() == -1);
+	HOST_CHECK((LPUART1->CTRL & TEST_TIE) == 0U);
+
+	/* Full queue written from the UART handler: the bytes that make room are sent by the writer */
+	for (i = 0U; i < sizeof(Test_Data); i++)
+	{
+		Test_Data[i] = (unsigned char)('a' + (i % 26U));
+	}
+	LPUART1->STAT = 0U;
+	for (i = 0U; i < LPUART_TX_QUEUE_SIZE; i += 128U)
+	{
+		Lpuart_Write(LPUART1, &Test_Data[i], 128U);
+	}
+	HOST_CHECK(Lpuart_GetTxSpace(LPUART1) == 0U);
+	/* TDRE stays set on the host copy: one byte per pass, the last pass sends one more */
+	LPUART1->STAT = TEST_TDRE;
+	Lpuart_Write(LPUART1, &Test_Data[LPUART_TX_QUEUE_SIZE], 3U);
+	HOST_CHECK(Lpuart_GetTxSpace(LPUART1) == 1U);
+	HOST_CHECK(LPUART1->DATA == Test_Data[3]);
+	HOST_CHECK(Host_BasePri == 0U);
+	/* Flush sends the rest, the last byte queued is the last one written */
+	LPUART1->STAT = TEST_TDRE | TEST_TC;
+	Lpuart_Flush(LPUART1);
+	HOST_CHECK(Lpuart_GetTxSpace(LPUART1) == LPUART_TX_QUEUE_SIZE);
+	HOST_CHECK(LPUART1->DATA == Test_Data[LPUART_TX_QUEUE_SIZE + 2U]);
+
+	/* An instance without queue is written directly */
+	LPUART0->STAT = TEST_TDRE;
+	Lpuart_Write(LPUART0, (const unsigned char *)"xyz", 3U);
+	HOST_CHECK(LPUART0->DATA == 'z');
+
+	/* Overrun: OR alone is written, IDLE and the MSBF control bit are left as they were */
+	LPUART1->STAT = (1U << LPUART_STAT_OR_SHIFT) | (1U << LPUART_STAT_IDLE_SHIFT) | TEST_TDRE | (1U << 29);
+	HOST_CHECK(Lpuart_ClearOverrun(LPUART1) == 1U);
+	HOST_CHECK(LPUART1->STAT == ((1U << LPUART_STAT_OR_SHIFT) | TEST_TDRE | (1U << 29)));
+	LPUART1->STAT = (1U << LPUART_STAT_IDLE_SHIFT);
+	HOST_CHECK(Lpuart_ClearOverrun(LPUART1) == 0U);
+	HOST_CHECK(LPUART1->STAT == (1U << LPUART_STAT_IDLE_SHIFT));
+	return Host_Result("Lpuart_Test");
+}
@@ -0,0 +1,185 @@
+/**
+ * @file    MAX7219_Test.c
+ * @brief   Host model of a MAX7219 chain on LPSPI1, routing and bus time
+ * @details Built with MAX7219_DEVICE_COUNT = 3. Words leaving LPSPI1 (see
+ *          SpiModel.h) enter the 16-bit shift register of device 0, whose old
+ *          content moves on to device 1, and so on; on the PCS rising edge
+ *          every device loads the word it holds. The digit registers of each
+ *          modeled device must end up equal to its framebuffer, which only
+ *          happens if frames are sent farthest device first. The bus time of
+ *          a refresh is the DWT count MAX7219_Refresh() keeps in MAX7219_Stats.
+ *          A message shown with MAX7219_ShowMessage() must survive Display_Time
+ *          until its SoftTimer hold runs out.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include "MAX7219.h"
+#include "Stats.h"
+#include "SpiModel.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define TEST_CORE_HZ 				(48000000U)
+#define TEST_REGISTERS 				(16U)
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static const Lpspi_ConfigType Test_Spi1 =
+{
+	.pSPIx = LPSPI1,
+	.Init =
+	{
+		.F_lpspi           = TEST_CORE_HZ,
+		.spi_speed         = 10000000,
+		.spi_frame         = LPSPI_FRAME_16,
+		.spi_pcs           = LPSPI_PCS_3,
+		.spi_dbt           = 1,
+	},
+};
+
+/* Per device: shift register and the 16 registers addressed by bits [11:8] */
+static unsigned short Chain_Shift[MAX7219_DEVICE_COUNT];
+static unsigned char Chain_Register[MAX7219_DEVICE_COUNT][TEST_REGISTERS];
+static unsigned int Chain_Loads;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Stats.c is target only (WFI), MAX7219.c just counts SPI words here */
+volatile Stats_CounterType Stats_Counter;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Chain_Word(unsigned int word)
+{
+	unsigned int device;
+
+	for (device = MAX7219_DEVICE_COUNT - 1U; device > 0U; device--)
+	{
+		Chain_Shift[device] = Chain_Shift[device - 1U];
+	}
+	Chain_Shift[0] = (unsigned short)word;
+}
+
+static void Chain_Load(void)
+{
+	unsigned int device;
+
+	for (device = 0U; device < MAX7219_DEVICE_COUNT; device++)
+	{
+		Chain_Register[device][(Chain_Shift[device] >> LED_REG_SHIFT) & 0x0FU] = (unsigned char)Chain_Shift[device];
+	}
+	Chain_Loads++;
+}
+
+static void Test_CheckDigits(void)
+{
+	unsigned int device;
+	unsigned int digit;
+
+	for (device = 0U; device < MAX7219_DEVICE_COUNT; device++)
+	{
+		for (digit = 0U; digit < MAX7219_DIGITS; digit++)
+		{
+			/* Digit 0 is register 1 */
+			HOST_CHECK(Chain_Register[device][digit + 1U] == MAX7219_FrameBuffer[device][digit]);
+		}
+	}
+}
+
+static unsigned int Test_Us(unsigned int cycles)
+{
+	return (unsigned int)(((unsigned long long)cycles * 1000000ULL + TEST_CORE_HZ / 2U) / TEST_CORE_HZ);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	unsigned int device;
+	unsigned int digit;
+	unsigned int clocks;
+
+	Host_Reset();
+	Lpspi_Init(&Test_Spi1);
+	SpiModel_Start(LPSPI1, 1U, Chain_Word, Chain_Load);
+
+	/* Step 1. Broadcast commands reach every device */
+	Init_MAX7219();
+	Control_Intensity(4095U);
+	/* The last frame is still on the bus */
+	Lpspi_WaitIdle(LPSPI1);
+	for (device = 0U; device < MAX7219_DEVICE_COUNT; device++)
+	{
+		HOST_CHECK(Chain_Register[device][0x0C] == (NORMAL_MODE & 0xFFU));
+		HOST_CHECK(Chain_Register[device][0x0F] == (NONE_DISPLAY_TEST & 0xFFU));
+		HOST_CHECK(Chain_Register[device][0x0B] == (SCAN_LIMIT_ALL_DIGITS & 0xFFU));
+		HOST_CHECK(Chain_Register[device][0x09] == (NO_DECODE_ALL_DIGITS & 0xFFU));
+		HOST_CHECK(Chain_Register[device][0x0A] == 14U);
+	}
+	HOST_CHECK(Chain_Loads == 5U);
+
+	/* Step 2. A distinct pattern per device and digit lands on that device only */
+	for (device = 0U; device < MAX7219_DEVICE_COUNT; device++)
+	{
+		for (digit = 0U; digit < MAX7219_DIGITS; digit++)
+		{
+			MAX7219_FrameBuffer[device][digit] = (unsigned char)((device << 4) | (digit + 1U));
+		}
+	}
+	MAX7219_Refresh();
+	Test_CheckDigits();
+	HOST_CHECK(Chain_Loads == 5U + MAX7219_DIGITS);
+
+	/* Step 3. Text on the middle device, the others keep their digits */
+	MAX7219_DisplayString(1U, "Err");
+	Test_CheckDigits();
+	HOST_CHECK(Chain_Register[1][8] == 0x4FU);
+	HOST_CHECK(Chain_Register[1][5] == 0x00U);
+	HOST_CHECK(Chain_Register[0][8] == 0x08U);
+	HOST_CHECK(Chain_Register[2][8] == 0x28U);
+
+	/* Step 4. Time on device 0 */
+	Display_Time(56U, 34U, 12U);
+	Test_CheckDigits();
+	HOST_CHECK(Chain_Register[0][8] == 0x30U);
+	HOST_CHECK(Chain_Register[0][1] == 0x5FU);
+
+	/* Step 5. A message holds device 0 against the LPIT path until it expires */
+	MAX7219_ShowMessage("Err", 3U);
+	HOST_CHECK(MAX7219_IsHeld() == 1U);
+	Display_Time(57U, 34U, 12U);
+	Lpspi_WaitIdle(LPSPI1);
+	HOST_CHECK(Chain_Register[0][8] == 0x4FU);
+	HOST_CHECK(Chain_Register[0][1] == 0x00U);
+	for (digit = 0U; digit < 3U; digit++)
+	{
+		SoftTimer_Tick();
+	}
+	HOST_CHECK(MAX7219_IsHeld() == 0U);
+	Display_Time(58U, 34U, 12U);
+	Lpspi_WaitIdle(LPSPI1);
+	HOST_CHECK(Chain_Register[0][8] == 0x30U);
+	HOST_CHECK(Chain_Register[0][1] == 0x7FU);
+
+	SpiModel_Stop();
+	HOST_CHECK(SpiModel_Stats.overflows == 0U);
+	HOST_CHECK(SpiModel_Stats.words == SpiModel_Stats.transfers * MAX7219_DEVICE_COUNT);
+	HOST_CHECK(MAX7219_Stats.refreshCount == 5U);
+	HOST_CHECK(MAX7219_Stats.frameCount == SpiModel_Stats.transfers);
+
+	/* Step 6. Bus time: per digit frame, PCSSCK + words * 16 bits * 5 clocks + SCKPCS, then DBT + 2 */
+	clocks = MAX7219_DIGITS * (1U + (MAX7219_DEVICE_COUNT * 16U * 5U) + 1U + 3U);
+	printf("refresh of %u devices: %u cycles (%u us), pure shifting %u cycles, %u FSR/SR polls in total\n",
+	       MAX7219_DEVICE_COUNT, MAX7219_Stats.lastBusCycles, Test_Us(MAX7219_Stats.lastBusCycles), clocks,
+	       SpiModel_Stats.polls);
+	HOST_CHECK(MAX7219_Stats.lastBusCycles >= clocks - 3U);
+	HOST_CHECK(MAX7219_Stats.lastBusCycles <= clocks + (clocks / 10U));
+	return Host_Result("MAX7219_Test");
+}
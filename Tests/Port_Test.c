@@ -0,0 +1,141 @@
+/**
+ * @file    Port_Test.c
+ * @brief   Host test and access count of Port_InitMulti() against Port_Init()
+ * @details The host PORT copy has no global registers behind it, so the test
+ *          plays the hardware: after each Port_InitMulti() call it takes every
+ *          GPCLR/GPCHR/GICLR/GICHR the driver wrote (each is written at most
+ *          once per call, and never with an empty mask), counts it and applies
+ *          it to the PCRs. The result must match Port_Init() run pin by pin on
+ *          a second copy, which costs one PCR read and one write per pin.
+ *          The board table below mirrors Config_PinTable in Config.c.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include "Port.h"
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static const Port_MultiConfigType Test_Board[] =
+{
+	{ PORTC,  (1u<<6)  | (1u<<7),                         PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_ALT2,     PORT_DMA_INT_DISABLED },
+	{ PORTB,  (1u<<14) | (1u<<15) | (1u<<16) | (1u<<17), PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_ALT3,     PORT_DMA_INT_DISABLED },
+	{ PORTC,  (1u<<12) | (1u<<13),                        PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_AS_GPIO,  PORT_INT_FALLING_EDGE },
+	{ PORTC,  (1u<<14),                                   PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_PIN_DISABLED, PORT_DMA_INT_DISABLED },
+	{ PORTD,  (1u<<0),                                    PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_AS_GPIO,  PORT_DMA_INT_DISABLED },
+	{ PORTC,  (1u<<0),                                    PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_ALT2,     PORT_DMA_INT_DISABLED },
+};
+
+/* Every setting field in use, pins in both halves of the port */
+static const Port_MultiConfigType Test_Mixed[] =
+{
+	{ PORTA,  0xFFFFFFFFu,                                PORT_PULL_UP,         PORT_HIGH_DRV_STRENGTH, PORT_MUX_ALT7,    PORT_INT_LOGIC_ONE    },
+	{ PORTA,  (1u<<3)  | (1u<<31),                        PORT_PULL_DOWN,       PORT_LOW_DRV_STRENGTH,  PORT_MUX_ALT4,    PORT_INT_EITHER_EDGE  },
+	{ PORTE,  (1u<<16),                                   PORT_NO_PULL_UP_DOWN, PORT_HIGH_DRV_STRENGTH, PORT_MUX_ALT5,    PORT_DMA_RISING_EDGE  },
+};
+
+static PORT_Type Test_Reference[5];
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+/* Global register write: [31:16] selects PCR[offset + n], [15:0] goes to the bits in keep */
+static unsigned int Test_Global(PORT_Type *port, volatile unsigned int *reg, unsigned int offset, unsigned int keep)
+{
+	unsigned int value = *reg;
+	unsigned int pin;
+
+	if (value == 0U)
+	{
+		return 0U;
+	}
+	for (pin = 0U; pin < PORT_PINS_PER_GPC_REG; pin++)
+	{
+		if (((value >> PORT_GPC_WE_SHIFT) >> pin) & 1U)
+		{
+			port->PCR[offset + pin] = (port->PCR[offset + pin] & keep)
+			                        | ((value & PORT_GPC_DATA_MASK) << ((keep == PORT_GPC_DATA_MASK) ? PORT_GPC_WE_SHIFT : 0U));
+		}
+	}
+	*reg = 0U;
+	return 1U;
+}
+
+/* The hardware side of one Port_InitMulti() call, returns the register writes */
+static unsigned int Test_Hardware(PORT_Type *port)
+{
+	unsigned int writes = 0U;
+
+	writes += Test_Global(port, &port->GPCLR, 0U, ~PORT_GPC_DATA_MASK);
+	writes += Test_Global(port, &port->GPCHR, PORT_PINS_PER_GPC_REG, ~PORT_GPC_DATA_MASK);
+	writes += Test_Global(port, &port->GICLR, 0U, PORT_GPC_DATA_MASK);
+	writes += Test_Global(port, &port->GICHR, PORT_PINS_PER_GPC_REG, PORT_GPC_DATA_MASK);
+	return writes;
+}
+
+/* Applies a table both ways, checks the PCRs agree and prints the access counts */
+static void Test_Table(const char *name, const Port_MultiConfigType *table, unsigned int count,
+                       unsigned int expectedWrites)
+{
+	Port_ConfigType pin;
+	unsigned int i;
+	unsigned int n;
+	unsigned int writes = 0U;
+	unsigned int pins = 0U;
+
+	Host_Reset();
+	memset(Test_Reference, 0, sizeof(Test_Reference));
+	for (i = 0U; i < count; i++)
+	{
+		HOST_CHECK(Port_InitMulti(&table[i]) == PORT_OK);
+		writes += Test_Hardware(table[i].base);
+
+		pin.base = &Test_Reference[table[i].base - Host_Port];
+		pin.pullConfig = table[i].pullConfig;
+		pin.driveSelect = table[i].driveSelect;
+		pin.mux = table[i].mux;
+		pin.intConfig = table[i].intConfig;
+		for (n = 0U; n < PORT_PCR_COUNT; n++)
+		{
+			if ((table[i].pinMask >> n) & 1U)
+			{
+				pin.pinPortIdx = n;
+				HOST_CHECK(Port_Init(&pin) == PORT_OK);
+				pins++;
+			}
+		}
+	}
+	for (i = 0U; i < 5U; i++)
+	{
+		for (n = 0U; n < PORT_PCR_COUNT; n++)
+		{
+			HOST_CHECK(Host_Port[i].PCR[n] == Test_Reference[i].PCR[n]);
+		}
+	}
+	HOST_CHECK(writes == expectedWrites);
+	printf("%-6s Port_Init: %2u pins, %2u PCR accesses   Port_InitMulti: %u groups, %2u writes\n",
+	       name, pins, 2U * pins, count, writes);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	Port_MultiConfigType config = Test_Board[0];
+
+	/* SPI1 spans PTB14..17, PTB16/17 are in the high half: 4 writes for that group */
+	Test_Table("board", Test_Board, sizeof(Test_Board) / sizeof(Test_Board[0]), 2U + 4U + 2U + 2U + 2U + 2U);
+	Test_Table("mixed", Test_Mixed, sizeof(Test_Mixed) / sizeof(Test_Mixed[0]), 4U + 4U + 2U);
+
+	config.pinMask = 0U;
+	HOST_CHECK(Port_InitMulti(&config) == PORT_ERR_PARA);
+	config.pinMask = 1U;
+	config.mux = (Port_mux_t)8;
+	HOST_CHECK(Port_InitMulti(&config) == PORT_ERR_PARA);
+	return Host_Result("Port_Test");
+}
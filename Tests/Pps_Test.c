@@ -0,0 +1,350 @@
+/**
+ * @file    Pps_Test.c
+ * @brief   Host model of the clock disciplined by a jittered PPS input
+ * @details Runs Pps.c, Sync.c and Tick.c unchanged in simulated time. The
+ *          board crystal gains ppm, so the LPIT counts f * (1 + ppm / 10^6);
+ *          the FTM runs from FIRC, off by TEST_FIRC_PPM. Events in true time:
+ *          - LPIT channel 3 timeouts, at the LPIT counts Tick_Update()
+ *            programmed; the handler runs up to TEST_TICK_LATENCY_US late and
+ *            does what LPIT0_Ch3_IRQHandler does for the clock: the edge from
+ *            Tick_EdgeTicks(), Tick_Update(), Sync_Second() every 4 ticks;
+ *          - PPS edges at every true second, gaussian jitter of jitter ns,
+ *            captured by FTM0 and handled up to TEST_PPS_LATENCY_US late.
+ *          Sync_Process() runs after every interrupt, as the main loop does.
+ *          Before each handler the LPIT and FTM counters are set to their
+ *          values at that time. The clock starts TEST_PHASE_US ahead.
+ *          Phases: lock, TEST_TRACK_S seconds locked (a glitch edge thrown in),
+ *          a holdover of holdover seconds during which the crystal moves by
+ *          wander ppb, then the PPS again until locked.
+ *          The error is the device time (Sync_Now()) at each true second.
+ *          Arguments, all optional: ppm jitter_ns holdover_s wander_ppb
+ *          (Tools/ppsmodel.py runs a sweep). Checked:
+ *          - Tick_EdgeTicks() is the exact timeout whatever the latency,
+ *          - locked within TEST_LOCK_MAX_S, then within TEST_TRACK_US,
+ *          - the frequency learnt is the crystal's within TEST_FREQ_PPB,
+ *          - after the holdover the error is within Sync_GetAccuracy(),
+ *          - locked again, one glitch dropped, no edge lost.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Pps.h"
+#include "Sync.h"
+#include "Tick.h"
+#include "Timestamp.h"
+#include "ProcessDateTime.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define VALID 						(1U<<SCG_FIRCCSR_FIRCVLD_SHIFT)
+#define DIV2(div) 					((unsigned int)(div)<<SCG_FIRCDIV_FIRCDIV2_SHIFT)
+#define PCC_ON(pcs) 				((1U<<PCC_CGC_SHIFT) | ((unsigned int)(pcs)<<PCC_PCS_SHIFT))
+#define CSR(scs) 					((unsigned int)(scs)<<SCG_CSR_SCS_SHIFT)
+#define TEST_NS 					(1000000000.0)
+#define TEST_UTC 					(1729382400U)     /* 2024-10-20 00:00:00 UTC */
+#define TEST_PHASE_US 				(312345.0)
+#define TEST_FIRC_PPM 				(2500.0)
+#define TEST_TICK_LATENCY_US 		(40U)
+#define TEST_PPS_LATENCY_US 		(60U)
+#define TEST_SEED 					(20241020U)
+#define TEST_LOCK_MAX_S 			(900U)
+#define TEST_TRACK_S 				(1800U)
+#define TEST_TRACK_US 				(5)
+#define TEST_FREQ_PPB 				(200)
+/* Defaults of the arguments */
+#define TEST_PPM 					(37)
+#define TEST_JITTER_NS 				(100)
+#define TEST_HOLDOVER_S 			(3600U)
+#define TEST_WANDER_PPB 			(50)
+/*==================================================================================================
+*                                    LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	double maxUs;                    /* Largest |error|                   */
+	double sumSquares;
+	unsigned int seconds;
+} Test_ErrorType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static unsigned int Test_Random = TEST_SEED;
+/* Crystal: LPIT counts rate1 per ns, rate2 from wanderAt on */
+static double Test_Rate1;
+static double Test_Rate2;
+static double Test_WanderAt = 1e30;
+/* Tick: LPIT count of the next timeout and of the last one, ticks in the second */
+static unsigned long long Test_NextTimeout;
+static unsigned long long Test_LastTimeout;
+static unsigned int Test_Quarter;
+static unsigned int Test_BadEdges;
+/* PPS: next edge, true second */
+static unsigned int Test_Second = 1U;
+static double Test_EdgeAt;
+static double Test_Now;
+static unsigned int Test_LockedAt;
+/* Error at the last second mark */
+static double Test_ErrorUs;
+static unsigned char Test_Marked;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Calendar of main.c */
+unsigned char second, minute, hour, day, month;
+unsigned short year;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+/* 0 to 1, xorshift32 */
+static double Test_Uniform(void)
+{
+	Test_Random ^= Test_Random << 13;
+	Test_Random ^= Test_Random >> 17;
+	Test_Random ^= Test_Random << 5;
+	return (double)Test_Random / 4294967296.0;
+}
+
+/* Gaussian of deviation 1, sum of 12 uniforms */
+static double Test_Gauss(void)
+{
+	double sum = 0.0;
+	unsigned int i;
+
+	for (i = 0U; i < 12U; i++)
+	{
+		sum += Test_Uniform();
+	}
+	return sum - 6.0;
+}
+
+/* LPIT counts at true time ns, and the true time of a count */
+static double Test_Counts(double ns)
+{
+	return (ns < Test_WanderAt) ? (ns * Test_Rate1)
+	                            : ((Test_WanderAt * Test_Rate1) + ((ns - Test_WanderAt) * Test_Rate2));
+}
+
+static double Test_TimeOf(unsigned long long counts)
+{
+	double wanderCounts = Test_WanderAt * Test_Rate1;
+
+	return ((double)counts < wanderCounts) ? ((double)counts / Test_Rate1)
+	                                       : (Test_WanderAt + (((double)counts - wanderCounts) / Test_Rate2));
+}
+
+/* LPIT timestamp and channel 3, FTM0 counter, as they read at true time ns */
+static unsigned long long Test_Hardware(double ns)
+{
+	unsigned long long counts = (unsigned long long)Test_Counts(ns);
+
+	LPIT0->TMR[TIMESTAMP_CHANNEL_LOW].CVAL = ~(unsigned int)counts;
+	LPIT0->TMR[TIMESTAMP_CHANNEL_HIGH].CVAL = ~(unsigned int)(counts >> 32);
+	LPIT0->TMR[TICK_CHANNEL].CVAL = LPIT0->TMR[TICK_CHANNEL].TVAL - (unsigned int)(counts - Test_LastTimeout);
+	FTM0->CNT = (unsigned int)(unsigned long long)(ns * 3e-3 * (1.0 + (TEST_FIRC_PPM * 1e-6))) & FTM_COUNTER_MAX;
+	return counts;
+}
+
+/* The clock part of LPIT0_Ch3_IRQHandler */
+static void Test_Tick(void)
+{
+	unsigned long long edge;
+
+	Test_LastTimeout = Test_NextTimeout;
+	(void)Test_Hardware(Test_Now + (Test_Uniform() * TEST_TICK_LATENCY_US * 1000.0));
+	edge = Tick_EdgeTicks();
+	if (edge != Test_LastTimeout)
+	{
+		Test_BadEdges++;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* The running tick is TVAL + 1 clocks, loaded at this timeout */
+	Test_NextTimeout = Test_LastTimeout + LPIT0->TMR[TICK_CHANNEL].TVAL + 1ULL;
+	Tick_Update();
+	Test_Quarter++;
+	if (Test_Quarter == 4U)
+	{
+		DateTime_Utc++;
+		Test_Quarter = 0U;
+		Sync_Second(DateTime_Utc, edge);
+		/* Device - true time at the start of the device second */
+		Test_ErrorUs = ((double)(DateTime_Utc - TEST_UTC) * 1e6)
+		             - ((Test_TimeOf(Test_LastTimeout) - (TEST_PHASE_US * 1000.0)) / 1000.0);
+		Test_Marked = 1U;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
+
+/* An edge at true time ns, captured, handled later */
+static void Test_Edge(double ns)
+{
+	unsigned int control = FTM0->CONTROLS[PPS_CHANNEL].CnSC;
+
+	(void)Test_Hardware(ns);
+	FTM0->CONTROLS[PPS_CHANNEL].CnV = FTM0->CNT;
+	FTM0->CONTROLS[PPS_CHANNEL].CnSC = control | (1U<<FTM_CnSC_CHF_SHIFT);
+	(void)Test_Hardware(ns + (Test_Uniform() * TEST_PPS_LATENCY_US * 1000.0));
+	Pps_IrqHandler();
+}
+
+/* True time of second s, UTC TEST_UTC + s */
+static double Test_SecondAt(unsigned int s)
+{
+	return (TEST_PHASE_US * 1000.0) + ((double)s * TEST_NS);
+}
+
+/* Runs to the start of true second until, with or without PPS. The error of every device
+   second goes to error if given; returns the first second from which it stayed within TEST_TRACK_US */
+static unsigned int Test_Run(unsigned int until, unsigned char pps, Test_ErrorType *error, int jitterNs)
+{
+	unsigned int within = Test_Second;
+	double tick;
+
+	while (Test_Second < until)
+	{
+		tick = Test_TimeOf(Test_NextTimeout);
+		if (tick < Test_EdgeAt)
+		{
+			Test_Now = tick;
+			Test_Tick();
+		}
+		else
+		{
+			Test_Now = Test_EdgeAt;
+			if (pps == 1U)
+			{
+				Test_Edge(Test_EdgeAt);
+			}
+			else
+			{
+				/*do not thing*/
+			}
+			Test_Second++;
+			Test_EdgeAt = Test_SecondAt(Test_Second) + (Test_Gauss() * (double)jitterNs);
+		}
+		if (Test_Marked == 1U)
+		{
+			Test_Marked = 0U;
+			if (fabs(Test_ErrorUs) > TEST_TRACK_US)
+			{
+				within = Test_Second + 1U;
+			}
+			else
+			{
+				/*do not thing*/
+			}
+			if (error != NULL)
+			{
+				error->maxUs = (fabs(Test_ErrorUs) > error->maxUs) ? fabs(Test_ErrorUs) : error->maxUs;
+				error->sumSquares += Test_ErrorUs * Test_ErrorUs;
+				error->seconds++;
+			}
+			else
+			{
+				/*do not thing*/
+			}
+		}
+		else
+		{
+			/*do not thing*/
+		}
+		/* Main loop */
+		(void)Sync_Process();
+		if ((Sync_Status.state == SYNC_STATE_LOCKED) && (Test_LockedAt == 0U))
+		{
+			Test_LockedAt = Test_Second;
+		}
+		else
+		{
+			/*do not thing*/
+		}
+	}
+	return within;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char *argv[])
+{
+	Ftm_CaptureConfigType config = { FTM0, FTM_PRESCALER_DIV_16, PPS_CHANNEL, FTM_EDGE_RISING, 4U, 1U, { 0U } };
+	Test_ErrorType track = { 0.0, 0.0, 0U };
+	int ppm = (argc > 1) ? atoi(argv[1]) : TEST_PPM;
+	int jitterNs = (argc > 2) ? atoi(argv[2]) : TEST_JITTER_NS;
+	unsigned int holdover = (argc > 3) ? (unsigned int)atoi(argv[3]) : TEST_HOLDOVER_S;
+	int wander = (argc > 4) ? atoi(argv[4]) : TEST_WANDER_PPB;
+	unsigned int settled;
+	unsigned int start;
+	int freq;
+	double err;
+
+	/* Step 1. FIRC 48MHz runs the core and the FTM, SOSC 8MHz / 8 the LPIT */
+	Host_Reset();
+	SCG->FIRCCSR = VALID;
+	SCG->CSR = CSR(FIRC_CLK);
+	SCG->SOSCCSR = VALID;
+	SCG->SOSCDIV = DIV2(SCG_CLOCK_DIV_BY_8);
+	PCC->PCCn[LPIT0_CLK] = PCC_ON(CLK_SRC_OP_1);
+	Lpit_Init();
+	Timestamp_Init();
+	Tick_Init();
+	Pps_Init(&config);
+	HOST_CHECK(Timestamp_TicksPerUs == 1U);
+	Test_Rate1 = (1.0 + (ppm * 1e-6)) * 1e-3;
+	Test_NextTimeout = LPIT0->TMR[TICK_CHANNEL].TVAL + 1ULL;
+	DateTime_SetUtc(TEST_UTC);
+
+	/* Step 2. Lock */
+	Test_EdgeAt = Test_SecondAt(Test_Second) + (Test_Gauss() * (double)jitterNs);
+	settled = Test_Run(TEST_LOCK_MAX_S, 1U, NULL, jitterNs);
+	HOST_CHECK(Test_LockedAt != 0U);
+	HOST_CHECK(settled < TEST_LOCK_MAX_S);
+
+	/* Step 3. Locked, with a glitch 0.2s after an edge */
+	start = Test_Second;
+	(void)Test_Run(start + 100U, 1U, &track, jitterNs);
+	Test_Edge(Test_SecondAt(Test_Second - 1U) + (0.2 * TEST_NS));
+	(void)Test_Run(start + TEST_TRACK_S, 1U, &track, jitterNs);
+	freq = Sync_Status.freqPpb;
+	printf("crystal %+d ppm, PPS jitter %d ns: locked after %u s, within %d us after %u s; "
+	       "then %u s within %.0f us (rms %.2f us), frequency %+d ppb\n", ppm, jitterNs, Test_LockedAt,
+	       TEST_TRACK_US, settled, track.seconds, track.maxUs, sqrt(track.sumSquares / track.seconds), freq);
+	HOST_CHECK(Sync_Status.state == SYNC_STATE_LOCKED);
+	HOST_CHECK(track.maxUs <= TEST_TRACK_US);
+	HOST_CHECK(abs(freq - (ppm * 1000)) <= TEST_FREQ_PPB);
+
+	/* Step 4. Holdover, the crystal moves */
+	Test_WanderAt = Test_SecondAt(Test_Second);
+	Test_Rate2 = Test_Rate1 + (wander * 1e-12);
+	start = Test_Second;
+	(void)Test_Run(start + holdover, 0U, NULL, jitterNs);
+	err = Test_ErrorUs;
+	printf("holdover %u s, crystal %+d ppb: %+.0f us, estimated accuracy %u us\n",
+	       holdover, wander, err, Sync_GetAccuracy());
+	HOST_CHECK(Sync_Status.state == SYNC_STATE_HOLDOVER);
+	HOST_CHECK(fabs(err) <= (double)Sync_GetAccuracy());
+
+	/* Step 5. The PPS is back */
+	start = Test_Second;
+	settled = Test_Run(start + TEST_LOCK_MAX_S, 1U, NULL, jitterNs);
+	printf("PPS back: within %d us after %u s, %u steps in all; %u edges, %u glitches, %u overruns\n",
+	       TEST_TRACK_US, settled - start, Sync_Status.steps, Pps_Stats.edges, Pps_Stats.glitches,
+	       Pps_Stats.overruns);
+	HOST_CHECK(settled < start + TEST_LOCK_MAX_S);
+	HOST_CHECK(Sync_Status.state == SYNC_STATE_LOCKED);
+	HOST_CHECK(Pps_Stats.glitches == 1U);
+	HOST_CHECK(Pps_Stats.overruns == 0U);
+	HOST_CHECK(Test_BadEdges == 0U);
+	return Host_Result("Pps_Test");
+}
@@ -0,0 +1,270 @@
+/**
+ * @file    SpiModel.c
+ * @brief   Host model of one LPSPI master: TX FIFO, shifter and bus timing
+ * @details A read or write of the protected page raises SIGSEGV. The handler
+ *          advances the shifter to Host_Cycles, refreshes FSR/SR, opens the
+ *          page and sets the trap flag; after the single instruction SIGTRAP
+ *          queues what was written to TCR/TDR and closes the page again.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "SpiModel.h"
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "SpiModel needs x86-64 Linux: page fault error code and trap flag"
+#endif
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define MODEL_CCR_PCSSCK_SHIFT 		(16U)
+#define MODEL_CCR_SCKPCS_SHIFT 		(24U)
+#define MODEL_FIELD_MASK 			(0xFFU)
+#define MODEL_TCR_PRESCALE_MASK 	(0x7U)
+#define MODEL_SR_MBF 				(1U<<LPSPI_SR_MBF_SHIFT)
+#define MODEL_SR_TDF 				(1U<<LPSPI_SR_TDF_SHIFT)
+#define MODEL_FCR_TXWATER_MASK 		(0x3U)
+#define MODEL_EFLAGS_TF 			(0x100)
+#define MODEL_FAULT_WRITE 			(0x2)
+/* Polls without the bus moving before the model calls it a hang */
+#define MODEL_HANG_POLLS 			(1000000U)
+/*==================================================================================================
+*                                    LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	unsigned int value;
+	unsigned char isCommand;
+	unsigned long long queued;           /* Core cycle it entered the FIFO */
+} Model_EntryType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static LPSPI_Type *Model_Spi;
+static unsigned int Model_CyclesPerClock;
+static SpiModel_WordType Model_OnWord;
+static SpiModel_EndType Model_OnEnd;
+static Model_EntryType Model_Fifo[LPSPI_TX_FIFO_SIZE];
+static unsigned int Model_Head;
+static unsigned int Model_Count;
+static unsigned long long Model_Now;
+static unsigned long long Model_FreeAt;      /* Shifter done with the current entry */
+static unsigned long long Model_AssertedAt;
+static unsigned char Model_Asserted;
+static unsigned int Model_Tcr;               /* Command in effect */
+static volatile unsigned int *Model_Access;  /* Register of the trapped instruction */
+static unsigned char Model_IsWrite;
+static unsigned int Model_IdlePolls;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+SpiModel_StatsType SpiModel_Stats;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+static void Model_Protect(int protection)
+{
+	if (mprotect(&Host_Lpspi, sizeof(Host_Lpspi), protection) != 0)
+	{
+		perror("SpiModel: mprotect");
+		exit(2);
+	}
+}
+
+/* Prescaled clocks to core cycles */
+static unsigned long long Model_Clocks(unsigned int clocks)
+{
+	return ((unsigned long long)clocks << ((Model_Tcr >> LPSPI_TCR_PRESCALE_SHIFT) & MODEL_TCR_PRESCALE_MASK))
+	       * Model_CyclesPerClock;
+}
+
+static unsigned int Model_Ccr(unsigned int shift)
+{
+	return (Model_Spi->CCR >> shift) & MODEL_FIELD_MASK;
+}
+
+static void Model_Negate(unsigned long long at)
+{
+	at += Model_Clocks(Model_Ccr(MODEL_CCR_SCKPCS_SHIFT) + 1U);
+	SpiModel_Stats.pcsCycles += at - Model_AssertedAt;
+	SpiModel_Stats.transfers++;
+	Model_Asserted = 0U;
+	Model_FreeAt = at + Model_Clocks(Model_Ccr(LPSPI_CCR_DBT_SHIFT) + 2U);
+	if (Model_OnEnd != NULL)
+	{
+		Model_OnEnd();
+	}
+}
+
+/* Runs the shifter up to Model_Now */
+static void Model_Advance(void)
+{
+	Model_EntryType entry;
+	unsigned long long at;
+	unsigned int bits;
+
+	while ((Model_Count != 0U) && (Model_FreeAt <= Model_Now))
+	{
+		entry = Model_Fifo[Model_Head];
+		Model_Head = (Model_Head + 1U) % LPSPI_TX_FIFO_SIZE;
+		Model_Count--;
+		at = (entry.queued > Model_FreeAt) ? entry.queued : Model_FreeAt;
+		if (entry.isCommand == 1U)
+		{
+			/* A command that does not continue the transfer ends it */
+			if ((Model_Asserted == 1U)
+			 && (((entry.value >> LPSPI_TCR_CONT_SHIFT) & 1U) == 0U || ((entry.value >> LPSPI_TCR_CONTC_SHIFT) & 1U) == 0U))
+			{
+				Model_Negate(at);
+			}
+			else
+			{
+				Model_FreeAt = at;
+			}
+			Model_Tcr = entry.value;
+			continue;
+		}
+		if (Model_Asserted == 0U)
+		{
+			Model_Asserted = 1U;
+			Model_AssertedAt = at;
+			at += Model_Clocks(Model_Ccr(MODEL_CCR_PCSSCK_SHIFT) + 1U);
+		}
+		bits = ((Model_Tcr >> LPSPI_TCR_FRAMESZ_SHIFT) & LPSPI_TCR_FRAMESZ_MASK) + 1U;
+		at += Model_Clocks(bits * (Model_Ccr(LPSPI_CCR_SCKDIV_SHIFT) + 2U));
+		Model_FreeAt = at;
+		SpiModel_Stats.words++;
+		if (Model_OnWord != NULL)
+		{
+			Model_OnWord((bits >= 32U) ? entry.value : (entry.value & ((1U << bits) - 1U)));
+		}
+		if (((Model_Tcr >> LPSPI_TCR_CONT_SHIFT) & 1U) == 0U)
+		{
+			Model_Negate(at);
+		}
+	}
+}
+
+static unsigned int Model_Busy(void)
+{
+	return ((Model_Count != 0U) || (Model_FreeAt > Model_Now) || (Model_Asserted == 1U)) ? 1U : 0U;
+}
+
+static void Model_Fault(int signal, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	unsigned char *address = (unsigned char *)info->si_addr;
+
+	(void)signal;
+	if ((address < Host_Lpspi.page) || (address >= &Host_Lpspi.page[sizeof(Host_Lpspi)]))
+	{
+		/* A real fault */
+		fprintf(stderr, "SpiModel: segmentation fault at %p\n", (void *)address);
+		_exit(3);
+	}
+	Model_Protect(PROT_READ | PROT_WRITE);
+	/* Step 1. The access takes bus time, the shifter runs meanwhile */
+	Model_Now += (unsigned int)(Host_Cycles - (unsigned int)Model_Now) + SPIMODEL_ACCESS_CYCLES;
+	Host_Cycles = (unsigned int)Model_Now;
+	SpiModel_Stats.accesses++;
+	Model_Advance();
+	/* Step 2. Status as of now for a read */
+	Model_Access = (volatile unsigned int *)((unsigned long)address & ~3UL);
+	Model_IsWrite = ((uc->uc_mcontext.gregs[REG_ERR] & MODEL_FAULT_WRITE) != 0) ? 1U : 0U;
+	if ((Model_Access == &Model_Spi->FSR) || (Model_Access == &Model_Spi->SR))
+	{
+		*(volatile unsigned int *)&Model_Spi->FSR = Model_Count;
+		Model_Spi->SR = ((Model_Busy() == 1U) ? MODEL_SR_MBF : 0U)
+		              | ((Model_Count <= ((Model_Spi->FCR >> LPSPI_FCR_TXWATER_SHIFT) & MODEL_FCR_TXWATER_MASK)) ? MODEL_SR_TDF : 0U);
+		SpiModel_Stats.polls++;
+		Model_IdlePolls++;
+		if (Model_IdlePolls > MODEL_HANG_POLLS)
+		{
+			fprintf(stderr, "SpiModel: driver polls a bus that never goes idle\n");
+			_exit(4);
+		}
+	}
+	/* Step 3. Run the one instruction */
+	uc->uc_mcontext.gregs[REG_EFL] |= MODEL_EFLAGS_TF;
+}
+
+static void Model_Step(int signal, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	unsigned char isData;
+
+	(void)signal;
+	(void)info;
+	uc->uc_mcontext.gregs[REG_EFL] &= ~MODEL_EFLAGS_TF;
+	isData = (Model_Access == &Model_Spi->TDR) ? 1U : 0U;
+	if ((Model_IsWrite == 1U) && ((isData == 1U) || (Model_Access == &Model_Spi->TCR)))
+	{
+		if (Model_Count == LPSPI_TX_FIFO_SIZE)
+		{
+			SpiModel_Stats.overflows++;
+		}
+		else
+		{
+			Model_Fifo[(Model_Head + Model_Count) % LPSPI_TX_FIFO_SIZE].value = *Model_Access;
+			Model_Fifo[(Model_Head + Model_Count) % LPSPI_TX_FIFO_SIZE].isCommand = (unsigned char)(1U - isData);
+			Model_Fifo[(Model_Head + Model_Count) % LPSPI_TX_FIFO_SIZE].queued = Model_Now;
+			Model_Count++;
+		}
+		Model_IdlePolls = 0U;
+	}
+	Model_Protect(PROT_NONE);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void SpiModel_Start(LPSPI_Type *spi, unsigned int cyclesPerClock, SpiModel_WordType onWord, SpiModel_EndType onEnd)
+{
+	struct sigaction action;
+
+	memset(&SpiModel_Stats, 0, sizeof(SpiModel_Stats));
+	Model_Spi = spi;
+	Model_CyclesPerClock = cyclesPerClock;
+	Model_OnWord = onWord;
+	Model_OnEnd = onEnd;
+	Model_Head = 0U;
+	Model_Count = 0U;
+	Model_Now = Host_Cycles;
+	Model_FreeAt = Model_Now;
+	Model_Asserted = 0U;
+	Model_Tcr = spi->TCR;
+	Model_IdlePolls = 0U;
+
+	memset(&action, 0, sizeof(action));
+	action.sa_flags = SA_SIGINFO;
+	action.sa_sigaction = Model_Fault;
+	sigaction(SIGSEGV, &action, NULL);
+	action.sa_sigaction = Model_Step;
+	sigaction(SIGTRAP, &action, NULL);
+	Model_Protect(PROT_NONE);
+}
+
+void SpiModel_Stop(void)
+{
+	Model_Protect(PROT_READ | PROT_WRITE);
+	Model_Now += (unsigned int)(Host_Cycles - (unsigned int)Model_Now);
+	Model_Advance();
+	while ((Model_Count != 0U) || (Model_FreeAt > Model_Now))
+	{
+		Model_Now = Model_FreeAt;
+		Model_Advance();
+	}
+	Host_Cycles = (unsigned int)Model_Now;
+	signal(SIGSEGV, SIG_DFL);
+	signal(SIGTRAP, SIG_DFL);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file    SpiModel.h
+ * @brief   Host model of one LPSPI master: TX FIFO, shifter and bus timing
+ * @details The host register page of LPSPI (Host_Lpspi) is made inaccessible
+ *          while the model runs. Every access of the unchanged driver faults,
+ *          the model brings the hardware up to the current time, lets the one
+ *          instruction run and takes what it wrote: TCR and TDR go through a
+ *          4-entry FIFO into the shifter, FSR and SR read back TXCOUNT, MBF
+ *          and TDF (TXCOUNT at or below FCR TXWATER).
+ *          Time is Host_Cycles (DWT_CYCCNT), in core cycles. Each register
+ *          access costs SPIMODEL_ACCESS_CYCLES; code between accesses is free.
+ *          Bus timing follows CCR and TCR: SCK = (SCKDIV + 2) prescaled clocks,
+ *          PCS to SCK = PCSSCK + 1, SCK to PCS = SCKPCS + 1, PCS high between
+ *          transfers = DBT + 2, and TCR CONT keeps PCS asserted across words.
+ *          Only for x86-64 Linux, where the fault tells reads from writes.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SPIMODEL_H
+#define SPIMODEL_H
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+/* Core cycles of one LPSPI register access through the peripheral bridge (assumed) */
+#define SPIMODEL_ACCESS_CYCLES 		(4U)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+/* Called with each word when its last bit is out, PCS asserted */
+typedef void (*SpiModel_WordType)(unsigned int word);
+/* Called when PCS is negated at the end of a transfer */
+typedef void (*SpiModel_EndType)(void);
+
+typedef struct
+{
+	unsigned int words;                  /* Data words shifted out                     */
+	unsigned int transfers;              /* PCS assert .. negate                       */
+	unsigned int polls;                  /* FSR and SR reads                           */
+	unsigned int accesses;               /* Every register access                      */
+	unsigned int overflows;              /* Writes to a full TX FIFO, lost             */
+	unsigned long long pcsCycles;        /* Core cycles with PCS asserted              */
+} SpiModel_StatsType;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+extern SpiModel_StatsType SpiModel_Stats;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Starts trapping. The driver must already have written CCR and TCR.
+ * @param spi           Modeled instance, one of LPSPI0..2.
+ * @param cyclesPerClock Core cycles per LPSPI functional clock.
+ */
+void SpiModel_Start(LPSPI_Type *spi, unsigned int cyclesPerClock, SpiModel_WordType onWord, SpiModel_EndType onEnd);
+
+/**
+ * @brief Runs the bus until the FIFO is empty and PCS is negated, then stops trapping.
+ */
+void SpiModel_Stop(void);
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file    Stats_Test.c
+ * @brief   Host test of the interrupt timing and the CPU load window
+ * @details Host_Cycles stands for DWT_CYCCNT and is moved by the test only.
+ *          Handlers are bracketed by hand, nested and across the 32-bit wrap
+ *          of the counter. For the load, each millisecond of a window is busy
+ *          for a known share of TEST_CYCLES_PER_MS and asleep in Stats_Idle()
+ *          for the rest (Host_Wfi lets that time pass), then SysTick runs
+ *          SoftTimer_Tick(). Stats_CpuLoad must be the busy share in 0.1%, as
+ *          GET STATS reports it.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include "Stats.h"
+#include "SoftTimer.h"
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define TEST_CYCLES_PER_MS 			(80000U)       /* 80MHz core */
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static unsigned int Test_SleepCycles;
+static unsigned int Test_SleepMasked;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+/* WFI: the next interrupt comes after the rest of the millisecond */
+static void Test_Wfi(void)
+{
+	Test_SleepMasked += Host_Primask;
+	Host_Cycles += Test_SleepCycles;
+}
+
+/* One window of STATS_WINDOW_MS, busy busyPerMs cycles of every millisecond */
+static void Test_Window(unsigned int busyPerMs)
+{
+	unsigned int ms;
+
+	Test_SleepCycles = TEST_CYCLES_PER_MS - busyPerMs;
+	for (ms = 0U; ms < STATS_WINDOW_MS; ms++)
+	{
+		Host_Cycles += busyPerMs;
+		Stats_Idle();
+		SoftTimer_Tick();
+	}
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	unsigned int outer;
+	unsigned int inner;
+	unsigned int start;
+
+	Host_Reset();
+	Stats_Reset();
+
+	/* Nested: the UART handler preempted by the LPIT tick, its duration includes the tick */
+	Host_Cycles = 1000U;
+	outer = Stats_IrqEnter(STATS_IRQ_UART);
+	Host_Cycles += 100U;
+	inner = Stats_IrqEnter(STATS_IRQ_LPIT);
+	Host_Cycles += 50U;
+	Stats_IrqExit(STATS_IRQ_LPIT, inner);
+	Host_Cycles += 150U;
+	Stats_IrqExit(STATS_IRQ_UART, outer);
+	HOST_CHECK((Stats_Irq[STATS_IRQ_LPIT].count == 1U) && (Stats_Irq[STATS_IRQ_LPIT].maxCycles == 50U));
+	HOST_CHECK(Stats_Irq[STATS_IRQ_LPIT].totalCycles == 50U);
+	HOST_CHECK((Stats_Irq[STATS_IRQ_UART].count == 1U) && (Stats_Irq[STATS_IRQ_UART].maxCycles == 300U));
+	HOST_CHECK(Stats_Irq[STATS_IRQ_UART].totalCycles == 300U);
+
+	/* Counter wrap inside a handler, then a shorter run: max kept, total summed */
+	Host_Cycles = 0xFFFFFF00U;
+	start = Stats_IrqEnter(STATS_IRQ_FTM0);
+	Host_Cycles += 0x200U;
+	Stats_IrqExit(STATS_IRQ_FTM0, start);
+	start = Stats_IrqEnter(STATS_IRQ_FTM0);
+	Host_Cycles += 0x80U;
+	Stats_IrqExit(STATS_IRQ_FTM0, start);
+	HOST_CHECK(Stats_Irq[STATS_IRQ_FTM0].count == 2U);
+	HOST_CHECK(Stats_Irq[STATS_IRQ_FTM0].maxCycles == 0x200U);
+	HOST_CHECK(Stats_Irq[STATS_IRQ_FTM0].totalCycles == 0x280U);
+
+	/* Load: the windows straddle the counter wrap (80M cycles each) */
+	Host_Wfi = Test_Wfi;
+	Host_Cycles = 0xFFFFFFFFU - (60U * 1000000U);
+	Stats_Init();
+	Test_Window(TEST_CYCLES_PER_MS / 4U);
+	printf("25.0%% busy: CPU LOAD x0.1%% %u\n", Stats_CpuLoad);
+	HOST_CHECK(Stats_CpuLoad == 250U);
+	Test_Window(30000U);
+	printf("37.5%% busy: CPU LOAD x0.1%% %u\n", Stats_CpuLoad);
+	HOST_CHECK(Stats_CpuLoad == 375U);
+	Test_Window(0U);
+	HOST_CHECK(Stats_CpuLoad == 0U);
+	Test_Window(TEST_CYCLES_PER_MS - 80U);
+	HOST_CHECK(Stats_CpuLoad == 999U);
+	/* The sleep is entered with PRIMASK set and left with it clear */
+	HOST_CHECK(Test_SleepMasked == 4U * STATS_WINDOW_MS);
+	HOST_CHECK(Host_Primask == 0U);
+
+	/* Reset clears every figure */
+	Stats_Counter.uartOverruns = 3U;
+	Stats_Reset();
+	HOST_CHECK((Stats_Irq[STATS_IRQ_UART].count == 0U) && (Stats_Irq[STATS_IRQ_FTM0].totalCycles == 0U));
+	HOST_CHECK(Stats_Counter.uartOverruns == 0U);
+	return Host_Result("Stats_Test");
+}
@@ -0,0 +1,165 @@
+/**
+ * @file    Tick_Test.c
+ * @brief   Host model of the calendar tick over a year
+ * @details The board crystal gains Test_Ppm[i] ppm, so the LPIT runs at
+ *          f * (1 + ppm / 10^6). Tick_Update() is stepped over a year of
+ *          250ms ticks, the length of each tick read back from channel 3 TVAL,
+ *          and the clocks counted are compared with the exact count of a year
+ *          at that frequency. Printed per ppm, in true time:
+ *          - the error after a year with Tick_SetCalibration(ppm), and the
+ *            largest distance of a tick edge from its ideal time on the way,
+ *          - the same without calibration, as the clock ran before.
+ *          Checked: calibrated, every edge within one LPIT clock of its ideal
+ *          time, so the error never accumulates; a discipline in ppb adds up
+ *          with the calibration; a phase shift moves the edges by its clocks.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include "Tick.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define VALID 						(1U<<SCG_FIRCCSR_FIRCVLD_SHIFT)
+#define DIV2(div) 					((unsigned int)(div)<<SCG_FIRCDIV_FIRCDIV2_SHIFT)
+#define PCC_ON(pcs) 				((1U<<PCC_CGC_SHIFT) | ((unsigned int)(pcs)<<PCC_PCS_SHIFT))
+#define TEST_TICKS_PER_YEAR 		(365U * 86400U * (1000000U / TICK_PERIOD_US))
+/* Exact counts are kept in 1/TEST_SCALE LPIT clock: clocks per tick are
+   f * TICK_PERIOD_US * (10^6 + ppm) / 10^12 = f * (10^6 + ppm) / TEST_SCALE */
+#define TEST_SCALE 					(1000000000000LL / TICK_PERIOD_US)
+/* 1MHz, 37ppm: 250009.25 clocks per tick, half of it more at most with a shift */
+#define TEST_TICK_37PPM 			(250009)
+#define TEST_SHIFTED_MAX 			(TEST_TICK_37PPM + 1 + (TEST_TICK_37PPM + 1) / 2)
+/*==================================================================================================
+*                                    LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	long long error;                 /* Last edge - ideal edge, 1/TEST_SCALE clock */
+	long long worst;                 /* Largest |error| on the way                 */
+} Test_DriftType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static const int Test_Ppm[] = { 0, 1, 37, -123, 500, -500 };
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+/* SOSC 8MHz, SOSCDIV2 clocks the LPIT */
+static unsigned int Test_Init(scg_async_clock_div_t div2)
+{
+	Host_Reset();
+	SCG->SOSCCSR = VALID;
+	SCG->SOSCDIV = DIV2(div2);
+	PCC->PCCn[LPIT0_CLK] = PCC_ON(CLK_SRC_OP_1);
+	Lpit_Init();
+	Tick_Init();
+	return Clock_GetFrequency(LPIT0_CLK);
+}
+
+/* Ticks on an LPIT gaining ppm, counted against the exact ticks of that clock */
+static Test_DriftType Test_Run(unsigned int frequency, int ppm, unsigned int ticks)
+{
+	Test_DriftType drift = { 0, 0 };
+	long long exact = (long long)frequency * (1000000LL + ppm);
+	long long clocks;
+	unsigned int i;
+
+	for (i = 0U; i < ticks; i++)
+	{
+		clocks = (long long)LPIT0->TMR[TICK_CHANNEL].TVAL + 1LL;
+		drift.error += (clocks * TEST_SCALE) - exact;
+		if (drift.error > drift.worst)
+		{
+			drift.worst = drift.error;
+		}
+		else if (-drift.error > drift.worst)
+		{
+			drift.worst = -drift.error;
+		}
+		else
+		{
+			/*do not thing*/
+		}
+		Tick_Update();
+	}
+	return drift;
+}
+
+/* 1/TEST_SCALE clocks of a clock gaining ppm in microseconds of true time */
+static double Test_Us(long long error, unsigned int frequency, int ppm)
+{
+	return ((double)error / (double)TEST_SCALE) * 1e6 / ((double)frequency * (1.0 + (ppm * 1e-6)));
+}
+
+static void Test_Year(scg_async_clock_div_t div2)
+{
+	Test_DriftType calibrated;
+	Test_DriftType free;
+	unsigned int frequency;
+	unsigned int i;
+
+	for (i = 0U; i < sizeof(Test_Ppm) / sizeof(Test_Ppm[0]); i++)
+	{
+		frequency = Test_Init(div2);
+		free = Test_Run(frequency, Test_Ppm[i], TEST_TICKS_PER_YEAR);
+		frequency = Test_Init(div2);
+		HOST_CHECK(Tick_SetCalibration(Test_Ppm[i]) == 1U);
+		Tick_Update();
+		calibrated = Test_Run(frequency, Test_Ppm[i], TEST_TICKS_PER_YEAR);
+		printf("%uMHz, crystal %+4d ppm: after a year %+.3f us, edges within %.3f us; "
+		       "uncalibrated %+8.1f s\n", frequency / 1000000U, Test_Ppm[i],
+		       Test_Us(calibrated.error, frequency, Test_Ppm[i]), Test_Us(calibrated.worst, frequency, Test_Ppm[i]),
+		       Test_Us(free.error, frequency, Test_Ppm[i]) / 1e6);
+		HOST_CHECK(calibrated.worst < TEST_SCALE);
+	}
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	Test_DriftType drift;
+	unsigned int frequency;
+	unsigned int i;
+	int clocks;
+	int extra;
+
+	/* Step 1. A year at 1MHz (the board) and 8MHz */
+	Test_Year(SCG_CLOCK_DIV_BY_8);
+	Test_Year(SCG_CLOCK_DIV_BY_1);
+
+	/* Step 2. Limits */
+	frequency = Test_Init(SCG_CLOCK_DIV_BY_8);
+	HOST_CHECK(Tick_SetCalibration(TICK_PPM_MAX + 1) == 0U);
+	HOST_CHECK(Tick_SetCalibration(-TICK_PPM_MAX - 1) == 0U);
+	HOST_CHECK(Tick_Ppm == TICK_PPM_DEFAULT);
+
+	/* Step 3. 37ppm as calibration -37000ppb + 74000ppb of discipline: 37ppm in all */
+	HOST_CHECK(Tick_SetCalibration(-37) == 1U);
+	Tick_SetDiscipline(74000);
+	Tick_Update();
+	drift = Test_Run(frequency, 37, 4U * 86400U);
+	printf("-37ppm calibration + 74000ppb discipline on a 37ppm crystal: %+.3f us after a day\n",
+	       Test_Us(drift.error, frequency, 37));
+	HOST_CHECK(drift.worst < TEST_SCALE);
+
+	/* Step 4. A shift of 300000 clocks comes in three ticks, at most half a tick each */
+	Tick_Shift(300000);
+	extra = 0;
+	for (i = 0U; i < 4U; i++)
+	{
+		Tick_Update();
+		clocks = (int)LPIT0->TMR[TICK_CHANNEL].TVAL + 1;
+		HOST_CHECK(clocks <= TEST_SHIFTED_MAX);
+		extra += clocks - TEST_TICK_37PPM;
+	}
+	printf("shift of 300000 clocks: %d clocks more in 4 ticks\n", extra);
+	HOST_CHECK((extra >= 300000 - 4) && (extra <= 300000 + 4));
+	return Host_Result("Tick_Test");
+}
@@ -0,0 +1,186 @@
+/**
+ * @file    TimeZone_Test.c
+ * @brief   Host test of the POSIX TZ rules against the tz database
+ * @details Runs TimeZone.c and ProcessDateTime.c for the zones of
+ *          Test_Zones, northern, southern, half-hour, no DST and rules with
+ *          negative and 24:00 times. For 2025 to 2036 it walks every
+ *          transition TimeZone_GetOffset() finds and samples a time of every
+ *          week, printing "offset <IANA name> <utc> <offset>" lines; the
+ *          checker in Tools/hosttest.py compares them with Python's zoneinfo.
+ *          Checked here:
+ *          - a zone string with a bad name, offset or rule is refused,
+ *          - TimeZone_LocalToUtc() gives back utc away from the repeated hour,
+ *            and the standard time reading in it,
+ *          - the first hours of 1970: no rule year before 1970 is evaluated,
+ *            the next transition found is a real one of 1970 and
+ *            DateTime_SetUtc() gives the calendar of utc + offset.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include "TimeZone.h"
+#include "ProcessDateTime.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define TEST_FROM 					(1735689600U)     /* 2025-01-01 00:00:00 UTC */
+#define TEST_TO 					(2114380800U)     /* 2037-01-01 00:00:00 UTC */
+#define TEST_1971 					(31536000U)       /* 1971-01-01 00:00:00 UTC */
+/* A week and a bit, so the samples go round the clock */
+#define TEST_STEP 					((7U * 86400U) + 3607U)
+#define TEST_ZONES 					(sizeof(Test_Zones) / sizeof(Test_Zones[0]))
+/*==================================================================================================
+*                                    LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	const char *name;                /* tz database name, for the checker */
+	const char *tz;
+} Test_ZoneType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static const Test_ZoneType Test_Zones[] =
+{
+	{ "Europe/Berlin",      "CET-1CEST,M3.5.0,M10.5.0/3" },
+	{ "America/New_York",   "EST5EDT,M3.2.0,M11.1.0" },
+	{ "America/Havana",     "CST5CDT,M3.2.0/0,M11.1.0/1" },
+	{ "America/Nuuk",       "<-02>2<-01>,M3.5.0/-1,M10.5.0/0" },
+	{ "America/Santiago",   "<-04>4<-03>,M9.1.6/24,M4.1.6/24" },
+	{ "Australia/Sydney",   "AEST-10AEDT,M10.1.0,M4.1.0/3" },
+	{ "Pacific/Auckland",   "NZST-12NZDT,M9.5.0,M4.1.0/3" },
+	{ "Asia/Kolkata",       "IST-5:30" },
+	{ "Asia/Tehran",        "<+0330>-3:30" },
+};
+
+static const char *const Test_Bad[] =
+{
+	"", "UT0", "CET", "CET-1CEST,M3.5.0", "CET-1CEST,M13.5.0,M10.5.0/3", "CET-1CEST,M3.6.0,M10.5.0",
+	"CET-1CEST,M3.5.7,M10.5.0", "CET-1CEST,J0,M10.5.0", "CET-1CEST,366,M10.5.0", "<+03-3", "CET-1:60",
+	"CET-1CEST,M3.5.0,M10.5.0/3x",
+};
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Calendar of main.c */
+unsigned char second, minute, hour, day, month;
+unsigned short year;
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+/* Transitions and daily samples of one zone, returns the transitions */
+static unsigned int Test_Walk(const Test_ZoneType *zone)
+{
+	unsigned int transitions = 0U;
+	unsigned int utc;
+	int offset;
+
+	/* Step 1. Each side of every transition */
+	utc = TEST_FROM;
+	TimeZone_Update(utc);
+	while (TimeZone_Next < TEST_TO)
+	{
+		utc = TimeZone_Next;
+		printf("offset %s %u %d\n", zone->name, utc - 1U, TimeZone_GetOffset(utc - 1U));
+		printf("offset %s %u %d\n", zone->name, utc, TimeZone_GetOffset(utc));
+		HOST_CHECK(TimeZone_Previous == utc);
+		transitions++;
+	}
+	/* Step 2. A time of every week; back to UTC unless in the repeated hour */
+	for (utc = TEST_FROM; utc < TEST_TO; utc += TEST_STEP)
+	{
+		offset = TimeZone_GetOffset(utc);
+		printf("offset %s %u %d\n", zone->name, utc, offset);
+		if ((TimeZone_GetOffset(utc - 3600U) == offset) && (TimeZone_GetOffset(utc + 3600U) == offset))
+		{
+			HOST_CHECK(TimeZone_LocalToUtc(utc + (unsigned int)offset) == utc);
+		}
+	}
+	return transitions;
+}
+
+/* The last hour of daylight time, repeated at the change back, reads as standard time */
+static void Test_Repeated(void)
+{
+	unsigned int change;
+
+	HOST_CHECK(TimeZone_Set("CET-1CEST,M3.5.0,M10.5.0/3") == 1U);
+	change = 1761440400U;                 /* 2025-10-26 01:00:00 UTC, 03:00 CEST -> 02:00 CET */
+	HOST_CHECK(TimeZone_GetOffset(change - 1U) == 7200);
+	HOST_CHECK(TimeZone_GetOffset(change) == 3600);
+	HOST_CHECK(TimeZone_LocalToUtc(change + 1800U + 3600U) == change + 1800U);
+}
+
+/* Before the fix the rules of 1969 were evaluated and DateTime_ToEpoch() wrapped */
+static void Test_1970(void)
+{
+	DateTime_Type local;
+	unsigned int i;
+	unsigned int utc;
+	unsigned int next;
+	int standard;
+	int offset;
+
+	for (i = 0U; i < TEST_ZONES; i++)
+	{
+		HOST_CHECK(TimeZone_Set(Test_Zones[i].tz) == 1U);
+		standard = TimeZone_Current;
+		/* Rules from 1970 on: standard time first, also south of the equator */
+		HOST_CHECK(TimeZone_GetOffset(0U) == standard);
+		for (utc = 0U; utc < 2U * (unsigned int)SECONDS_PER_DAY; utc += 1800U)
+		{
+			offset = TimeZone_GetOffset(utc);
+			HOST_CHECK(TimeZone_Previous <= utc);
+			HOST_CHECK(TimeZone_Next > utc);
+			next = TimeZone_Next;
+			HOST_CHECK((next < TEST_1971) || (next == TIMEZONE_NEVER));
+			/* West of UTC the local time is still in 1969 and wraps: not checked */
+			if ((offset >= 0) || (utc >= (unsigned int)(-offset)))
+			{
+				DateTime_SetUtc(utc);
+				DateTime_Get(&local);
+				HOST_CHECK(local.year == 1970U);
+				HOST_CHECK(DateTime_ToEpoch(&local) == utc + (unsigned int)offset);
+			}
+			/* A real transition, not a wrapped epoch of 1969 or 2107 */
+			if (next != TIMEZONE_NEVER)
+			{
+				HOST_CHECK(TimeZone_GetOffset(next - 1U) != TimeZone_GetOffset(next));
+			}
+		}
+	}
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	unsigned int i;
+	unsigned int transitions;
+
+	Host_Reset();
+	TimeZone_Init();
+	HOST_CHECK(TimeZone_GetOffset(TEST_FROM) == 0);
+	/* Step 1. Refused strings leave the zone as it was */
+	for (i = 0U; i < sizeof(Test_Bad) / sizeof(Test_Bad[0]); i++)
+	{
+		HOST_CHECK(TimeZone_Set(Test_Bad[i]) == 0U);
+	}
+	HOST_CHECK(TimeZone_GetOffset(TEST_FROM) == 0);
+	/* Step 2. Offsets for the checker */
+	for (i = 0U; i < TEST_ZONES; i++)
+	{
+		HOST_CHECK(TimeZone_Set(Test_Zones[i].tz) == 1U);
+		transitions = Test_Walk(&Test_Zones[i]);
+		printf("zone %s: %u transitions\n", Test_Zones[i].name, transitions);
+		HOST_CHECK((transitions == 24U) || (transitions == 0U));
+	}
+	Test_Repeated();
+	Test_1970();
+	return Host_Result("TimeZone_Test");
+}
@@ -0,0 +1,140 @@
+/**
+ * @file    Timestamp_Test.c
+ * @brief   Host test of the chained 64-bit LPIT timestamp
+ * @details Runs Timestamp_Init() and Timestamp_Now() on the LPIT model (see
+ *          LpitModel.h) and checks
+ *          - resolution: 1us at a 1MHz LPIT clock, 8MHz divided down to 1us,
+ *            and no timestamp at all from a clock that is no multiple of 1MHz,
+ *          - the high-low-high read: for every phase of a wrap of channel 0
+ *            between two of its reads the result is one of the times read,
+ *            where reading high then low once goes wrong by 2^32,
+ *          - the 2^64 wrap: unsigned differences stay right across it.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include <stdio.h>
+#include "Timestamp.h"
+#include "LpitModel.h"
+/*==================================================================================================
+*                                    LOCAL MACROS
+==================================================================================================*/
+#define VALID 						(1U<<SCG_FIRCCSR_FIRCVLD_SHIFT)
+#define DIV2(div) 					((unsigned int)(div)<<SCG_FIRCDIV_FIRCDIV2_SHIFT)
+#define PCC_ON(pcs) 				((1U<<PCC_CGC_SHIFT) | ((unsigned int)(pcs)<<PCC_PCS_SHIFT))
+#define TEST_WRAP 					(0x100000000ULL)
+/* Reads of Timestamp_NowTicks() with no wrap in between */
+#define TEST_READS 					(3U)
+/*==================================================================================================
+*                                    LOCAL FUNCTIONS
+==================================================================================================*/
+/* SOSC 8MHz, SOSCDIV2 clocks the LPIT */
+static void Test_Init(scg_async_clock_div_t div2)
+{
+	Host_Reset();
+	Timestamp_TicksPerUs = 0U;
+	SCG->SOSCCSR = VALID;
+	SCG->SOSCDIV = DIV2(div2);
+	PCC->PCCn[LPIT0_CLK] = PCC_ON(CLK_SRC_OP_1);
+	Lpit_Init();
+	Timestamp_Init();
+	LpitModel_Start();
+}
+
+/* What the driver did before the retry: one high read, one low read */
+static unsigned long long Test_NaiveTicks(void)
+{
+	unsigned int high = LPIT0->TMR[TIMESTAMP_CHANNEL_HIGH].CVAL;
+	unsigned int low = LPIT0->TMR[TIMESTAMP_CHANNEL_LOW].CVAL;
+
+	return ((unsigned long long)(~high) << 32) | (unsigned long long)(~low);
+}
+
+/* Every phase of a channel 0 wrap within a read sequence, returns the wrong results */
+static unsigned int Test_Wrap(unsigned long long base, unsigned int perRead, unsigned char naive)
+{
+	unsigned long long start;
+	unsigned long long ticks;
+	unsigned int wrong = 0U;
+
+	LpitModel_TicksPerRead = perRead;
+	for (start = base - (4U * perRead); start <= base + perRead; start++)
+	{
+		LpitModel_Now = start;
+		ticks = (naive == 1U) ? Test_NaiveTicks() : Timestamp_NowTicks();
+		/* Some instant between the first and the last read */
+		if ((ticks < start + perRead) || (ticks > LpitModel_Now))
+		{
+			wrong++;
+		}
+	}
+	return wrong;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+	unsigned long long before;
+	unsigned int perRead;
+	unsigned int wrong;
+	unsigned int naive;
+
+	/* Step 1. 1MHz: the tick count is the microsecond count */
+	Test_Init(SCG_CLOCK_DIV_BY_8);
+	HOST_CHECK(Timestamp_TicksPerUs == 1U);
+	HOST_CHECK((LPIT0->TMR[TIMESTAMP_CHANNEL_HIGH].TCTRL & (1U<<LPIT_TMR_TCTRL_CHAIN_SHIFT)) != 0U);
+	LpitModel_TicksPerRead = 0U;
+	HOST_CHECK(Timestamp_Now() == 0U);
+	LpitModel_Now = 1U;
+	HOST_CHECK(Timestamp_Now() == 1U);
+	LpitModel_Now = 123456789012ULL;
+	HOST_CHECK(Timestamp_Now() == 123456789012ULL);
+	LpitModel_TicksPerRead = 1U;
+	before = Timestamp_Now();
+	HOST_CHECK(Timestamp_Now() - before == TEST_READS);
+
+	/* Step 2. A channel 0 wrap between any two reads, from one clock per read up */
+	wrong = 0U;
+	naive = 0U;
+	for (perRead = 1U; perRead <= 8U; perRead++)
+	{
+		wrong += Test_Wrap(TEST_WRAP, perRead, 0U);
+		wrong += Test_Wrap(7U * TEST_WRAP, perRead, 0U);
+		naive += Test_Wrap(TEST_WRAP, perRead, 1U);
+	}
+	printf("wrap of the low word at every read phase: high-low-high %u wrong, high-low %u wrong\n", wrong, naive);
+	HOST_CHECK(wrong == 0U);
+	HOST_CHECK(naive != 0U);
+
+	/* Step 3. 2^64 wraps to 0, the difference across it is still the elapsed time */
+	LpitModel_TicksPerRead = 0U;
+	LpitModel_Now = 0xFFFFFFFFFFFFFFF0ULL;
+	before = Timestamp_Now();
+	HOST_CHECK(before == 0xFFFFFFFFFFFFFFF0ULL);
+	LpitModel_Now += 0x20U;
+	HOST_CHECK(Timestamp_Now() == 0x10U);
+	HOST_CHECK(Timestamp_Now() - before == 0x20U);
+	LpitModel_Stop();
+
+	/* Step 4. 8MHz: 8 clocks per microsecond, rounded down */
+	Test_Init(SCG_CLOCK_DIV_BY_1);
+	HOST_CHECK(Timestamp_TicksPerUs == 8U);
+	LpitModel_TicksPerRead = 0U;
+	LpitModel_Now = 8U * 1000000U + 7U;
+	HOST_CHECK(Timestamp_Now() == 1000000U);
+	LpitModel_Now += 1U;
+	HOST_CHECK(Timestamp_Now() == 1000001U);
+	LpitModel_Stop();
+
+	/* Step 5. 8MHz / 64 = 125kHz is not a whole number of clocks per microsecond */
+	Test_Init(SCG_CLOCK_DIV_BY_64);
+	HOST_CHECK(Timestamp_TicksPerUs == 0U);
+	HOST_CHECK((LPIT0->TMR[TIMESTAMP_CHANNEL_LOW].TCTRL & (1U<<LPIT_TMR_TCTRL_T_EN_SHIFT)) == 0U);
+	LpitModel_Stop();
+	return Host_Result("Timestamp_Test");
+}
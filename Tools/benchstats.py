@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Interrupt timing of two or more firmware builds from their GET STATS reports.
+
+Usage: benchstats.py capture PORT [seconds] > build.txt
+       benchstats.py compare BASE.txt OTHER.txt [...]
+
+capture waits seconds (default 60) so the counters cover that much running
+time after boot, sends "GET STATS" over UART1 and prints the report. Flash
+each build (e.g. CODE_RAM_ENABLE=0 and 1, LMEM_CACHE_ENABLE=0 and 1), reset
+the board, and capture it to its own file the same way: same display mode, no
+buttons pressed, so the interrupt paths match.
+
+compare prints, per interrupt, count, max and average cycles of every report,
+and the change of max and average against the first one, with the CODE RAM
+and CODE CACHE flags each report gives. Reports with no interrupt lines are
+refused. Exit status is 1 when a report cannot be used.
+"""
+import os
+import select
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from timesync import open_port  # noqa: E402
+
+REPLY_TIMEOUT = 2.0
+# Names in Stats_IrqNames (Utilities/src/Stats.c)
+IRQ_NAMES = ["LPIT", "UART", "PORTC", "ADC", "SYSTICK", "LVD_LVW", "FTFC", "FTM0"]
+# Report lines that tell the builds apart
+BUILD_FLAGS = ["CODE RAM", "CODE CACHE"]
+
+
+def capture(path, seconds):
+    fd = open_port(path)
+    try:
+        time.sleep(seconds)
+        os.write(fd, b"GET STATS")
+        data = b""
+        while select.select([fd], [], [], REPLY_TIMEOUT)[0]:
+            data += os.read(fd, 256)
+    finally:
+        os.close(fd)
+    sys.stdout.write(data.decode(errors="replace"))
+    return 0 if data else 1
+
+
+def parse(path):
+    """Returns ({build flag: 0/1}, {irq: (count, max, avg)})."""
+    flags = {}
+    irqs = {}
+    with open(path) as report:
+        for line in report:
+            fields = line.split()
+            if len(fields) == 3 and " ".join(fields[:2]) in BUILD_FLAGS:
+                flags[" ".join(fields[:2])] = int(fields[2])
+            elif len(fields) == 4 and fields[0] in IRQ_NAMES:
+                irqs[fields[0]] = tuple(int(value) for value in fields[1:])
+    return flags, irqs
+
+
+def change(value, base):
+    return "%+6.1f%%" % (100.0 * (value - base) / base) if base else "      -"
+
+
+def compare(paths):
+    reports = []
+    for path in paths:
+        flags, irqs = parse(path)
+        if not irqs:
+            print("%s: no IRQ COUNT MAX AVG lines, not a GET STATS report" % path)
+            return 1
+        reports.append((os.path.basename(path), flags, irqs))
+    for name, flags, _ in reports:
+        print("%-24s %s" % (name, "  ".join("%s %s" % (flag, flags.get(flag, "?")) for flag in BUILD_FLAGS)))
+    print()
+    print("%-8s %-24s %10s %8s %8s %8s %8s" % ("irq", "build", "count", "max", "avg", "max chg", "avg chg"))
+    base_irqs = reports[0][2]
+    for irq in IRQ_NAMES:
+        for name, _, irqs in reports:
+            if irq not in irqs:
+                continue
+            count, worst, average = irqs[irq]
+            base = base_irqs.get(irq, (0, 0, 0))
+            print("%-8s %-24s %10d %8d %8d %8s %8s" % (irq, name, count, worst, average,
+                                                       change(worst, base[1]), change(average, base[2])))
+    return 0
+
+
+def main(argv):
+    if len(argv) >= 3 and argv[1] == "capture":
+        return capture(argv[2], float(argv[3]) if len(argv) > 3 else 60.0)
+    if len(argv) >= 4 and argv[1] == "compare":
+        return compare(argv[2:])
+    print(__doc__)
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
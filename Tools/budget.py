@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Per-module ROM/RAM budget report from the armlink map file and call graph.
+
+Usage: budget.py [Listings/Test.map] [Objects/Test.htm]
+
+ROM is Code + RO Data + RW Data (initial values live in flash), RAM is
+RW Data + ZI Data. Modules without an entry in BUDGETS get DEFAULT_BUDGET.
+The worst-case stack is the deepest main() call chain plus, for every
+application interrupt handler, its deepest chain and an exception frame
+(extended FPU frame, the FPU is enabled at startup), i.e. all handlers nested.
+It must fit in ARM_LIB_STACK. Exit status is 1 when anything is over budget.
+
+The map must come from a build of the current main.uvprojx: when a C file of
+the project has no object in the map, the report is printed but the map is
+called stale and the exit status is 2. Rebuild in uVision and run again.
+"""
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+# module: (ROM bytes, RAM bytes)
+DEFAULT_BUDGET = (1024, 128)
+BUDGETS = {
+    "alarm.o":           (2560, 384),
+    "brownout.o":        (1024, 128),
+    "button.o":          (1536, 256),
+    "clock.o":           (1024, 16),
+    "config.o":          (1536, 512),
+    "ftfc.o":            (2048, 256),
+    "ftm.o":             (512, 16),
+    "journal.o":         (3072, 128),
+    "lmem.o":            (1024, 16),
+    "log.o":             (1536, 768),
+    "lpit.o":            (1024, 16),
+    "lpspi.o":           (1024, 16),
+    "lpuart.o":          (768, 16),
+    "main.o":            (4096, 512),
+    "max7219.o":         (3072, 256),
+    "pps.o":             (1024, 128),
+    "processdatetime.o": (2048, 64),
+    "softtimer.o":       (2048, 2048),
+    "stack.o":           (512, 16),
+    "stats.o":           (1024, 256),
+    "string.o":          (2560, 64),
+    "sync.o":            (4096, 128),
+    "systick.o":         (512, 16),
+    "tick.o":            (1536, 64),
+    "timestamp.o":       (256, 16),
+    "timezone.o":        (3584, 128),
+    "trace.o":           (512, 1152),
+    "uart_processing.o": (5120, 384),
+    "startup_s32k144.o": (1536, 64),
+    # RAM vector table, stack and heap regions
+    "(generated)":       (64, 2560),
+}
+LIBRARY_BUDGET = (1024, 64)
+EXCEPTION_FRAME = 104
+
+OBJECT_ROW = re.compile(r"^\s*(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\S+|\(incl\. Generated\))\s*$")
+STACK_REGION = re.compile(r"Execution Region ARM_LIB_STACK .*?Size: (0x[0-9a-fA-F]+)")
+FUNCTION = re.compile(r"<STRONG><a name=\"\[\w+\]\"></a>(\w+)</STRONG> \(Thumb, \d+ bytes, "
+                      r"Stack size (\d+|unknown) bytes, ([\w$.]+)\(")
+MAX_DEPTH = re.compile(r"Max Depth = (\d+)")
+SOURCE = re.compile(r"<FileName>(\w+)\.c</FileName>")
+
+
+def parse_map(path):
+    """Returns ({object: (code, ro, rw, zi)}, library totals, stack size)."""
+    objects = {}
+    library = [0, 0, 0, 0]
+    stack_size = None
+    section = None
+    with open(path) as mapfile:
+        for line in mapfile:
+            region = STACK_REGION.search(line)
+            if region:
+                stack_size = int(region.group(1), 16)
+            if "Object Name" in line:
+                section = "object"
+                continue
+            if "Library Member Name" in line:
+                section = "library"
+                continue
+            row = OBJECT_ROW.match(line)
+            if "Totals" in line or "Library Name" in line:
+                section = "totals" if section == "object" else None
+                continue
+            if row is None or section is None:
+                continue
+            code, _, ro, rw, zi = (int(row.group(i)) for i in range(1, 6))
+            if section == "totals":
+                if row.group(7) == "(incl. Generated)":
+                    objects["(generated)"] = (code, ro, rw, zi)
+            elif section == "object":
+                objects[row.group(7)] = (code, ro, rw, zi)
+            else:
+                library = [a + b for a, b in zip(library, (code, ro, rw, zi))]
+    return objects, tuple(library), stack_size
+
+
+def parse_callgraph(path):
+    """Returns {function: (max depth or None, object)}."""
+    functions = {}
+    current = None
+    with open(path) as htm:
+        for line in htm:
+            entry = FUNCTION.search(line)
+            if entry:
+                name, size, obj = entry.groups()
+                current = name
+                functions[name] = (None if size == "unknown" else int(size), obj)
+                continue
+            depth = MAX_DEPTH.search(line)
+            if depth and current is not None:
+                functions[current] = (int(depth.group(1)), functions[current][1])
+                current = None
+    return functions
+
+
+def parse_project(path):
+    """Returns the objects the C files of the uVision project compile to."""
+    with open(path) as project:
+        return set(name.lower() + ".o" for name in SOURCE.findall(project.read()))
+
+
+def check(name, rom, ram, budget, out):
+    over = rom > budget[0] or ram > budget[1]
+    out.write("%-20s %7d %7d %7d %7d  %s\n" % (name, rom, budget[0], ram, budget[1],
+                                               "OVER" if over else "ok"))
+    return over
+
+
+def main():
+    map_path = sys.argv[1] if len(sys.argv) > 1 else os.path.join(ROOT, "Listings", "Test.map")
+    htm_path = sys.argv[2] if len(sys.argv) > 2 else os.path.join(ROOT, "Objects", "Test.htm")
+    objects, library, stack_size = parse_map(map_path)
+    functions = parse_callgraph(htm_path)
+    out = sys.stdout
+    failed = False
+
+    out.write("%-20s %7s %7s %7s %7s\n" % ("module", "ROM", "budget", "RAM", "budget"))
+    for name in sorted(objects):
+        code, ro, rw, zi = objects[name]
+        failed |= check(name, code + ro + rw, rw + zi, BUDGETS.get(name, DEFAULT_BUDGET), out)
+    code, ro, rw, zi = library
+    failed |= check("(C library)", code + ro + rw, rw + zi, LIBRARY_BUDGET, out)
+
+    main_depth = functions.get("main", (0, None))[0] or 0
+    handlers = sorted((name, depth or 0) for name, (depth, obj) in functions.items()
+                      if name.endswith("Handler") and not obj.startswith("startup"))
+    worst = main_depth + sum(depth + EXCEPTION_FRAME for _, depth in handlers)
+    out.write("\nstack: main %d\n" % main_depth)
+    for name, depth in handlers:
+        out.write("  %-28s %5d + %d frame\n" % (name, depth, EXCEPTION_FRAME))
+    out.write("worst case %d of %s bytes" % (worst, stack_size if stack_size else "?"))
+    if stack_size is None or worst > stack_size:
+        out.write("  OVER\n")
+        failed = True
+    else:
+        out.write("  ok\n")
+
+    missing = sorted(parse_project(os.path.join(ROOT, "main.uvprojx")) - set(objects))
+    if missing:
+        out.write("\nSTALE MAP: %s built without %s\n" % (map_path, ", ".join(missing)))
+        out.write("rebuild the project and run again, the figures above are not the current firmware\n")
+        sys.exit(2)
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
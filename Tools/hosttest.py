@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Builds and runs the host tests and models in Tests/ with the PC's gcc.
+
+Usage: hosttest.py [-v] [test ...]
+
+Each test links the firmware modules it exercises, unchanged, with
+Tests/Host.c and its Tests/<name>.c. Tests/Host.h is force-included in front
+of every translation unit and points the peripheral bases at RAM copies, so
+no target hardware or toolchain is involved. A test passes when its program
+exits 0 and, if it has a checker, the checker accepts its output. -v prints
+the output of passing tests too (the models print their figures there).
+Exit status is 1 when any test fails or does not build.
+"""
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+CC = os.environ.get("CC", "gcc")
+CFLAGS = ["-std=gnu99", "-O1", "-Wall", "-Wno-int-to-pointer-cast",
+          "-DHOST_TEST", "-DTRACE_ENABLE=0", "-DNVIC_CRITICAL_STATS=0",
+          "-include", "Tests/Host.h", "-ITests", "-IDriver/inc", "-IUtilities/inc"]
+
+# name: (sources under test and models, extra defines), Tests/<name>.c and Tests/Host.c are added
+TESTS = {
+    "Alarm_Test": (["Utilities/src/Alarm.c", "Utilities/src/SoftTimer.c", "Driver/scr/GPIO.c",
+                    "Driver/scr/Clock.c", "Driver/scr/Systick.c"], []),
+    "Brownout_Test": (["Utilities/src/Brownout.c", "Utilities/src/Journal.c", "Driver/scr/Ftfc.c",
+                       "Utilities/src/SoftTimer.c", "Driver/scr/Clock.c", "Driver/scr/Systick.c",
+                       "Tests/FlashModel.c"], []),
+    "Clock_Test": (["Driver/scr/Clock.c", "Driver/scr/Lpit.c", "Driver/scr/Lpspi.c",
+                    "Driver/scr/Lpuart.c"], []),
+    "Ftfc_Test": (["Driver/scr/Ftfc.c", "Tests/FlashModel.c"], []),
+    "GPIO_Test": ([], []),
+    "Journal_Test": (["Utilities/src/Journal.c", "Driver/scr/Ftfc.c", "Utilities/src/SoftTimer.c",
+                      "Driver/scr/Clock.c", "Driver/scr/Systick.c", "Tests/FlashModel.c"], []),
+    "Lpspi_Test": (["Utilities/src/MAX7219.c", "Utilities/src/SoftTimer.c", "Driver/scr/Clock.c",
+                    "Driver/scr/Lpspi.c", "Driver/scr/Systick.c", "Tests/SpiModel.c"], []),
+    "Lpuart_Test": (["Driver/scr/Lpuart.c", "Driver/scr/Clock.c"], []),
+    "MAX7219_Test": (["Utilities/src/MAX7219.c", "Utilities/src/SoftTimer.c", "Driver/scr/Clock.c",
+                      "Driver/scr/Lpspi.c", "Driver/scr/Systick.c",
+                      "Tests/SpiModel.c"], ["-DMAX7219_DEVICE_COUNT=3"]),
+    "Port_Test": (["Driver/scr/Port.c"], []),
+    "Pps_Test": (["Utilities/src/Pps.c", "Utilities/src/Sync.c", "Utilities/src/Tick.c",
+                  "Utilities/src/Timestamp.c", "Utilities/src/ProcessDateTime.c", "Utilities/src/TimeZone.c",
+                  "Driver/scr/Ftm.c", "Driver/scr/Lpit.c", "Driver/scr/Clock.c"], []),
+    "Stats_Test": (["Utilities/src/Stats.c", "Utilities/src/SoftTimer.c", "Driver/scr/Clock.c",
+                    "Driver/scr/Systick.c"], []),
+    "Tick_Test": (["Utilities/src/Tick.c", "Driver/scr/Lpit.c", "Driver/scr/Clock.c"], []),
+    "TimeZone_Test": (["Utilities/src/TimeZone.c", "Utilities/src/ProcessDateTime.c"], []),
+    "Timestamp_Test": (["Utilities/src/Timestamp.c", "Driver/scr/Lpit.c", "Driver/scr/Clock.c",
+                        "Tests/LpitModel.c"], []),
+}
+
+
+def check_timezone(output):
+    """Offsets of the POSIX rules against the tz database, lines "offset <zone> <utc> <offset>"."""
+    try:
+        import datetime
+        import zoneinfo
+    except ImportError:
+        return "zoneinfo needs Python 3.9"
+    checked = 0
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) != 4 or fields[0] != "offset":
+            continue
+        utc = datetime.datetime.fromtimestamp(int(fields[2]), datetime.timezone.utc)
+        expected = int(utc.astimezone(zoneinfo.ZoneInfo(fields[1])).utcoffset().total_seconds())
+        if int(fields[3]) != expected:
+            return "%s at %s UTC: offset %s, tz database %d" % (fields[1], utc.isoformat(), fields[3], expected)
+        checked += 1
+    return None if checked != 0 else "no offsets printed"
+
+
+# name: function(output) returning an error message or None
+CHECKERS = {"TimeZone_Test": check_timezone}
+
+
+def build(name, sources, defines, workdir):
+    """Returns (executable, compiler output) or (None, compiler output)."""
+    executable = os.path.join(workdir, name)
+    command = [CC] + CFLAGS + defines + sources + ["Tests/Host.c", "Tests/%s.c" % name, "-o", executable, "-lm"]
+    result = subprocess.run(command, cwd=ROOT, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    return (executable if result.returncode == 0 else None), result.stdout
+
+
+def run(name, executable, verbose):
+    result = subprocess.run([executable], cwd=ROOT, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    error = None
+    if result.returncode != 0:
+        error = "exit status %d" % result.returncode
+    elif name in CHECKERS:
+        error = CHECKERS[name](result.stdout)
+    if error is not None or verbose:
+        sys.stdout.write(result.stdout)
+    print("%-20s %s" % (name, "FAIL: " + error if error else "PASS"))
+    return error is None
+
+
+def main():
+    args = sys.argv[1:]
+    verbose = "-v" in args
+    names = [arg for arg in args if arg != "-v"] or sorted(TESTS)
+    unknown = [name for name in names if name not in TESTS]
+    if unknown:
+        print("unknown test: %s" % ", ".join(unknown))
+        return 1
+    failed = 0
+    with tempfile.TemporaryDirectory() as workdir:
+        for name in names:
+            executable, output = build(name, TESTS[name][0], TESTS[name][1], workdir)
+            if output:
+                sys.stdout.write(output)
+            if executable is None:
+                print("%-20s FAIL: does not build" % name)
+                failed += 1
+            elif not run(name, executable, verbose):
+                failed += 1
+    print("%d/%d passed" % (len(names) - failed, len(names)))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Decode deferred log records captured from UART1 into readable messages.
+
+Usage: logdecode.py [capture.txt]      (reads stdin when no file is given)
+
+The dictionary is generated from Utilities/inc/Log_Formats.h: the n-th X(...)
+entry is message id n. Record lines look like "@<id> <timestamp> <args...>" in
+hex; other lines (console replies) are passed through unchanged.
+"""
+import os
+import re
+import sys
+
+FORMATS_H = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                         "..", "Utilities", "inc", "Log_Formats.h")
+ENTRY = re.compile(r'X\(\s*(\w+)\s*,\s*(\d+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+
+
+def load_dictionary(path=FORMATS_H):
+    with open(path) as header:
+        return [(name, int(count), fmt) for name, count, fmt in ENTRY.findall(header.read())]
+
+
+def decode(lines, dictionary, out):
+    high = 0
+    last = None
+    for line in lines:
+        line = line.rstrip("\r\n")
+        if not line.startswith("@"):
+            out.write(line + "\n")
+            continue
+        try:
+            fields = [int(f, 16) for f in line[1:].split()]
+        except ValueError:
+            out.write(line + "\n")
+            continue
+        msg_id, raw, args = fields[0], fields[1], fields[2:]
+        # 32-bit microsecond counter on target; unwrap, records arrive in order
+        if last is not None and raw < last:
+            high += 1 << 32
+        last = raw
+        seconds = (high + raw) / 1e6
+        if msg_id < len(dictionary):
+            name, count, fmt = dictionary[msg_id]
+            try:
+                text = fmt % tuple(args[:count])
+            except (TypeError, ValueError):
+                text = "%s %s" % (name, args)
+        else:
+            text = "unknown id %d %s" % (msg_id, args)
+        out.write("[%12.6f] %s\n" % (seconds, text))
+
+
+def main():
+    dictionary = load_dictionary()
+    if len(sys.argv) > 1:
+        with open(sys.argv[1]) as capture:
+            decode(capture, dictionary, sys.stdout)
+    else:
+        decode(sys.stdin, dictionary, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
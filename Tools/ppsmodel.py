@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""Runs the PPS discipline model (Tests/Pps_Test.c) over a range of crystals and PPS jitters.
+
+Usage: ppsmodel.py [ppm,...] [jitter_ns,...] [holdover_s] [wander_ppb]
+       e.g. ppsmodel.py 0,37,-123 100,1000 3600 50
+
+The model is built once the way hosttest.py builds it (Pps.c, Sync.c, Tick.c
+unchanged on the PC) and run for every ppm and jitter pair, with a holdover of
+holdover_s seconds (default 3600) during which the crystal moves by wander_ppb
+(default 50). Each run prints the time to lock, the error held once locked,
+the frequency learnt, the error after the holdover against the accuracy the
+device estimates, and the model's verdict. Exit status is 1 when a run fails.
+"""
+import os
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import hosttest  # noqa: E402
+
+NAME = "Pps_Test"
+PPMS = [0, 37, -123, 300]
+JITTERS_NS = [100, 1000]
+
+
+def numbers(arg):
+    return [int(value) for value in arg.split(",")]
+
+
+def main(argv):
+    if len(argv) > 1 and argv[1] in ("-h", "--help"):
+        print(__doc__)
+        return 2
+    ppms = numbers(argv[1]) if len(argv) > 1 else PPMS
+    jitters = numbers(argv[2]) if len(argv) > 2 else JITTERS_NS
+    holdover = argv[3] if len(argv) > 3 else "3600"
+    wander = argv[4] if len(argv) > 4 else "50"
+    failed = 0
+    with tempfile.TemporaryDirectory() as workdir:
+        executable, output = hosttest.build(NAME, hosttest.TESTS[NAME][0], hosttest.TESTS[NAME][1], workdir)
+        if executable is None:
+            sys.stdout.write(output)
+            return 1
+        for ppm in ppms:
+            for jitter in jitters:
+                result = subprocess.run([executable, str(ppm), str(jitter), holdover, wander],
+                                        stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                        universal_newlines=True)
+                sys.stdout.write(result.stdout + "\n")
+                failed += 1 if result.returncode != 0 else 0
+    print("%d/%d runs passed" % (len(ppms) * len(jitters) - failed, len(ppms) * len(jitters)))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,366 @@
+#!/usr/bin/env python3
+"""Time reference for the clock discipline over UART1 (see Utilities/inc/Sync.h).
+
+Usage: timesync.py PORT [interval_s] [status_every]
+       timesync.py --simulate PPM [interval_s] [status_every] [hours] [traffic]
+       e.g. timesync.py /dev/ttyACM0 16 8
+            timesync.py --simulate 37
+            timesync.py --simulate 37 16 8 3 masked
+
+Every interval_s (default 16, at most 32 for the frequency loop) sends
+"SYNC s1 u1 s4 u4" with t1 = now and t4 = arrival of the previous reply, reads
+"SYNC s2 u2 s3 u3" and prints the offset and delay seen from this side. Every
+status_every exchanges (default 8, 0 = never) sends "GET SYNC" and prints the
+device report. The host clock is the reference: keep it NTP-synchronised.
+Timestamps are taken at the first byte sent and received, as on the device.
+A read that returns several bytes dates each one a character before the
+next, so a reply that comes right after a log line, in the same read, still
+gets the time of its own first byte.
+Input left from before a frame (a late reply, a log line) is flushed before
+it is sent; log records ("@..." lines, see logdecode.py) and the tail of one
+that was on the wire when the frame went out are skipped.
+
+--simulate runs the same exchanges, in simulated time, against a device whose
+crystal gains PPM ppm and whose loop follows Sync.c with the constants of
+Sync.h, over a serial line with random delays. It runs for hours (default 3)
+and ends with the time to lock and the offset held once locked. traffic is
+the device's log output when a frame arrives: "log" (default) has a log line
+on the wire at a random point every time, "idle" none, and "masked" a line
+as with the firmware that held the UART interrupt masked while it sent one,
+which stamped t2 only once the line was out.
+"""
+import os
+import random
+import re
+import select
+import sys
+import termios
+import time
+
+BAUD = termios.B19200
+# The device ends a frame after 8 idle characters, ~4ms at 19200 baud
+FRAME_GAP = 0.05
+REPLY_TIMEOUT = 1.0
+SYNC_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Utilities", "inc", "Sync.h")
+# One character (start, 8 data, stop) at 19200 baud, in us
+CHAR_US = 10 * 1000000 / 19200
+# Simulated serial line: characters take CHAR_US, the device ends a frame after the gap,
+# scheduling jitter on each end; a log line is 43 characters at most (LOG_LINE_LENGTH)
+SIM_CHAR_US = 521
+SIM_GAP_US = 4200
+SIM_JITTER_US = 300
+SIM_LOG_US = 43 * SIM_CHAR_US
+SIM_TRAFFIC = ("log", "idle", "masked")
+SIM_SEED = 20241020
+
+
+class SerialPort:
+    """The device on a tty, raw 8N1."""
+
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        attrs = termios.tcgetattr(self.fd)
+        # Raw 8N1, no flow control
+        attrs[0] = 0
+        attrs[1] = 0
+        attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attrs[3] = 0
+        attrs[4] = attrs[5] = BAUD
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.pending = b""
+        self.times = []                        # Arrival time of each pending byte, us
+
+    def now_us(self):
+        return time.time_ns() // 1000
+
+    def sleep(self, seconds):
+        time.sleep(seconds)
+
+    def flush_input(self):
+        termios.tcflush(self.fd, termios.TCIFLUSH)
+        self.pending = b""
+        self.times = []
+
+    def write(self, data):
+        os.write(self.fd, data)
+
+    def read_line(self, timeout=REPLY_TIMEOUT):
+        """Returns (line, arrival time of its first byte in us), ("", None) on timeout.
+        Log records are skipped."""
+        deadline = time.monotonic() + timeout
+        while True:
+            while b"\n" in self.pending:
+                line, self.pending = self.pending.split(b"\n", 1)
+                first = self.times[0]
+                self.times = self.times[len(line) + 1:]
+                text = line.decode(errors="replace").strip()
+                if text and not text.startswith("@"):
+                    return text, first
+            left = deadline - time.monotonic()
+            if left <= 0 or not select.select([self.fd], [], [], left)[0]:
+                text = self.pending.decode(errors="replace").strip()
+                first = self.times[0] if self.times else None
+                self.pending = b""
+                self.times = []
+                return ("", None) if not text or text.startswith("@") else (text, first)
+            chunk = os.read(self.fd, 64)
+            # The last byte arrived now, each one before it a character earlier
+            now = self.now_us()
+            self.times += [int(now - (len(chunk) - 1 - i) * CHAR_US) for i in range(len(chunk))]
+            self.pending += chunk
+
+    def close(self):
+        os.close(self.fd)
+
+
+def sync_constants():
+    """The SYNC_* numbers of Sync.h."""
+    constants = {}
+    with open(SYNC_H) as header:
+        for match in re.finditer(r"#define\s+SYNC_(\w+)\s+\((-?\d+)U?\)", header.read()):
+            constants[match.group(1)] = int(match.group(2))
+    return constants
+
+
+def cdiv(a, b):
+    """C integer division, truncating toward zero."""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+class SimulatedPort:
+    """A device with a crystal gaining ppm, disciplined as in Sync.c (serial source),
+    behind a serial line with random delays and log traffic (SIM_TRAFFIC).
+    Time is simulated: sleep() returns at once."""
+
+    def __init__(self, ppm, traffic="log", seed=SIM_SEED):
+        self.c = sync_constants()
+        self.random = random.Random(seed)
+        self.ppm = ppm
+        self.traffic = traffic
+        self.now = 1729382400 * 1000000        # Reference time, us
+        self.phase = 250000.0                  # Device - reference, us
+        self.discipline = 0                    # Tick_SetDiscipline(), ppb, slows when positive
+        self.freq = 0
+        self.last = 0
+        self.t1 = self.t2 = self.t3 = 0
+        self.count = self.steps = self.jitter = 0
+        self.offset = self.delay = 0
+        self.state = 0
+        self.locked_at = None
+        self.lines = []                        # (text, reference time its first byte is sent)
+        self.tx_free = 0                       # Reference time the device's TX line is idle
+        self.history = []                      # (reference s, device - reference us) per exchange
+
+    # Clocks
+    def advance(self, us):
+        self.phase += us * (self.ppm * 1000 - self.discipline) * 1e-9
+        self.now += us
+
+    def device_us(self):
+        return int(self.now + self.phase)
+
+    def now_us(self):
+        return self.now
+
+    def sleep(self, seconds):
+        self.advance(int(seconds * 1000000))
+
+    def flush_input(self):
+        self.lines = []
+
+    def send(self, text):
+        """Device output: queued behind what is on the wire, as by Lpuart_Write()."""
+        start = max(self.now, self.tx_free)
+        self.tx_free = start + (len(text) + 1) * SIM_CHAR_US
+        self.lines.append((text, start))
+
+    # Sync.c
+    def step(self, offset):
+        self.phase -= offset
+        self.discipline = self.freq
+        self.steps += 1
+        self.jitter = 0
+        self.state = 1
+        self.last = 0
+        self.send("@16 %x %x" % (self.device_us() & 0xFFFFFFFF, abs(offset)))
+
+    def discipline_loop(self, offset, now, tau):
+        interval = now - self.last
+        if self.last != 0 and interval <= self.c["INTERVAL_MAX"]:
+            self.freq = max(-self.c["PPB_MAX"], min(self.c["PPB_MAX"],
+                            self.freq + cdiv(offset * 1000 * interval, 4 * tau * tau)))
+        self.last = now
+        self.discipline = max(-self.c["PPB_MAX"], min(self.c["PPB_MAX"], self.freq + cdiv(offset * 1000, tau)))
+
+    def track(self, offset):
+        self.jitter += cdiv(abs(offset) - self.jitter, 4)
+        if self.count > 4 and self.jitter < self.c["LOCK_US"]:
+            if self.state != 2 and self.locked_at is None:
+                self.locked_at = self.now
+                self.send("@17 %x %x" % (self.device_us() & 0xFFFFFFFF, self.count))
+            self.state = 2
+        else:
+            self.state = 1
+
+    def exchange(self, t1, t4, t2):
+        if t4 and self.t1 and self.t3:
+            offset = cdiv((self.t2 - self.t1) + (self.t3 - t4), 2)
+            delay = (t4 - self.t1) - (self.t3 - self.t2)
+            if 0 <= delay <= self.c["DELAY_MAX_US"]:
+                self.count += 1
+                self.offset = offset
+                self.delay = delay
+                if abs(offset) >= self.c["STEP_US"]:
+                    self.step(offset)
+                    t1 = 0
+                else:
+                    self.discipline_loop(offset, t2 // 1000000, self.c["TIME_CONSTANT"])
+                    self.track(offset)
+        self.t1 = t1
+        self.t2 = t2
+
+    # Serial line
+    def jitter_us(self):
+        return self.random.randint(0, SIM_JITTER_US)
+
+    def write(self, data):
+        fields = data.decode().split()
+        # A log line is on the wire, its tail reaches the host after the flush
+        if self.traffic != "idle":
+            self.tx_free = self.now + self.random.randint(0, SIM_LOG_US)
+            self.lines.append(("%x %x" % (self.random.getrandbits(32), self.random.getrandbits(32)), self.now))
+        # t2 is taken in the handler of the first byte; masked, only once the log line is out
+        self.advance(SIM_CHAR_US + self.jitter_us())
+        late = max(0, self.tx_free - self.now) if self.traffic == "masked" else 0
+        t2 = self.device_us() + late
+        self.advance((len(data) - 1) * SIM_CHAR_US)
+        if fields[:2] == ["GET", "SYNC"]:
+            for line in ["SYNC STATE SOURCE COUNT STEPS %d 1 %d %d" % (self.state, self.count, self.steps),
+                         "SYNC %s US %d" % ("BEHIND" if self.offset < 0 else "AHEAD", abs(self.offset)),
+                         "SYNC %s PPB %d" % ("SLOW" if self.freq < 0 else "FAST", abs(self.freq)),
+                         "SYNC DELAY ACCURACY US %d %d" % (self.delay, self.jitter + self.delay // 2)]:
+                self.send(line)
+            return
+        s1, u1, s4, u4 = (int(f) for f in fields[1:])
+        self.exchange(s1 * 1000000 + u1, s4 * 1000000 + u4, t2)
+        self.history.append((self.now // 1000000, self.phase))
+        # The UART handler sees the frame end after the gap, waits for the queued lines
+        # to leave (Lpuart_Flush), takes t3 and replies
+        self.advance(SIM_GAP_US + self.jitter_us())
+        self.advance(max(0, self.tx_free - self.now))
+        self.t3 = self.device_us()
+        self.send("SYNC %d %d %d %d" % (self.t2 // 1000000, self.t2 % 1000000,
+                                        self.t3 // 1000000, self.t3 % 1000000))
+
+    def read_line(self, timeout=REPLY_TIMEOUT):
+        while self.lines:
+            line, start = self.lines.pop(0)
+            first = start + SIM_CHAR_US + self.jitter_us()
+            self.advance(max(0, first + len(line) * SIM_CHAR_US - self.now))
+            if not line.startswith("@"):
+                return line, first
+        self.advance(int(timeout * 1000000))
+        return "", None
+
+    def close(self):
+        pass
+
+    def report(self, interval):
+        if self.locked_at is None:
+            print("simulated %+d ppm, %s traffic: not locked" % (self.ppm, self.traffic))
+            return 1
+        start = self.history[0][0]
+        locked = self.locked_at // 1000000
+        held = [abs(phase) for second, phase in self.history if second >= locked]
+        print("simulated %+d ppm, poll %gs, %s traffic: locked after %d s (%d steps), then within %.0f us "
+              "(rms %.0f us), frequency estimate %+d ppb"
+              % (self.ppm, interval, self.traffic, locked - start, self.steps, max(held),
+                 (sum(h * h for h in held) / len(held)) ** 0.5, self.freq))
+        return 0
+
+
+def exchange(port, t4_previous):
+    """One frame; returns (t1, t2, t3, t4) or None."""
+    t4s, t4u = divmod(t4_previous, 1000000) if t4_previous else (0, 0)
+    # A reply that came too late, or a log line, must not be taken for this one
+    port.flush_input()
+    t1 = port.now_us()
+    s1, u1 = divmod(t1, 1000000)
+    port.write(("SYNC %d %d %d %d" % (s1, u1, t4s, t4u)).encode())
+    # The reply, after the tail of a log line that was on the wire
+    while True:
+        line, t4 = port.read_line()
+        fields = line.split()
+        if not line or (len(fields) == 5 and fields[0] == "SYNC"):
+            break
+    if len(fields) != 5 or fields[0] != "SYNC":
+        print("no reply: %r" % line)
+        return None
+    s2, u2, s3, u3 = (int(f) for f in fields[1:])
+    return t1, s2 * 1000000 + u2, s3 * 1000000 + u3, t4
+
+
+def status(port):
+    port.sleep(FRAME_GAP)
+    port.flush_input()
+    port.write(b"GET SYNC")
+    while True:
+        line, _ = port.read_line(0.5)
+        if not line:
+            break
+        # Report lines are upper case, the tail of a log line is not
+        if line[:1].isupper():
+            print("  " + line)
+
+
+def run(port, interval, status_every, seconds=None):
+    t4 = 0
+    count = 0
+    start = port.now_us()
+    while seconds is None or port.now_us() - start < seconds * 1000000:
+        times = exchange(port, t4)
+        if times:
+            t1, t2, t3, t4 = times
+            # Same formulas as the device, device ahead when positive
+            offset = ((t2 - t1) + (t3 - t4)) / 2
+            delay = (t4 - t1) - (t3 - t2)
+            print("%s offset %+10.0f us  delay %6d us"
+                  % (time.strftime("%H:%M:%S", time.gmtime(t1 // 1000000)), offset, delay))
+            count += 1
+            if status_every and count % status_every == 0:
+                status(port)
+        else:
+            t4 = 0
+        port.sleep(interval)
+
+
+def main(argv):
+    if len(argv) < 2 or (argv[1] == "--simulate" and len(argv) < 3):
+        print(__doc__)
+        return 2
+    simulate = argv[1] == "--simulate"
+    args = argv[3:] if simulate else argv[2:]
+    interval = float(args[0]) if len(args) > 0 else 16.0
+    status_every = int(args[1]) if len(args) > 1 else 8
+    if simulate:
+        traffic = args[3] if len(args) > 3 else "log"
+        if traffic not in SIM_TRAFFIC:
+            print(__doc__)
+            return 2
+        port = SimulatedPort(int(argv[2]), traffic)
+        hours = float(args[2]) if len(args) > 2 else 3.0
+        run(port, interval, status_every, hours * 3600)
+        return port.report(interval)
+    port = SerialPort(argv[1])
+    try:
+        run(port, interval, status_every)
+    except KeyboardInterrupt:
+        return 0
+    finally:
+        port.close()
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Convert a "GET TRACE" dump captured from UART1 into Chrome/Perfetto trace JSON.
+
+Usage: trace2chrome.py dump.txt trace.json
+Open the result in chrome://tracing or https://ui.perfetto.dev.
+
+Dump format (see Utilities/inc/Trace.h):
+    TRACE <ticks_per_us> <count>
+    TTTTTTTT EEEE AAAA        timestamp, event id, argument in hex
+    END
+"""
+import json
+import sys
+
+# Trace_EventType
+ISR_ENTER, ISR_EXIT, SPI_START, SPI_END, UART_COMMAND, TIME_ROLLOVER = range(1, 7)
+# Stats_IrqIdType
+IRQ_NAMES = ["LPIT", "UART", "PORTC", "ADC", "SYSTICK", "LVD_LVW", "FTFC", "FTM0"]
+# UART_Processing.h command states
+COMMANDS = {0: "invalid", 1: "Setting Time", 2: "Setting Date", 3: "GET STATS", 5: "GET TRACE", 6: "GET STACK",
+            7: "Setting Alarm", 8: "GET ALARMS", 9: "CLEAR ALARMS", 10: "Setting Zone",
+            11: "Setting Calib", 12: "GET SYNC"}
+ROLLOVERS = ["minute", "hour", "day"]
+
+TID_ISR, TID_SPI, TID_EVENTS = 1, 2, 3
+
+
+def parse(lines):
+    ticks_per_us = 1
+    records = []
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "TRACE":
+            ticks_per_us = max(int(fields[1]), 1)
+            records = []
+        elif fields[0] == "END":
+            break
+        elif len(fields) == 3:
+            records.append(tuple(int(f, 16) for f in fields))
+    return ticks_per_us, records
+
+
+def convert(ticks_per_us, records):
+    events = []
+    for tid, name in ((TID_ISR, "ISR"), (TID_SPI, "LPSPI1"), (TID_EVENTS, "Events")):
+        events.append({"ph": "M", "name": "thread_name", "pid": 1, "tid": tid, "args": {"name": name}})
+    high = 0
+    last = None
+    for raw, event, arg in records:
+        # The target keeps 32 bits of the counter; unwrap, records are in time order
+        if last is not None and raw < last:
+            high += 1 << 32
+        last = raw
+        ts = (high + raw) / ticks_per_us
+        if event in (ISR_ENTER, ISR_EXIT):
+            name = IRQ_NAMES[arg] if arg < len(IRQ_NAMES) else "IRQ%d" % arg
+            events.append({"ph": "B" if event == ISR_ENTER else "E", "name": name,
+                           "pid": 1, "tid": TID_ISR, "ts": ts})
+        elif event in (SPI_START, SPI_END):
+            events.append({"ph": "B" if event == SPI_START else "E", "name": "frame",
+                           "pid": 1, "tid": TID_SPI, "ts": ts, "args": {"words": arg}})
+        elif event == UART_COMMAND:
+            events.append({"ph": "i", "s": "t", "name": "cmd " + COMMANDS.get(arg, str(arg)),
+                           "pid": 1, "tid": TID_EVENTS, "ts": ts})
+        elif event == TIME_ROLLOVER:
+            name = ROLLOVERS[arg] if arg < len(ROLLOVERS) else str(arg)
+            events.append({"ph": "i", "s": "t", "name": "rollover " + name,
+                           "pid": 1, "tid": TID_EVENTS, "ts": ts})
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    with open(sys.argv[1]) as dump:
+        ticks_per_us, records = parse(dump)
+    with open(sys.argv[2], "w") as out:
+        json.dump(convert(ticks_per_us, records), out)
+    print("%d records converted" % len(records))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,103 @@
+/**
+ * @file    Alarm.h
+ * @brief   One-shot and recurring alarms
+ * @details Alarms are kept in a binary min-heap keyed by the epoch of their
+ *          next firing, so the check made every second by the LPIT tick is one
+ *          compare against the root (Alarm_Check). Only a firing alarm costs a
+ *          heap update: O(log ALARM_MAX).
+ *          Next firings are computed on epoch seconds (day number and weekday),
+ *          so month and year ends and leap days need no special case.
+ *          A firing alarm blinks ALARM_GPIO/ALARM_PIN for ALARM_RING_MS, or
+ *          until Alarm_Stop().
+ *          Alarms are set from the UART handler: the heap is locked against
+ *          the LPIT tick with NVIC_EnterCritical(PRIORITY_LPIT_TICK).
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef ALARM_H
+#define ALARM_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define ALARM_MAX 								(16U)
+#define ALARM_RING_MS 						(30000U)
+#define ALARM_BLINK_MS 						(250U)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef enum
+{
+	ALARM_ONCE = 0U,                 /* Next occurrence of the time, then removed */
+	ALARM_DAILY,
+	ALARM_WEEKDAYS                   /* Monday to Friday                          */
+} Alarm_RepeatType;
+
+typedef struct
+{
+	unsigned int  next;              /* Epoch of the next firing, heap key        */
+	unsigned int  timeOfDay;         /* Seconds after midnight                    */
+	unsigned char repeat;            /* Alarm_RepeatType                          */
+	unsigned char id;
+} Alarm_Type;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Heap, root at index 0; read by the inline check */
+extern Alarm_Type Alarm_Heap[ALARM_MAX];
+extern volatile unsigned int Alarm_Count;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Drives the output to its idle level. Config_System() must have been called.
+ */
+void Alarm_Init(void);
+
+/**
+ * @brief Adds an alarm firing at timeOfDay (seconds after midnight) after now.
+ * @return Alarm id (1..255), 0 if the table is full.
+ */
+unsigned char Alarm_Add(unsigned int timeOfDay, Alarm_RepeatType repeat, unsigned int now);
+
+/**
+ * @brief Removes all alarms and stops a ringing one.
+ */
+void Alarm_Clear(void);
+
+/**
+ * @brief Recomputes the recurring alarms after the clock was set to now.
+ * @details A one-shot alarm keeps its epoch: skipped over by the change, it fires at once.
+ */
+void Alarm_Reschedule(unsigned int now);
+
+/**
+ * @brief Fires every alarm due at now and schedules the next firings. Called by Alarm_Check.
+ */
+void Alarm_Fire(unsigned int now);
+
+/**
+ * @brief Stops the alarm output.
+ * @return 1 if an alarm was ringing.
+ */
+unsigned char Alarm_Stop(void);
+
+/**
+ * @brief Per-second check from the LPIT tick.
+ */
+static inline void Alarm_Check(unsigned int now)
+{
+	if ((Alarm_Count != 0U) && (Alarm_Heap[0].next <= now))
+	{
+		Alarm_Fire(now);
+	}
+}
+
+#endif
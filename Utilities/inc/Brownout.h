@@ -0,0 +1,74 @@
+/**
+ * @file    Brownout.h
+ * @brief   State snapshot on low voltage warning
+ * @details The PMC low voltage warning interrupt runs at PRIORITY_BROWNOUT (0),
+ *          above every critical section, and programs one journal record into
+ *          the slot each sector keeps erased for it: one phrase program, no
+ *          erase, whatever the thread was doing with the flash.
+ *          The time from handler entry to programmed record is measured with
+ *          the DWT cycle counter and checked against BROWNOUT_BUDGET_US, the
+ *          time the supply capacitance holds the MCU between the warning and
+ *          the reset threshold (to be checked on the board). On the host flash
+ *          model (Tests/Brownout_Test.c) a snapshot takes 91us with the
+ *          controller idle or an erase to suspend, 181us behind a program.
+ *          After a snapshot the warning is disabled; if the supply comes back,
+ *          it is armed again within BROWNOUT_REARM_MS of the flag clearing.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef BROWNOUT_H
+#define BROWNOUT_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Journal.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#ifndef BROWNOUT_BUDGET_US
+#define BROWNOUT_BUDGET_US 				(250U)     /* Warning to programmed record */
+#endif
+#define BROWNOUT_REARM_MS 				(1000U)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef struct
+{
+	unsigned int count;              /* Warnings handled                       */
+	unsigned int lastCycles;         /* Entry to programmed, last warning      */
+	unsigned int maxCycles;
+	unsigned int overBudget;         /* Snapshots slower than the budget       */
+	unsigned int errors;             /* Snapshots not written                  */
+} Brownout_StatsType;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+extern volatile Brownout_StatsType Brownout_Stats;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Enables the warning interrupt. The journal must be initialised.
+ */
+void Brownout_Init(void);
+
+/**
+ * @brief Sets the function that fills the snapshot record. Runs at priority 0: no locks.
+ */
+void Brownout_SetSource(Journal_SourceType source);
+
+/**
+ * @brief Writes the snapshot. Called from LVD_LVW_IRQHandler.
+ */
+void Brownout_IrqHandler(void);
+
+/**
+ * @brief Converts cycles of the DWT counter to microseconds.
+ */
+unsigned int Brownout_CyclesToUs(unsigned int cycles);
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file    Button.h
+ * @brief   Debounced push buttons with gesture events
+ * @details The first falling edge of a button disables its pin interrupt and
+ *          starts a SoftTimer that samples the pin. The bounce is filtered by
+ *          requiring BUTTON_DEBOUNCE_SAMPLES equal samples. Once the button is
+ *          released and stable, sampling stops and the pin interrupt is re-armed.
+ *          Events are press, release, long press (held BUTTON_LONG_PRESS_MS) and
+ *          double press (pressed again within BUTTON_DOUBLE_PRESS_MS of a short
+ *          click). Buttons are active low.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef BUTTON_H
+#define BUTTON_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+#include "SoftTimer.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define BUTTON_MAX_NUMBER 				(4U)
+#define BUTTON_SAMPLE_MS 					(5U)
+#define BUTTON_DEBOUNCE_SAMPLES 	(4U)       /* 20ms stable */
+#define BUTTON_LONG_PRESS_MS 			(1000U)
+#define BUTTON_DOUBLE_PRESS_MS 		(300U)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef enum
+{
+	BUTTON_EVENT_PRESS = 0U,
+	BUTTON_EVENT_RELEASE,
+	BUTTON_EVENT_LONG_PRESS,
+	BUTTON_EVENT_DOUBLE_PRESS
+} Button_EventType;
+
+typedef void (*Button_CallbackType)(unsigned char button, Button_EventType event);
+
+typedef struct
+{
+	PORT_Type     *port;        /* Port with the pin interrupt (falling edge) */
+	GPIO_Type     *gpio;        /* GPIO used to sample the pin                */
+	unsigned char  pin;
+} Button_ConfigType;
+
+typedef struct
+{
+	unsigned int irqCount;      /* Pin interrupts taken                             */
+	unsigned int rawEdges;      /* Level changes seen by interrupt and sampling     */
+	unsigned int events;        /* Debounced events delivered                       */
+} Button_StatsType;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Registers the buttons. Index in the table is the button number in events.
+ *        Pins must already be muxed as GPIO input with falling edge interrupt.
+ */
+void Button_Init(const Button_ConfigType *table, unsigned char count);
+
+/**
+ * @brief Sets the event callback, called in SysTick context.
+ */
+void Button_SetEventCallback(Button_CallbackType callback);
+
+/**
+ * @brief Handles the pin interrupt flags of one port. Called from PORTx_IRQHandler.
+ */
+void Button_IrqHandler(PORT_Type *port);
+
+/**
+ * @brief Returns the counters of one button, NULL if out of range.
+ */
+const Button_StatsType* Button_GetStats(unsigned char button);
+
+#endif
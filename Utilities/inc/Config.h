@@ -23,6 +23,7 @@
 #include "Lpit.h"
 #include "Lpspi.h"
 #include "Lpuart.h"
+#include "Ftm.h"
  /*==================================================================================================
 *                                       MACRO DEFINITIONS
 ==================================================================================================*/
@@ -37,6 +38,26 @@
 #define ADC0_RA 	(*((volatile unsigned int*)(ADC0_BASE_ADDRESS+ 0x48U)))
 #define ADC_SC1A_ADCH_SHIFT (0U)
 #define ADC0_SE12 					(12U)
+/* NVIC priorities. The tick must not be 0 so that NVIC_EnterCritical() can mask it.
+ * The brownout snapshot is the only priority 0 handler: nothing may delay it. */
+#define PRIORITY_BROWNOUT 			(0U)
+#define PRIORITY_LPIT_TICK 			(1U)
+#define PRIORITY_SOFTTIMER 			(2U)
+#define PRIORITY_PPS 						(3U)       /* Capture is latched in hardware, 21.8ms to read it */
+#define PRIORITY_BUTTON 				(5U)
+#define PRIORITY_UART 					(9U)
+#define PRIORITY_ADC 						(10U)
+#define PRIORITY_FLASH 					(11U)      /* Journal flash completion, never urgent */
+/* Button numbers, index in Config_ButtonTable */
+#define BUTTON_1 								(0U)
+#define BUTTON_2 								(1U)
+/* Alarm output: PTD0, blue LED of the EVB (active low) or a buzzer driver */
+#define ALARM_GPIO 							(GPIOD)
+#define ALARM_PIN 							(0U)
+#define ALARM_OUTPUT_IDLE 			(1U)
+/* PPS input: PTC0 = FTM0_CH0 (ALT2), rising edge */
+#define PPS_FTM 								(FTM0)
+#define PPS_CHANNEL 						(0U)
  /*==================================================================================================
 *                                  GLOBAL FUNCTION PROTOTYPE
 ==================================================================================================*/
@@ -0,0 +1,111 @@
+/**
+ * @file    Journal.h
+ * @brief   Time and settings journal in FlexNVM
+ * @details JOURNAL_SECTOR_COUNT D-Flash sectors are used as a ring. The first
+ *          phrase of a sector is its header (sequence number, erase count), the
+ *          other phrases hold one 8-byte record each, appended in order. When
+ *          the active sector is full the oldest one is erased and becomes the
+ *          active one with the next sequence number, so all sectors wear evenly.
+ *          A record is one phrase program, protected by a CRC: a record or
+ *          header cut by a power loss is skipped at the next boot, also when
+ *          the cut left it with an ECC error (counted in badPhrases).
+ *          Boot recovery reads the headers, then scans the active sector (and
+ *          the previous one if the active one has no record yet): at most
+ *          JOURNAL_SECTOR_COUNT + 2 * JOURNAL_RECORDS_PER_SECTOR phrase reads.
+ *          Journal_Process() runs from the main loop and writes at most once per
+ *          JOURNAL_INTERVAL_MS; the record contents come from the callback.
+ *          Writes are queued to the FTFC driver and finish in its interrupt:
+ *          the main loop never waits for the flash.
+ *          The last slot of a sector is kept for Journal_Snapshot(), so the
+ *          brownout handler always finds an erased phrase without erasing.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef JOURNAL_H
+#define JOURNAL_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Ftfc.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#ifndef JOURNAL_INTERVAL_MS
+#define JOURNAL_INTERVAL_MS 				(60000U)   /* Minimum time between two flash writes */
+#endif
+#define JOURNAL_BASE 								(FTFC_DFLASH_BASE)
+#define JOURNAL_SECTOR_COUNT 				(4U)
+#define JOURNAL_RECORDS_PER_SECTOR 	((FTFC_DFLASH_SECTOR_SIZE / FTFC_PHRASE_SIZE) - 1U)
+/* Record types */
+#define JOURNAL_TYPE_PERIODIC 			(1U)
+#define JOURNAL_TYPE_SNAPSHOT 			(2U)       /* Written on low voltage warning */
+#define JOURNAL_TYPE_MASK 					(0x0FU)
+#define JOURNAL_PHASE_SHIFT 				(4U)       /* Snapshot: quarter second in the high nibble */
+/* Settings bits */
+#define JOURNAL_SETTING_TIME_MODE 	(1U << 0)  /* Display shows the time (else the date) */
+#define JOURNAL_SETTING_DISPLAY_ON 	(1U << 1)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+/* One phrase */
+typedef struct
+{
+	unsigned int   epoch;            /* Seconds since 1970-01-01 UTC          */
+	unsigned char  type;             /* JOURNAL_TYPE_*, snapshot: phase too   */
+	unsigned char  settings;         /* JOURNAL_SETTING_*                    */
+	unsigned short crc;              /* CRC-16 of the first 6 bytes          */
+} Journal_RecordType;
+
+typedef struct
+{
+	unsigned int writes;
+	unsigned int erases;
+	unsigned int errors;
+	unsigned int sequence;           /* Sequence number of the active sector */
+	unsigned int maxEraseCount;      /* Highest erase count of the sectors   */
+	unsigned int badPhrases;         /* Phrases read with an ECC error       */
+} Journal_StatsType;
+
+/* Fills epoch, type and settings of the record to write */
+typedef void (*Journal_SourceType)(Journal_RecordType *record);
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+extern Journal_StatsType Journal_Stats;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Finds the active sector and the latest valid record, formats an empty journal.
+ * @return 1 and the record in latest if one was found, 0 otherwise.
+ */
+unsigned char Journal_Init(Journal_RecordType *latest);
+
+/**
+ * @brief Sets the function that provides the record contents.
+ */
+void Journal_SetSource(Journal_SourceType source);
+
+/**
+ * @brief Queues a record now, moving to the next sector if needed.
+ * @return FTFC_OK if queued, FTFC_ERROR_BUSY while the previous write is in progress.
+ */
+Ftfc_StatusType Journal_Append(Journal_RecordType *record);
+
+/**
+ * @brief Programs a record into the next erased slot without erasing, from the brownout handler.
+ * @details Preempts Journal_Append() at any point; costs one phrase program.
+ */
+Ftfc_StatusType Journal_Snapshot(Journal_RecordType *record);
+
+/**
+ * @brief Queues a record from the source when JOURNAL_INTERVAL_MS has passed.
+ * @return 1 if a write was queued, 0 otherwise.
+ */
+unsigned char Journal_Process(void);
+
+#endif
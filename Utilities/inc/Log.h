@@ -0,0 +1,70 @@
+/**
+ * @file    Log.h
+ * @brief   Deferred-formatting logger
+ * @details A call site stores only a message id (Log_Formats.h), up to 3 raw
+ *          integer arguments and the LPIT microsecond timestamp in a lock-free
+ *          ring buffer; slots are reserved with LDREX/STREX so any interrupt can
+ *          log. Formatting happens on the host: Log_Process(), called from the
+ *          idle loop, queues each record for LPUART1 as one text line
+ *          "@<id> <timestamp> <args...>" (hex) and Tools/logdecode.py turns the
+ *          capture back into readable messages. When the buffer is full new
+ *          records are dropped and counted.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LOG_H
+#define LOG_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+#include "Log_Formats.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#ifndef LOG_ENABLE
+#define LOG_ENABLE 								1          /* Set to 0 to compile every LOGn() out */
+#endif
+#define LOG_BUFFER_SIZE 					(32U)      /* Records, power of 2 */
+#define LOG_MAX_ARGS 							(3U)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+#define LOG_ENUM_ENTRY(id, count, format) 	id,
+typedef enum
+{
+	LOG_FORMATS(LOG_ENUM_ENTRY)
+	LOG_ID_NUMBER
+} Log_IdType;
+#undef LOG_ENUM_ENTRY
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Stores one record. Safe from any context, never blocks.
+ */
+void Log_Write(Log_IdType id, unsigned int count, unsigned int arg0, unsigned int arg1, unsigned int arg2);
+
+/**
+ * @brief Queues the oldest record on the LPUART1 TX queue. Called from main loop only.
+ * @return 1 if a record was queued, 0 if the buffer is empty or the queue is full.
+ */
+unsigned char Log_Process(void);
+
+#if (LOG_ENABLE == 1)
+#define LOG0(id) 								Log_Write((id), 0U, 0U, 0U, 0U)
+#define LOG1(id, a) 						Log_Write((id), 1U, (unsigned int)(a), 0U, 0U)
+#define LOG2(id, a, b) 					Log_Write((id), 2U, (unsigned int)(a), (unsigned int)(b), 0U)
+#define LOG3(id, a, b, c) 			Log_Write((id), 3U, (unsigned int)(a), (unsigned int)(b), (unsigned int)(c))
+#else
+#define LOG0(id) 								((void)0)
+#define LOG1(id, a) 						((void)0)
+#define LOG2(id, a, b) 					((void)0)
+#define LOG3(id, a, b, c) 			((void)0)
+#endif
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file    Log_Formats.h
+ * @brief   Log message dictionary
+ * @details One X(id, argument count, "format") entry per message. The firmware
+ *          only uses the id and count; the format strings are never compiled in
+ *          and are read from this file by Tools/logdecode.py. Append new entries
+ *          at the end so that ids of older captures stay valid. Formats take
+ *          unsigned integer arguments (%u, %02u, %x).
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LOG_FORMATS_H
+#define LOG_FORMATS_H
+
+#define LOG_FORMATS(X) \
+	X(LOG_DROPPED,        1, "%u log records dropped") \
+	X(LOG_BOOT,           0, "boot") \
+	X(LOG_BUTTON_EVENT,   2, "button %u event %u") \
+	X(LOG_TIME_SET,       3, "time set %02u-%02u-%02u") \
+	X(LOG_DATE_SET,       3, "date set %02u.%02u.%u") \
+	X(LOG_UART_REJECTED,  1, "uart input rejected in state %u") \
+	X(LOG_JOURNAL_RESTORED, 2, "journal sector sequence %u restored epoch %u") \
+	X(LOG_JOURNAL_ERROR,  2, "journal flash error %u at %x") \
+	X(LOG_BROWNOUT_RECOVERED, 3, "supply recovered after %u warnings, snapshot %u us (max %u us)") \
+	X(LOG_ALARM_SET,      3, "alarm %u set at %u s of day, repeat %u") \
+	X(LOG_ALARM_FIRED,    2, "alarm %u fired, due epoch %u") \
+	X(LOG_ZONE_SET,       3, "zone set, offset %u s, west %u, dst %u") \
+	X(LOG_CALIB_SET,      2, "tick calibration %u ppm, slower %u") \
+	X(LOG_SYNC_STEP,      3, "sync step %u s %u us, was ahead %u") \
+	X(LOG_SYNC_LOCKED,    2, "sync locked after %u measurements, accuracy %u us") \
+	X(LOG_SYNC_SOURCE,    1, "sync source %u (1 serial, 2 pps)") \
+	X(LOG_SYNC_HOLDOVER,  2, "sync holdover, source %u silent for %u s")
+
+#endif
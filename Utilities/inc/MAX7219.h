@@ -1,8 +1,9 @@
 /**
- * @file    
- * @brief   
- * @details 
- *          
+ * @file    MAX7219.h
+ * @brief   MAX7219 Driver Functions
+ * @details Supports MAX7219_DEVICE_COUNT devices daisy-chained on one chip select.
+ *          Digits run in no-decode mode; characters are drawn from a 7-segment
+ *          font table in flash. The time/date functions draw on device 0.
  *
  * @version 1.0
  * @date    2024-10-09
@@ -16,6 +17,7 @@
 *                                       INCLUDE FILE
 ==================================================================================================*/
 #include "Config.h"
+#include "SoftTimer.h"
 /*==================================================================================================
 *                                    MACRO DEFINITIONS
 ==================================================================================================*/
@@ -23,6 +25,7 @@
 #define SHUTDOWN_MODE 				0x0C00
 #define NONE_DISPLAY_TEST 		0x0F00
 #define DECODE_ALL_DIGITS 		0x09FF
+#define NO_DECODE_ALL_DIGITS 	0x0900
 #define SCAN_LIMIT_ALL_DIGITS 0x0B07
 #define INTENSITY_REG 				0x0A00
 #define LED_0									0x0100
@@ -33,10 +36,32 @@
 #define LED_5									0x0600
 #define LED_6									0x0700
 #define LED_7									0x0800 			 				
+#define LED_REG_SHIFT 				(8U)
+/* Number of cascaded MAX7219 on LPSPI1 PCS3. Device 0 is the one wired to the MCU */
+#ifndef MAX7219_DEVICE_COUNT
+#define MAX7219_DEVICE_COUNT 	(1U)
+#endif
+#define MAX7219_DIGITS 				(8U)
+/* No-decode segment bits: DP A B C D E F G */
+#define MAX7219_SEG_DP 				(0x80U)
+#define MAX7219_MARQUEE_MAX 	(32U)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef struct
+{
+	unsigned int refreshCount;      /* Full refreshes sent                        */
+	unsigned int frameCount;        /* CS frames sent (one per register write)    */
+	unsigned int lastBusCycles;     /* Core cycles of the last refresh until idle */
+	unsigned int maxBusCycles;
+} MAX7219_StatsType;
 /*==================================================================================================
 *                                    GLOBLA VARIABLES
 ==================================================================================================*/
 extern unsigned short ADC_Value;
+/* Digit register data per device, sent by MAX7219_Refresh() */
+extern unsigned char MAX7219_FrameBuffer[MAX7219_DEVICE_COUNT][MAX7219_DIGITS];
+extern MAX7219_StatsType MAX7219_Stats;
 /**
  * @brief Initializes the MAX7219 display.
  *
@@ -46,6 +71,72 @@ extern unsigned short ADC_Value;
  */
 void Init_MAX7219(void);
 
+/**
+ * @brief Sends the same command word to every device in the chain, one CS frame.
+ *
+ * @param command Register address in [11:8], data in [7:0].
+ */
+void MAX7219_WriteAll(unsigned short command);
+
+/**
+ * @brief Sends the whole framebuffer: one CS frame of MAX7219_DEVICE_COUNT words per digit.
+ */
+void MAX7219_Refresh(void);
+
+/**
+ * @brief Renders text to segment patterns. A '.' is merged into the previous glyph.
+ *
+ * @param text   Zero terminated ASCII text.
+ * @param glyphs Output segment patterns.
+ * @param max    Size of glyphs.
+ * @return Number of glyphs written.
+ */
+unsigned int MAX7219_RenderText(const char *text, unsigned char *glyphs, unsigned int max);
+
+/**
+ * @brief Shows up to 8 characters left aligned on one device, e.g. "SYNC", "Err 2".
+ *
+ * @param device Device index in the chain.
+ * @param text   Zero terminated ASCII text.
+ */
+void MAX7219_DisplayString(unsigned char device, const char *text);
+
+/**
+ * @brief Scrolls text from right to left over device 0, one digit per step.
+ *        Glyphs are rendered once; each step only copies 8 bytes and refreshes.
+ *        Display_Time/Display_Date leave the display alone while it runs.
+ *
+ * @param text   Zero terminated ASCII text, up to MAX7219_MARQUEE_MAX glyphs.
+ * @param stepMs Time per step in ms.
+ * @param loop   0 to stop after the text has left the display, 1 to repeat.
+ */
+void MAX7219_StartMarquee(const char *text, unsigned int stepMs, unsigned char loop);
+
+/**
+ * @brief Stops the marquee.
+ */
+void MAX7219_StopMarquee(void);
+
+/**
+ * @brief Returns 1 while the marquee is running.
+ */
+unsigned char MAX7219_IsMarqueeActive(void);
+
+/**
+ * @brief Shows a short message on device 0 over the time/date, e.g. "Err".
+ *        Display_Time/Display_Date leave the display alone for holdMs, then the
+ *        next LPIT tick draws over it. Stops a running marquee.
+ *
+ * @param text   Zero terminated ASCII text, up to 8 characters.
+ * @param holdMs Time the message stays, in ms.
+ */
+void MAX7219_ShowMessage(const char *text, unsigned int holdMs);
+
+/**
+ * @brief Returns 1 while a message or the marquee owns device 0.
+ */
+unsigned char MAX7219_IsHeld(void);
+
 /**
  * @brief Displays time on the MAX7219.
  *
@@ -0,0 +1,63 @@
+/**
+ * @file    Pps.h
+ * @brief   Pulse per second input, timestamped by FTM input capture
+ * @details A GPS or other reference drives PTC0 (FTM0_CH0) with one rising
+ *          edge at the start of every UTC second. FTM0 latches its counter on
+ *          the edge; the channel interrupt reads the counter and the 64-bit
+ *          LPIT timestamp together and takes the elapsed FTM counts back from
+ *          the timestamp. The edge time is then exact to one FTM count
+ *          (333ns at 3MHz) whatever the interrupt latency, as long as it is
+ *          under one wrap of the 16-bit counter (21.8ms).
+ *          Edges closer than PPS_PERIOD_MIN_US to the previous one are
+ *          glitches and dropped. The edge is handed to the main loop (Sync);
+ *          one it has not taken by the next edge is counted as an overrun.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef PPS_H
+#define PPS_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define PPS_PERIOD_MIN_US 				(900000U)  /* Shorter intervals are glitches */
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef struct
+{
+	unsigned int edges;              /* Edges accepted                         */
+	unsigned int glitches;           /* Edges too close to the previous one    */
+	unsigned int overruns;           /* Edges not taken by Pps_GetEdge in time */
+} Pps_StatsType;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+extern volatile Pps_StatsType Pps_Stats;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Starts the capture. Timestamp_Init() and the pin mux must be done.
+ */
+void Pps_Init(const Ftm_CaptureConfigType *ConfigPtr);
+
+/**
+ * @brief Timestamps the edge. Called from FTM0_Ch0_Ch1_IRQHandler.
+ */
+void Pps_IrqHandler(void);
+
+/**
+ * @brief Takes the last edge, in Timestamp_NowTicks() units.
+ * @return 1 if there was a new edge since the last call, 0 otherwise.
+ */
+unsigned char Pps_GetEdge(unsigned long long *ticks);
+
+#endif
@@ -19,15 +19,40 @@
 #define DISPLAY_TIME_MODE			(1)
 #define TURNOFF_DISPLAY_MODE	(0)		
 #define TURNON_DISPLAY_MODE		(1)
+#define SECONDS_PER_DAY				(86400UL)
+/*==================================================================================================
+*                                       STRUCTURES
+==================================================================================================*/
+typedef struct
+{
+	unsigned char  second;
+	unsigned char  minute;
+	unsigned char  hour;
+	unsigned char  day;
+	unsigned char  month;
+	unsigned short year;
+} DateTime_Type;
 /*==================================================================================================
 *                                       GLOBAL FUNCTION PROTOTYPE
 ==================================================================================================*/
 void Date(unsigned char *day_update);
 void Time(unsigned char *second_update);
+/* Seconds since 1970-01-01 00:00:00, valid up to 2106 */
+unsigned int DateTime_ToEpoch(const DateTime_Type *dt);
+void DateTime_FromEpoch(unsigned int epoch, DateTime_Type *dt);
+/* Copy of the running calendar; callers mask the LPIT tick around them */
+void DateTime_Get(DateTime_Type *dt);
+void DateTime_Set(const DateTime_Type *dt);
+/* Sets the UTC clock and loads its local time into the calendar; callers mask the LPIT tick */
+void DateTime_SetUtc(unsigned int utc);
+/* Takes the calendar, just set from UART in local time, as the new UTC clock; callers mask the LPIT tick */
+void DateTime_SyncUtc(void);
 /*==================================================================================================
 *                                       GLOBAL VARIABLES
 ==================================================================================================*/
 extern unsigned char second,minute,hour,day,month;
 extern unsigned short year;
+/* Seconds since 1970-01-01 UTC, counted by the LPIT tick next to the local calendar */
+extern volatile unsigned int DateTime_Utc;
 
 #endif
@@ -0,0 +1,91 @@
+/**
+ * @file    SoftTimer.h
+ * @brief   Software timer service driven by SysTick
+ * @details One-shot and periodic software timers sharing a single 1ms tick.
+ *          Timers are kept in a hierarchical timer wheel (4 levels: 256 slots of
+ *          1ms, then 3 x 64 slots), so start and stop are O(1) and a tick only
+ *          touches the timers that expire on it. The caller owns the timer
+ *          objects, so there is no fixed limit on how many can run.
+ *
+ * @note    Callbacks run in SysTick interrupt context and must be short.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SOFTTIMER_H
+#define SOFTTIMER_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define SOFTTIMER_TICK_HZ 				(1000U)          /* 1 tick = 1ms */
+#define SOFTTIMER_LVL0_BITS 			(8U)
+#define SOFTTIMER_LVLN_BITS 			(6U)
+#define SOFTTIMER_LEVELS 					(4U)
+/* Longest timeout that can be armed in one go: 2^26 ms, about 18.6 hours */
+#define SOFTTIMER_MAX_TICKS 			((1UL << (SOFTTIMER_LVL0_BITS + (SOFTTIMER_LEVELS - 1U) * SOFTTIMER_LVLN_BITS)) - 1UL)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef void (*SoftTimer_CallbackType)(void *arg);
+
+/**
+ * @brief Software timer object, allocated by the user (static or in a struct).
+ *        Must start zero-initialised; fields are private to SoftTimer.c.
+ */
+typedef struct SoftTimer_Type
+{
+	struct SoftTimer_Type  *next;        /* Next timer in the same wheel slot             */
+	struct SoftTimer_Type **pprev;       /* Link pointing at this timer, NULL = not armed */
+	unsigned int            expires;     /* Absolute tick of expiry                       */
+	unsigned int            period;      /* Reload in ticks, 0 = one-shot                 */
+	SoftTimer_CallbackType  callback;
+	void                   *arg;
+} SoftTimer_Type;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Starts SysTick at SOFTTIMER_TICK_HZ from the current core clock.
+ */
+void SoftTimer_Init(void);
+
+/**
+ * @brief Advances time by one tick and runs expired callbacks. Called from SysTick_Handler.
+ */
+void SoftTimer_Tick(void);
+
+/**
+ * @brief Arms (or re-arms) a timer.
+ *
+ * @param timer    Timer object, must stay valid while armed.
+ * @param delay    Ticks until the first expiry (clamped to 1..SOFTTIMER_MAX_TICKS).
+ * @param period   Reload in ticks for periodic timers, 0 for one-shot.
+ * @param callback Function called on expiry, in SysTick context.
+ * @param arg      Passed to callback.
+ */
+void SoftTimer_Start(SoftTimer_Type *timer, unsigned int delay, unsigned int period,
+                     SoftTimer_CallbackType callback, void *arg);
+
+/**
+ * @brief Cancels a timer. Does nothing if it is not armed.
+ */
+void SoftTimer_Stop(SoftTimer_Type *timer);
+
+/**
+ * @brief Returns 1 if the timer is armed.
+ */
+unsigned char SoftTimer_IsActive(const SoftTimer_Type *timer);
+
+/**
+ * @brief Returns the number of ticks since SoftTimer_Init (wraps after 2^32 ms).
+ */
+unsigned int SoftTimer_GetTicks(void);
+
+#endif
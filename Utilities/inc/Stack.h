@@ -0,0 +1,48 @@
+/**
+ * @file    Stack.h
+ * @brief   Main stack painting and high-water mark
+ * @details All code runs on MSP, so ARM_LIB_STACK from the scatter file is the
+ *          only stack. Stack_Paint() fills the free part of it with
+ *          STACK_PAINT_PATTERN at the top of main(); the high-water mark is the
+ *          distance from the top to the lowest word that no longer holds the
+ *          pattern. The static figure in Objects/Test.htm excludes interrupt
+ *          nesting and exception frames, this one includes them.
+ *          "GET STACK" on UART1 reports size, used and free bytes.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef STACK_H
+#define STACK_H
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define STACK_PAINT_PATTERN 			(0xC5C5C5C5UL)
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Paints the stack below the current stack pointer. Call first in main(),
+ *        before any interrupt is enabled.
+ */
+void Stack_Paint(void);
+
+/**
+ * @brief Size of the stack region in bytes.
+ */
+unsigned int Stack_GetSize(void);
+
+/**
+ * @brief Deepest stack use since Stack_Paint() in bytes.
+ */
+unsigned int Stack_GetUsed(void);
+
+/**
+ * @brief Returns 1 if the bottom word was overwritten, the stack may have overflowed.
+ */
+unsigned char Stack_IsOverflowed(void);
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file    Stats.h
+ * @brief   Runtime statistics: interrupt load, CPU load and traffic counters
+ * @details Each handler brackets its body with Stats_IrqEnter/Stats_IrqExit, which
+ *          read the DWT cycle counter and record trace entry/exit events.
+ *          Durations are inclusive: time spent in a higher priority interrupt
+ *          that preempted the handler is counted too.
+ *          CPU load is measured from the idle loop in main(): Stats_Idle() sleeps
+ *          in WFI with PRIMASK set, so the cycles it records exclude the handler
+ *          that woke it. The load is refreshed once per STATS_WINDOW_MS.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef STATS_H
+#define STATS_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+#include "Trace.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#ifndef STATS_ENABLE
+#define STATS_ENABLE 							1          /* Set to 0 to compile the instrumentation out */
+#endif
+#define STATS_WINDOW_MS 					(1000U)
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef enum
+{
+	STATS_IRQ_LPIT = 0U,
+	STATS_IRQ_UART,
+	STATS_IRQ_PORTC,
+	STATS_IRQ_ADC,
+	STATS_IRQ_SYSTICK,
+	STATS_IRQ_LVD_LVW,
+	STATS_IRQ_FTFC,
+	STATS_IRQ_FTM0,
+	STATS_IRQ_NUMBER
+} Stats_IrqIdType;
+
+typedef struct
+{
+	unsigned long long totalCycles;
+	unsigned int       maxCycles;
+	unsigned int       count;
+} Stats_IrqType;
+
+typedef struct
+{
+	unsigned int spiWords;       /* Words pushed to LPSPI1 (display)  */
+	unsigned int uartRxBytes;
+	unsigned int uartTxBytes;
+	unsigned int uartOverruns;   /* Received bytes lost (STAT[OR])    */
+} Stats_CounterType;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+extern volatile Stats_IrqType Stats_Irq[STATS_IRQ_NUMBER];
+extern volatile Stats_CounterType Stats_Counter;
+/* CPU load of the last window in 0.1% */
+extern volatile unsigned int Stats_CpuLoad;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Starts the CPU load window. The DWT counter is enabled by NVIC_CriticalStatsInit().
+ */
+void Stats_Init(void);
+
+/**
+ * @brief Clears all counters.
+ */
+void Stats_Reset(void);
+
+/**
+ * @brief Sleeps until the next interrupt and accounts the time as idle. Called from main loop.
+ */
+void Stats_Idle(void);
+
+/**
+ * @brief Short name of an interrupt for reports.
+ */
+const char* Stats_IrqName(Stats_IrqIdType id);
+
+/**
+ * @brief Returns the cycle counter at handler entry and traces the entry.
+ */
+static inline unsigned int Stats_IrqEnter(Stats_IrqIdType id)
+{
+	TRACE(TRACE_EVT_ISR_ENTER, id);
+#if (STATS_ENABLE == 1)
+	return DWT_CYCCNT;
+#else
+	(void)id;
+	return 0U;
+#endif
+}
+
+/**
+ * @brief Accounts one handler run that started at start.
+ */
+static inline void Stats_IrqExit(Stats_IrqIdType id, unsigned int start)
+{
+	TRACE(TRACE_EVT_ISR_EXIT, id);
+#if (STATS_ENABLE == 1)
+	unsigned int elapsed = DWT_CYCCNT - start;
+
+	Stats_Irq[id].count++;
+	Stats_Irq[id].totalCycles += elapsed;
+	if (elapsed > Stats_Irq[id].maxCycles)
+	{
+		Stats_Irq[id].maxCycles = elapsed;
+	}
+#else
+	(void)id;
+	(void)start;
+#endif
+}
+
+#endif
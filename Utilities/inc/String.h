@@ -24,14 +24,20 @@
 ==================================================================================================*/
 unsigned char my_atouchar (char* str);
 unsigned short my_atoushort(char *str);
+unsigned int my_atou(char *str);
 void my_strcpy(char *dest, const char *src);
 void my_strncpy(char *dest, const char *src, int n);
 char *my_strchr(char *str, char c);
 char *my_strtok(char* str, char* delim);
 unsigned char my_strlen(char *str);
+unsigned char my_utoa(unsigned int value, char *str);
+unsigned char my_utohex(unsigned int value, unsigned char digits, char *str);
 char stringcompare(unsigned char* str1, const unsigned char* str2);
 unsigned char Check_Format_Setting_Date(char *str);
 unsigned char Check_Format_Setting_Time(char *str);
+unsigned char Check_Format_Setting_Alarm(char *str);
+unsigned char Check_Format_Setting_Ppm(char *str);
+unsigned char Check_Format_Sync(char *str);
 
 #endif
 
@@ -0,0 +1,140 @@
+/**
+ * @file    Sync.h
+ * @brief   Clock discipline from a host time reference over UART1
+ * @details NTP-like exchange, host timestamps t1/t4, device timestamps t2/t3,
+ *          all in microseconds since 1970-01-01 UTC:
+ *          - host -> device "SYNC s1 u1 s4 u4": t1 = send time of this frame,
+ *            t4 = receive time of the previous reply (0 0 if none);
+ *          - device -> host "SYNC s2 u2 s3 u3": t2 = first byte of the frame
+ *            received, t3 = first byte of the reply sent.
+ *          Each frame completes the previous exchange:
+ *          offset = ((t2 - t1) + (t3 - t4)) / 2 (device ahead when positive),
+ *          delay = (t4 - t1) - (t3 - t2).
+ *          An offset of SYNC_STEP_US or more is stepped: whole seconds on the
+ *          calendar, the rest as a tick phase shift. A smaller one is slewed by
+ *          a type 2 phase-locked loop, time constant SYNC_TIME_CONSTANT,
+ *          critically damped: the tick discipline is freq + offset / tau, freq
+ *          integrating offset * dt / (4 tau^2). freq converges to the frequency
+ *          error of the crystal, so the clock keeps it between exchanges.
+ *          Estimated accuracy: half the delay (path asymmetry bound) plus the
+ *          jitter, a running average of |offset|.
+ *          Device time between seconds comes from the 64-bit LPIT timestamp,
+ *          marked at every second with the timeout of the LPIT tick, read
+ *          back from the hardware (Tick_EdgeTicks, Sync_Second).
+ *          A PPS input (Pps), when present, takes over: its edges give the
+ *          phase to a fraction of a microsecond every second, so the same loop
+ *          runs with SYNC_PPS_TIME_CONSTANT and the serial exchanges only set
+ *          the whole seconds. The serial reference takes over again when the
+ *          PPS is lost.
+ *          Holdover: with no measurement for SYNC_PPS_TIMEOUT (PPS) or
+ *          SYNC_SERIAL_TIMEOUT seconds the phase slew stops and the clock runs
+ *          on the learnt frequency; the accuracy estimate then grows by
+ *          SYNC_HOLDOVER_PPB, the assumed wander of the crystal.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SYNC_H
+#define SYNC_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define SYNC_STEP_US 							(128000)
+#define SYNC_DELAY_MAX_US 				(100000U)  /* Slower round trips are dropped        */
+#define SYNC_TIME_CONSTANT 				(64)       /* Seconds, exchanges every 16s or less  */
+#define SYNC_INTERVAL_MAX 				(32U)      /* Longer gaps do not update freq        */
+#define SYNC_PPB_MAX 							(500000)   /* Slew limit                            */
+#define SYNC_LOCK_US 							(1000U)    /* Jitter under this: locked             */
+#define SYNC_SERIAL_TIMEOUT 			(128U)     /* Seconds without exchange: holdover    */
+#define SYNC_PPS_STEP_US 					(2000)
+#define SYNC_PPS_TIME_CONSTANT 		(16)       /* Seconds, one edge every second        */
+#define SYNC_PPS_LOCK_US 					(20U)
+#define SYNC_PPS_TIMEOUT 					(3U)       /* Seconds without edge: holdover        */
+#define SYNC_PPS_SETTLE 					(2U)       /* Edges skipped after a phase step      */
+#define SYNC_HOLDOVER_PPB 				(100U)     /* Accuracy lost per second of holdover  */
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef enum
+{
+	SYNC_STATE_NONE = 0U,            /* No exchange yet                            */
+	SYNC_STATE_TRACKING,             /* Following the reference                    */
+	SYNC_STATE_LOCKED,               /* Jitter below the lock limit of the source  */
+	SYNC_STATE_HOLDOVER              /* Source lost, running on the learnt freq    */
+} Sync_StateType;
+
+typedef enum
+{
+	SYNC_SOURCE_NONE = 0U,
+	SYNC_SOURCE_SERIAL,              /* Exchanges over UART1                       */
+	SYNC_SOURCE_PPS                  /* PPS edges, serial for the seconds only     */
+} Sync_SourceType;
+
+typedef struct
+{
+	unsigned int  count;             /* Measurements since the source took over    */
+	unsigned int  steps;
+	unsigned int  holdovers;
+	int           offsetUs;          /* Last offset, device ahead when positive    */
+	int           freqPpb;           /* Estimated crystal error, gains if positive */
+	unsigned int  delayUs;
+	unsigned int  jitterUs;
+	unsigned char state;             /* Sync_StateType                             */
+	unsigned char source;            /* Sync_SourceType                            */
+} Sync_StatusType;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Written by the UART handler and Sync_Process, under NVIC_EnterCritical(PRIORITY_UART) */
+extern Sync_StatusType Sync_Status;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Marks the start of UTC second utc at Timestamp ticks ticks, the
+ *        timeout of the tick (Tick_EdgeTicks). Called by the LPIT tick.
+ */
+void Sync_Second(unsigned int utc, unsigned long long ticks);
+
+/**
+ * @brief Device time in microseconds since 1970-01-01 UTC at a Timestamp_NowTicks() value.
+ */
+unsigned long long Sync_Now(unsigned long long ticks);
+
+/**
+ * @brief Takes a frame received at Timestamp ticks rxTicks: completes the
+ *        previous exchange with t4, starts a new one with t1.
+ * @return 1 if the clock was stepped, 0 otherwise.
+ */
+unsigned char Sync_Exchange(unsigned long long t1, unsigned long long t4, unsigned long long rxTicks);
+
+/**
+ * @brief Gives t2 of the last frame and takes t3 now, just before the reply is sent.
+ */
+void Sync_Reply(unsigned long long *t2, unsigned long long *t3);
+
+/**
+ * @brief Takes a PPS edge, once the second mark nearest to it is taken, and
+ *        checks for holdover. Called from the main loop.
+ * @return 1 if an edge was processed, 0 otherwise.
+ */
+unsigned char Sync_Process(void);
+
+/**
+ * @brief Estimated accuracy of the clock in microseconds.
+ */
+unsigned int Sync_GetAccuracy(void);
+
+/**
+ * @brief Seconds since the last measurement, 0 if none.
+ */
+unsigned int Sync_GetAge(void);
+
+#endif
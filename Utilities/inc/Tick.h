@@ -0,0 +1,90 @@
+/**
+ * @file    Tick.h
+ * @brief   Calibrated 250ms calendar tick
+ * @details LPIT channel 3 times the calendar. The exact number of LPIT clocks
+ *          in one tick, f_lpit * TICK_PERIOD_US / 1000000 with the corrections
+ *          applied, is rarely whole: it is kept in 32.32 fixed point, each tick
+ *          is programmed with the whole part and the fraction is carried to the
+ *          next one. The tick is then at most one LPIT clock (1us) off its
+ *          ideal edge and never drifts.
+ *          Two corrections add up, both positive when the clock gains:
+ *          - calibration, the measured error of the crystal in ppm (UART);
+ *          - discipline, in ppb, set by a time reference (Sync).
+ *          A phase shift lengthens or shortens the coming ticks by a number of
+ *          clocks, at most half a tick at a time.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef TICK_H
+#define TICK_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+#include "Timestamp.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define TICK_CHANNEL 							(LPIT_CHANNEL_3)
+#define TICK_PERIOD_US 						(250000U)
+#define TICK_PPM_MAX 							(500)
+#ifndef TICK_PPM_DEFAULT
+#define TICK_PPM_DEFAULT 					(0)        /* Measured error of the board crystal */
+#endif
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Calibration in force, ppm the clock would gain without it */
+extern volatile int Tick_Ppm;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Programs the first period with TICK_PPM_DEFAULT. The channel must be
+ *        initialised and not yet started.
+ */
+void Tick_Init(void);
+
+/**
+ * @brief Sets the calibration, applied from the next tick on.
+ * @return 1 if ppm is within +-TICK_PPM_MAX, 0 otherwise (unchanged).
+ */
+unsigned char Tick_SetCalibration(int ppm);
+
+/**
+ * @brief Sets the discipline correction in ppb, on top of the calibration.
+ *        The caller bounds it.
+ */
+void Tick_SetDiscipline(int ppb);
+
+/**
+ * @brief Moves the clock phase: clocks > 0 delays it, clocks < 0 advances it.
+ */
+void Tick_Shift(int clocks);
+
+/**
+ * @brief Programs the length of the period after the running one. Called at
+ *        every tick from the LPIT handler.
+ */
+void Tick_Update(void);
+
+/**
+ * @brief Timestamp_NowTicks() value at the timeout that started the running
+ *        tick: the clocks channel 3 counted since it reloaded (loaded TVAL -
+ *        CVAL) are taken back from the timestamp, so the result does not
+ *        depend on the interrupt latency.
+ * @details First thing in the LPIT handler: Tick_Update() overwrites TVAL.
+ */
+static inline unsigned long long Tick_EdgeTicks(void)
+{
+	unsigned long long now = Timestamp_NowTicks();
+	unsigned int counted = LPIT0->TMR[TICK_CHANNEL].TVAL - LPIT0->TMR[TICK_CHANNEL].CVAL;
+
+	return now - counted;
+}
+
+#endif
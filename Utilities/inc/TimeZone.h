@@ -0,0 +1,78 @@
+/**
+ * @file    TimeZone.h
+ * @brief   Time zone and daylight saving rules
+ * @details The zone is given as a POSIX TZ string, for example
+ *          "CET-1CEST,M3.5.0,M10.5.0/3" or "EST5EDT,M3.2.0,M11.1.0".
+ *          Rules: Mm.w.d (day d of week w of month m, w = 5 is the last one),
+ *          Jn (day 1..365, Feb 29 never counted) and n (day 0..365), each
+ *          with an optional /time, default 02:00:00. A zone with a DST name
+ *          but no rules uses the US rules.
+ *          The offset in force and the UTC epochs of the transitions around
+ *          it are cached: converting a UTC second to local time is two
+ *          compares and one add (TimeZone_GetOffset); the rules are only
+ *          evaluated again when a transition is passed or the clock is set.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef TIMEZONE_H
+#define TIMEZONE_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#ifndef TIMEZONE_DEFAULT
+#define TIMEZONE_DEFAULT 					"UTC0"     /* Zone at boot, set per deployment */
+#endif
+#define TIMEZONE_NEVER 						(0xFFFFFFFFU)
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* Seconds east of UTC in force from TimeZone_Previous until TimeZone_Next (UTC epochs) */
+extern volatile int TimeZone_Current;
+extern volatile unsigned int TimeZone_Previous;
+extern volatile unsigned int TimeZone_Next;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Loads TIMEZONE_DEFAULT.
+ */
+void TimeZone_Init(void);
+
+/**
+ * @brief Parses and loads a POSIX TZ string.
+ * @return 1 if the string was valid, 0 otherwise (the zone is unchanged).
+ */
+unsigned char TimeZone_Set(const char *tz);
+
+/**
+ * @brief Evaluates the rules at utc and refills the cache.
+ */
+void TimeZone_Update(unsigned int utc);
+
+/**
+ * @brief UTC epoch of a local time. In the hour skipped or repeated by a
+ *        transition, the standard time reading is used.
+ */
+unsigned int TimeZone_LocalToUtc(unsigned int local);
+
+/**
+ * @brief Offset in seconds east of UTC at utc.
+ */
+static inline int TimeZone_GetOffset(unsigned int utc)
+{
+	if ((utc >= TimeZone_Next) || (utc < TimeZone_Previous))
+	{
+		TimeZone_Update(utc);
+	}
+	return TimeZone_Current;
+}
+
+#endif
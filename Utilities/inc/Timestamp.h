@@ -0,0 +1,73 @@
+/**
+ * @file    Timestamp.h
+ * @brief   Free-running 64-bit microsecond timestamp
+ * @details LPIT channel 0 counts the LPIT clock down from 0xFFFFFFFF, channel 1
+ *          is chained to it and counts the wraps of channel 0. Together they form
+ *          a 64-bit counter that never needs an interrupt.
+ *
+ *          Resolution is 1us (the LPIT clock is SOSCDIV2 = 1MHz on this board;
+ *          any integer multiple of 1MHz works). The counter starts at 0 in
+ *          Timestamp_Init and wraps after 2^64 us (about 584000 years), so
+ *          differences of two timestamps never need wrap handling.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#define TIMESTAMP_CHANNEL_LOW 		(LPIT_CHANNEL_0)
+#define TIMESTAMP_CHANNEL_HIGH 		(LPIT_CHANNEL_1)
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+/* LPIT clocks per microsecond, 0 until Timestamp_Init succeeded */
+extern unsigned int Timestamp_TicksPerUs;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Starts the chained channels. Lpit_Init() must have been called.
+ */
+void Timestamp_Init(void);
+
+/**
+ * @brief Returns the raw 64-bit LPIT tick count.
+ * @details The high word is read before and after the low word; if channel 0
+ *          wrapped in between the low word is read again. No lock is needed.
+ */
+static inline unsigned long long Timestamp_NowTicks(void)
+{
+	unsigned int high;
+	unsigned int low;
+
+	do
+	{
+		high = LPIT0->TMR[TIMESTAMP_CHANNEL_HIGH].CVAL;
+		low = LPIT0->TMR[TIMESTAMP_CHANNEL_LOW].CVAL;
+	} while (high != LPIT0->TMR[TIMESTAMP_CHANNEL_HIGH].CVAL);
+	/* Both channels count down from 0xFFFFFFFF */
+	return ((unsigned long long)(~high) << 32) | (unsigned long long)(~low);
+}
+
+/**
+ * @brief Returns microseconds since Timestamp_Init. A few register reads when
+ *        the LPIT clock is 1MHz, a 64-bit division otherwise.
+ */
+static inline unsigned long long Timestamp_Now(void)
+{
+	unsigned long long ticks = Timestamp_NowTicks();
+
+	return (Timestamp_TicksPerUs > 1U) ? (ticks / Timestamp_TicksPerUs) : ticks;
+}
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file    Trace.h
+ * @brief   Binary event trace in a RAM ring buffer
+ * @details Each record is 8 bytes: the low 32 bits of the LPIT timestamp (us),
+ *          an event id and a 16-bit argument. The newest TRACE_BUFFER_SIZE
+ *          records are kept. TRACE() compiles to nothing with TRACE_ENABLE = 0;
+ *          when enabled a record costs a flag test, a timer read and four stores
+ *          with PRIMASK set. "GET TRACE" on UART1 dumps the buffer as text, which
+ *          Tools/trace2chrome.py converts to Chrome/Perfetto trace JSON.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+==================================================================================================*/
+#ifndef TRACE_H
+#define TRACE_H
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Config.h"
+#include "Timestamp.h"
+/*==================================================================================================
+*                                    MACRO DEFINITIONS
+==================================================================================================*/
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 							1          /* Set to 0 to compile every TRACE() out */
+#endif
+#define TRACE_BUFFER_SIZE 				(128U)     /* Records, power of 2 */
+/*==================================================================================================
+*                                    STRUCTURES
+==================================================================================================*/
+typedef enum
+{
+	TRACE_EVT_ISR_ENTER = 1U,         /* arg: Stats_IrqIdType                  */
+	TRACE_EVT_ISR_EXIT,               /* arg: Stats_IrqIdType                  */
+	TRACE_EVT_SPI_FRAME_START,        /* arg: words in the frame               */
+	TRACE_EVT_SPI_FRAME_END,          /* arg: words in the frame (all queued)  */
+	TRACE_EVT_UART_COMMAND,           /* arg: command state (SET_DATE, ...)    */
+	TRACE_EVT_TIME_ROLLOVER           /* arg: 0 minute, 1 hour, 2 day          */
+} Trace_EventType;
+
+typedef struct
+{
+	unsigned int   timestamp;
+	unsigned short event;
+	unsigned short arg;
+} Trace_RecordType;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+extern Trace_RecordType Trace_Buffer[TRACE_BUFFER_SIZE];
+extern volatile unsigned int Trace_Head;          /* Records written since reset */
+extern volatile unsigned char Trace_Enabled;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief Clears the buffer and starts recording.
+ */
+void Trace_Init(void);
+
+/**
+ * @brief Copies record number index (0 = oldest kept). Returns 0 if out of range.
+ */
+unsigned char Trace_Read(unsigned int index, Trace_RecordType *record);
+
+/**
+ * @brief Number of records currently kept.
+ */
+unsigned int Trace_Count(void);
+
+#if (TRACE_ENABLE == 1)
+/**
+ * @brief Appends one record. Safe from any context.
+ */
+static inline void Trace_Record(Trace_EventType event, unsigned short arg)
+{
+	Trace_RecordType *record;
+	unsigned int primask;
+
+	if (Trace_Enabled == 0U) return;
+	primask = NVIC_EnterExclusive();
+	record = &Trace_Buffer[Trace_Head & (TRACE_BUFFER_SIZE - 1U)];
+	Trace_Head++;
+	record->timestamp = ~LPIT0->TMR[TIMESTAMP_CHANNEL_LOW].CVAL;
+	record->event = (unsigned short)event;
+	record->arg = arg;
+	NVIC_ExitExclusive(primask);
+}
+#define TRACE(event, arg) 			Trace_Record((event), (unsigned short)(arg))
+#else
+#define TRACE(event, arg) 			((void)0)
+#endif
+
+#endif
@@ -15,13 +15,23 @@
 /*==================================================================================================
 *                                       MACRO DEFINITIONS
 ==================================================================================================*/
-#define MAX_LENGHT 					 20
+#define MAX_LENGHT 					 48
 #define NOT_SETTING 				 0
 #define SET_DATE 						 2
 #define SET_TIME 						 1
+#define GET_STATS 					 3
+#define GET_TRACE 					 5
+#define GET_STACK 					 6
+#define SET_ALARM 					 7
+#define GET_ALARMS 					 8
+#define CLEAR_ALARMS 				 9
+#define SET_ZONE 						 10
+#define SET_CALIB 					 11
+#define GET_SYNC 						 12
 #define START_SETTING 			 4
 #define INPUT_COMPLETE  		 1
 #define INPUT_NONE_COMPLETE  0
+#define ERROR_HOLD_MS 			 2000       /* "Err" stays on the display this long */
 /*==================================================================================================
 *                                       INCLUDE FILES
 ==================================================================================================*/
@@ -35,21 +45,41 @@ extern unsigned char Date_Updated_Str[20];
 extern unsigned char Time_Updated_Str[20];
 extern unsigned char Time_Format_Str[40];
 extern unsigned char Date_Format_Str[40];
+extern unsigned char Alarm_Format_Str[48];
+extern unsigned char Zone_Format_Str[51];
+extern unsigned char Calib_Format_Str[42];
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
-void print_error_string(void);
 void reset_received_data(void);
 void receive_data(void);
+void receive_overrun(void);
 void reset_data(volatile unsigned char *str);
 void process_setting(volatile unsigned char *state_set);
+unsigned char Check_Overrun(void);
 unsigned char Check_Date_Format(void);
 unsigned char Check_Time_Format(void);
+unsigned char Check_Alarm_Format(void);
+unsigned char Check_Calib_Format(void);
+unsigned char Check_Sync_Format(void);
 void Update_Date(unsigned char *day, unsigned char *month, unsigned short *year);
 void Update_Time(unsigned char *second, unsigned char *minute, unsigned char *hour);
+void Update_Alarm(unsigned int *timeOfDay, unsigned char *repeat);
+unsigned char Update_Zone(void);
+void Update_Calib(int *ppm);
+void Update_Sync(unsigned long long *t1, unsigned long long *t4, unsigned long long *rxTicks);
 void print_Date_Updated_Str(void);
 void print_Time_Updated_Str(void);
 void print_Output(char *str);
+void print_Rejected(unsigned char state_set);
+void print_Stats(void);
+void print_Trace(void);
+void print_Stack(void);
+void print_Alarms(void);
+void print_Zone(void);
+void print_Calib(void);
+void print_Sync_Reply(void);
+void print_Sync(void);
 
 
 #endif
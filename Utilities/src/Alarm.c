@@ -0,0 +1,221 @@
+/**
+ * @file    Alarm.c
+ * @brief   One-shot and recurring alarms
+ * @details Heap order: a parent never fires after its children. 1970-01-01 was
+ *          a Thursday, so the weekday of day number d is (d + 4) % 7, 0 = Sunday.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Alarm.h"
+#include "ProcessDateTime.h"
+#include "SoftTimer.h"
+#include "Log.h"
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define ALARM_SUNDAY 							(0U)
+#define ALARM_SATURDAY 						(6U)
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static unsigned char Alarm_LastId;
+static SoftTimer_Type Alarm_Timer;
+static volatile unsigned int Alarm_RingLeft;                  /* Blinks left, 0 = silent */
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+Alarm_Type Alarm_Heap[ALARM_MAX];
+volatile unsigned int Alarm_Count;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned int Alarm_NextFiring(unsigned int timeOfDay, unsigned char repeat, unsigned int now);
+static void Alarm_SiftUp(unsigned int index);
+static void Alarm_SiftDown(unsigned int index);
+static void Alarm_Blink(void *arg);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+/* First epoch strictly after now at timeOfDay, on an allowed day */
+static unsigned int Alarm_NextFiring(unsigned int timeOfDay, unsigned char repeat, unsigned int now)
+{
+	unsigned int dayNumber = now / SECONDS_PER_DAY;
+	unsigned int weekday;
+
+	if (((dayNumber * SECONDS_PER_DAY) + timeOfDay) <= now)
+	{
+		dayNumber++;
+	}
+	if (repeat == ALARM_WEEKDAYS)
+	{
+		weekday = (dayNumber + 4U) % 7U;
+		if (weekday == ALARM_SATURDAY)
+		{
+			dayNumber += 2U;
+		}
+		else if (weekday == ALARM_SUNDAY)
+		{
+			dayNumber += 1U;
+		}
+		else
+		{
+			/*do not thing*/
+		}
+	}
+	return (dayNumber * SECONDS_PER_DAY) + timeOfDay;
+}
+
+static void Alarm_SiftUp(unsigned int index)
+{
+	Alarm_Type alarm = Alarm_Heap[index];
+	unsigned int parent;
+
+	while (index > 0U)
+	{
+		parent = (index - 1U) / 2U;
+		if (Alarm_Heap[parent].next <= alarm.next) break;
+		Alarm_Heap[index] = Alarm_Heap[parent];
+		index = parent;
+	}
+	Alarm_Heap[index] = alarm;
+}
+
+static void Alarm_SiftDown(unsigned int index)
+{
+	Alarm_Type alarm = Alarm_Heap[index];
+	unsigned int child;
+
+	for (;;)
+	{
+		child = (2U * index) + 1U;
+		if (child >= Alarm_Count) break;
+		/* Earlier of the two children */
+		if (((child + 1U) < Alarm_Count) && (Alarm_Heap[child + 1U].next < Alarm_Heap[child].next))
+		{
+			child++;
+		}
+		if (alarm.next <= Alarm_Heap[child].next) break;
+		Alarm_Heap[index] = Alarm_Heap[child];
+		index = child;
+	}
+	Alarm_Heap[index] = alarm;
+}
+
+/* SoftTimer callback, toggles the output until the ring time is over */
+static void Alarm_Blink(void *arg)
+{
+	(void)arg;
+	if (Alarm_RingLeft == 0U)
+	{
+		SoftTimer_Stop(&Alarm_Timer);
+		GPIO_WriteToOutputPin(ALARM_GPIO, ALARM_PIN, ALARM_OUTPUT_IDLE);
+		return;
+	}
+	Alarm_RingLeft--;
+	GPIO_TogglePin(ALARM_GPIO, ALARM_PIN);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Alarm_Init(void)
+{
+	Alarm_Count = 0U;
+	GPIO_WriteToOutputPin(ALARM_GPIO, ALARM_PIN, ALARM_OUTPUT_IDLE);
+}
+
+unsigned char Alarm_Add(unsigned int timeOfDay, Alarm_RepeatType repeat, unsigned int now)
+{
+	unsigned int critical;
+	unsigned char id = 0U;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	if (Alarm_Count < ALARM_MAX)
+	{
+		/* Ids wrap over 1..255, 0 reports a full table */
+		Alarm_LastId = (Alarm_LastId == 255U) ? 1U : (unsigned char)(Alarm_LastId + 1U);
+		id = Alarm_LastId;
+		Alarm_Heap[Alarm_Count].timeOfDay = timeOfDay;
+		Alarm_Heap[Alarm_Count].repeat = (unsigned char)repeat;
+		Alarm_Heap[Alarm_Count].id = id;
+		Alarm_Heap[Alarm_Count].next = Alarm_NextFiring(timeOfDay, (unsigned char)repeat, now);
+		Alarm_Count++;
+		Alarm_SiftUp(Alarm_Count - 1U);
+	}
+	NVIC_ExitCritical(critical);
+	return id;
+}
+
+void Alarm_Clear(void)
+{
+	unsigned int critical;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	Alarm_Count = 0U;
+	NVIC_ExitCritical(critical);
+	(void)Alarm_Stop();
+}
+
+void Alarm_Reschedule(unsigned int now)
+{
+	unsigned int critical;
+	unsigned int i;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	for (i = 0U; i < Alarm_Count; i++)
+	{
+		if (Alarm_Heap[i].repeat != ALARM_ONCE)
+		{
+			Alarm_Heap[i].next = Alarm_NextFiring(Alarm_Heap[i].timeOfDay, Alarm_Heap[i].repeat, now);
+		}
+	}
+	/* Keys changed everywhere: rebuild bottom-up, O(n) */
+	for (i = Alarm_Count / 2U; i > 0U; i--)
+	{
+		Alarm_SiftDown(i - 1U);
+	}
+	NVIC_ExitCritical(critical);
+}
+
+void Alarm_Fire(unsigned int now)
+{
+	unsigned int critical;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	/* Step 1. Every alarm due, several may share the second */
+	while ((Alarm_Count != 0U) && (Alarm_Heap[0].next <= now))
+	{
+		LOG2(LOG_ALARM_FIRED, Alarm_Heap[0].id, Alarm_Heap[0].next);
+		if (Alarm_Heap[0].repeat == ALARM_ONCE)
+		{
+			Alarm_Count--;
+			Alarm_Heap[0] = Alarm_Heap[Alarm_Count];
+		}
+		else
+		{
+			Alarm_Heap[0].next = Alarm_NextFiring(Alarm_Heap[0].timeOfDay, Alarm_Heap[0].repeat, now);
+		}
+		if (Alarm_Count != 0U)
+		{
+			Alarm_SiftDown(0U);
+		}
+	}
+	NVIC_ExitCritical(critical);
+	/* Step 2. Ring, a firing during a ring restarts it */
+	Alarm_RingLeft = ALARM_RING_MS / ALARM_BLINK_MS;
+	SoftTimer_Start(&Alarm_Timer, ALARM_BLINK_MS, ALARM_BLINK_MS, Alarm_Blink, NULL);
+}
+
+unsigned char Alarm_Stop(void)
+{
+	unsigned char ringing = SoftTimer_IsActive(&Alarm_Timer);
+
+	SoftTimer_Stop(&Alarm_Timer);
+	Alarm_RingLeft = 0U;
+	GPIO_WriteToOutputPin(ALARM_GPIO, ALARM_PIN, ALARM_OUTPUT_IDLE);
+	return ringing;
+}
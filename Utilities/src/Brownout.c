@@ -0,0 +1,107 @@
+/**
+ * @file    Brownout.c
+ * @brief   State snapshot on low voltage warning
+ * @details The handler does the minimum before the record is programmed: read
+ *          the counter, fill and program the record, then statistics.
+ *          SoftTimer and Log lock with BASEPRI, which does not mask priority 0:
+ *          the handler only sets Brownout_Disarmed, a periodic timer started by
+ *          Brownout_Init() does the re-arming and the logging.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Brownout.h"
+#include "Pmc.h"
+#include "SoftTimer.h"
+#include "Log.h"
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static Journal_SourceType Brownout_Source;
+static SoftTimer_Type Brownout_Timer;
+static unsigned int Brownout_CyclesPerUs;
+static volatile unsigned char Brownout_Disarmed;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+volatile Brownout_StatsType Brownout_Stats;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static void Brownout_Check(void *arg);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+/* SoftTimer callback: the supply came back if the warning is no longer latched after acknowledging it */
+static void Brownout_Check(void *arg)
+{
+	(void)arg;
+	if (Brownout_Disarmed == 0U) return;
+	Pmc_SetLowVoltageWarning(0U);
+	if (Pmc_IsLowVoltageWarning() == 1U)
+	{
+		/* Still low: check again next period */
+		return;
+	}
+	Brownout_Disarmed = 0U;
+	Pmc_SetLowVoltageWarning(1U);
+	LOG3(LOG_BROWNOUT_RECOVERED, Brownout_Stats.count, Brownout_CyclesToUs(Brownout_Stats.lastCycles),
+	     Brownout_CyclesToUs(Brownout_Stats.maxCycles));
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Brownout_Init(void)
+{
+	Brownout_CyclesPerUs = Clock_GetFrequency(CORE_CLK) / 1000000U;
+	Brownout_Disarmed = 0U;
+	SoftTimer_Start(&Brownout_Timer, BROWNOUT_REARM_MS, BROWNOUT_REARM_MS, Brownout_Check, NULL);
+	/* A warning latched before the journal was ready is dropped */
+	Pmc_SetLowVoltageWarning(1U);
+}
+
+void Brownout_SetSource(Journal_SourceType source)
+{
+	Brownout_Source = source;
+}
+
+void Brownout_IrqHandler(void)
+{
+	unsigned int start = DWT_CYCCNT;
+	Journal_RecordType record;
+	unsigned int cycles;
+
+	/* Step 1. Snapshot first */
+	if (Brownout_Source != NULL)
+	{
+		Brownout_Source(&record);
+		if (Journal_Snapshot(&record) != FTFC_OK)
+		{
+			Brownout_Stats.errors++;
+		}
+	}
+	cycles = DWT_CYCCNT - start;
+	/* Step 2. One snapshot per warning: the flag stays latched while the supply is low */
+	Pmc_SetLowVoltageWarning(0U);
+	Brownout_Disarmed = 1U;
+	/* Step 3. Statistics */
+	Brownout_Stats.count++;
+	Brownout_Stats.lastCycles = cycles;
+	if (cycles > Brownout_Stats.maxCycles)
+	{
+		Brownout_Stats.maxCycles = cycles;
+	}
+	if (cycles > (BROWNOUT_BUDGET_US * Brownout_CyclesPerUs))
+	{
+		Brownout_Stats.overBudget++;
+	}
+}
+
+unsigned int Brownout_CyclesToUs(unsigned int cycles)
+{
+	return (Brownout_CyclesPerUs != 0U) ? (cycles / Brownout_CyclesPerUs) : cycles;
+}
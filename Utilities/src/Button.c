@@ -0,0 +1,225 @@
+/**
+ * @file    Button.c
+ * @brief   Debounced push buttons with gesture events
+ * @details Each button is either idle (pin interrupt armed, no CPU load) or
+ *          sampled every BUTTON_SAMPLE_MS by its own SoftTimer.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Button.h"
+/*==================================================================================================
+*                                      LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	SoftTimer_Type timer;
+	unsigned int   pressTick;
+	unsigned int   releaseTick;
+	unsigned char  raw;           /* Last sample, 1 = pressed          */
+	unsigned char  stable;        /* Debounced level, 1 = pressed      */
+	unsigned char  count;         /* Samples differing from stable     */
+	unsigned char  longSent;
+	unsigned char  clickPending;  /* Last press was a short click      */
+	unsigned char  doubleSent;
+} Button_StateType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static const Button_ConfigType *Button_Table;
+static unsigned char Button_Count;
+static Button_CallbackType Button_Callback;
+static Button_StateType Button_State[BUTTON_MAX_NUMBER];
+static Button_StatsType Button_Stats[BUTTON_MAX_NUMBER];
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static void Button_Emit(unsigned char button, Button_EventType event);
+static void Button_Arm(const Button_ConfigType *config);
+static void Button_Disarm(const Button_ConfigType *config);
+static void Button_Sample(void *arg);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+static void Button_Emit(unsigned char button, Button_EventType event)
+{
+	Button_Stats[button].events++;
+	if (Button_Callback != NULL)
+	{
+		Button_Callback(button, event);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
+
+/* Clears a stale flag, then enables the falling edge interrupt */
+static void Button_Arm(const Button_ConfigType *config)
+{
+	unsigned int regValue = config->port->PCR[config->pin];
+
+	regValue &= ~PORT_PCR_IRQC_MASK;
+	regValue |= (1u << PORT_PCR_ISF_SHIFT) | ((unsigned int)PORT_INT_FALLING_EDGE << PORT_PCR_IRQC_SHIFT);
+	config->port->PCR[config->pin] = regValue;
+}
+
+/* Disables the interrupt and clears its flag (ISF is w1c) in one write */
+static void Button_Disarm(const Button_ConfigType *config)
+{
+	unsigned int regValue = config->port->PCR[config->pin];
+
+	regValue &= ~PORT_PCR_IRQC_MASK;
+	regValue |= (1u << PORT_PCR_ISF_SHIFT);
+	config->port->PCR[config->pin] = regValue;
+}
+
+static void Button_Sample(void *arg)
+{
+	Button_StateType *state = (Button_StateType *)arg;
+	unsigned char button = (unsigned char)(state - Button_State);
+	const Button_ConfigType *config = &Button_Table[button];
+	unsigned int now = SoftTimer_GetTicks();
+	unsigned char raw;
+
+	/* Step 1. Sample, count every level change */
+	raw = (GPIO_ReadStateInputPin(config->gpio, config->pin) == 0U) ? 1U : 0U;
+	if (raw != state->raw)
+	{
+		state->raw = raw;
+		Button_Stats[button].rawEdges++;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 2. Debounce: accept a new level after BUTTON_DEBOUNCE_SAMPLES in a row */
+	if (raw != state->stable)
+	{
+		state->count++;
+		if (state->count >= BUTTON_DEBOUNCE_SAMPLES)
+		{
+			state->stable = raw;
+			state->count = 0U;
+			if (raw != 0U)
+			{
+				Button_Emit(button, BUTTON_EVENT_PRESS);
+				state->doubleSent = 0U;
+				if ((state->clickPending != 0U) && ((now - state->releaseTick) <= BUTTON_DOUBLE_PRESS_MS))
+				{
+					state->doubleSent = 1U;
+					Button_Emit(button, BUTTON_EVENT_DOUBLE_PRESS);
+				}
+				else
+				{
+					/*do not thing*/
+				}
+				state->clickPending = 0U;
+				state->longSent = 0U;
+				state->pressTick = now;
+			}
+			else
+			{
+				Button_Emit(button, BUTTON_EVENT_RELEASE);
+				state->clickPending = ((state->longSent == 0U) && (state->doubleSent == 0U)) ? 1U : 0U;
+				state->releaseTick = now;
+			}
+		}
+		else
+		{
+			/*do not thing*/
+		}
+	}
+	else
+	{
+		state->count = 0U;
+	}
+	/* Step 3. Long press while held */
+	if ((state->stable != 0U) && (state->longSent == 0U) && ((now - state->pressTick) >= BUTTON_LONG_PRESS_MS))
+	{
+		state->longSent = 1U;
+		Button_Emit(button, BUTTON_EVENT_LONG_PRESS);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 4. Released and settled: back to interrupt mode */
+	if ((state->stable == 0U) && (state->count == 0U))
+	{
+		Button_Arm(config);
+		/* A press between the last sample and re-arming gave no edge, keep sampling */
+		if (GPIO_ReadStateInputPin(config->gpio, config->pin) == 0U)
+		{
+			Button_Disarm(config);
+		}
+		else
+		{
+			SoftTimer_Stop(&state->timer);
+		}
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Button_Init(const Button_ConfigType *table, unsigned char count)
+{
+	unsigned char index;
+
+	/* Step 1. Check parameter */
+	if ((table == NULL) || (count > BUTTON_MAX_NUMBER)) return;
+	Button_Table = table;
+	Button_Count = count;
+	/* Step 2. All buttons start released, waiting for an edge */
+	for (index = 0U; index < count; index++)
+	{
+		Button_Arm(&table[index]);
+	}
+}
+
+void Button_SetEventCallback(Button_CallbackType callback)
+{
+	Button_Callback = callback;
+}
+
+void Button_IrqHandler(PORT_Type *port)
+{
+	unsigned int flags = port->ISFR;
+	const Button_ConfigType *config;
+	unsigned char index;
+
+	for (index = 0U; index < Button_Count; index++)
+	{
+		config = &Button_Table[index];
+		if ((config->port == port) && ((flags >> config->pin) & 0x01u))
+		{
+			/* Step 1. First edge: stop interrupts, the bounce is left to the sampler */
+			Button_Disarm(config);
+			Button_Stats[index].irqCount++;
+			Button_Stats[index].rawEdges++;
+			Button_State[index].raw = 1U;
+			Button_State[index].count = 0U;
+			/* Step 2. Start sampling */
+			SoftTimer_Start(&Button_State[index].timer, BUTTON_SAMPLE_MS, BUTTON_SAMPLE_MS,
+			                Button_Sample, &Button_State[index]);
+		}
+		else
+		{
+			/*do not thing*/
+		}
+	}
+}
+
+const Button_StatsType* Button_GetStats(unsigned char button)
+{
+	if (button >= Button_Count) return NULL;
+	return &Button_Stats[button];
+}
@@ -3,6 +3,7 @@
  * @brief   System Configuration for Peripherals
  * @details This file initializes system clocks, NVIC, UART, SPI, LPIT, 
  *          ADC, and button configurations for the microcontroller.
+ *          Every setting is a const table in flash, applied by a short loop.
  *
  * @version 1.0
  * @date    2024-10-09
@@ -12,214 +13,184 @@
 *                                       INCLUDE FILE
 ==================================================================================================*/
 #include "Config.h"
+#include "SoftTimer.h"
+#include "Button.h"
+#include "Timestamp.h"
+#include "Stats.h"
+#include "Tick.h"
+#include "Pps.h"
 /*==================================================================================================
-*                                      LOCAL VARIABLES
+*                                      LOCAL TYPES
 ==================================================================================================*/
-static Port_ConfigType PORTC_Pin6;
-static Port_ConfigType PORTC_Pin7;
-static Port_ConfigType PORTC_Pin12;
-static Port_ConfigType PORTC_Pin13;
-static Port_ConfigType PORTC_Pin14;
-static Port_ConfigType PORTB_Pin14;
-static Port_ConfigType PORTB_Pin15;
-static Port_ConfigType PORTB_Pin16;
-static Port_ConfigType PORTB_Pin17;
-static Pcc_ConfigType  PCC_PORTC;
-static Pcc_ConfigType  PCC_PORTD;
-static Pcc_ConfigType  PCC_PORTB;
-static Pcc_ConfigType  PCC_UART1;
-static Pcc_ConfigType  PCC_UART0;
-static Pcc_ConfigType  PCC_LPSPI1;
-static Pcc_ConfigType  PCC_ADC0;
-static Lpspi_ConfigType ConfigSPI1;
-static Pcc_ConfigType ConfigLPIT;
-static Scg_Firc_ConfigType ConfigFIRC;
-static Scg_Sosc_ConfigType ConfigSOSC;
-static Lpit_ChannelConfigType ConfigLPIT_CH3;
-static Lpuart_ConfigType ConfigUART;
+typedef struct
+{
+	IRQn_Type     irq;          /* Interrupt number          */
+	unsigned int  priority;     /* Preemption priority 0..15 */
+} Config_IrqType;
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+/* All board configuration lives in flash; nothing below is copied to RAM at boot. */
+
+/* FIRC: DIV2 = 48MHz for LPUART/LPSPI/ADC. SOSC: DIV2 = 1MHz for LPIT. */
+static const Scg_Firc_ConfigType Config_Firc = { SCG_CLOCK_DISABLE, SCG_CLOCK_DIV_BY_1 };
+static const Scg_Sosc_ConfigType Config_Sosc = { SCG_CLOCK_DIV_BY_2, SCG_CLOCK_DIV_BY_8 };
+
+static const Pcc_ConfigType Config_PccTable[] =
+{
+	/* clockName     clkGate          clkSrc        */
+	{ PORTC_CLK,    CLK_GATE_ENABLE, CLK_SRC_OFF  },
+	{ PORTD_CLK,    CLK_GATE_ENABLE, CLK_SRC_OFF  },
+	{ PORTB_CLK,    CLK_GATE_ENABLE, CLK_SRC_OFF  },
+	{ LPUART0_CLK,  CLK_GATE_ENABLE, CLK_SRC_OP_3 },   /* FIRCDIV2 */
+	{ LPUART1_CLK,  CLK_GATE_ENABLE, CLK_SRC_OP_3 },   /* FIRCDIV2 */
+	{ LPSPI1_CLK,   CLK_GATE_ENABLE, CLK_SRC_OP_3 },   /* FIRCDIV2 */
+	{ LPIT0_CLK,    CLK_GATE_ENABLE, CLK_SRC_OP_1 },   /* SOSCDIV2 */
+	{ ADC0_CLK,     CLK_GATE_ENABLE, CLK_SRC_OP_3 },   /* FIRCDIV2 */
+	{ FTM0_CLK,     CLK_GATE_ENABLE, CLK_SRC_OFF  },   /* Counts the system clock */
+};
+
+static const Config_IrqType Config_IrqTable[] =
+{
+	{ LPUART1_RxTx_IRQn, PRIORITY_UART      },
+	{ PORTC_IRQn,        PRIORITY_BUTTON    },
+	{ LPIT0_Ch3_IRQ,     PRIORITY_LPIT_TICK },
+	{ ADC0_IRQ,          PRIORITY_ADC       },
+	{ LVD_LVW_IRQ,       PRIORITY_BROWNOUT  },
+	{ FTFC_IRQ,          PRIORITY_FLASH     },
+	{ FTM0_Ch0_Ch1_IRQ,  PRIORITY_PPS       },
+};
+
+/* Pins grouped by identical settings, one Port_InitMulti() call per group */
+static const Port_MultiConfigType Config_PinTable[] =
+{
+	/* base   pinMask                                         pullConfig            driveSelect            mux                intConfig             */
+	{ PORTC,  (1u<<6)  | (1u<<7),                             PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_ALT2,     PORT_DMA_INT_DISABLED },  /* UART1 RX/TX           */
+	{ PORTB,  (1u<<14) | (1u<<15) | (1u<<16) | (1u<<17),     PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_ALT3,     PORT_DMA_INT_DISABLED },  /* SPI1 SCK/SIN/SOUT/CS3 */
+	{ PORTC,  (1u<<12) | (1u<<13),                            PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_AS_GPIO,  PORT_INT_FALLING_EDGE },  /* Button 1/2            */
+	{ PORTC,  (1u<<14),                                       PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_PIN_DISABLED, PORT_DMA_INT_DISABLED },  /* ADC0_SE12             */
+	{ PORTD,  (1u<<0),                                        PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_AS_GPIO,  PORT_DMA_INT_DISABLED },  /* Alarm output          */
+	{ PORTC,  (1u<<0),                                        PORT_NO_PULL_UP_DOWN, PORT_LOW_DRV_STRENGTH, PORT_MUX_ALT2,     PORT_DMA_INT_DISABLED },  /* PPS in, FTM0_CH0      */
+};
+
+static const GPIO_Pin_Config_t Config_GpioTable[] =
+{
+	{ GPIOC, 12, GPIO_MODE_INPUT },   /* Button 1 */
+	{ GPIOC, 13, GPIO_MODE_INPUT },   /* Button 2 */
+	{ GPIOD, 0,  GPIO_MODE_OUTPUT },  /* Alarm    */
+};
 
+/* Index is the button number reported in events (BUTTON_1, BUTTON_2) */
+static const Button_ConfigType Config_ButtonTable[] =
+{
+	{ PORTC, GPIOC, 12 },
+	{ PORTC, GPIOC, 13 },
+};
+
+/* UART1: 19200 baud, interrupt RX, queued TX, one stop bit, no parity bit, idle line with 8 character */
+static const Lpuart_ConfigType Config_Uart1 =
+{
+	.pUARTx = LPUART1,
+	.Init =
+	{
+		.lpuart_enable_int_TX        = 1,
+		.lpuart_enable_int_RX        = 1,
+		.lpuart_enable_idl           = 1,
+		.lpuart_baudrate             = 19200,
+		.lpuart_oversampling         = oversampling_ratio_10,
+		.lpuart_stop_bit             = ONE_STOP_BIT,
+		.lpuart_data_frame           = FRAME_8_BIT,
+		.lpuart_parity_bit           = LPUART_DISABLE_PARITY_BIT,
+		.lpuart_number_character_idl = IDLE_CHARACTER_8,
+	},
+};
+
+/* SPI1: ~10MHz, 16 bits, chip select 3, CPOL = 0, CPHA = 0, MSB data transfer */
+static const Lpspi_ConfigType Config_Spi1 =
+{
+	.pSPIx = LPSPI1,
+	.Init =
+	{
+		.spi_speed         = 10000000,   /* 48MHz / 5 = 9.6MHz, MAX7219 max is 10MHz */
+		.spi_prescaler     = LPSPI_PRE_DIV_BY_1,
+		.spi_type_transfer = LPSPI_MSB_FIRST,
+		.spi_frame         = LPSPI_FRAME_16,
+		.spi_cpol          = SPI_CPOL_0,
+		.spi_cpha          = SPI_CPHA_0,
+		.spi_pcs           = LPSPI_PCS_3,
+		.spi_dbt           = 1,          /* CS high 3 x 20.8ns >= 50ns tCSW */
+	},
+	.TxLen = 13,
+};
+
+/* LPIT channel 3: 250ms tick with interrupt, each period then set by the tick calibration */
+static const Lpit_ChannelConfigType Config_LpitCh3 = { .periodUs = TICK_PERIOD_US, .isInterruptEnabled = 1 };
+
+/* FTM0 channel 0: PPS capture, 48MHz / 16 = 3MHz, wraps every 21.8ms; filter 4 x 4 clocks = 333ns */
+static const Ftm_CaptureConfigType Config_Pps =
+{
+	.pFTMx              = PPS_FTM,
+	.prescaler          = FTM_PRESCALER_DIV_16,
+	.channel            = PPS_CHANNEL,
+	.edge               = FTM_EDGE_RISING,
+	.filter             = 4,
+	.isInterruptEnabled = 1,
+};
+
+#define CONFIG_TABLE_SIZE(table)   (sizeof(table) / sizeof((table)[0]))
 /*==================================================================================================
 *                                      LOCAL FUNCTIONS
 ==================================================================================================*/
 static void Config_Clock(void)
 {
-	/*Confugure clock source for LPITUART*/
-	ConfigFIRC.div1=0;
-	ConfigFIRC.div2=1;
-	Clock_SetScgFircConfig(&ConfigFIRC);
-	
-	/*Confugure clock source for LPIT*/
-	ConfigSOSC.div1=SCG_CLOCK_DIV_BY_2;
-	ConfigSOSC.div2=SCG_CLOCK_DIV_BY_8;
-	Clock_SetScgSoscConfig(&ConfigSOSC);
-	
-	/*Enable Port Clock*/
-	/*Enable clock for PORTC: PCC[CGC]*/
-	PCC_PORTC.clockName = PORTC_CLK;
-	PCC_PORTC.clkGate = CLK_GATE_ENABLE;
-	Clock_SetPccConfig(&PCC_PORTC);
-	
-	/*Enable clock for PORTB: PCC[CGC]*/
-	PCC_PORTD.clockName = PORTD_CLK;
-	PCC_PORTD.clkGate = CLK_GATE_ENABLE;
-	Clock_SetPccConfig(&PCC_PORTD);
-	
-	PCC_PORTB.clockName = PORTB_CLK;
-	PCC_PORTB.clkGate = CLK_GATE_ENABLE;
-	Clock_SetPccConfig(&PCC_PORTB);
-	
-	/*Peripheral Clock Source Select of UART_Channel0: PCC[PCS]*/
-	PCC_UART0.clkGate = CLK_GATE_ENABLE;
-	PCC_UART0.clkSrc = CLK_SRC_OP_3;
-	PCC_UART0.clockName =  LPUART0_CLK;
-	Clock_SetPccConfig(&PCC_UART0);
-	
-	/*Peripheral Clock Source Select: PCC[PCS]*/
-	PCC_UART1.clkGate = CLK_GATE_ENABLE;
-	PCC_UART1.clkSrc = CLK_SRC_OP_3;
-	PCC_UART1.clockName =  LPUART1_CLK;
-	Clock_SetPccConfig(&PCC_UART1);
-	
-	/* Enable clock for LPSPI: PCC[CGC]*/
-	PCC_LPSPI1.clkGate = CLK_GATE_ENABLE;
-	PCC_LPSPI1.clkSrc = CLK_SRC_OP_3;
-	PCC_LPSPI1.clockName = LPSPI1_CLK;
-	Clock_SetPccConfig(&PCC_LPSPI1);
-	
-	/* Enable clock for LPIT: PCC[CGC]*/
-	ConfigLPIT.clkGate=CLK_GATE_ENABLE;
-	ConfigLPIT.clockName=LPIT0_CLK;
-	ConfigLPIT.clkSrc=CLK_SRC_OP_1;
-	Clock_SetPccConfig(&ConfigLPIT);
-	
-	/* Enable clock for ADC0: PCC[CGC]*/
-	PCC_ADC0.clockName = ADC0_CLK;
-	PCC_ADC0.clkSrc = CLK_SRC_OP_3;
-	PCC_ADC0.clkGate = CLK_GATE_ENABLE;
-	Clock_SetPccConfig(&PCC_ADC0);
-	
+	unsigned int i;
+
+	Clock_SetScgFircConfig(&Config_Firc);
+	Clock_SetScgSoscConfig(&Config_Sosc);
+	for (i = 0; i < CONFIG_TABLE_SIZE(Config_PccTable); i++)
+	{
+		Clock_SetPccConfig(&Config_PccTable[i]);
+	}
 }
 
 static void Config_NVIC(void)
 {
-	/*Configures NVIC for LPITUART1*/
-	NVIC_EnableInterrupt(LPUART1_RxTx_IRQn); 
-	NVIC_SetPriority(LPUART1_RxTx_IRQn, 9);
-	
-	/*Configures NVIC for Button*/
-	NVIC_EnableInterrupt(PORTC_IRQn);
-	NVIC_SetPriority(PORTC_IRQn, 5);
-	
-	/*Setting NIVIC for LPIT Channel 3*/
-	NVIC_SetPriority(LPIT0_Ch3_IRQ, 0);
-	NVIC_EnableInterrupt(LPIT0_Ch3_IRQ);
-	
-	/*Setting NIVIC for ADC Channel 0*/
-	NVIC_EnableInterrupt(ADC0_IRQ);
-	NVIC_SetPriority(ADC0_IRQ, 10);
-}
+	unsigned int i;
 
-
-static void Config_UART_1(void)
-{
-	/*Set alternate function pins: PORT_PCR[MUX]*/
-	PORTC_Pin6.base = PORTC;
-	PORTC_Pin6.mux = 2; 
-	PORTC_Pin6.pinPortIdx = 6;
-	Port_Init(&PORTC_Pin6);
-	PORTC_Pin7.base = PORTC;
-	PORTC_Pin7.mux = 2;
-	PORTC_Pin7.pinPortIdx = 7;
-	Port_Init(&PORTC_Pin7);
-	/*Configure UART1: Baudrate 19200, interrupt RX, 
-	one stop bit, no parity bit, idle line with 8 character*/
-	ConfigUART.pUARTx= LPUART1;
-	ConfigUART.Init.lpuart_baudrate_modulo_divisor= 250;
-	ConfigUART.Init.lpuart_data_frame = FRAME_8_BIT;
-	ConfigUART.Init.lpuart_oversampling = oversampling_ratio_10;
-	ConfigUART.Init.lpuart_enable_int_RX = 1;
-	ConfigUART.Init.lpuart_parity_bit = LPUART_DISABLE_PARITY_BIT;
-	ConfigUART.Init.lpuart_stop_bit = ONE_STOP_BIT;
-	ConfigUART.Init.lpuart_enable_idl = 1;
-	ConfigUART.Init.lpuart_number_character_idl = IDLE_CHARACTER_8;
-	Lpuart_Init (&ConfigUART);
+	for (i = 0; i < CONFIG_TABLE_SIZE(Config_IrqTable); i++)
+	{
+		NVIC_SetPriority(Config_IrqTable[i].irq, Config_IrqTable[i].priority);
+		NVIC_EnableInterrupt(Config_IrqTable[i].irq);
+	}
 }
 
-static void Config_Buttons(void)
-{
-	/* Configure Pin 12 of Port C is GPIO */
-	PORTC_Pin12.base = PORTC;
-	PORTC_Pin12.pinPortIdx= 12;
-	PORTC_Pin12.mux= 1;
-	PORTC_Pin12.intConfig= PORT_INT_FALLING_EDGE;
-	Port_Init(&PORTC_Pin12);
-	
-	PORTC_Pin13.base = PORTC;
-	PORTC_Pin13.pinPortIdx= 13;
-	PORTC_Pin13.mux= 1;
-	PORTC_Pin13.intConfig= PORT_INT_FALLING_EDGE;
-	Port_Init(&PORTC_Pin13);
-	
-	/* Configure Pin 12&13 of Port C is input */
-	GPIO_Init (GPIOC, 12, GPIO_MODE_INPUT);
-	GPIO_Init (GPIOC, 13, GPIO_MODE_INPUT);
-}
-	
-static void Config_SPI(void) 
+static void Config_Pins(void)
 {
-	/* Set alternate function pin: PORT_PCR[MUX]*/
-	PORTB_Pin14.base = PORTB;
-	PORTB_Pin15.base = PORTB;
-	PORTB_Pin16.base = PORTB;
-	PORTB_Pin17.base = PORTB;
-	
-	PORTB_Pin14.pinPortIdx = 14; /*SCK*/
-	PORTB_Pin15.pinPortIdx = 15; /*SIN*/
-	PORTB_Pin16.pinPortIdx = 16; /*SOUT*/
-	PORTB_Pin17.pinPortIdx = 17; /*CS3*/
-	
-	PORTB_Pin14.mux= PORT_MUX_ALT3; 
-	PORTB_Pin15.mux= PORT_MUX_ALT3;
-	PORTB_Pin16.mux= PORT_MUX_ALT3;
-	PORTB_Pin17.mux= PORT_MUX_ALT3;
+	unsigned int i;
 
-	Port_Init(&PORTB_Pin14);
-	Port_Init(&PORTB_Pin15);
-	Port_Init(&PORTB_Pin16);
-	Port_Init(&PORTB_Pin17);
-	
-	
-	/*Configure SPI1: Speed 1MHZ, 16 bits, chip select 3, 
-	CPOL = 0, CPHA = 0, MSB data transfer*/
-	ConfigSPI1.pSPIx = LPSPI1;
-	ConfigSPI1.TxLen = 13;
-	ConfigSPI1.Init.spi_sck_div = 46;
-	ConfigSPI1.Init.spi_cpol = SPI_CPOL_0;
-	ConfigSPI1.Init.spi_cpha = SPI_CPHA_0;
-	ConfigSPI1.Init.spi_frame = LPSPI_FRAME_16;
-	ConfigSPI1.Init.spi_pcs = LPSPI_PCS_3;
-	ConfigSPI1.Init.spi_prescaler = LPSPI_PRE_DIV_BY_1;
-	ConfigSPI1.Init.spi_type_transfer = LPSPI_MSB_FIRST;
-	Lpspi_Init (&ConfigSPI1);
+	/* Alternate functions for UART1, SPI1, buttons, ADC input and alarm output: PORT_PCR[MUX] */
+	for (i = 0; i < CONFIG_TABLE_SIZE(Config_PinTable); i++)
+	{
+		Port_InitMulti(&Config_PinTable[i]);
+	}
+	for (i = 0; i < CONFIG_TABLE_SIZE(Config_GpioTable); i++)
+	{
+		GPIO_Init(Config_GpioTable[i].base, Config_GpioTable[i].GPIO_PinNumber, Config_GpioTable[i].GPIO_PinMode);
+	}
 }
 
 static void Config_LPIT(void)
 {
-	/*Congigure LPIT: enable interrupt, period = 250000 (=250ms), f = 1MHZ*/
 	Lpit_Init();
-	ConfigLPIT_CH3.isInterruptEnabled = 1;
-	ConfigLPIT_CH3.period = 250000+1;
-	Lpit_InitChannel(3, &ConfigLPIT_CH3);
-	Lpit_StartChannel(3);
+	/* Channels 0/1: chained 64-bit microsecond timestamp */
+	Timestamp_Init();
+	Lpit_InitChannel(TICK_CHANNEL, &Config_LpitCh3);
+	Tick_Init();
+	Lpit_StartChannel(TICK_CHANNEL);
 }
 
 static void Config_ADC(void)
 {
-	PORTC_Pin14.base = PORTC;
-	PORTC_Pin14.mux = 0; 
-	PORTC_Pin14.pinPortIdx = 14;
-	Port_Init(&PORTC_Pin14);
-	
 	ADC0_CFG1 |= (1U<<5);
 	
 	/*Enable the calibration : SC3[CAL]*/
@@ -261,12 +232,18 @@ static void Config_ADC(void)
 ==================================================================================================*/
 void Config_System(void)
 {
+	NVIC_CriticalStatsInit();
 	Config_Clock();
 	Config_NVIC();
+	SoftTimer_Init();
+	Stats_Init();
+	Trace_Init();
 	Config_LPIT();
-	Config_UART_1();
-	Config_SPI();
-	Config_Buttons();
+	Config_Pins();
+	Pps_Init(&Config_Pps);
+	Button_Init(Config_ButtonTable, (unsigned char)CONFIG_TABLE_SIZE(Config_ButtonTable));
+	Lpuart_Init(&Config_Uart1);
+	Lpspi_Init(&Config_Spi1);
 	Config_ADC();
 }
 
@@ -0,0 +1,387 @@
+/**
+ * @file    Journal.c
+ * @brief   Time and settings journal in FlexNVM
+ * @details An erased phrase reads all 0xFF and ends the records of a sector.
+ *          Sequence numbers are compared with wrap-around. An empty journal is
+ *          formatted by the first write, not at boot.
+ *          Journal_Snapshot() runs at priority 0, above BASEPRI critical
+ *          sections: the slot reservation and the sector switch mask it with
+ *          PRIMASK. A slot reserved by the thread and never programmed because
+ *          the snapshot came first leaves a hole, the scan steps over one.
+ *          A write is a chain of queued FTFC commands, each started by the
+ *          completion callback of the previous one: [erase, header,] record.
+ *          Phrases are read with Ftfc_ReadPhrase(): one whose program or erase
+ *          was cut holds an uncorrectable ECC error, and a plain load of it
+ *          would take a BusFault at boot. Such a phrase counts as written and
+ *          invalid, like a CRC failure.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Journal.h"
+#include "Nvic.h"
+#include "SoftTimer.h"
+#include "Log.h"
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define JOURNAL_CRC_LENGTH 					(6U)       /* Bytes covered, the CRC is the last 2 */
+/* Journal_ReadPhrase() results */
+#define JOURNAL_PHRASE_DATA 				(0U)
+#define JOURNAL_PHRASE_ERASED 			(1U)
+#define JOURNAL_PHRASE_INVALID 			(2U)       /* ECC error, the copy is not valid */
+/*==================================================================================================
+*                                      LOCAL TYPES
+==================================================================================================*/
+/* First phrase of a sector */
+typedef struct
+{
+	unsigned int   sequence;
+	unsigned short eraseCount;
+	unsigned short crc;
+} Journal_HeaderType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static volatile unsigned int Journal_Active;                  /* Active sector               */
+static volatile unsigned int Journal_Next;                    /* Next free slot in it        */
+static unsigned int Journal_Sequence;
+static unsigned short Journal_EraseCount[JOURNAL_SECTOR_COUNT];   /* 0 = unknown         */
+static Journal_SourceType Journal_Source;
+static unsigned int Journal_LastWrite;
+static Journal_RecordType Journal_Last;
+static unsigned char Journal_HasLast;
+/* Write in progress, owned by the FTFC callbacks until Journal_Busy is cleared */
+static volatile unsigned char Journal_Busy;
+static Journal_RecordType Journal_Record;
+static Journal_HeaderType Journal_Header;
+static unsigned int Journal_Target;                           /* Sector being activated      */
+static unsigned int Journal_Pending;                          /* Address of the record       */
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+Journal_StatsType Journal_Stats;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned short Journal_Crc(const void *data);
+static unsigned int Journal_Address(unsigned int sector, unsigned int slot);
+static unsigned char Journal_ReadPhrase(unsigned int address, void *phrase);
+static unsigned char Journal_ReadHeader(unsigned int sector, Journal_HeaderType *header);
+static unsigned char Journal_ScanSector(unsigned int sector, Journal_RecordType *latest, unsigned int *next);
+static Ftfc_StatusType Journal_Activate(unsigned int sector, unsigned int sequence);
+static unsigned int Journal_Reserve(void);
+static Ftfc_StatusType Journal_Program(void);
+static void Journal_Fail(Ftfc_StatusType status, unsigned int address);
+static void Journal_Erased(Ftfc_StatusType status, void *arg);
+static void Journal_HeaderWritten(Ftfc_StatusType status, void *arg);
+static void Journal_Written(Ftfc_StatusType status, void *arg);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+/* CRC-16/CCITT of the first JOURNAL_CRC_LENGTH bytes of a phrase */
+static unsigned short Journal_Crc(const void *data)
+{
+	const unsigned char *byte = (const unsigned char *)data;
+	unsigned short crc = 0xFFFFU;
+	unsigned int i;
+	unsigned int bit;
+
+	for (i = 0U; i < JOURNAL_CRC_LENGTH; i++)
+	{
+		crc ^= (unsigned short)(byte[i] << 8);
+		for (bit = 0U; bit < 8U; bit++)
+		{
+			crc = ((crc & 0x8000U) != 0U) ? (unsigned short)((crc << 1) ^ 0x1021U) : (unsigned short)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+static unsigned int Journal_Address(unsigned int sector, unsigned int slot)
+{
+	return JOURNAL_BASE + (sector * FTFC_DFLASH_SECTOR_SIZE) + (slot * FTFC_PHRASE_SIZE);
+}
+
+/* Copies a phrase, returns JOURNAL_PHRASE_DATA, _ERASED or _INVALID */
+static unsigned char Journal_ReadPhrase(unsigned int address, void *phrase)
+{
+	unsigned char *copy = (unsigned char *)phrase;
+	unsigned char erased = 0xFFU;
+	unsigned int i;
+
+	if (Ftfc_ReadPhrase(address, copy) != FTFC_OK)
+	{
+		Journal_Stats.badPhrases++;
+		return JOURNAL_PHRASE_INVALID;
+	}
+	for (i = 0U; i < FTFC_PHRASE_SIZE; i++)
+	{
+		erased &= copy[i];
+	}
+	return (erased == 0xFFU) ? JOURNAL_PHRASE_ERASED : JOURNAL_PHRASE_DATA;
+}
+
+static unsigned char Journal_ReadHeader(unsigned int sector, Journal_HeaderType *header)
+{
+	if (Journal_ReadPhrase(Journal_Address(sector, 0U), header) != JOURNAL_PHRASE_DATA) return 0U;
+	return (header->crc == Journal_Crc(header)) ? 1U : 0U;
+}
+
+/* Latest valid record of a sector and the first erased slot */
+static unsigned char Journal_ScanSector(unsigned int sector, Journal_RecordType *latest, unsigned int *next)
+{
+	Journal_RecordType record;
+	unsigned char found = 0U;
+	unsigned int slot;
+
+	unsigned char read;
+
+	for (slot = 1U; slot <= JOURNAL_RECORDS_PER_SECTOR; slot++)
+	{
+		read = Journal_ReadPhrase(Journal_Address(sector, slot), &record);
+		if (read == JOURNAL_PHRASE_ERASED)
+		{
+			/* Hole before a snapshot, or the end of the records */
+			if ((slot == JOURNAL_RECORDS_PER_SECTOR)
+			    || (Journal_ReadPhrase(Journal_Address(sector, slot + 1U), &record) == JOURNAL_PHRASE_ERASED)) break;
+			continue;
+		}
+		/* A record cut by a power loss fails the CRC or the ECC and keeps its slot */
+		if ((read == JOURNAL_PHRASE_DATA) && (record.crc == Journal_Crc(&record)))
+		{
+			*latest = record;
+			found = 1U;
+		}
+	}
+	*next = slot;
+	return found;
+}
+
+/* Starts the erase of the next sector; Journal_HeaderWritten() makes it active */
+static Ftfc_StatusType Journal_Activate(unsigned int sector, unsigned int sequence)
+{
+	/* Step 1. Erase count: the old header's, or the highest known one if it was unreadable */
+	Journal_Header.eraseCount = Journal_EraseCount[sector];
+	if (Journal_Header.eraseCount == 0U)
+	{
+		Journal_Header.eraseCount = (unsigned short)Journal_Stats.maxEraseCount;
+	}
+	Journal_Header.eraseCount++;
+	Journal_Header.sequence = sequence;
+	Journal_Header.crc = Journal_Crc(&Journal_Header);
+	/* Step 2. Erase, then write the header: until then the previous sector stays active */
+	Journal_Target = sector;
+	return Ftfc_EraseSector(Journal_Address(sector, 0U), Journal_Erased, NULL);
+}
+
+/* Takes the next slot, returns its address */
+static unsigned int Journal_Reserve(void)
+{
+	unsigned int primask;
+	unsigned int address;
+
+	primask = NVIC_EnterExclusive();
+	address = Journal_Address(Journal_Active, Journal_Next);
+	Journal_Next++;
+	NVIC_ExitExclusive(primask);
+	return address;
+}
+
+/* Queues the record; the slot is spent even if programming fails */
+static Ftfc_StatusType Journal_Program(void)
+{
+	Journal_Pending = Journal_Reserve();
+	return Ftfc_ProgramPhrase(Journal_Pending, (const unsigned char *)&Journal_Record, Journal_Written, NULL);
+}
+
+static void Journal_Fail(Ftfc_StatusType status, unsigned int address)
+{
+	Journal_Stats.errors++;
+	LOG2(LOG_JOURNAL_ERROR, status, address);
+	Journal_Busy = 0U;
+}
+
+/* FTFC callbacks, in FTFC_IRQHandler context */
+static void Journal_Erased(Ftfc_StatusType status, void *arg)
+{
+	unsigned int address = Journal_Address(Journal_Target, 0U);
+
+	(void)arg;
+	Journal_Stats.erases++;
+	if (status == FTFC_OK)
+	{
+		status = Ftfc_ProgramPhrase(address, (const unsigned char *)&Journal_Header, Journal_HeaderWritten, NULL);
+	}
+	if (status != FTFC_OK) Journal_Fail(status, address);
+}
+
+static void Journal_HeaderWritten(Ftfc_StatusType status, void *arg)
+{
+	unsigned int primask;
+
+	(void)arg;
+	if (status != FTFC_OK)
+	{
+		Journal_Fail(status, Journal_Address(Journal_Target, 0U));
+		return;
+	}
+	/* Switch; a snapshot before this point went to the previous sector's last slot */
+	Journal_EraseCount[Journal_Target] = Journal_Header.eraseCount;
+	if (Journal_Header.eraseCount > Journal_Stats.maxEraseCount)
+	{
+		Journal_Stats.maxEraseCount = Journal_Header.eraseCount;
+	}
+	primask = NVIC_EnterExclusive();
+	Journal_Active = Journal_Target;
+	Journal_Sequence = Journal_Header.sequence;
+	Journal_Next = 1U;
+	NVIC_ExitExclusive(primask);
+	Journal_Stats.sequence = Journal_Header.sequence;
+	status = Journal_Program();
+	if (status != FTFC_OK) Journal_Fail(status, Journal_Pending);
+}
+
+static void Journal_Written(Ftfc_StatusType status, void *arg)
+{
+	(void)arg;
+	if (status != FTFC_OK)
+	{
+		Journal_Fail(status, Journal_Pending);
+		return;
+	}
+	Journal_Stats.writes++;
+	Journal_Busy = 0U;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+unsigned char Journal_Init(Journal_RecordType *latest)
+{
+	Journal_HeaderType header;
+	unsigned char valid = 0U;
+	unsigned char found = 0U;
+	unsigned int previous;
+	unsigned int unused;
+	unsigned int next;
+	unsigned int sector;
+
+	Journal_LastWrite = SoftTimer_GetTicks();
+	Journal_HasLast = 0U;
+	/* Step 1. The valid header with the newest sequence is the active sector */
+	for (sector = 0U; sector < JOURNAL_SECTOR_COUNT; sector++)
+	{
+		Journal_EraseCount[sector] = 0U;
+		if (Journal_ReadHeader(sector, &header) == 0U) continue;
+		Journal_EraseCount[sector] = header.eraseCount;
+		if (header.eraseCount > Journal_Stats.maxEraseCount)
+		{
+			Journal_Stats.maxEraseCount = header.eraseCount;
+		}
+		if ((valid == 0U) || ((int)(header.sequence - Journal_Sequence) > 0))
+		{
+			Journal_Active = sector;
+			Journal_Sequence = header.sequence;
+			valid = 1U;
+		}
+	}
+	/* Step 2. Nothing written yet: the first append formats sector 0 */
+	if (valid == 0U)
+	{
+		Journal_Active = JOURNAL_SECTOR_COUNT - 1U;
+		Journal_Sequence = 0U;
+		Journal_Next = JOURNAL_RECORDS_PER_SECTOR + 1U;
+		return 0U;
+	}
+	Journal_Stats.sequence = Journal_Sequence;
+	/* Step 3. Latest record, from the previous sector if the active one was just started */
+	found = Journal_ScanSector(Journal_Active, latest, &next);
+	Journal_Next = next;
+	if (found == 0U)
+	{
+		previous = (Journal_Active + JOURNAL_SECTOR_COUNT - 1U) % JOURNAL_SECTOR_COUNT;
+		if ((Journal_ReadHeader(previous, &header) == 1U) && (header.sequence == (Journal_Sequence - 1U)))
+		{
+			found = Journal_ScanSector(previous, latest, &unused);
+		}
+	}
+	if (found == 1U)
+	{
+		Journal_Last = *latest;
+		Journal_HasLast = 1U;
+	}
+	return found;
+}
+
+void Journal_SetSource(Journal_SourceType source)
+{
+	Journal_Source = source;
+}
+
+Ftfc_StatusType Journal_Append(Journal_RecordType *record)
+{
+	Ftfc_StatusType status;
+
+	/* Step 1. One write at a time */
+	if (Journal_Busy == 1U) return FTFC_ERROR_BUSY;
+	Journal_Busy = 1U;
+	record->crc = Journal_Crc(record);
+	Journal_Record = *record;
+	/* Step 2. Active sector full (last slot kept for a snapshot): the oldest one becomes the next active sector */
+	if (Journal_Next >= JOURNAL_RECORDS_PER_SECTOR)
+	{
+		status = Journal_Activate((Journal_Active + 1U) % JOURNAL_SECTOR_COUNT, Journal_Sequence + 1U);
+		if (status != FTFC_OK) Journal_Fail(status, Journal_Address(Journal_Target, 0U));
+	}
+	else
+	{
+		status = Journal_Program();
+		if (status != FTFC_OK) Journal_Fail(status, Journal_Pending);
+	}
+	return status;
+}
+
+Ftfc_StatusType Journal_Snapshot(Journal_RecordType *record)
+{
+	Ftfc_StatusType status;
+
+	/* Step 1. Journal not formatted yet, or a snapshot already took the last slot */
+	if (Journal_Next > JOURNAL_RECORDS_PER_SECTOR) return FTFC_ERROR_PARAM;
+	/* Step 2. Seal and program, no log: the UART would not drain before the power goes */
+	record->crc = Journal_Crc(record);
+	status = Ftfc_ProgramPhraseNow(Journal_Address(Journal_Active, Journal_Next), (const unsigned char *)record);
+	Journal_Next++;
+	if (status != FTFC_OK)
+	{
+		Journal_Stats.errors++;
+		return status;
+	}
+	Journal_Stats.writes++;
+	return FTFC_OK;
+}
+
+unsigned char Journal_Process(void)
+{
+	Journal_RecordType record;
+	unsigned int now = SoftTimer_GetTicks();
+
+	/* Step 1. Rate limit, and wait for the previous write */
+	if ((Journal_Source == NULL) || ((now - Journal_LastWrite) < JOURNAL_INTERVAL_MS)) return 0U;
+	if (Journal_Busy == 1U) return 0U;
+	Journal_LastWrite = now;
+	/* Step 2. Skip the write if nothing changed, e.g. the clock is stopped */
+	Journal_Source(&record);
+	if ((Journal_HasLast == 1U) && (record.epoch == Journal_Last.epoch)
+	    && (record.type == Journal_Last.type) && (record.settings == Journal_Last.settings))
+	{
+		return 0U;
+	}
+	(void)Journal_Append(&record);
+	Journal_Last = record;
+	Journal_HasLast = 1U;
+	return 1U;
+}
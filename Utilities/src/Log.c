@@ -0,0 +1,151 @@
+/**
+ * @file    Log.c
+ * @brief   Deferred-formatting logger
+ * @details Producers reserve a slot by moving Log_Head with compare-and-swap,
+ *          fill it and publish it by writing the header last. The single
+ *          consumer (idle loop) reads slots in order and stops at the first one
+ *          that is reserved but not yet published. Lines go to the LPUART1 TX
+ *          queue shared with the console; a record stays in the buffer until
+ *          the queue has room for its whole line, so nothing waits on the UART.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Log.h"
+#include "Timestamp.h"
+#include "Stats.h"
+#include "String.h"
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define LOG_HEADER_VALID 					(1UL << 31)
+#define LOG_HEADER_COUNT_SHIFT 		(16U)
+#define LOG_HEADER_ID_MASK 				(0xFFFFU)
+/* '@' + id + timestamp + 3 args, hex with spaces, '\n' and '\0' */
+#define LOG_LINE_LENGTH 					(1U + 4U + 9U + (LOG_MAX_ARGS * 9U) + 2U)
+/*==================================================================================================
+*                                      LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	volatile unsigned int header;      /* valid | count << 16 | id, written last */
+	unsigned int          timestamp;
+	unsigned int          args[LOG_MAX_ARGS];
+} Log_RecordType;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static Log_RecordType Log_Buffer[LOG_BUFFER_SIZE];
+static volatile unsigned int Log_Head;        /* Next slot to reserve       */
+static volatile unsigned int Log_Tail;        /* Next slot to send          */
+static volatile unsigned int Log_Dropped;
+static unsigned int Log_DroppedReported;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned char Log_AppendHex(char *str, unsigned int value);
+static void Log_Send(unsigned int id, unsigned int count, unsigned int timestamp, const unsigned int *args);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+/* " <hex>" without leading zeros, returns characters written */
+static unsigned char Log_AppendHex(char *str, unsigned int value)
+{
+	unsigned char digits = 1U;
+
+	while ((digits < 8U) && ((value >> (4U * digits)) != 0U))
+	{
+		digits++;
+	}
+	str[0] = ' ';
+	return (unsigned char)(1U + my_utohex(value, digits, &str[1]));
+}
+
+static void Log_Send(unsigned int id, unsigned int count, unsigned int timestamp, const unsigned int *args)
+{
+	char line[LOG_LINE_LENGTH];
+	unsigned char length;
+	unsigned int i;
+
+	/* Step 1. Format the line */
+	line[0] = '@';
+	length = (unsigned char)(1U + my_utohex(id, 4U, &line[1]));
+	length += Log_AppendHex(&line[length], timestamp);
+	for (i = 0U; (i < count) && (i < LOG_MAX_ARGS); i++)
+	{
+		length += Log_AppendHex(&line[length], args[i]);
+	}
+	line[length] = '\n';
+	length++;
+	/* Step 2. Queue it whole, Log_Process() checked the room: the RX interrupt is never held off */
+	Lpuart_Write(LPUART1, (unsigned char *)line, length);
+	Stats_Counter.uartTxBytes += length;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Log_Write(Log_IdType id, unsigned int count, unsigned int arg0, unsigned int arg1, unsigned int arg2)
+{
+	Log_RecordType *record;
+	unsigned int head;
+
+	/* Step 1. Reserve a slot, drop the record if the consumer is a full buffer behind */
+	do
+	{
+		head = Log_Head;
+		if ((head - Log_Tail) >= LOG_BUFFER_SIZE)
+		{
+			(void)__sync_fetch_and_add(&Log_Dropped, 1U);
+			return;
+		}
+	} while (!__sync_bool_compare_and_swap(&Log_Head, head, head + 1U));
+	/* Step 2. Fill it */
+	record = &Log_Buffer[head & (LOG_BUFFER_SIZE - 1U)];
+	record->timestamp = ~LPIT0->TMR[TIMESTAMP_CHANNEL_LOW].CVAL;
+	record->args[0] = arg0;
+	record->args[1] = arg1;
+	record->args[2] = arg2;
+	/* Step 3. Publish: header last, after the payload is visible */
+	__asm volatile ("dmb" : : : "memory");
+	record->header = LOG_HEADER_VALID | (count << LOG_HEADER_COUNT_SHIFT) | ((unsigned int)id & LOG_HEADER_ID_MASK);
+}
+
+unsigned char Log_Process(void)
+{
+	Log_RecordType *record;
+	unsigned int header;
+	unsigned int timestamp;
+	unsigned int args[LOG_MAX_ARGS];
+	unsigned int dropped = Log_Dropped;
+
+	/* Step 1. Keep the records while the TX queue cannot take a line, the TX interrupt wakes the idle loop */
+	if (Lpuart_GetTxSpace(LPUART1) < LOG_LINE_LENGTH) return 0U;
+	/* Step 2. Report losses once, as a record of its own */
+	if (dropped != Log_DroppedReported)
+	{
+		args[0] = dropped - Log_DroppedReported;
+		Log_DroppedReported = dropped;
+		Log_Send(LOG_DROPPED, 1U, ~LPIT0->TMR[TIMESTAMP_CHANNEL_LOW].CVAL, args);
+		return 1U;
+	}
+	/* Step 3. Oldest slot, stop if it is empty or still being written */
+	if (Log_Tail == Log_Head) return 0U;
+	record = &Log_Buffer[Log_Tail & (LOG_BUFFER_SIZE - 1U)];
+	header = record->header;
+	if ((header & LOG_HEADER_VALID) == 0U) return 0U;
+	__asm volatile ("dmb" : : : "memory");
+	timestamp = record->timestamp;
+	args[0] = record->args[0];
+	args[1] = record->args[1];
+	args[2] = record->args[2];
+	/* Step 4. Free the slot before the line is formatted */
+	record->header = 0U;
+	__asm volatile ("dmb" : : : "memory");
+	Log_Tail++;
+	Log_Send(header & LOG_HEADER_ID_MASK, (header >> LOG_HEADER_COUNT_SHIFT) & 0x3U, timestamp, args);
+	return 1U;
+}
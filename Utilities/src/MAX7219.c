@@ -4,6 +4,9 @@
  * @details This file contains the implementation of functions to control the MAX7219 LED driver,
  *          including initialization, displaying time and date, controlling display intensity, 
  *          and turning the display on or off.
+ *          Every register write goes to all cascaded devices as one continuous
+ *          CS frame of MAX7219_DEVICE_COUNT words. The first word shifted out ends
+ *          in the farthest device, so frames are built from the last device down.
  *
  * @version 1.0
  * @date    2024-10-09
@@ -13,69 +16,304 @@
 *                                       INCLUDE FILE
 ==================================================================================================*/
 #include "MAX7219.h"
+#include "Stats.h"
+/*==================================================================================================
+*                                       GLOBAL VARIABLES
+==================================================================================================*/
+unsigned char MAX7219_FrameBuffer[MAX7219_DEVICE_COUNT][MAX7219_DIGITS];
+MAX7219_StatsType MAX7219_Stats;
+/*==================================================================================================
+*                                       LOCAL CONSTANTS
+==================================================================================================*/
+#define MAX7219_FONT_FIRST 		(0x20U)
+#define MAX7219_FONT_LAST 		(0x7FU)
+/* 7-segment font for ASCII 0x20..0x7F, bits DP A B C D E F G. Letters without a
+   readable 7-segment form use the nearest shape, unknown characters are blank. */
+static const unsigned char MAX7219_Font[MAX7219_FONT_LAST - MAX7219_FONT_FIRST + 1U] =
+{
+	0x00, 0xB0, 0x22, 0x00, 0x00, 0x00, 0x00, 0x02,   /*   ! " # $ % & ' */
+	0x4E, 0x78, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00,   /* ( ) * + , - . / */
+	0x7E, 0x30, 0x6D, 0x79, 0x33, 0x5B, 0x5F, 0x70,   /* 0 1 2 3 4 5 6 7 */
+	0x7F, 0x7B, 0x00, 0x00, 0x00, 0x09, 0x00, 0x65,   /* 8 9 : ; < = > ? */
+	0x00, 0x77, 0x1F, 0x4E, 0x3D, 0x4F, 0x47, 0x5E,   /* @ A B C D E F G */
+	0x37, 0x06, 0x3C, 0x57, 0x0E, 0x54, 0x76, 0x7E,   /* H I J K L M N O */
+	0x67, 0x73, 0x05, 0x5B, 0x0F, 0x3E, 0x1C, 0x2A,   /* P Q R S T U V W */
+	0x37, 0x3B, 0x6D, 0x4E, 0x00, 0x78, 0x00, 0x08,   /* X Y Z [ \ ] ^ _ */
+	0x00, 0x7D, 0x1F, 0x0D, 0x3D, 0x6F, 0x47, 0x7B,   /* ` a b c d e f g */
+	0x17, 0x04, 0x18, 0x57, 0x06, 0x54, 0x15, 0x1D,   /* h i j k l m n o */
+	0x67, 0x73, 0x05, 0x5B, 0x0F, 0x1C, 0x1C, 0x2A,   /* p q r s t u v w */
+	0x37, 0x3B, 0x6D, 0x00, 0x00, 0x00, 0x00, 0x00,   /* x y z { | } ~   */
+};
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static unsigned char MAX7219_MarqueeGlyphs[MAX7219_MARQUEE_MAX];
+static unsigned int MAX7219_MarqueeLength;
+static unsigned int MAX7219_MarqueePosition;
+static unsigned char MAX7219_MarqueeLoop;
+static SoftTimer_Type MAX7219_MarqueeTimer;
+static SoftTimer_Type MAX7219_HoldTimer;
+/*==================================================================================================
+*                                   LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static void MAX7219_SendFrame(const unsigned short *pFrame);
+static unsigned char MAX7219_Glyph(char c);
+static void MAX7219_MarqueeStep(void *arg);
+static void MAX7219_HoldEnd(void *arg);
+/*==================================================================================================
+*                                       LOCAL FUNCTION
+==================================================================================================*/
+CODE_RAM static void MAX7219_SendFrame(const unsigned short *pFrame)
+{
+	unsigned int critical;
+	/* Writers run in LPIT and ADC interrupts, a frame must not be interleaved */
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	TRACE(TRACE_EVT_SPI_FRAME_START, MAX7219_DEVICE_COUNT);
+	Lpspi_TransmitContinuous(LPSPI1, pFrame, MAX7219_DEVICE_COUNT);
+	TRACE(TRACE_EVT_SPI_FRAME_END, MAX7219_DEVICE_COUNT);
+	MAX7219_Stats.frameCount++;
+	Stats_Counter.spiWords += MAX7219_DEVICE_COUNT;
+	NVIC_ExitCritical(critical);
+}
+CODE_RAM static unsigned char MAX7219_Glyph(char c)
+{
+	unsigned char code = (unsigned char)c;
+
+	if ((code < MAX7219_FONT_FIRST) || (code > MAX7219_FONT_LAST))
+	{
+		return 0U;
+	}
+	return MAX7219_Font[code - MAX7219_FONT_FIRST];
+}
+
+static void MAX7219_MarqueeStep(void *arg)
+{
+	unsigned char *Digit = MAX7219_FrameBuffer[0];
+	unsigned int digit;
+	unsigned int index;
+
+	(void)arg;
+	/* Step 1. Window of 8 glyphs; the text enters from the right and leaves on the left */
+	for (digit = 0U; digit < MAX7219_DIGITS; digit++)
+	{
+		/* Digit 7 is the leftmost */
+		index = MAX7219_MarqueePosition + (MAX7219_DIGITS - 1U - digit);
+		if ((index >= MAX7219_DIGITS) && ((index - MAX7219_DIGITS) < MAX7219_MarqueeLength))
+		{
+			Digit[digit] = MAX7219_MarqueeGlyphs[index - MAX7219_DIGITS];
+		}
+		else
+		{
+			Digit[digit] = 0U;
+		}
+	}
+	MAX7219_Refresh();
+	/* Step 2. Next position, end after the last glyph has left */
+	MAX7219_MarqueePosition++;
+	if (MAX7219_MarqueePosition > (MAX7219_MarqueeLength + MAX7219_DIGITS))
+	{
+		MAX7219_MarqueePosition = 0U;
+		if (MAX7219_MarqueeLoop == 0U)
+		{
+			SoftTimer_Stop(&MAX7219_MarqueeTimer);
+		}
+		else
+		{
+			/*do not thing*/
+		}
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
+
+static void MAX7219_HoldEnd(void *arg)
+{
+	/* Expiry alone ends the hold, the next LPIT tick redraws */
+	(void)arg;
+}
 /*==================================================================================================
 *                                       GLOBAL FUNCTION
 ==================================================================================================*/
+void MAX7219_WriteAll(unsigned short command)
+{
+	unsigned short Frame[MAX7219_DEVICE_COUNT];
+	unsigned int device;
+
+	for (device = 0U; device < MAX7219_DEVICE_COUNT; device++)
+	{
+		Frame[device] = command;
+	}
+	MAX7219_SendFrame(Frame);
+}
+
+CODE_RAM void MAX7219_Refresh(void)
+{
+	unsigned short Frame[MAX7219_DEVICE_COUNT];
+	unsigned int digit;
+	unsigned int device;
+	unsigned int start;
+	unsigned int elapsed;
+
+	start = DWT_CYCCNT;
+	for (digit = 0U; digit < MAX7219_DIGITS; digit++)
+	{
+		/* Step 1. Farthest device first */
+		for (device = 0U; device < MAX7219_DEVICE_COUNT; device++)
+		{
+			Frame[device] = (unsigned short)(((digit + 1U) << LED_REG_SHIFT)
+			              | MAX7219_FrameBuffer[MAX7219_DEVICE_COUNT - 1U - device][digit]);
+		}
+		/* Step 2. One CS frame loads digit register of every device */
+		MAX7219_SendFrame(Frame);
+	}
+	/* Step 3. Bus time of the refresh, until the last bit is out */
+	Lpspi_WaitIdle(LPSPI1);
+	elapsed = DWT_CYCCNT - start;
+	MAX7219_Stats.lastBusCycles = elapsed;
+	if (elapsed > MAX7219_Stats.maxBusCycles)
+	{
+		MAX7219_Stats.maxBusCycles = elapsed;
+	}
+	MAX7219_Stats.refreshCount++;
+}
+
+unsigned int MAX7219_RenderText(const char *text, unsigned char *glyphs, unsigned int max)
+{
+	unsigned int count = 0U;
+
+	if ((text == NULL) || (glyphs == NULL)) return 0U;
+	while ((*text != '\0') && (count < max))
+	{
+		/* A point shares the digit of the character before it */
+		if ((*text == '.') && (count > 0U) && ((glyphs[count - 1U] & MAX7219_SEG_DP) == 0U))
+		{
+			glyphs[count - 1U] |= MAX7219_SEG_DP;
+		}
+		else
+		{
+			glyphs[count] = MAX7219_Glyph(*text);
+			count++;
+		}
+		text++;
+	}
+	return count;
+}
+
+void MAX7219_DisplayString(unsigned char device, const char *text)
+{
+	unsigned char Glyphs[MAX7219_DIGITS];
+	unsigned int count;
+	unsigned int digit;
+
+	if (device >= MAX7219_DEVICE_COUNT) return;
+	count = MAX7219_RenderText(text, Glyphs, MAX7219_DIGITS);
+	/* Left aligned: first character on digit 7 */
+	for (digit = 0U; digit < MAX7219_DIGITS; digit++)
+	{
+		MAX7219_FrameBuffer[device][MAX7219_DIGITS - 1U - digit] = (digit < count) ? Glyphs[digit] : 0U;
+	}
+	MAX7219_Refresh();
+}
+
+void MAX7219_StartMarquee(const char *text, unsigned int stepMs, unsigned char loop)
+{
+	SoftTimer_Stop(&MAX7219_MarqueeTimer);
+	/* Glyphs are rendered once here, each step only copies them */
+	MAX7219_MarqueeLength = MAX7219_RenderText(text, MAX7219_MarqueeGlyphs, MAX7219_MARQUEE_MAX);
+	MAX7219_MarqueePosition = 0U;
+	MAX7219_MarqueeLoop = loop;
+	if (MAX7219_MarqueeLength == 0U) return;
+	SoftTimer_Start(&MAX7219_MarqueeTimer, stepMs, stepMs, MAX7219_MarqueeStep, NULL);
+}
+
+void MAX7219_StopMarquee(void)
+{
+	SoftTimer_Stop(&MAX7219_MarqueeTimer);
+}
+
+unsigned char MAX7219_IsMarqueeActive(void)
+{
+	return SoftTimer_IsActive(&MAX7219_MarqueeTimer);
+}
+
+void MAX7219_ShowMessage(const char *text, unsigned int holdMs)
+{
+	/* Step 1. Claim device 0 before drawing, the LPIT tick may come in between */
+	SoftTimer_Stop(&MAX7219_MarqueeTimer);
+	SoftTimer_Start(&MAX7219_HoldTimer, holdMs, 0U, MAX7219_HoldEnd, NULL);
+	/* Step 2. Draw */
+	MAX7219_DisplayString(0U, text);
+}
+
+unsigned char MAX7219_IsHeld(void)
+{
+	return ((SoftTimer_IsActive(&MAX7219_HoldTimer) != 0U) || (SoftTimer_IsActive(&MAX7219_MarqueeTimer) != 0U)) ? 1U : 0U;
+}
+
 void Init_MAX7219(void)
 {
 	/* Array to hold initialization commands for the MAX7219 */
-	unsigned short Init[4]= {NORMAL_MODE, NONE_DISPLAY_TEST, SCAN_LIMIT_ALL_DIGITS, DECODE_ALL_DIGITS};
-	/* Transmit the initialization commands to the MAX7219 via SPI */
-	Lpspi_Transmit(LPSPI1,Init,4);
-}
-
-void Display_Time(unsigned char second, unsigned char minute, unsigned char hour)
-{
-	 /* Array to hold data for displaying time; calculates LED values for seconds, minutes, and hours */
-	unsigned short Data_Time[8]={(LED_0 + (second%10))
-															, (LED_1 + (second/10))
-															, (LED_2 + 10)
-															, (LED_5 + 10)
-															, (LED_3 + (minute%10))
-															, (LED_4 + (minute/10))
-															, (LED_6 + (hour%10))
-															, (LED_7 + (hour/10))};
+	unsigned short Init[4]= {NORMAL_MODE, NONE_DISPLAY_TEST, SCAN_LIMIT_ALL_DIGITS, NO_DECODE_ALL_DIGITS};
+	unsigned int i;
+	/* Transmit the initialization commands to every MAX7219 via SPI */
+	for (i = 0U; i < 4U; i++)
+	{
+		MAX7219_WriteAll(Init[i]);
+	}
+}
+
+CODE_RAM void Display_Time(unsigned char second, unsigned char minute, unsigned char hour)
+{
+	unsigned char *Digit = MAX7219_FrameBuffer[0];
+	if (MAX7219_IsHeld() != 0U) return;
+	/* Glyphs for seconds, minutes, and hours */
+	Digit[0] = MAX7219_Glyph((char)('0' + second%10));
+	Digit[1] = MAX7219_Glyph((char)('0' + second/10));
+	Digit[2] = MAX7219_Glyph('-');
+	Digit[5] = MAX7219_Glyph('-');
+	Digit[3] = MAX7219_Glyph((char)('0' + minute%10));
+	Digit[4] = MAX7219_Glyph((char)('0' + minute/10));
+	Digit[6] = MAX7219_Glyph((char)('0' + hour%10));
+	Digit[7] = MAX7219_Glyph((char)('0' + hour/10));
 	/* Transmit the time data to the MAX7219 via SPI */
-	Lpspi_Transmit(LPSPI1,Data_Time,8);
+	MAX7219_Refresh();
 }
 
-void Display_Date(unsigned char day, unsigned char month, unsigned short year)
+CODE_RAM void Display_Date(unsigned char day, unsigned char month, unsigned short year)
 {
-	 /* Array to hold data for displaying date; includes bit manipulation for indicators */
-	unsigned short Data_Date[8]={((LED_6 + (day%10)) | (1U<<7))
-															, (LED_7 + (day/10))
-															, ((LED_4 + (month%10)) | (1U<<7))
-															, (LED_5 + (month/10))
-															, (LED_0 + (year%10))
-															, (LED_1 + ((year/10)%10))
-															, (LED_2 + ((year/100)%10))
-															, (LED_3 + (year/1000))};
+	unsigned char *Digit = MAX7219_FrameBuffer[0];
+	if (MAX7219_IsHeld() != 0U) return;
+	/* Glyphs for the date; decimal point after day and month */
+	Digit[6] = MAX7219_Glyph((char)('0' + day%10)) | MAX7219_SEG_DP;
+	Digit[7] = MAX7219_Glyph((char)('0' + day/10));
+	Digit[4] = MAX7219_Glyph((char)('0' + month%10)) | MAX7219_SEG_DP;
+	Digit[5] = MAX7219_Glyph((char)('0' + month/10));
+	Digit[0] = MAX7219_Glyph((char)('0' + year%10));
+	Digit[1] = MAX7219_Glyph((char)('0' + (year/10)%10));
+	Digit[2] = MAX7219_Glyph((char)('0' + (year/100)%10));
+	Digit[3] = MAX7219_Glyph((char)('0' + (year/1000)%10));
 	/* Transmit the date data to the MAX7219 via SPI */
-	Lpspi_Transmit(LPSPI1,Data_Date,8);
+	MAX7219_Refresh();
 }
 
 void Control_Intensity(unsigned short ADC_value)
 {
 	/* Calculate the intensity level based on the ADC value */
 	unsigned short Level= INTENSITY_REG + (ADC_value*15)/4096;
-	/* Transmit the intensity level to the MAX7219 via SPI */
-	Lpspi_Transmit(LPSPI1,&Level,1);
+	/* Transmit the intensity level to every MAX7219 via SPI */
+	MAX7219_WriteAll(Level);
 }
 
 void Turn_Off_Display(void)
 {
 	/* Set to shutdown mode */
-	unsigned short Shut_Down_Mode = SHUTDOWN_MODE;
-	/* Transmit the shutdown command to the MAX7219 via SPI */
-	Lpspi_Transmit(LPSPI1,&Shut_Down_Mode,1);
+	MAX7219_WriteAll(SHUTDOWN_MODE);
 }
 
 void Turn_On_Display(void)
 {
 	/* Set to normal mode */
-	unsigned short Normal_Mode = NORMAL_MODE;
-	/* Transmit the normal mode command to the MAX7219 via SPI */
-	Lpspi_Transmit(LPSPI1,&Normal_Mode,1);
+	MAX7219_WriteAll(NORMAL_MODE);
 }
-
-
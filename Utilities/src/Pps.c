@@ -0,0 +1,102 @@
+/**
+ * @file    Pps.c
+ * @brief   Pulse per second input, timestamped by FTM input capture
+ * @details FTM counts are converted to LPIT clocks with a 16.16 factor
+ *          computed once, so the handler needs no division.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Pps.h"
+#include "Timestamp.h"
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static FTM_Type *Pps_Ftm;
+static unsigned char Pps_Channel;
+static unsigned int Pps_TicksPerCount;               /* LPIT clocks per FTM count, 16.16      */
+static unsigned long long Pps_PeriodMinTicks;
+static unsigned long long Pps_LastTicks;             /* Last accepted edge                    */
+static unsigned long long Pps_EdgeTicks;             /* Edge not yet taken by Pps_GetEdge     */
+static unsigned char Pps_Pending;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+volatile Pps_StatsType Pps_Stats;
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Pps_Init(const Ftm_CaptureConfigType *ConfigPtr)
+{
+	unsigned int frequency;
+
+	Pps_Ftm = ConfigPtr->pFTMx;
+	Pps_Channel = ConfigPtr->channel;
+	Ftm_InitCapture(ConfigPtr);
+	frequency = Ftm_GetFrequency(Pps_Ftm);
+	if (frequency != 0U)
+	{
+		Pps_TicksPerCount = (unsigned int)((((unsigned long long)Timestamp_TicksPerUs * 1000000ULL) << 16) / frequency);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	Pps_PeriodMinTicks = (unsigned long long)PPS_PERIOD_MIN_US * Timestamp_TicksPerUs;
+}
+
+CODE_RAM void Pps_IrqHandler(void)
+{
+	unsigned long long now;
+	unsigned long long edge;
+	unsigned short counter;
+	unsigned short capture;
+
+	/* Step 1. Counter and timestamp back to back, then the capture */
+	counter = Ftm_GetCounter(Pps_Ftm);
+	now = Timestamp_NowTicks();
+	capture = Ftm_GetCapture(Pps_Ftm, Pps_Channel);
+	Ftm_ClearCapture(Pps_Ftm, Pps_Channel);
+	/* Step 2. Back to the edge: counts since the capture, modulo 2^16 */
+	edge = now - (((unsigned long long)(unsigned short)(counter - capture) * Pps_TicksPerCount) >> 16);
+	/* Step 3. Drop glitches */
+	if ((Pps_Stats.edges != 0U) && ((edge - Pps_LastTicks) < Pps_PeriodMinTicks))
+	{
+		Pps_Stats.glitches++;
+		return;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 4. Hand it over; an edge still pending was not taken in time */
+	if (Pps_Pending == 1U)
+	{
+		Pps_Stats.overruns++;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	Pps_LastTicks = edge;
+	Pps_EdgeTicks = edge;
+	Pps_Pending = 1U;
+	Pps_Stats.edges++;
+}
+
+unsigned char Pps_GetEdge(unsigned long long *ticks)
+{
+	unsigned char pending;
+	unsigned int critical;
+
+	critical = NVIC_EnterCritical(PRIORITY_PPS);
+	pending = Pps_Pending;
+	*ticks = Pps_EdgeTicks;
+	Pps_Pending = 0U;
+	NVIC_ExitCritical(critical);
+	return pending;
+}
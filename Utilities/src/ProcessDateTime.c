@@ -13,6 +13,12 @@
 *                                       INCLUDE FILE
 ==================================================================================================*/
 #include "ProcessDateTime.h"
+#include "Trace.h"
+#include "TimeZone.h"
+/*==================================================================================================
+*                                       GLOBAL VARIABLES
+==================================================================================================*/
+volatile unsigned int DateTime_Utc;
 /*==================================================================================================
 *                                       LOCAL FUNCTIONS PROTOTYPE
 ==================================================================================================*/
@@ -21,7 +27,7 @@ static unsigned char days_in_month(unsigned char Month, unsigned short Year);
 /*==================================================================================================
 *                                       LOCAL FUNCTIONS
 ==================================================================================================*/
-static unsigned char is_leap_year(unsigned short Year)
+CODE_RAM static unsigned char is_leap_year(unsigned short Year)
 {  
 	  /* A year is a leap year if it is divisible by 4 but not by 100,
     or if it is divisible by 400.*/
@@ -36,7 +42,7 @@ static unsigned char is_leap_year(unsigned short Year)
 			/* Return 0 (FALSE) if it's NOT a leap year */
     }
 }
-static unsigned char days_in_month(unsigned char Month, unsigned short Year)
+CODE_RAM static unsigned char days_in_month(unsigned char Month, unsigned short Year)
 { 
     unsigned char Day;
 	  /* Determine the number of days based on the month */
@@ -53,7 +59,7 @@ static unsigned char days_in_month(unsigned char Month, unsigned short Year)
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
-void Date(unsigned char *day_update)
+CODE_RAM void Date(unsigned char *day_update)
 {
 	/* Check if the current day exceeds the number of days in the current month */
 	if (*day_update > days_in_month(month, year))
@@ -77,7 +83,7 @@ void Date(unsigned char *day_update)
 	}
 }
 
-void Time(unsigned char *second_update)
+CODE_RAM void Time(unsigned char *second_update)
 {
 	/* Check if seconds equal 60 */
 	if (*second_update==60)
@@ -86,6 +92,7 @@ void Time(unsigned char *second_update)
 		minute++;
 		/* Reset seconds to 0 */
 		*second_update = 0;
+		TRACE(TRACE_EVT_TIME_ROLLOVER, 0);
 	}
 	else
 	{
@@ -98,6 +105,7 @@ void Time(unsigned char *second_update)
 		hour++;
 		/* Reset minutes to 0 */
 		minute=0;
+		TRACE(TRACE_EVT_TIME_ROLLOVER, 1);
 	}
 	else
 	{
@@ -110,6 +118,7 @@ void Time(unsigned char *second_update)
 		hour = 0 ;
 		/* Increment day */
 		day++;
+		TRACE(TRACE_EVT_TIME_ROLLOVER, 2);
 	}
 	else
 	{
@@ -117,4 +126,69 @@ void Time(unsigned char *second_update)
 	}
 }
 
+unsigned int DateTime_ToEpoch(const DateTime_Type *dt)
+{
+	/* Days from civil date, years counted from March so that Feb 29 is the last day */
+	unsigned int y = (unsigned int)dt->year - ((dt->month <= 2U) ? 1U : 0U);
+	unsigned int era = y / 400U;
+	unsigned int yoe = y - era * 400U;
+	unsigned int doy = (153U * ((dt->month + 9U) % 12U) + 2U) / 5U + dt->day - 1U;
+	unsigned int doe = yoe * 365U + yoe / 4U - yoe / 100U + doy;
+	unsigned int days = era * 146097U + doe - 719468U;
+	return days * SECONDS_PER_DAY + dt->hour * 3600U + dt->minute * 60U + dt->second;
+}
+
+void DateTime_FromEpoch(unsigned int epoch, DateTime_Type *dt)
+{
+	unsigned int seconds = epoch % SECONDS_PER_DAY;
+	unsigned int z = epoch / SECONDS_PER_DAY + 719468U;
+	unsigned int era = z / 146097U;
+	unsigned int doe = z - era * 146097U;
+	unsigned int yoe = (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U;
+	unsigned int doy = doe - (365U * yoe + yoe / 4U - yoe / 100U);
+	unsigned int mp = (5U * doy + 2U) / 153U;
+	/* Step 1. Time of day */
+	dt->second = (unsigned char)(seconds % 60U);
+	dt->minute = (unsigned char)((seconds / 60U) % 60U);
+	dt->hour = (unsigned char)(seconds / 3600U);
+	/* Step 2. Civil date, mp counts months from March */
+	dt->day = (unsigned char)(doy - (153U * mp + 2U) / 5U + 1U);
+	dt->month = (unsigned char)((mp < 10U) ? (mp + 3U) : (mp - 9U));
+	dt->year = (unsigned short)(yoe + era * 400U + ((dt->month <= 2U) ? 1U : 0U));
+}
+
+void DateTime_Get(DateTime_Type *dt)
+{
+	dt->second = second;
+	dt->minute = minute;
+	dt->hour = hour;
+	dt->day = day;
+	dt->month = month;
+	dt->year = year;
+}
+
+void DateTime_Set(const DateTime_Type *dt)
+{
+	second = dt->second;
+	minute = dt->minute;
+	hour = dt->hour;
+	day = dt->day;
+	month = dt->month;
+	year = dt->year;
+}
 
+void DateTime_SetUtc(unsigned int utc)
+{
+	DateTime_Type local;
+	DateTime_Utc = utc;
+	DateTime_FromEpoch(utc + (unsigned int)TimeZone_GetOffset(utc), &local);
+	DateTime_Set(&local);
+}
+
+void DateTime_SyncUtc(void)
+{
+	DateTime_Type local;
+	DateTime_Get(&local);
+	/* A time skipped by a DST change reads as standard time, the calendar is reloaded from it */
+	DateTime_SetUtc(TimeZone_LocalToUtc(DateTime_ToEpoch(&local)));
+}
@@ -0,0 +1,238 @@
+/**
+ * @file    SoftTimer.c
+ * @brief   Software timer service driven by SysTick
+ * @details Hierarchical timer wheel. Level 0 has one slot per tick, each upper
+ *          level has 64 slots covering the whole span of the level below. A timer
+ *          is linked into the slot of the lowest level that can hold its delay;
+ *          when a lower level wraps, the next slot of the level above is emptied
+ *          and its timers are re-linked one level down ("cascade").
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "SoftTimer.h"
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define SOFTTIMER_LVL0_SIZE 			(1UL << SOFTTIMER_LVL0_BITS)
+#define SOFTTIMER_LVLN_SIZE 			(1UL << SOFTTIMER_LVLN_BITS)
+#define SOFTTIMER_LVL0_MASK 			(SOFTTIMER_LVL0_SIZE - 1UL)
+#define SOFTTIMER_LVLN_MASK 			(SOFTTIMER_LVLN_SIZE - 1UL)
+/* Shift of level n (n >= 1) in the tick counter */
+#define SOFTTIMER_LVL_SHIFT(n) 		(SOFTTIMER_LVL0_BITS + ((n) - 1U) * SOFTTIMER_LVLN_BITS)
+/* Timers may be started from any ISR, so the lock masks every maskable priority in use */
+#define SOFTTIMER_LOCK_PRIORITY 	(PRIORITY_LPIT_TICK)
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static SoftTimer_Type *SoftTimer_Lvl0[SOFTTIMER_LVL0_SIZE];
+static SoftTimer_Type *SoftTimer_LvlN[SOFTTIMER_LEVELS - 1U][SOFTTIMER_LVLN_SIZE];
+static volatile unsigned int SoftTimer_Now;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static void SoftTimer_Link(SoftTimer_Type *timer);
+static void SoftTimer_Unlink(SoftTimer_Type *timer);
+static void SoftTimer_Cascade(unsigned int level);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+/* Puts the timer in the slot matching its remaining delay. Caller holds the lock. */
+CODE_RAM static void SoftTimer_Link(SoftTimer_Type *timer)
+{
+	unsigned int delta = timer->expires - SoftTimer_Now;
+	SoftTimer_Type **slot;
+	unsigned int level;
+
+	if (delta < SOFTTIMER_LVL0_SIZE)
+	{
+		slot = &SoftTimer_Lvl0[timer->expires & SOFTTIMER_LVL0_MASK];
+	}
+	else
+	{
+		/* Step 1. Find the lowest level whose span covers the delay */
+		level = 1U;
+		while ((level < (SOFTTIMER_LEVELS - 1U)) && ((delta >> SOFTTIMER_LVL_SHIFT(level + 1U)) != 0U))
+		{
+			level++;
+		}
+		/* Step 2. Slot is picked by the expiry time so that the cascade lands on time */
+		slot = &SoftTimer_LvlN[level - 1U][(timer->expires >> SOFTTIMER_LVL_SHIFT(level)) & SOFTTIMER_LVLN_MASK];
+	}
+	/* Step 3. Push at the head of the slot */
+	timer->next = *slot;
+	if (*slot != NULL)
+	{
+		(*slot)->pprev = &timer->next;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	*slot = timer;
+	timer->pprev = slot;
+}
+
+/* Removes the timer from whatever slot it is in. Caller holds the lock. */
+CODE_RAM static void SoftTimer_Unlink(SoftTimer_Type *timer)
+{
+	*timer->pprev = timer->next;
+	if (timer->next != NULL)
+	{
+		timer->next->pprev = timer->pprev;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	timer->next = NULL;
+	timer->pprev = NULL;
+}
+
+/* Moves the current slot of an upper level down the wheel, then the level above if it wrapped too */
+CODE_RAM static void SoftTimer_Cascade(unsigned int level)
+{
+	unsigned int index = (SoftTimer_Now >> SOFTTIMER_LVL_SHIFT(level)) & SOFTTIMER_LVLN_MASK;
+	SoftTimer_Type *timer = SoftTimer_LvlN[level - 1U][index];
+	SoftTimer_Type *next;
+
+	/* Step 1. Upper level first, its timers may belong to this slot */
+	if ((index == 0U) && (level < (SOFTTIMER_LEVELS - 1U)))
+	{
+		SoftTimer_Cascade(level + 1U);
+		timer = SoftTimer_LvlN[level - 1U][index];
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 2. Detach the slot and re-link every timer one level down */
+	SoftTimer_LvlN[level - 1U][index] = NULL;
+	while (timer != NULL)
+	{
+		next = timer->next;
+		SoftTimer_Link(timer);
+		timer = next;
+	}
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void SoftTimer_Init(void)
+{
+	Systick_ConfigType SysTickConfig;
+
+	/* Step 1. Reload for one tick from the current core clock */
+	SysTickConfig.fSystick = Clock_GetFrequency(CORE_CLK);
+	SysTickConfig.period = (SysTickConfig.fSystick / SOFTTIMER_TICK_HZ) - 1U;
+	SysTickConfig.isInterruptEnabled = 1U;
+	/* Step 2. SysTick priority, SHPR3[31:24] */
+	SCB_SHPR3 = (SCB_SHPR3 & ~SCB_SHPR3_SYSTICK_MASK) |
+	            ((PRIORITY_SOFTTIMER << (8U - NVIC_PRIO_BITS)) << SCB_SHPR3_SYSTICK_SHIFT);
+	/* Step 3. Start counting */
+	Systick_Init(&SysTickConfig);
+	Systick_Start();
+}
+
+CODE_RAM void SoftTimer_Tick(void)
+{
+	SoftTimer_Type **slot;
+	SoftTimer_Type *timer;
+	SoftTimer_CallbackType callback;
+	void *arg;
+	unsigned int critical;
+
+	critical = NVIC_EnterCritical(SOFTTIMER_LOCK_PRIORITY);
+	/* Step 1. Advance time, cascade when level 0 wraps */
+	SoftTimer_Now++;
+	if ((SoftTimer_Now & SOFTTIMER_LVL0_MASK) == 0U)
+	{
+		SoftTimer_Cascade(1U);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 2. Every timer in this slot expires now. Pop one at a time so callbacks may start/stop any timer */
+	slot = &SoftTimer_Lvl0[SoftTimer_Now & SOFTTIMER_LVL0_MASK];
+	while (*slot != NULL)
+	{
+		timer = *slot;
+		SoftTimer_Unlink(timer);
+		callback = timer->callback;
+		arg = timer->arg;
+		if (timer->period != 0U)
+		{
+			timer->expires = SoftTimer_Now + timer->period;
+			SoftTimer_Link(timer);
+		}
+		else
+		{
+			/*do not thing*/
+		}
+		/* Step 3. Run the callback unlocked */
+		NVIC_ExitCritical(critical);
+		callback(arg);
+		critical = NVIC_EnterCritical(SOFTTIMER_LOCK_PRIORITY);
+	}
+	NVIC_ExitCritical(critical);
+}
+
+void SoftTimer_Start(SoftTimer_Type *timer, unsigned int delay, unsigned int period,
+                     SoftTimer_CallbackType callback, void *arg)
+{
+	unsigned int critical;
+
+	/* Step 1. Check parameter */
+	if ((timer == NULL) || (callback == NULL)) return;
+	if (delay == 0U) delay = 1U;
+	if (delay > SOFTTIMER_MAX_TICKS) delay = SOFTTIMER_MAX_TICKS;
+	if (period > SOFTTIMER_MAX_TICKS) period = SOFTTIMER_MAX_TICKS;
+	/* Step 2. Re-arm: drop the old position first */
+	critical = NVIC_EnterCritical(SOFTTIMER_LOCK_PRIORITY);
+	if (timer->pprev != NULL)
+	{
+		SoftTimer_Unlink(timer);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	timer->callback = callback;
+	timer->arg = arg;
+	timer->period = period;
+	timer->expires = SoftTimer_Now + delay;
+	SoftTimer_Link(timer);
+	NVIC_ExitCritical(critical);
+}
+
+void SoftTimer_Stop(SoftTimer_Type *timer)
+{
+	unsigned int critical;
+
+	if (timer == NULL) return;
+	critical = NVIC_EnterCritical(SOFTTIMER_LOCK_PRIORITY);
+	if (timer->pprev != NULL)
+	{
+		SoftTimer_Unlink(timer);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	NVIC_ExitCritical(critical);
+}
+
+unsigned char SoftTimer_IsActive(const SoftTimer_Type *timer)
+{
+	return ((timer != NULL) && (timer->pprev != NULL)) ? 1U : 0U;
+}
+
+unsigned int SoftTimer_GetTicks(void)
+{
+	return SoftTimer_Now;
+}
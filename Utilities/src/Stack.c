@@ -0,0 +1,59 @@
+/**
+ * @file    Stack.c
+ * @brief   Main stack painting and high-water mark
+ * @details The region bounds come from the linker symbols of ARM_LIB_STACK, so
+ *          the module follows Stack_Size in the scatter file.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Stack.h"
+/*==================================================================================================
+*                                      EXTERNAL SYMBOLS
+==================================================================================================*/
+extern unsigned int Image$$ARM_LIB_STACK$$ZI$$Base[];
+extern unsigned int Image$$ARM_LIB_STACK$$ZI$$Limit[];
+/* The heap region is 0 bytes: make the link fail if malloc() is ever pulled in */
+__asm(".global __use_no_heap\n\t");
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Stack_Paint(void)
+{
+	unsigned int *word = Image$$ARM_LIB_STACK$$ZI$$Base;
+	unsigned int *sp;
+
+	/* Everything below the current stack pointer is unused at this point */
+	__asm volatile ("mov %0, sp" : "=r" (sp));
+	while (word < sp)
+	{
+		*word = STACK_PAINT_PATTERN;
+		word++;
+	}
+}
+
+unsigned int Stack_GetSize(void)
+{
+	return (unsigned int)(Image$$ARM_LIB_STACK$$ZI$$Limit - Image$$ARM_LIB_STACK$$ZI$$Base) * 4U;
+}
+
+unsigned int Stack_GetUsed(void)
+{
+	const unsigned int *word = Image$$ARM_LIB_STACK$$ZI$$Base;
+
+	/* The stack grows down: the first overwritten word from the bottom is the deepest point */
+	while ((word < Image$$ARM_LIB_STACK$$ZI$$Limit) && (*word == STACK_PAINT_PATTERN))
+	{
+		word++;
+	}
+	return (unsigned int)(Image$$ARM_LIB_STACK$$ZI$$Limit - word) * 4U;
+}
+
+unsigned char Stack_IsOverflowed(void)
+{
+	return (Image$$ARM_LIB_STACK$$ZI$$Base[0] != STACK_PAINT_PATTERN) ? 1U : 0U;
+}
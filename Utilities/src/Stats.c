@@ -0,0 +1,114 @@
+/**
+ * @file    Stats.c
+ * @brief   Runtime statistics: interrupt load, CPU load and traffic counters
+ * @details Idle cycles are summed in Stats_Idle() and turned into a load figure
+ *          by a SoftTimer callback once per window.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Stats.h"
+#include "SoftTimer.h"
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+static const char * const Stats_IrqNames[STATS_IRQ_NUMBER] =
+{
+	"LPIT", "UART", "PORTC", "ADC", "SYSTICK", "LVD_LVW", "FTFC", "FTM0"
+};
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+volatile Stats_IrqType Stats_Irq[STATS_IRQ_NUMBER];
+volatile Stats_CounterType Stats_Counter;
+volatile unsigned int Stats_CpuLoad;
+/*==================================================================================================
+*                                      LOCAL VARIABLES
+==================================================================================================*/
+static volatile unsigned int Stats_IdleCycles;
+static unsigned int Stats_WindowStart;
+static SoftTimer_Type Stats_WindowTimer;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static void Stats_Window(void *arg);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+static void Stats_Window(void *arg)
+{
+	unsigned int now = DWT_CYCCNT;
+	unsigned int elapsed = now - Stats_WindowStart;
+	unsigned int idle = Stats_IdleCycles;
+
+	(void)arg;
+	/* Stats_Idle() updates the sum with interrupts off, so this pair cannot tear */
+	Stats_IdleCycles = 0U;
+	Stats_WindowStart = now;
+	if ((elapsed != 0U) && (idle <= elapsed))
+	{
+		Stats_CpuLoad = 1000U - (unsigned int)(((unsigned long long)idle * 1000U) / elapsed);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Stats_Init(void)
+{
+	Stats_Reset();
+	Stats_WindowStart = DWT_CYCCNT;
+	SoftTimer_Start(&Stats_WindowTimer, STATS_WINDOW_MS, STATS_WINDOW_MS, Stats_Window, NULL);
+}
+
+void Stats_Reset(void)
+{
+	unsigned int critical;
+	unsigned int i;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	for (i = 0U; i < STATS_IRQ_NUMBER; i++)
+	{
+		Stats_Irq[i].count = 0U;
+		Stats_Irq[i].maxCycles = 0U;
+		Stats_Irq[i].totalCycles = 0U;
+	}
+	Stats_Counter.spiWords = 0U;
+	Stats_Counter.uartRxBytes = 0U;
+	Stats_Counter.uartTxBytes = 0U;
+	Stats_Counter.uartOverruns = 0U;
+	NVIC_ExitCritical(critical);
+}
+
+void Stats_Idle(void)
+{
+	unsigned int start;
+
+	/* WFI still wakes on a pending interrupt with PRIMASK set; the handler runs after cpsie */
+#if defined(HOST_TEST)
+	Host_Primask = 1U;
+	start = DWT_CYCCNT;
+	Host_Wfi();
+	Stats_IdleCycles += DWT_CYCCNT - start;
+	Host_Primask = 0U;
+#else
+	__asm volatile ("cpsid i" : : : "memory");
+	start = DWT_CYCCNT;
+	__asm volatile ("wfi" : : : "memory");
+	Stats_IdleCycles += DWT_CYCCNT - start;
+	__asm volatile ("cpsie i" : : : "memory");
+#endif
+}
+
+const char* Stats_IrqName(Stats_IrqIdType id)
+{
+	if (id >= STATS_IRQ_NUMBER) return "";
+	return Stats_IrqNames[id];
+}
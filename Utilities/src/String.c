@@ -43,6 +43,43 @@ unsigned char my_strlen(char *str)
   return length;
 }
 
+unsigned char my_utoa(unsigned int value, char *str)
+{
+	char digits[10];
+	unsigned char count = 0;
+	unsigned char length = 0;
+	/* Collect digits from the least significant one */
+	do
+	{
+		digits[count] = (char)('0' + (value % 10U));
+		value /= 10U;
+		count++;
+	} while (value != 0U);
+	/* Write them in reading order, then terminate the string */
+	while (count > 0)
+	{
+		count--;
+		str[length] = digits[count];
+		length++;
+	}
+	str[length] = '\0';
+	return length;
+}
+
+unsigned char my_utohex(unsigned int value, unsigned char digits, char *str)
+{
+	unsigned char i;
+	unsigned char nibble;
+	/* Fixed width, most significant nibble first */
+	for (i = 0; i < digits; i++)
+	{
+		nibble = (unsigned char)((value >> (4U * (digits - 1U - i))) & 0x0FU);
+		str[i] = (char)((nibble < 10U) ? ((unsigned int)'0' + nibble) : ((unsigned int)'A' + nibble - 10U));
+	}
+	str[digits] = '\0';
+	return digits;
+}
+
 
 void my_strcpy(char *dest, const char *src) 
 {
@@ -328,6 +365,28 @@ unsigned short my_atoushort(char *str)
   return result; 
 }
 
+unsigned int my_atou(char *str)
+{
+	unsigned int result = 0;
+	/* Iterate through the string */
+	while (*str)
+	{
+		/* Check if the character is not a digit */
+		if (*str < '0' || *str > '9')
+		{
+			return 0;
+		}
+		else
+		{
+		/*do not thing*/
+		}
+		result = result * 10U + (unsigned int)(*str - '0'); /* Update the result */
+		str++;
+	}
+	/* Return the final result */
+	return result;
+}
+
 char* my_strtok(char* str, char* delim) 
 {
 	char* tokenStart;
@@ -387,4 +446,86 @@ char* my_strtok(char* str, char* delim)
   return tokenStart;
 }
 
+unsigned char Check_Format_Setting_Alarm(char *input)
+{
+	/* "hh-mm-ss R": a time, one space, R = O (once), D (daily) or W (weekdays) */
+	char time[9];
+	unsigned char i;
+	if (my_strlen(input) != 10)
+	{
+		return FALSE;
+	}
+	if ((input[8] != ' ') || ((input[9] != 'O') && (input[9] != 'D') && (input[9] != 'W')))
+	{
+		return FALSE;
+	}
+	for (i = 0; i < 8; i++)
+	{
+		time[i] = input[i];
+	}
+	time[8] = '\0';
+	return Check_Format_Setting_Time(time);
+}
+
+unsigned char Check_Format_Setting_Ppm(char *input)
+{
+	/* "+XXX" or "-XXX": optional sign, 1 to 3 digits */
+	unsigned char i = 0;
+	unsigned char digits = 0;
+	if ((input[0] == '+') || (input[0] == '-'))
+	{
+		i++;
+	}
+	while ((input[i] >= '0') && (input[i] <= '9'))
+	{
+		i++;
+		digits++;
+	}
+	if ((input[i] != '\0') || (digits == 0) || (digits > 3))
+	{
+		return FALSE;
+	}
+	return TRUE;
+}
 
+unsigned char Check_Format_Sync(char *input)
+{
+	/* "SYNC s1 u1 s4 u4": 4 numbers, seconds up to 4294967295, microseconds up to 999999 */
+	unsigned long long value;
+	unsigned char field;
+	unsigned char digits;
+	unsigned char i = 5;
+	if ((input[0] != 'S') || (input[1] != 'Y') || (input[2] != 'N') || (input[3] != 'C') || (input[4] != ' '))
+	{
+		return FALSE;
+	}
+	for (field = 0; field < 4; field++)
+	{
+		value = 0;
+		digits = 0;
+		while ((input[i] >= '0') && (input[i] <= '9'))
+		{
+			value = value * 10U + (unsigned long long)(input[i] - '0');
+			digits++;
+			i++;
+		}
+		if ((digits == 0) || (digits > 10) || (value > (((field & 1U) == 0U) ? 0xFFFFFFFFULL : 999999ULL)))
+		{
+			return FALSE;
+		}
+		/* Single spaces between the fields, nothing after the last one */
+		if (field < 3)
+		{
+			if (input[i] != ' ')
+			{
+				return FALSE;
+			}
+			i++;
+		}
+	}
+	if (input[i] != '\0')
+	{
+		return FALSE;
+	}
+	return TRUE;
+}
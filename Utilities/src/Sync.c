@@ -0,0 +1,395 @@
+/**
+ * @file    Sync.c
+ * @brief   Clock discipline from a host time reference over UART1
+ * @details Offsets are in microseconds and corrections in ppb: offset * 1000 / tau
+ *          is then a rate in ppb (ns per s). The loop runs in the UART handler
+ *          and, for PPS edges, in the main loop at PRIORITY_UART; the second
+ *          mark is shared with the LPIT tick under NVIC_EnterCritical.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Sync.h"
+#include "Tick.h"
+#include "Timestamp.h"
+#include "ProcessDateTime.h"
+#include "Log.h"
+#include "Pps.h"
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define SYNC_US_PER_SECOND 				(1000000LL)
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static unsigned int Sync_MarkUtc;                    /* Second started at Sync_MarkTicks      */
+static unsigned long long Sync_MarkTicks;
+static unsigned long long Sync_T1;                   /* Open exchange, 0 = none               */
+static unsigned long long Sync_T2;
+static unsigned long long Sync_T3;
+static unsigned int Sync_LastUtc;                    /* Second of the last offset, 0 = none   */
+static unsigned int Sync_SeenUtc;                    /* Same, kept across steps for holdover  */
+static unsigned char Sync_PpsSkip;                   /* Edges to skip after a phase step      */
+static unsigned long long Sync_EdgeTicks;            /* PPS edge waiting for its second mark  */
+static unsigned char Sync_EdgePending;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+Sync_StatusType Sync_Status;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static int Sync_Clamp(long long value, int limit);
+static long long Sync_Seconds(long long offset);
+static unsigned long long Sync_GetMark(unsigned int *utc);
+static void Sync_Select(Sync_SourceType source);
+static void Sync_Step(long long offset);
+static void Sync_Discipline(long long offset, unsigned int now, long long tau);
+static void Sync_Track(long long offset, unsigned int lockUs);
+static void Sync_Pps(unsigned long long edgeTicks);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+static int Sync_Clamp(long long value, int limit)
+{
+	if (value > limit) return limit;
+	if (value < -limit) return -limit;
+	return (int)value;
+}
+
+/* Offset rounded to whole seconds */
+static long long Sync_Seconds(long long offset)
+{
+	return (offset >= 0) ? ((offset + (SYNC_US_PER_SECOND / 2)) / SYNC_US_PER_SECOND)
+	                     : -((-offset + (SYNC_US_PER_SECOND / 2)) / SYNC_US_PER_SECOND);
+}
+
+/* Last second mark, shared with the LPIT tick */
+static unsigned long long Sync_GetMark(unsigned int *utc)
+{
+	unsigned long long markTicks;
+	unsigned int critical;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	markTicks = Sync_MarkTicks;
+	*utc = Sync_MarkUtc;
+	NVIC_ExitCritical(critical);
+	return markTicks;
+}
+
+/* The PPS always takes over; the serial reference when there is no source or it is lost */
+static void Sync_Select(Sync_SourceType source)
+{
+	if (Sync_Status.source != (unsigned char)source)
+	{
+		Sync_Status.source = (unsigned char)source;
+		Sync_Status.count = 0U;
+		Sync_Status.jitterUs = 0U;
+		Sync_LastUtc = 0U;
+		Sync_PpsSkip = 0U;
+		LOG1(LOG_SYNC_SOURCE, (unsigned int)source);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
+
+/* Whole seconds on the calendar, the rest (within +-0.5s) as a tick phase shift */
+static void Sync_Step(long long offset)
+{
+	long long seconds = Sync_Seconds(offset);
+	long long rest = offset - (seconds * SYNC_US_PER_SECOND);
+	unsigned int critical;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	if (seconds != 0)
+	{
+		DateTime_SetUtc(DateTime_Utc - (unsigned int)seconds);
+		Sync_MarkUtc -= (unsigned int)seconds;
+		if (Sync_SeenUtc != 0U)
+		{
+			Sync_SeenUtc -= (unsigned int)seconds;
+		}
+		else
+		{
+			/*do not thing*/
+		}
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	NVIC_ExitCritical(critical);
+	/* Ahead: longer ticks; the slew of the old offset is dropped, the frequency kept */
+	Tick_Shift((int)rest * (int)Timestamp_TicksPerUs);
+	Tick_SetDiscipline(Sync_Status.freqPpb);
+	Sync_Status.steps++;
+	Sync_Status.jitterUs = 0U;
+	Sync_Status.state = SYNC_STATE_TRACKING;
+	Sync_LastUtc = 0U;
+	LOG3(LOG_SYNC_STEP, (seconds < 0) ? (unsigned int)(-seconds) : (unsigned int)seconds,
+	     (rest < 0) ? (unsigned int)(-rest) : (unsigned int)rest, (offset > 0) ? 1U : 0U);
+}
+
+/* Type 2 loop: freq integrates the offset, the phase is slewed out over tau */
+static void Sync_Discipline(long long offset, unsigned int now, long long tau)
+{
+	unsigned int interval = now - Sync_LastUtc;
+	long long freq = Sync_Status.freqPpb;
+
+	if ((Sync_LastUtc != 0U) && (interval <= SYNC_INTERVAL_MAX))
+	{
+		freq += (offset * 1000 * (long long)interval) / (4 * tau * tau);
+		Sync_Status.freqPpb = Sync_Clamp(freq, SYNC_PPB_MAX);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	Sync_LastUtc = now;
+	/* Positive discipline slows the clock */
+	Tick_SetDiscipline(Sync_Clamp(Sync_Status.freqPpb + ((offset * 1000) / tau), SYNC_PPB_MAX));
+}
+
+/* Jitter: running average of |offset|; locked once it is under the limit of the source */
+static void Sync_Track(long long offset, unsigned int lockUs)
+{
+	Sync_Status.jitterUs = (unsigned int)((long long)Sync_Status.jitterUs
+	                     + ((((offset < 0) ? -offset : offset) - (long long)Sync_Status.jitterUs) / 4));
+	if ((Sync_Status.count > 4U) && (Sync_Status.jitterUs < lockUs))
+	{
+		if (Sync_Status.state != SYNC_STATE_LOCKED)
+		{
+			Sync_Status.state = SYNC_STATE_LOCKED;
+			LOG2(LOG_SYNC_LOCKED, Sync_Status.count, Sync_GetAccuracy());
+		}
+		else
+		{
+			/*do not thing*/
+		}
+	}
+	else
+	{
+		Sync_Status.state = SYNC_STATE_TRACKING;
+	}
+}
+
+/* The edge starts a UTC second: the device time at the edge, modulo 1s, is the phase offset */
+static void Sync_Pps(unsigned long long edgeTicks)
+{
+	long long offset = (long long)(Sync_Now(edgeTicks) % (unsigned long long)SYNC_US_PER_SECOND);
+
+	if (offset >= (SYNC_US_PER_SECOND / 2))
+	{
+		offset -= SYNC_US_PER_SECOND;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 1. Take over from the serial reference */
+	Sync_Select(SYNC_SOURCE_PPS);
+	/* Step 2. Edges right after a step would see the shift half applied */
+	if (Sync_PpsSkip != 0U)
+	{
+		Sync_PpsSkip--;
+		Sync_SeenUtc = Sync_MarkUtc;
+		return;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	Sync_Status.count++;
+	Sync_Status.offsetUs = (int)offset;
+	/* Step 3. Step a large offset as a phase shift (under 0.5s), slew a small one */
+	if ((offset >= SYNC_PPS_STEP_US) || (offset <= -SYNC_PPS_STEP_US))
+	{
+		Sync_Step(offset);
+		Sync_PpsSkip = SYNC_PPS_SETTLE;
+	}
+	else
+	{
+		Sync_Discipline(offset, Sync_MarkUtc, SYNC_PPS_TIME_CONSTANT);
+		Sync_Track(offset, SYNC_PPS_LOCK_US);
+	}
+	Sync_SeenUtc = Sync_MarkUtc;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+CODE_RAM void Sync_Second(unsigned int utc, unsigned long long ticks)
+{
+	Sync_MarkTicks = ticks;
+	Sync_MarkUtc = utc;
+}
+
+unsigned long long Sync_Now(unsigned long long ticks)
+{
+	unsigned int markUtc;
+	unsigned long long markTicks = Sync_GetMark(&markUtc);
+
+	/* ticks may be a little before the mark: signed */
+	return ((unsigned long long)markUtc * SYNC_US_PER_SECOND)
+	     + (unsigned long long)((long long)(ticks - markTicks) / (long long)Timestamp_TicksPerUs);
+}
+
+unsigned char Sync_Exchange(unsigned long long t1, unsigned long long t4, unsigned long long rxTicks)
+{
+	unsigned long long t2 = Sync_Now(rxTicks);
+	unsigned char stepped = 0U;
+	long long offset;
+	long long delay;
+
+	/* Step 1. Complete the previous exchange */
+	if ((t4 != 0U) && (Sync_T1 != 0U) && (Sync_T3 != 0U))
+	{
+		offset = ((long long)(Sync_T2 - Sync_T1) + (long long)(Sync_T3 - t4)) / 2;
+		delay = (long long)(t4 - Sync_T1) - (long long)(Sync_T3 - Sync_T2);
+		if ((delay >= 0) && (delay <= (long long)SYNC_DELAY_MAX_US)
+		 && (Sync_Status.source == SYNC_SOURCE_PPS) && (Sync_Status.state != SYNC_STATE_HOLDOVER))
+		{
+			/* Step 2. The PPS has the phase: whole seconds only */
+			Sync_Status.delayUs = (unsigned int)delay;
+			if (Sync_Seconds(offset) != 0)
+			{
+				Sync_Step(Sync_Seconds(offset) * SYNC_US_PER_SECOND);
+				Sync_PpsSkip = SYNC_PPS_SETTLE;
+				stepped = 1U;
+				t1 = 0U;
+			}
+			else
+			{
+				/*do not thing*/
+			}
+		}
+		else if ((delay >= 0) && (delay <= (long long)SYNC_DELAY_MAX_US))
+		{
+			Sync_Select(SYNC_SOURCE_SERIAL);
+			Sync_Status.count++;
+			Sync_Status.offsetUs = Sync_Clamp(offset, 0x7FFFFFFF);
+			Sync_Status.delayUs = (unsigned int)delay;
+			/* Step 3. Step a large offset, the times of this frame are then stale */
+			if ((offset >= SYNC_STEP_US) || (offset <= -SYNC_STEP_US))
+			{
+				Sync_Step(offset);
+				stepped = 1U;
+				t1 = 0U;
+			}
+			else
+			{
+				/* Step 4. Slew a small one */
+				Sync_Discipline(offset, Sync_MarkUtc, SYNC_TIME_CONSTANT);
+				Sync_Track(offset, SYNC_LOCK_US);
+			}
+			Sync_SeenUtc = Sync_MarkUtc;
+		}
+		else
+		{
+			/*do not thing*/
+		}
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 5. Open the next one, t3 is taken by the reply */
+	Sync_T1 = t1;
+	Sync_T2 = t2;
+	Sync_T3 = 0U;
+	return stepped;
+}
+
+void Sync_Reply(unsigned long long *t2, unsigned long long *t3)
+{
+	Sync_T3 = Sync_Now(Timestamp_NowTicks());
+	*t2 = Sync_T2;
+	*t3 = Sync_T3;
+}
+
+unsigned char Sync_Process(void)
+{
+	unsigned long long edge;
+	unsigned char processed = 0U;
+	unsigned int markUtc;
+	unsigned int age;
+	unsigned int critical;
+
+	if (Pps_GetEdge(&edge) == 1U)
+	{
+		Sync_EdgeTicks = edge;
+		Sync_EdgePending = 1U;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	critical = NVIC_EnterCritical(PRIORITY_UART);
+	/* Step 1. PPS edge, against the nearest second mark: Sync_Now() counts the
+	   clocks from the mark undisciplined, a second of them is off by the crystal
+	   error. Over half a second past the mark it waits for the next one. */
+	if ((Sync_EdgePending == 1U)
+	 && ((long long)(Sync_EdgeTicks - Sync_GetMark(&markUtc))
+	     <= ((SYNC_US_PER_SECOND / 2) * (long long)Timestamp_TicksPerUs)))
+	{
+		Sync_EdgePending = 0U;
+		Sync_Pps(Sync_EdgeTicks);
+		processed = 1U;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 2. Source silent too long: keep the frequency, drop the phase slew */
+	age = Sync_GetAge();
+	if (((Sync_Status.state == SYNC_STATE_TRACKING) || (Sync_Status.state == SYNC_STATE_LOCKED))
+	 && (age > ((Sync_Status.source == SYNC_SOURCE_PPS) ? SYNC_PPS_TIMEOUT : SYNC_SERIAL_TIMEOUT)))
+	{
+		Tick_SetDiscipline(Sync_Status.freqPpb);
+		Sync_Status.state = SYNC_STATE_HOLDOVER;
+		Sync_Status.holdovers++;
+		Sync_LastUtc = 0U;
+		LOG2(LOG_SYNC_HOLDOVER, Sync_Status.source, age);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	NVIC_ExitCritical(critical);
+	return processed;
+}
+
+unsigned int Sync_GetAccuracy(void)
+{
+	unsigned int accuracy = Sync_Status.jitterUs;
+
+	/* Path asymmetry bound of the serial reference */
+	if (Sync_Status.source == SYNC_SOURCE_SERIAL)
+	{
+		accuracy += Sync_Status.delayUs / 2U;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Crystal wander since the source was lost */
+	if (Sync_Status.state == SYNC_STATE_HOLDOVER)
+	{
+		accuracy += (Sync_GetAge() * SYNC_HOLDOVER_PPB) / 1000U;
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	return accuracy;
+}
+
+unsigned int Sync_GetAge(void)
+{
+	return (Sync_SeenUtc != 0U) ? (Sync_MarkUtc - Sync_SeenUtc) : 0U;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file    Tick.c
+ * @brief   Calibrated 250ms calendar tick
+ * @details The step per tick is clocks << 32. The correction is computed on
+ *          the step / 10^6 (10^9 resolution left at 1MHz) so that the product
+ *          with +-10^6 ppb stays within 64 bits. Only additions run per tick,
+ *          the divisions are made once per setting.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Tick.h"
+#include "Log.h"
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static unsigned long long Tick_Nominal;              /* LPIT clocks per tick, 32.32 fixed point */
+static unsigned long long Tick_Step;                 /* Same, corrections applied            */
+static unsigned int Tick_Fraction;                   /* Carried fraction of a clock          */
+static int Tick_DisciplinePpb;
+static int Tick_Pending;                             /* Phase shift left to apply, clocks    */
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+volatile int Tick_Ppm;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static void Tick_Load(void);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+static void Tick_Load(void)
+{
+	long long ppb = ((long long)Tick_Ppm * 1000) + Tick_DisciplinePpb;
+
+	Tick_Step = Tick_Nominal + (unsigned long long)(((long long)(Tick_Nominal / 1000000U) * ppb) / 1000);
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void Tick_Init(void)
+{
+	unsigned long long clocks = (unsigned long long)Clock_GetFrequency(LPIT0_CLK) * TICK_PERIOD_US;
+
+	/* Step 1. f_lpit * period / 10^6 in 32.32 fixed point */
+	Tick_Nominal = ((clocks / 1000000U) << 32) + (((clocks % 1000000U) << 32) / 1000000U);
+	Tick_Fraction = 0U;
+	Tick_DisciplinePpb = 0;
+	Tick_Pending = 0;
+	Tick_Ppm = TICK_PPM_DEFAULT;
+	Tick_Load();
+	/* Step 2. First period, the following ones are programmed one tick ahead */
+	Tick_Update();
+}
+
+unsigned char Tick_SetCalibration(int ppm)
+{
+	unsigned int critical;
+
+	if ((ppm > TICK_PPM_MAX) || (ppm < -TICK_PPM_MAX))
+	{
+		return 0U;
+	}
+	/* The LPIT handler must not see half of the new step; the carried fraction is kept */
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	Tick_Ppm = ppm;
+	Tick_Load();
+	NVIC_ExitCritical(critical);
+	LOG2(LOG_CALIB_SET, (ppm < 0) ? (unsigned int)(-ppm) : (unsigned int)ppm, (ppm < 0) ? 1U : 0U);
+	return 1U;
+}
+
+void Tick_SetDiscipline(int ppb)
+{
+	unsigned int critical;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	Tick_DisciplinePpb = ppb;
+	Tick_Load();
+	NVIC_ExitCritical(critical);
+}
+
+void Tick_Shift(int clocks)
+{
+	unsigned int critical;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	Tick_Pending += clocks;
+	NVIC_ExitCritical(critical);
+}
+
+CODE_RAM void Tick_Update(void)
+{
+	unsigned long long sum = (unsigned long long)Tick_Fraction + Tick_Step;
+	unsigned int clocks = (unsigned int)(sum >> 32);
+	int limit = (int)(clocks / 2U);
+	int shift = Tick_Pending;
+
+	/* Step 1. Whole clocks of this tick, the fraction goes to the next one */
+	Tick_Fraction = (unsigned int)sum;
+	/* Step 2. Part of a pending phase shift, the tick stays between 1/2 and 3/2 of its length */
+	if (shift != 0)
+	{
+		if (shift > limit)
+		{
+			shift = limit;
+		}
+		else if (shift < -limit)
+		{
+			shift = -limit;
+		}
+		else
+		{
+			/*do not thing*/
+		}
+		Tick_Pending -= shift;
+		clocks = (unsigned int)((int)clocks + shift);
+	}
+	else
+	{
+		/*do not thing*/
+	}
+	/* Step 3. The timeout is TVAL + 1 clocks */
+	Lpit_SetPeriod(TICK_CHANNEL, clocks - 1U);
+}
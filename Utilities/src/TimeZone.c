@@ -0,0 +1,427 @@
+/**
+ * @file    TimeZone.c
+ * @brief   Time zone and daylight saving rules
+ * @details POSIX offsets count hours west of UTC; they are stored negated, in
+ *          seconds east, so that local = utc + offset. A start rule is given
+ *          in local standard time, an end rule in local daylight time.
+ *          Evaluation takes the transitions of the year before, the year of
+ *          and the year after utc, which also covers southern hemisphere
+ *          zones where daylight time spans the new year. The rules start in
+ *          1970, the epoch has no 1969: a southern zone reads standard time
+ *          until its daylight time starts in 1970.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "TimeZone.h"
+#include "ProcessDateTime.h"
+#include "Log.h"
+/*==================================================================================================
+*                                     LOCAL MACROS
+==================================================================================================*/
+#define TIMEZONE_RULE_MONTH 			(0U)       /* Mm.w.d */
+#define TIMEZONE_RULE_JULIAN 			(1U)       /* Jn     */
+#define TIMEZONE_RULE_DAY 				(2U)       /* n      */
+#define TIMEZONE_RULE_TIME 				(7200)     /* 02:00:00 */
+#define TIMEZONE_EVENTS 					(6U)       /* 2 transitions x 3 years */
+#define TIMEZONE_FIRST_YEAR 			(1970U)
+/*==================================================================================================
+*                                      LOCAL TYPES
+==================================================================================================*/
+typedef struct
+{
+	unsigned char  type;             /* TIMEZONE_RULE_*                     */
+	unsigned char  month;
+	unsigned char  week;             /* 1..5, 5 = last                      */
+	unsigned char  weekday;          /* 0 = Sunday                          */
+	unsigned short day;              /* Jn: 1..365, n: 0..365               */
+	int            time;             /* Seconds after local midnight        */
+} TimeZone_RuleType;
+
+typedef struct
+{
+	int               stdOffset;     /* Seconds east of UTC                 */
+	int               dstOffset;
+	unsigned char     hasDst;
+	TimeZone_RuleType start;
+	TimeZone_RuleType end;
+} TimeZone_Type;
+/*==================================================================================================
+*                                    LOCAL VARIABLES
+==================================================================================================*/
+static TimeZone_Type TimeZone_Zone;
+/*==================================================================================================
+*                                    GLOBAL VARIABLES
+==================================================================================================*/
+volatile int TimeZone_Current;
+volatile unsigned int TimeZone_Previous;
+volatile unsigned int TimeZone_Next;
+/*==================================================================================================
+*                                LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static unsigned char TimeZone_ParseNumber(const char **str, unsigned int max, unsigned int *value);
+static unsigned char TimeZone_ParseName(const char **str);
+static unsigned char TimeZone_ParseTime(const char **str, int *seconds);
+static unsigned char TimeZone_ParseRule(const char **str, TimeZone_RuleType *rule);
+static unsigned int TimeZone_DayNumber(unsigned char dayOfMonth, unsigned char month, unsigned short year);
+static unsigned int TimeZone_RuleLocal(const TimeZone_RuleType *rule, unsigned short year);
+static unsigned int TimeZone_Transition(const TimeZone_RuleType *rule, unsigned short year, int offset);
+static int TimeZone_Evaluate(unsigned int utc, unsigned int *previous, unsigned int *next);
+/*==================================================================================================
+*                                     LOCAL FUNCTIONS
+==================================================================================================*/
+/* Decimal number up to max, at least one digit */
+static unsigned char TimeZone_ParseNumber(const char **str, unsigned int max, unsigned int *value)
+{
+	const char *p = *str;
+	unsigned int number = 0U;
+
+	if ((*p < '0') || (*p > '9')) return 0U;
+	while ((*p >= '0') && (*p <= '9'))
+	{
+		number = (number * 10U) + (unsigned int)(*p - '0');
+		if (number > max) return 0U;
+		p++;
+	}
+	*str = p;
+	*value = number;
+	return 1U;
+}
+
+/* "ABC" (3 letters or more) or "<+03>" (quoted, 3 characters or more) */
+static unsigned char TimeZone_ParseName(const char **str)
+{
+	const char *p = *str;
+	unsigned int length = 0U;
+
+	if (*p == '<')
+	{
+		p++;
+		while ((*p != '>') && (*p != '\0'))
+		{
+			p++;
+			length++;
+		}
+		if (*p != '>') return 0U;
+		p++;
+	}
+	else
+	{
+		while (((*p >= 'A') && (*p <= 'Z')) || ((*p >= 'a') && (*p <= 'z')))
+		{
+			p++;
+			length++;
+		}
+	}
+	*str = p;
+	return (length >= 3U) ? 1U : 0U;
+}
+
+/* [+|-]hh[:mm[:ss]], hours up to 167 as POSIX allows for rule times */
+static unsigned char TimeZone_ParseTime(const char **str, int *seconds)
+{
+	const char *p = *str;
+	unsigned int hours;
+	unsigned int minutes = 0U;
+	unsigned int secs = 0U;
+	int sign = 1;
+
+	if ((*p == '+') || (*p == '-'))
+	{
+		sign = (*p == '-') ? -1 : 1;
+		p++;
+	}
+	if (TimeZone_ParseNumber(&p, 167U, &hours) == 0U) return 0U;
+	if (*p == ':')
+	{
+		p++;
+		if (TimeZone_ParseNumber(&p, 59U, &minutes) == 0U) return 0U;
+		if (*p == ':')
+		{
+			p++;
+			if (TimeZone_ParseNumber(&p, 59U, &secs) == 0U) return 0U;
+		}
+	}
+	*str = p;
+	*seconds = sign * (int)((hours * 3600U) + (minutes * 60U) + secs);
+	return 1U;
+}
+
+static unsigned char TimeZone_ParseRule(const char **str, TimeZone_RuleType *rule)
+{
+	const char *p = *str;
+	unsigned int value;
+
+	/* Step 1. Date */
+	if (*p == 'M')
+	{
+		p++;
+		rule->type = TIMEZONE_RULE_MONTH;
+		if ((TimeZone_ParseNumber(&p, 12U, &value) == 0U) || (value == 0U)) return 0U;
+		rule->month = (unsigned char)value;
+		if (*p != '.') return 0U;
+		p++;
+		if ((TimeZone_ParseNumber(&p, 5U, &value) == 0U) || (value == 0U)) return 0U;
+		rule->week = (unsigned char)value;
+		if (*p != '.') return 0U;
+		p++;
+		if (TimeZone_ParseNumber(&p, 6U, &value) == 0U) return 0U;
+		rule->weekday = (unsigned char)value;
+	}
+	else if (*p == 'J')
+	{
+		p++;
+		rule->type = TIMEZONE_RULE_JULIAN;
+		if ((TimeZone_ParseNumber(&p, 365U, &value) == 0U) || (value == 0U)) return 0U;
+		rule->day = (unsigned short)value;
+	}
+	else
+	{
+		rule->type = TIMEZONE_RULE_DAY;
+		if (TimeZone_ParseNumber(&p, 365U, &value) == 0U) return 0U;
+		rule->day = (unsigned short)value;
+	}
+	/* Step 2. Time of the change */
+	rule->time = TIMEZONE_RULE_TIME;
+	if (*p == '/')
+	{
+		p++;
+		if (TimeZone_ParseTime(&p, &rule->time) == 0U) return 0U;
+	}
+	*str = p;
+	return 1U;
+}
+
+/* Days since 1970-01-01; month 13 is January of the next year */
+static unsigned int TimeZone_DayNumber(unsigned char dayOfMonth, unsigned char month, unsigned short year)
+{
+	DateTime_Type date = { 0U, 0U, 0U, 1U, 1U, 1970U };
+
+	if (month > 12U)
+	{
+		month = 1U;
+		year++;
+	}
+	date.day = dayOfMonth;
+	date.month = month;
+	date.year = year;
+	return DateTime_ToEpoch(&date) / SECONDS_PER_DAY;
+}
+
+/* Local epoch of the change in the given year */
+static unsigned int TimeZone_RuleLocal(const TimeZone_RuleType *rule, unsigned short year)
+{
+	unsigned int first;
+	unsigned int last;
+	unsigned int dayNumber;
+
+	if (rule->type == TIMEZONE_RULE_MONTH)
+	{
+		/* Weekday d of week w: the first one in the month plus w - 1 weeks, the last if past the end */
+		first = TimeZone_DayNumber(1U, rule->month, year);
+		last = TimeZone_DayNumber(1U, (unsigned char)(rule->month + 1U), year) - 1U;
+		dayNumber = first + ((rule->weekday + 7U - ((first + 4U) % 7U)) % 7U) + ((rule->week - 1U) * 7U);
+		while (dayNumber > last)
+		{
+			dayNumber -= 7U;
+		}
+	}
+	else if (rule->type == TIMEZONE_RULE_JULIAN)
+	{
+		/* Feb 29 is not counted: from March 1 on, a leap year is one day further */
+		first = TimeZone_DayNumber(1U, 1U, year);
+		dayNumber = first + rule->day - 1U;
+		if ((rule->day >= 60U) && ((TimeZone_DayNumber(1U, 3U, year) - first) == 60U))
+		{
+			dayNumber++;
+		}
+	}
+	else
+	{
+		dayNumber = TimeZone_DayNumber(1U, 1U, year) + rule->day;
+	}
+	return (dayNumber * SECONDS_PER_DAY) + (unsigned int)rule->time;
+}
+
+/* UTC epoch of the change, a change before the epoch counts as at the epoch */
+static unsigned int TimeZone_Transition(const TimeZone_RuleType *rule, unsigned short year, int offset)
+{
+	unsigned int local = TimeZone_RuleLocal(rule, year);
+
+	if ((offset > 0) && (local < (unsigned int)offset))
+	{
+		return 0U;
+	}
+	return local - (unsigned int)offset;
+}
+
+/* Offset at utc and the transitions around it */
+static int TimeZone_Evaluate(unsigned int utc, unsigned int *previous, unsigned int *next)
+{
+	unsigned int epoch[TIMEZONE_EVENTS];
+	unsigned char isDst[TIMEZONE_EVENTS];
+	DateTime_Type date;
+	unsigned int swapEpoch;
+	unsigned char swapDst;
+	unsigned char inDst = 0U;
+	unsigned short year;
+	int offset = TimeZone_Zone.stdOffset;
+	unsigned int count = 0U;
+	unsigned int i;
+	unsigned int j;
+
+	*previous = 0U;
+	*next = TIMEZONE_NEVER;
+	if (TimeZone_Zone.hasDst == 0U) return offset;
+	/* Step 1. Transitions in UTC of the 3 years around utc, from 1970 on: the epoch has no
+	 * earlier year, standard time holds until the first transition of 1970 */
+	DateTime_FromEpoch(utc + (unsigned int)TimeZone_Zone.stdOffset, &date);
+	year = (unsigned short)((date.year > TIMEZONE_FIRST_YEAR) ? (date.year - 1U) : TIMEZONE_FIRST_YEAR);
+	if ((TimeZone_Zone.stdOffset < 0) && (utc < (unsigned int)(-TimeZone_Zone.stdOffset)))
+	{
+		/* West of UTC in the first hours of 1970: the local time wrapped to 2106 */
+		year = (unsigned short)TIMEZONE_FIRST_YEAR;
+	}
+	for (i = 0U; i < 3U; i++)
+	{
+		epoch[count] = TimeZone_Transition(&TimeZone_Zone.start, (unsigned short)(year + i), TimeZone_Zone.stdOffset);
+		isDst[count] = 1U;
+		count++;
+		epoch[count] = TimeZone_Transition(&TimeZone_Zone.end, (unsigned short)(year + i), TimeZone_Zone.dstOffset);
+		isDst[count] = 0U;
+		count++;
+	}
+	/* Step 2. Sort, 6 entries */
+	for (i = 1U; i < count; i++)
+	{
+		swapEpoch = epoch[i];
+		swapDst = isDst[i];
+		for (j = i; (j > 0U) && (epoch[j - 1U] > swapEpoch); j--)
+		{
+			epoch[j] = epoch[j - 1U];
+			isDst[j] = isDst[j - 1U];
+		}
+		epoch[j] = swapEpoch;
+		isDst[j] = swapDst;
+	}
+	/* Step 3. The last transition at or before utc decides; an end of daylight time with none
+	 * started (the first of a southern zone in 1970) changes nothing and is skipped */
+	for (i = 0U; i < count; i++)
+	{
+		if (isDst[i] == inDst) continue;
+		if (epoch[i] > utc)
+		{
+			*next = epoch[i];
+			break;
+		}
+		*previous = epoch[i];
+		inDst = isDst[i];
+		offset = (isDst[i] == 1U) ? TimeZone_Zone.dstOffset : TimeZone_Zone.stdOffset;
+	}
+	return offset;
+}
+/*==================================================================================================
+*                                    GLOBAL FUNCTIONS
+==================================================================================================*/
+void TimeZone_Init(void)
+{
+	(void)TimeZone_Set(TIMEZONE_DEFAULT);
+}
+
+unsigned char TimeZone_Set(const char *tz)
+{
+	TimeZone_Type zone;
+	const char *p = tz;
+	unsigned int critical;
+	int offset;
+
+	/* Step 1. Standard time: name and offset */
+	if ((TimeZone_ParseName(&p) == 0U) || (TimeZone_ParseTime(&p, &offset) == 0U)) return 0U;
+	zone.stdOffset = -offset;
+	zone.dstOffset = zone.stdOffset;
+	zone.hasDst = 0U;
+	/* Step 2. Daylight time: name, optional offset (one hour ahead by default) and rules */
+	if (*p != '\0')
+	{
+		if (TimeZone_ParseName(&p) == 0U) return 0U;
+		zone.hasDst = 1U;
+		zone.dstOffset = zone.stdOffset + 3600;
+		if ((*p != ',') && (*p != '\0'))
+		{
+			if (TimeZone_ParseTime(&p, &offset) == 0U) return 0U;
+			zone.dstOffset = -offset;
+		}
+		if (*p == ',')
+		{
+			p++;
+			if (TimeZone_ParseRule(&p, &zone.start) == 0U) return 0U;
+			if (*p != ',') return 0U;
+			p++;
+			if (TimeZone_ParseRule(&p, &zone.end) == 0U) return 0U;
+		}
+		else
+		{
+			/* No rules: US, M3.2.0,M11.1.0 */
+			zone.start.type = TIMEZONE_RULE_MONTH;
+			zone.start.month = 3U;
+			zone.start.week = 2U;
+			zone.start.weekday = 0U;
+			zone.start.time = TIMEZONE_RULE_TIME;
+			zone.end = zone.start;
+			zone.end.month = 11U;
+			zone.end.week = 1U;
+		}
+	}
+	if (*p != '\0') return 0U;
+	/* Step 3. Load, the next TimeZone_GetOffset() evaluates the rules */
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	TimeZone_Zone = zone;
+	TimeZone_Current = zone.stdOffset;
+	TimeZone_Previous = TIMEZONE_NEVER;
+	TimeZone_Next = 0U;
+	NVIC_ExitCritical(critical);
+	LOG3(LOG_ZONE_SET, (zone.stdOffset < 0) ? (unsigned int)(-zone.stdOffset) : (unsigned int)zone.stdOffset,
+	     (zone.stdOffset < 0) ? 1U : 0U, zone.hasDst);
+	return 1U;
+}
+
+void TimeZone_Update(unsigned int utc)
+{
+	unsigned int previous;
+	unsigned int next;
+	unsigned int critical;
+	int offset;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	offset = TimeZone_Evaluate(utc, &previous, &next);
+	TimeZone_Current = offset;
+	TimeZone_Previous = previous;
+	TimeZone_Next = next;
+	NVIC_ExitCritical(critical);
+}
+
+unsigned int TimeZone_LocalToUtc(unsigned int local)
+{
+	unsigned int previous;
+	unsigned int next;
+	unsigned int critical;
+	unsigned int utc = local - (unsigned int)TimeZone_Zone.stdOffset;
+	int offset;
+
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	/* Read as standard time; if that instant is in daylight time, read as daylight time if it stays there */
+	offset = TimeZone_Evaluate(utc, &previous, &next);
+	if (offset != TimeZone_Zone.stdOffset)
+	{
+		if (TimeZone_Evaluate(local - (unsigned int)offset, &previous, &next) == offset)
+		{
+			utc = local - (unsigned int)offset;
+		}
+	}
+	NVIC_ExitCritical(critical);
+	return utc;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file    Timestamp.c
+ * @brief   Free-running 64-bit microsecond timestamp
+ * @details Sets up LPIT channels 0 and 1 as one chained 64-bit down counter.
+ *
+ * @version 1.0
+ * @date    2024-10-20
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Timestamp.h"
+/*==================================================================================================
+*                                      LOCAL CONSTANTS
+==================================================================================================*/
+/* Full 32-bit reload, no interrupt; the high channel counts timeouts of the low one */
+static const Lpit_ChannelConfigType Timestamp_LowConfig  = { .period = MAX_TAVL_VALUE };
+static const Lpit_ChannelConfigType Timestamp_HighConfig = { .period = MAX_TAVL_VALUE, .isChained = 1 };
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+unsigned int Timestamp_TicksPerUs;
+/*==================================================================================================
+*                                      GLOBAL FUNCTIONS
+==================================================================================================*/
+void Timestamp_Init(void)
+{
+	unsigned int freq = Clock_GetFrequency(LPIT0_CLK);
+
+	/* Step 1. Need a whole number of clocks per microsecond */
+	if ((freq == 0U) || ((freq % 1000000U) != 0U))
+	{
+		return;
+	}
+	Timestamp_TicksPerUs = freq / 1000000U;
+	/* Step 2. Configure both channels */
+	Lpit_InitChannel(TIMESTAMP_CHANNEL_LOW, &Timestamp_LowConfig);
+	Lpit_InitChannel(TIMESTAMP_CHANNEL_HIGH, &Timestamp_HighConfig);
+	/* Step 3. High channel first so that no wrap of the low channel is lost */
+	Lpit_StartChannel(TIMESTAMP_CHANNEL_HIGH);
+	Lpit_StartChannel(TIMESTAMP_CHANNEL_LOW);
+}
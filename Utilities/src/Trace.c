@@ -0,0 +1,46 @@
+/**
+ * @file    Trace.c
+ * @brief   Binary event trace in a RAM ring buffer
+ * @details Recording is inline in Trace.h; this file owns the buffer and the
+ *          read side used by the UART dump.
+ *
+ * @version 1.0
+ * @date    2024-10-09
+ * @author  Mai Anh Tuan
+ */
+/*==================================================================================================
+*                                       INCLUDE FILE
+==================================================================================================*/
+#include "Trace.h"
+/*==================================================================================================
+*                                      GLOBAL VARIABLES
+==================================================================================================*/
+Trace_RecordType Trace_Buffer[TRACE_BUFFER_SIZE];
+volatile unsigned int Trace_Head;
+volatile unsigned char Trace_Enabled;
+/*==================================================================================================
+*                                      GLOBAL FUNCTIONS
+==================================================================================================*/
+void Trace_Init(void)
+{
+	Trace_Enabled = 0U;
+	Trace_Head = 0U;
+	Trace_Enabled = (TRACE_ENABLE == 1) ? 1U : 0U;
+}
+
+unsigned int Trace_Count(void)
+{
+	unsigned int head = Trace_Head;
+
+	return (head > TRACE_BUFFER_SIZE) ? TRACE_BUFFER_SIZE : head;
+}
+
+unsigned char Trace_Read(unsigned int index, Trace_RecordType *record)
+{
+	unsigned int head = Trace_Head;
+	unsigned int count = (head > TRACE_BUFFER_SIZE) ? TRACE_BUFFER_SIZE : head;
+
+	if ((record == NULL) || (index >= count)) return 0U;
+	*record = Trace_Buffer[(head - count + index) & (TRACE_BUFFER_SIZE - 1U)];
+	return 1U;
+}
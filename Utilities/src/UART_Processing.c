@@ -13,22 +13,85 @@
 *                                       INCLUDE FILE
 ==================================================================================================*/
 #include "UART_Processing.h"
+#include "Stats.h"
+#include "Stack.h"
+#include "Lmem.h"
+#include "Brownout.h"
+#include "Alarm.h"
+#include "TimeZone.h"
+#include "ProcessDateTime.h"
+#include "Tick.h"
+#include "Sync.h"
+#include "Pps.h"
+#include "Timestamp.h"
+#include "Button.h"
+#include "MAX7219.h"
+#include "Log.h"
 
  /*==================================================================================================
 *                                       LOCAL VARIABLES
 ==================================================================================================*/
 static unsigned char received_data[MAX_LENGHT];
 static unsigned char count_input_data=0;
+static unsigned char frame_overrun=0;
+static unsigned long long frame_start_ticks;
 static unsigned char Setting_Date_String[20] = "Setting Date:"; 
 static unsigned char Setting_Time_String[20] = "Setting Time:"; 
+static unsigned char Get_Stats_String[20] = "GET STATS";
+static unsigned char Get_Trace_String[20] = "GET TRACE";
+static unsigned char Get_Stack_String[20] = "GET STACK";
+static unsigned char Setting_Alarm_String[20] = "Setting Alarm:";
+static unsigned char Get_Alarms_String[20] = "GET ALARMS";
+static unsigned char Clear_Alarms_String[20] = "CLEAR ALARMS";
+static unsigned char Setting_Zone_String[20] = "Setting Zone:";
+static unsigned char Setting_Calib_String[20] = "Setting Calib:";
+static unsigned char Get_Sync_String[20] = "GET SYNC";
+ /*==================================================================================================
+*                                       LOCAL FUNCTIONS PROTOTYPE
+==================================================================================================*/
+static void print_Line(const char *label, const unsigned int *values, unsigned char count);
+ /*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+static void print_Line(const char *label, const unsigned int *values, unsigned char count)
+{
+	/* "label v0 v1 ...\n", at most 5 numbers of 10 digits */
+	char line[64];
+	unsigned char length;
+	unsigned char i;
+	my_strcpy(line, label);
+	length = my_strlen(line);
+	for (i = 0; i < count; i++)
+	{
+		line[length] = ' ';
+		length++;
+		length += my_utoa(values[i], &line[length]);
+	}
+	line[length] = '\n';
+	line[length + 1U] = '\0';
+	print_Output(line);
+}
  /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
 void receive_data(void)
 {
+	/* Arrival of the first byte, the receive time of a sync frame. Nothing masks this
+	   interrupt for long (log lines and replies leave from the TX queue); a handler
+	   later than one character lets the second byte overrun and the frame is rejected,
+	   so an accepted frame is stamped less than a character (520us) late */
+	if (count_input_data == 0)
+	{
+		frame_start_ticks = Timestamp_NowTicks();
+	}
+	else
+	{
+		/*do not thing*/
+	}
 	/* Receive data from LPUART1 and store it in the received_data array */
 	Lpuart_Receive(LPUART1, &received_data[count_input_data]);
 	count_input_data++;
+	Stats_Counter.uartRxBytes++;
 	/* Reset count_input_data if it exceeds MAX_LENGTH */
 	if (count_input_data > MAX_LENGHT)
 	{
@@ -40,10 +103,18 @@ void receive_data(void)
 	}
 }
 
+void receive_overrun(void)
+{
+	/* Bytes of this frame were lost, it is rejected when complete */
+	frame_overrun = 1;
+	Stats_Counter.uartOverruns++;
+}
+
 void reset_data(volatile unsigned char *str)
 {
-	/* Reset the input data counter */
+	/* Reset the input data counter and the overrun of the frame */
 	count_input_data=0;
+	frame_overrun=0;
 	/* Clear the string buffer by setting all elements to null */
 	for (int i=0; i< MAX_LENGHT;i++)
 	{
@@ -61,11 +132,20 @@ void print_Output(char *str)
 	/* Get the length of the input string */
 	static int length;
 	length = my_strlen(str);
-	/* Transmit the string via LPUART */
-	Lpuart_Transmit(LPUART1,(unsigned char*) str, (unsigned char)length);
+	/* Queue the string, the LPUART1 TX interrupt sends it along with the log lines */
+	Lpuart_Write(LPUART1,(unsigned char*) str, (unsigned char)length);
+	Stats_Counter.uartTxBytes += (unsigned int)length;
 }
 
 
+void print_Rejected(unsigned char state_set)
+{
+	/* Answer on the UART and, for a user away from the terminal, on the display */
+	print_Output((char*)Error_String);
+	LOG1(LOG_UART_REJECTED, state_set);
+	MAX7219_ShowMessage("Err", ERROR_HOLD_MS);
+}
+
 void process_setting(volatile unsigned char *state_set)
 {	
 	/* Compare the received data to predefined setting strings */
@@ -79,11 +159,62 @@ void process_setting(volatile unsigned char *state_set)
 		 /* Set the state to SET_TIME if the time string is matched */
 		*state_set = SET_TIME;
 	}
+	else if (stringcompare(received_data, Get_Stats_String))
+	{
+		 /* One-shot report, no value follows */
+		*state_set = GET_STATS;
+	}
+	else if (stringcompare(received_data, Get_Trace_String))
+	{
+		 /* One-shot dump, no value follows */
+		*state_set = GET_TRACE;
+	}
+	else if (stringcompare(received_data, Get_Stack_String))
+	{
+		 /* One-shot report, no value follows */
+		*state_set = GET_STACK;
+	}
+	else if (stringcompare(received_data, Setting_Alarm_String))
+	{
+		 /* The alarm time and repeat follow */
+		*state_set = SET_ALARM;
+	}
+	else if (stringcompare(received_data, Get_Alarms_String))
+	{
+		 /* One-shot report, no value follows */
+		*state_set = GET_ALARMS;
+	}
+	else if (stringcompare(received_data, Clear_Alarms_String))
+	{
+		 /* One-shot command, no value follows */
+		*state_set = CLEAR_ALARMS;
+	}
+	else if (stringcompare(received_data, Setting_Zone_String))
+	{
+		 /* The POSIX TZ string follows */
+		*state_set = SET_ZONE;
+	}
+	else if (stringcompare(received_data, Setting_Calib_String))
+	{
+		 /* The clock error in ppm follows */
+		*state_set = SET_CALIB;
+	}
+	else if (stringcompare(received_data, Get_Sync_String))
+	{
+		 /* One-shot report, no value follows */
+		*state_set = GET_SYNC;
+	}
 	else 
 	{
 		 /* Set the state to NOT_SETTING if no match is found */
 		*state_set = NOT_SETTING;
 	}
+	TRACE(TRACE_EVT_UART_COMMAND, *state_set);
+}
+
+unsigned char Check_Overrun(void)
+{
+	return frame_overrun;
 }
 
 unsigned char Check_Date_Format(void)
@@ -110,6 +241,42 @@ unsigned char Check_Time_Format(void)
 	}
 }
 
+unsigned char Check_Alarm_Format(void)
+{
+	if (Check_Format_Setting_Alarm((char*)received_data))
+	{
+		return TRUE;
+	}
+	else 
+	{
+		return FALSE;
+	}
+}
+
+unsigned char Check_Calib_Format(void)
+{
+	if (Check_Format_Setting_Ppm((char*)received_data))
+	{
+		return TRUE;
+	}
+	else 
+	{
+		return FALSE;
+	}
+}
+
+unsigned char Check_Sync_Format(void)
+{
+	if (Check_Format_Sync((char*)received_data))
+	{
+		return TRUE;
+	}
+	else 
+	{
+		return FALSE;
+	}
+}
+
 void Update_Date(unsigned char *day, unsigned char *month, unsigned short *year)
 {
 	/* Temporary buffer to store the received date string */
@@ -149,4 +316,280 @@ void Update_Time(unsigned char *second, unsigned char *minute, unsigned char *ho
   *second = my_atouchar(token);
 }
 
+void Update_Alarm(unsigned int *timeOfDay, unsigned char *repeat)
+{
+	unsigned char hour;
+	unsigned char minute;
+	unsigned char second;
+	/* "hh-mm-ss R", already checked: the time part is parsed like a time setting */
+	received_data[8] = '\0';
+	Update_Time(&second, &minute, &hour);
+	*timeOfDay = ((unsigned int)hour * 3600U) + ((unsigned int)minute * 60U) + second;
+	if (received_data[9] == 'D')
+	{
+		*repeat = ALARM_DAILY;
+	}
+	else if (received_data[9] == 'W')
+	{
+		*repeat = ALARM_WEEKDAYS;
+	}
+	else
+	{
+		*repeat = ALARM_ONCE;
+	}
+}
+
+unsigned char Update_Zone(void)
+{
+	/* The whole line is the TZ string, checked and loaded by the time zone module */
+	return TimeZone_Set((const char*)received_data);
+}
+
+void Update_Calib(int *ppm)
+{
+	/* "+XXX" or "-XXX", already checked: the digits are parsed like a year */
+	if ((received_data[0] == '+') || (received_data[0] == '-'))
+	{
+		*ppm = (int)my_atoushort((char*)&received_data[1]);
+		if (received_data[0] == '-')
+		{
+			*ppm = -*ppm;
+		}
+	}
+	else
+	{
+		*ppm = (int)my_atoushort((char*)received_data);
+	}
+}
+
+void Update_Sync(unsigned long long *t1, unsigned long long *t4, unsigned long long *rxTicks)
+{
+	/* Temporary buffer to store the received frame */
+	char temp[MAX_LENGHT];
+	unsigned int fields[4];
+	char *token;
+	unsigned char i;
+	/* "SYNC s1 u1 s4 u4", already checked: tokenize the numbers after "SYNC " */
+	my_strcpy(temp, (char*)&received_data[5]);
+	token = my_strtok(temp, " ");
+	for (i = 0; i < 4; i++)
+	{
+		fields[i] = my_atou(token);
+		token = my_strtok(NULL, " ");
+	}
+	*t1 = ((unsigned long long)fields[0] * 1000000U) + fields[1];
+	*t4 = ((unsigned long long)fields[2] * 1000000U) + fields[3];
+	*rxTicks = frame_start_ticks;
+}
+
+void print_Stats(void)
+{
+	Stats_IrqType irq[STATS_IRQ_NUMBER];
+	Stats_CounterType counter;
+	Button_StatsType button[BUTTON_MAX_NUMBER];
+	const Button_StatsType *stats;
+	unsigned int buttons = 0U;
+	unsigned int values[4];
+	unsigned int critical;
+	unsigned int i;
+	/* Snapshot first, the report itself takes tens of ms at 19200 baud */
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	for (i = 0U; i < STATS_IRQ_NUMBER; i++)
+	{
+		irq[i] = Stats_Irq[i];
+	}
+	counter = Stats_Counter;
+	while ((stats = Button_GetStats((unsigned char)buttons)) != NULL)
+	{
+		button[buttons] = *stats;
+		buttons++;
+	}
+	values[0] = Stats_CpuLoad;
+	NVIC_ExitCritical(critical);
+	/* CPU load in 0.1% */
+	print_Line("\nCPU LOAD x0.1%", values, 1U);
+	/* Build flag: 1 when the hot handlers run from SRAM_L, durations below depend on it */
+	values[0] = CODE_RAM_ENABLE;
+	print_Line("CODE RAM", values, 1U);
+	/* 1 when the LMEM code cache is on, durations below depend on it */
+	values[0] = Lmem_IsEnabled();
+	print_Line("CODE CACHE", values, 1U);
+	/* Per interrupt: count, max and average duration in core cycles */
+	print_Output("IRQ COUNT MAX AVG\n");
+	for (i = 0U; i < STATS_IRQ_NUMBER; i++)
+	{
+		values[0] = irq[i].count;
+		values[1] = irq[i].maxCycles;
+		values[2] = (irq[i].count != 0U) ? (unsigned int)(irq[i].totalCycles / irq[i].count) : 0U;
+		print_Line(Stats_IrqName((Stats_IrqIdType)i), values, 3U);
+	}
+	values[0] = counter.spiWords;
+	print_Line("SPI WORDS", values, 1U);
+	values[0] = counter.uartRxBytes;
+	values[1] = counter.uartTxBytes;
+	values[2] = counter.uartOverruns;
+	print_Line("UART RX TX OVERRUNS", values, 3U);
+	/* Per button: pin interrupts, raw level changes, debounced events; raw above events is bounce */
+	for (i = 0U; i < buttons; i++)
+	{
+		values[0] = i;
+		values[1] = button[i].irqCount;
+		values[2] = button[i].rawEdges;
+		values[3] = button[i].events;
+		print_Line("BUTTON N IRQ EDGES EVENTS", values, 4U);
+	}
+	/* Low voltage warnings, snapshot time last and max in us, snapshots over budget */
+	values[0] = Brownout_Stats.count;
+	values[1] = Brownout_CyclesToUs(Brownout_Stats.lastCycles);
+	values[2] = Brownout_CyclesToUs(Brownout_Stats.maxCycles);
+	values[3] = Brownout_Stats.overBudget;
+	print_Line("BROWNOUT", values, 4U);
+}
+
+void print_Trace(void)
+{
+	Trace_RecordType record;
+	unsigned int values[2];
+	unsigned int count;
+	unsigned int i;
+	char line[20];
+	/* Freeze the buffer, the dump takes about 10ms per record at 19200 baud */
+	Trace_Enabled = 0U;
+	count = Trace_Count();
+	/* Header: LPIT ticks per us, number of records */
+	values[0] = Timestamp_TicksPerUs;
+	values[1] = count;
+	print_Line("\nTRACE", values, 2U);
+	/* One record per line: "TTTTTTTT EEEE AAAA" */
+	for (i = 0U; i < count; i++)
+	{
+		if (Trace_Read(i, &record) == 0U) break;
+		my_utohex(record.timestamp, 8U, &line[0]);
+		line[8] = ' ';
+		my_utohex(record.event, 4U, &line[9]);
+		line[13] = ' ';
+		my_utohex(record.arg, 4U, &line[14]);
+		line[18] = '\n';
+		line[19] = '\0';
+		print_Output(line);
+	}
+	print_Output("END\n");
+	/* Start a fresh trace */
+	Trace_Init();
+}
+
+void print_Stack(void)
+{
+	unsigned int values[3];
+	/* Size, deepest use since boot and what is left, in bytes */
+	values[0] = Stack_GetSize();
+	values[1] = Stack_GetUsed();
+	values[2] = values[0] - values[1];
+	print_Line("\nSTACK SIZE USED FREE", values, 3U);
+	if (Stack_IsOverflowed())
+	{
+		print_Output("STACK OVERFLOW\n");
+	}
+	else
+	{
+		/*do not thing*/
+	}
+}
 
+void print_Alarms(void)
+{
+	Alarm_Type alarms[ALARM_MAX];
+	unsigned int values[3];
+	unsigned int critical;
+	unsigned int count;
+	unsigned int i;
+	/* Copy first, the heap changes when an alarm fires */
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	count = Alarm_Count;
+	for (i = 0U; i < count; i++)
+	{
+		alarms[i] = Alarm_Heap[i];
+	}
+	NVIC_ExitCritical(critical);
+	values[0] = count;
+	print_Line("\nALARMS", values, 1U);
+	/* Heap order, the first one fires next: id, seconds of day, repeat (0 once, 1 daily, 2 weekdays) */
+	for (i = 0U; i < count; i++)
+	{
+		values[0] = alarms[i].id;
+		values[1] = alarms[i].timeOfDay;
+		values[2] = alarms[i].repeat;
+		print_Line("ALARM", values, 3U);
+	}
+}
+
+void print_Zone(void)
+{
+	unsigned int values[2];
+	unsigned int critical;
+	int offset;
+	/* Offset in force now and UTC epoch of the next change */
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	offset = TimeZone_GetOffset(DateTime_Utc);
+	values[1] = TimeZone_Next;
+	NVIC_ExitCritical(critical);
+	values[0] = (offset < 0) ? (unsigned int)(-offset) : (unsigned int)offset;
+	print_Line((offset < 0) ? "\nZONE WEST" : "\nZONE EAST", values, 1U);
+	/* 4294967295: no daylight saving */
+	print_Line("NEXT CHANGE", &values[1], 1U);
+}
+
+void print_Calib(void)
+{
+	unsigned int values[1];
+	int ppm = Tick_Ppm;
+	/* Correction in force: ppm the clock gains (FAST) or loses (SLOW) without it */
+	values[0] = (ppm < 0) ? (unsigned int)(-ppm) : (unsigned int)ppm;
+	print_Line((ppm < 0) ? "\nCALIB SLOW PPM" : "\nCALIB FAST PPM", values, 1U);
+}
+
+void print_Sync_Reply(void)
+{
+	unsigned long long t2;
+	unsigned long long t3;
+	unsigned int values[4];
+	/* "SYNC s2 u2 s3 u3": t3 is taken here, the line goes out right after,
+	   once the log lines queued before it have left */
+	Lpuart_Flush(LPUART1);
+	Sync_Reply(&t2, &t3);
+	values[0] = (unsigned int)(t2 / 1000000U);
+	values[1] = (unsigned int)(t2 % 1000000U);
+	values[2] = (unsigned int)(t3 / 1000000U);
+	values[3] = (unsigned int)(t3 % 1000000U);
+	print_Line("SYNC", values, 4U);
+}
+
+void print_Sync(void)
+{
+	Sync_StatusType status = Sync_Status;
+	Pps_StatsType pps = Pps_Stats;
+	unsigned int values[4];
+	/* State (0 none, 1 tracking, 2 locked, 3 holdover), source (1 serial, 2 pps), measurements, steps */
+	values[0] = status.state;
+	values[1] = status.source;
+	values[2] = status.count;
+	values[3] = status.steps;
+	print_Line("\nSYNC STATE SOURCE COUNT STEPS", values, 4U);
+	/* Last offset from the reference and estimated crystal error */
+	values[0] = (status.offsetUs < 0) ? (unsigned int)(-status.offsetUs) : (unsigned int)status.offsetUs;
+	print_Line((status.offsetUs < 0) ? "SYNC BEHIND US" : "SYNC AHEAD US", values, 1U);
+	values[0] = (status.freqPpb < 0) ? (unsigned int)(-status.freqPpb) : (unsigned int)status.freqPpb;
+	print_Line((status.freqPpb < 0) ? "SYNC SLOW PPB" : "SYNC FAST PPB", values, 1U);
+	/* Round trip and estimated accuracy */
+	values[0] = status.delayUs;
+	values[1] = Sync_GetAccuracy();
+	print_Line("SYNC DELAY ACCURACY US", values, 2U);
+	/* Seconds since the last measurement, holdovers entered */
+	values[0] = Sync_GetAge();
+	values[1] = status.holdovers;
+	print_Line("SYNC AGE S HOLDOVERS", values, 2U);
+	values[0] = pps.edges;
+	values[1] = pps.glitches;
+	values[2] = pps.overruns;
+	print_Line("PPS EDGES GLITCHES OVERRUNS", values, 3U);
+}
@@ -27,6 +27,18 @@
 #include "MAX7219.h"
 #include "UART_Processing.h"
 #include "ProcessDateTime.h"
+#include "SoftTimer.h"
+#include "Button.h"
+#include "Stats.h"
+#include "Log.h"
+#include "Stack.h"
+#include "Journal.h"
+#include "Brownout.h"
+#include "Alarm.h"
+#include "TimeZone.h"
+#include "Tick.h"
+#include "Sync.h"
+#include "Pps.h"
 /*==================================================================================================
 *                                FUNCTION PROTOTYPES
 ==================================================================================================*/
@@ -34,6 +46,15 @@ void PORTC_IRQHandler(void);
 void LPUART1_RxTx_IRQHandler(void);
 void LPIT0_Ch3_IRQHandler(void);
 void ADC0_IRQHandler (void);
+void SysTick_Handler(void);
+void LVD_LVW_IRQHandler(void);
+void FTFC_IRQHandler(void);
+void FTM0_Ch0_Ch1_IRQHandler(void);
+static void Main_ButtonEvent(unsigned char button, Button_EventType event);
+static void Main_Restore(void);
+static void Main_JournalSource(Journal_RecordType *record);
+static void Main_SnapshotSource(Journal_RecordType *record);
+static unsigned int Main_Now(void);
 /*==================================================================================================
 *                                GLOBAL VARIALBES
 ==================================================================================================*/
@@ -51,28 +72,126 @@ unsigned char Date_Updated_Str[] = "\nDate Updated\n";
 unsigned char Time_Updated_Str[] = "\nTime Updated\n";
 unsigned char Time_Format_Str[] = "\nPlease type right format: XX-XX-XX\n";
 unsigned char Date_Format_Str[] = "\nPlease type right format: dd.mm.yyyy\n";
+unsigned char Alarm_Format_Str[] = "\nPlease type right format: XX-XX-XX O/D/W\n";
+unsigned char Zone_Format_Str[] = "\nPlease type POSIX TZ: CET-1CEST,M3.5.0,M10.5.0/3\n";
+unsigned char Calib_Format_Str[] = "\nPlease type clock error in ppm: +XX/-XX\n";
 /*==================================================================================================
 *                                MAIN FUNCTION
 ==================================================================================================*/
 int main(void)
 {
+	/*Fill the unused stack with a pattern for the high-water mark*/
+	Stack_Paint();
 	/*Function to configure overall system*/
 	Config_System();
+	/*Local time rules, before the saved UTC clock is shown as local time*/
+	TimeZone_Init();
+	/*Continue from the time and settings saved in FlexNVM*/
+	Main_Restore();
+	Journal_SetSource(Main_JournalSource);
+	/*Save the clock on low voltage warning*/
+	Brownout_SetSource(Main_SnapshotSource);
+	Brownout_Init();
+	/*Alarm output idle, no alarm until set over UART*/
+	Alarm_Init();
+	/*Button presses switch the display modes*/
+	Button_SetEventCallback(Main_ButtonEvent);
 	/*Function to init module MAX*/
 	Init_MAX7219();
+	LOG0(LOG_BOOT);
 	while(1)
 	{
-		/*empty*/
+		/*Send pending log records, save the clock when due, discipline the clock from a PPS edge, otherwise sleep until the next interrupt; idle time gives the CPU load*/
+		if ((Log_Process() == 0U) && (Journal_Process() == 0U) && (Sync_Process() == 0U))
+		{
+			Stats_Idle();
+		}
+	}
+}
+
+static void Main_Restore(void)
+{
+	Journal_RecordType record;
+	DateTime_Type now;
+	unsigned int critical;
+	if (Journal_Init(&record) == 0U)
+	{
+		/*First boot: SRS 1 defaults, taken as local time*/
+		critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+		DateTime_Get(&now);
+		DateTime_SetUtc(TimeZone_LocalToUtc(DateTime_ToEpoch(&now)));
+		NVIC_ExitCritical(critical);
+		return;
+	}
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	DateTime_SetUtc(record.epoch);
+	State_Button1 = ((record.settings & JOURNAL_SETTING_TIME_MODE) != 0U) ? DISPLAY_TIME_MODE : DISPLAY_DATE_MODE;
+	State_Button2 = ((record.settings & JOURNAL_SETTING_DISPLAY_ON) != 0U) ? TURNON_DISPLAY_MODE : TURNOFF_DISPLAY_MODE;
+	if ((record.type & JOURNAL_TYPE_MASK) == JOURNAL_TYPE_SNAPSHOT)
+	{
+		/*Snapshot: continue from the quarter second it was taken in*/
+		count = (unsigned char)(record.type >> JOURNAL_PHASE_SHIFT);
 	}
+	else
+	{
+		/*do not thing*/
+	}
+	NVIC_ExitCritical(critical);
+	LOG2(LOG_JOURNAL_RESTORED, Journal_Stats.sequence, record.epoch);
+}
+
+static void Main_JournalSource(Journal_RecordType *record)
+{
+	/*Saved in UTC, a zone change does not move the clock*/
+	record->epoch = DateTime_Utc;
+	record->settings = (unsigned char)(((State_Button1 == DISPLAY_TIME_MODE) ? JOURNAL_SETTING_TIME_MODE : 0U)
+	                 | ((State_Button2 == TURNON_DISPLAY_MODE) ? JOURNAL_SETTING_DISPLAY_ON : 0U));
+	record->type = JOURNAL_TYPE_PERIODIC;
+}
+
+static unsigned int Main_Now(void)
+{
+	unsigned int critical;
+	unsigned int now;
+	/*Local epoch, alarms ring at local time*/
+	critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+	now = DateTime_Utc + (unsigned int)TimeZone_Current;
+	NVIC_ExitCritical(critical);
+	return now;
+}
+
+static void Main_SnapshotSource(Journal_RecordType *record)
+{
+	/*Priority 0, nothing preempts it: no lock, the UTC clock is one word*/
+	record->settings = (unsigned char)(((State_Button1 == DISPLAY_TIME_MODE) ? JOURNAL_SETTING_TIME_MODE : 0U)
+	                 | ((State_Button2 == TURNON_DISPLAY_MODE) ? JOURNAL_SETTING_DISPLAY_ON : 0U));
+	record->epoch = DateTime_Utc;
+	/*count is 4 for a moment inside the tick*/
+	record->type = (unsigned char)(JOURNAL_TYPE_SNAPSHOT | ((count & 0x03U) << JOURNAL_PHASE_SHIFT));
 }
 
 void PORTC_IRQHandler(void)
 {
-	/* Check interrupt flag of Pin12-PortC(Button1) */
-	if(PORTC->PCR[12] & (1<<24))
+	unsigned int start = Stats_IrqEnter(STATS_IRQ_PORTC);
+	/* Button 1/2 edges, debounced by the button module */
+	Button_IrqHandler(PORTC);
+	Stats_IrqExit(STATS_IRQ_PORTC, start);
+}
+
+static void Main_ButtonEvent(unsigned char button, Button_EventType event)
+{
+	LOG2(LOG_BUTTON_EVENT, button, event);
+	if (event != BUTTON_EVENT_PRESS)
+	{
+		return;
+	}
+	if (Alarm_Stop() == 1U)
+	{
+		/* A press during an alarm only silences it */
+		return;
+	}
+	if (button == BUTTON_1)
 	{
-		/* Clear interrupt flag */
-		PORTC->PCR[12] |= (1<<24);
 		/* Toggle state of button 1 */
 		State_Button1++;
 		if (State_Button1 > DISPLAY_TIME_MODE)
@@ -80,11 +199,8 @@ void PORTC_IRQHandler(void)
 			State_Button1 = DISPLAY_DATE_MODE;
 		}
 	}
-	/* Check interrupt flag of Pin13-PortC(Button2) */
-	else if (PORTC->PCR[13] & (1<<24))
+	else if (button == BUTTON_2)
 	{
-		/* Clear interrupt flag */
-		PORTC->PCR[13] |= (1<<24);
 		/* Toggle state of button 2 */
 		State_Button2++;
 		if (State_Button2 > TURNON_DISPLAY_MODE)
@@ -100,11 +216,29 @@ void PORTC_IRQHandler(void)
 
 void LPUART1_RxTx_IRQHandler(void)
 {
+	unsigned int start = Stats_IrqEnter(STATS_IRQ_UART);
+	unsigned int critical;
+	unsigned int timeOfDay;
+	unsigned char repeat;
+	unsigned char id;
+	int ppm;
+	unsigned long long reference;
+	unsigned long long received;
+	unsigned long long rxTicks;
+	/* Receiver overrun: a byte was lost, the receiver is stalled until OR is cleared */
+	if (Lpuart_ClearOverrun(LPUART1))
+	{
+		receive_overrun();
+	}
+	else 
+	{
+		/*do not thing*/
+	}
 	/* Check idle flag */
 	if (((LPUART1->STAT >> LPUART_STAT_IDLE_SHIFT)&0x01))  
 	{
-		/* Clear the interrupt flag */
-		LPUART1->STAT |=(1U<<LPUART_STAT_IDLE_SHIFT);			
+		/* Clear the interrupt flag alone, OR set meanwhile must stay for the next run */
+		LPUART1->STAT = (LPUART1->STAT & ~LPUART_STAT_W1C_MASK) | (1U<<LPUART_STAT_IDLE_SHIFT);
 		/* Set the flag indicating input is complete */		
 		input_complete = INPUT_COMPLETE;											
 	}
@@ -112,13 +246,48 @@ void LPUART1_RxTx_IRQHandler(void)
 	{
 		/*do not thing*/
 	}
-	/*Function to receive buffer data*/
-	receive_data();
+	/*Function to receive buffer data, the handler also runs for the TX queue*/
+	if (((LPUART1->STAT >> LPUART_STAT_RDRF_SHIFT)&0x01))
+	{
+		receive_data();
+	}
+	else 
+	{
+		/*do not thing*/
+	}
+	/*Next queued byte of the console replies and log lines*/
+	Lpuart_TxIrqHandler(LPUART1);
 	/*Check input complete or not*/
 	if((input_complete == INPUT_COMPLETE))
 		{
 			/*Check state set*/
-			if ((State_Set == NOT_SETTING))
+			if (Check_Overrun())
+			{
+				/*Bytes were lost: the frame, and for a sync frame its arrival time, cannot be trusted*/
+				print_Rejected(State_Set);
+				/*Reset initial conditions*/
+				input_complete = INPUT_NONE_COMPLETE;
+				reset_received_data();
+			}
+			else if ((State_Set == NOT_SETTING) && Check_Sync_Format())
+			{
+				/*Time reference frame: answered at once, outside the setting states*/
+				Update_Sync(&reference, &received, &rxTicks);
+				if (Sync_Exchange(reference, received, rxTicks) == 1U)
+				{
+					/*Stepped: recurring alarms follow the new time*/
+					Alarm_Reschedule(Main_Now());
+				}
+				else
+				{
+					/*do not thing*/
+				}
+				print_Sync_Reply();
+				/*Reset initial conditions*/
+				input_complete = INPUT_NONE_COMPLETE;
+				reset_received_data();
+			}
+			else if ((State_Set == NOT_SETTING))
 			{
 				/*Function to check, process input buffer from RX-UART1 and return State_Set */
 				process_setting(&State_Set);
@@ -135,10 +304,62 @@ void LPUART1_RxTx_IRQHandler(void)
 					/*Show format Time String for setting Date*/
 					print_Output((char*)Time_Format_Str);
 				}
+				else if (State_Set == GET_STATS)
+				{
+					/*Report runtime statistics, nothing else to receive*/
+					print_Stats();
+					State_Set = NOT_SETTING;
+				}
+				else if (State_Set == GET_TRACE)
+				{
+					/*Dump the event trace, nothing else to receive*/
+					print_Trace();
+					State_Set = NOT_SETTING;
+				}
+				else if (State_Set == GET_STACK)
+				{
+					/*Report the stack high-water mark, nothing else to receive*/
+					print_Stack();
+					State_Set = NOT_SETTING;
+				}
+				else if (State_Set == SET_ALARM)
+				{
+					/*Show format Alarm String for setting an alarm*/
+					print_Output((char*)Alarm_Format_Str);
+				}
+				else if (State_Set == GET_ALARMS)
+				{
+					/*List the alarms, nothing else to receive*/
+					print_Alarms();
+					State_Set = NOT_SETTING;
+				}
+				else if (State_Set == SET_ZONE)
+				{
+					/*Show format Zone String for setting the time zone*/
+					print_Output((char*)Zone_Format_Str);
+				}
+				else if (State_Set == SET_CALIB)
+				{
+					/*Show format Calib String for setting the tick calibration*/
+					print_Output((char*)Calib_Format_Str);
+				}
+				else if (State_Set == GET_SYNC)
+				{
+					/*Report the time discipline, nothing else to receive*/
+					print_Sync();
+					State_Set = NOT_SETTING;
+				}
+				else if (State_Set == CLEAR_ALARMS)
+				{
+					/*Remove all alarms, nothing else to receive*/
+					Alarm_Clear();
+					print_Alarms();
+					State_Set = NOT_SETTING;
+				}
 				else 
 				{
 					/*Show error if users input invalid string for setting mode*/
-					print_Output((char*)Error_String);
+					print_Rejected(State_Set);
 				}
 			}
 			else if ((State_Set == SET_DATE))
@@ -146,8 +367,14 @@ void LPUART1_RxTx_IRQHandler(void)
 				/*Function to check Date format from RX-UART1 buffer*/
 				if (Check_Date_Format())
 				{
-					/*Function to update input Date*/
+					/*Function to update input Date, LPIT tick must not see a half-written date*/
+					critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
 					Update_Date(&day, &month, &year);
+					DateTime_SyncUtc();
+					NVIC_ExitCritical(critical);
+					/*Recurring alarms follow the new date*/
+					Alarm_Reschedule(Main_Now());
+					LOG3(LOG_DATE_SET, day, month, year);
 					/*Print successfull notifications*/
 					print_Output((char*)Date_Updated_Str);
 					/*Reset State_Set*/
@@ -155,7 +382,7 @@ void LPUART1_RxTx_IRQHandler(void)
 				}
 				else 
 				{
-					print_Output((char*)Error_String);
+					print_Rejected(State_Set);
 				}
 				/*Reset initial conditions*/
 				input_complete = INPUT_NONE_COMPLETE;
@@ -165,8 +392,14 @@ void LPUART1_RxTx_IRQHandler(void)
 			{
 				if (Check_Time_Format())
 				{
-					/*Function to update input Time*/
+					/*Function to update input Time, LPIT tick must not see a half-written time*/
+					critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
 					Update_Time(&second, &minute, &hour);
+					DateTime_SyncUtc();
+					NVIC_ExitCritical(critical);
+					/*Recurring alarms follow the new time*/
+					Alarm_Reschedule(Main_Now());
+					LOG3(LOG_TIME_SET, hour, minute, second);
 					/*Print successfull notifications*/
 					print_Output((char*)Time_Updated_Str);
 					/*Reset State_Set*/
@@ -174,7 +407,86 @@ void LPUART1_RxTx_IRQHandler(void)
 				}
 				else 
 				{
-					print_Output((char*)Error_String);
+					print_Rejected(State_Set);
+				}
+				/*Reset initial conditions*/
+				input_complete = INPUT_NONE_COMPLETE;
+				reset_received_data();
+			}
+			else if ((State_Set == SET_ALARM))
+			{
+				if (Check_Alarm_Format())
+				{
+					/*Function to add the alarm, next firing after the current time*/
+					Update_Alarm(&timeOfDay, &repeat);
+					id = Alarm_Add(timeOfDay, (Alarm_RepeatType)repeat, Main_Now());
+					if (id != 0U)
+					{
+						LOG3(LOG_ALARM_SET, id, timeOfDay, repeat);
+						/*Print the alarm list as confirmation*/
+						print_Alarms();
+					}
+					else
+					{
+						/*Table full*/
+						print_Rejected(State_Set);
+					}
+					/*Reset State_Set*/
+					State_Set = NOT_SETTING;
+				}
+				else 
+				{
+					print_Rejected(State_Set);
+				}
+				/*Reset initial conditions*/
+				input_complete = INPUT_NONE_COMPLETE;
+				reset_received_data();
+			}
+			else if ((State_Set == SET_ZONE))
+			{
+				if (Update_Zone())
+				{
+					/*Same UTC clock, new local time*/
+					critical = NVIC_EnterCritical(PRIORITY_LPIT_TICK);
+					DateTime_SetUtc(DateTime_Utc);
+					NVIC_ExitCritical(critical);
+					/*Recurring alarms follow the new local time*/
+					Alarm_Reschedule(Main_Now());
+					/*Print the offset and the next change as confirmation*/
+					print_Zone();
+					/*Reset State_Set*/
+					State_Set = NOT_SETTING;
+				}
+				else 
+				{
+					print_Rejected(State_Set);
+				}
+				/*Reset initial conditions*/
+				input_complete = INPUT_NONE_COMPLETE;
+				reset_received_data();
+			}
+			else if ((State_Set == SET_CALIB))
+			{
+				if (Check_Calib_Format())
+				{
+					/*Function to set the correction, applied from the next tick*/
+					Update_Calib(&ppm);
+					if (Tick_SetCalibration(ppm))
+					{
+						/*Print the correction in force as confirmation*/
+						print_Calib();
+					}
+					else
+					{
+						/*Out of range*/
+						print_Rejected(State_Set);
+					}
+					/*Reset State_Set*/
+					State_Set = NOT_SETTING;
+				}
+				else 
+				{
+					print_Rejected(State_Set);
 				}
 				/*Reset initial conditions*/
 				input_complete = INPUT_NONE_COMPLETE;
@@ -185,12 +497,18 @@ void LPUART1_RxTx_IRQHandler(void)
 				/*do not thing*/
 			}
 		}
+	Stats_IrqExit(STATS_IRQ_UART, start);
 }
 
-void LPIT0_Ch3_IRQHandler (void)
+CODE_RAM void LPIT0_Ch3_IRQHandler (void)
 {
+	/*Time of the timeout, before Tick_Update() reprograms TVAL*/
+	unsigned long long edge = Tick_EdgeTicks();
+	unsigned int start = Stats_IrqEnter(STATS_IRQ_LPIT);
 	/*Clear interrupt flag*/
 	Lpit_Clear_Interrupt_Flag(3);
+	/*Length of the period after this one: exact, with the ppm correction*/
+	Tick_Update();
 	/*Trigger ADC*/
 	ADC0_SC1A |=  (ADC0_SE12<<ADC_SC1A_ADCH_SHIFT);
 	/*Increase count to 1 unit, every time count is increased to 1 corresponding to 250ms*/
@@ -198,6 +516,7 @@ void LPIT0_Ch3_IRQHandler (void)
 	if (count==4)
 	{
 		/*Enough 1s*/
+		DateTime_Utc++;
 		second++; 
 		count = 0;
 	}
@@ -209,6 +528,26 @@ void LPIT0_Ch3_IRQHandler (void)
 	Time(&second);
 	/*Date update after 1 second*/
 	Date(&day);
+	if (count == 0U)
+	{
+		/*Start of the second for the time reference exchange*/
+		Sync_Second(DateTime_Utc, edge);
+		/*DST change: reload the calendar from the UTC clock, one compare otherwise*/
+		if (DateTime_Utc >= TimeZone_Next)
+		{
+			DateTime_SetUtc(DateTime_Utc);
+		}
+		else
+		{
+			/*do not thing*/
+		}
+		/*Alarms due at this second: one compare against the earliest one*/
+		Alarm_Check(DateTime_Utc + (unsigned int)TimeZone_Current);
+	}
+	else
+	{
+		/*do not thing*/
+	}
 	/*Check state display and mode display*/
 	if (State_Button1 == DISPLAY_DATE_MODE && State_Button2 == TURNON_DISPLAY_MODE)
 	{
@@ -239,14 +578,47 @@ void LPIT0_Ch3_IRQHandler (void)
 	{
 		/*do not thing*/
 	}
+	Stats_IrqExit(STATS_IRQ_LPIT, start);
 }
 
 void ADC0_IRQHandler (void)
 {
+	unsigned int start = Stats_IrqEnter(STATS_IRQ_ADC);
 	/*Read ADC value*/
 	ADC_Value = (unsigned short)ADC0_RA;
 	/*Update intensity for module Led*/
 	Control_Intensity(ADC_Value);
+	Stats_IrqExit(STATS_IRQ_ADC, start);
+}
+
+CODE_RAM void SysTick_Handler(void)
+{
+	unsigned int start = Stats_IrqEnter(STATS_IRQ_SYSTICK);
+	/*1ms tick for software timers*/
+	SoftTimer_Tick();
+	Stats_IrqExit(STATS_IRQ_SYSTICK, start);
+}
+
+void LVD_LVW_IRQHandler(void)
+{
+	unsigned int start = Stats_IrqEnter(STATS_IRQ_LVD_LVW);
+	/*Low voltage warning: snapshot the time to FlexNVM*/
+	Brownout_IrqHandler();
+	Stats_IrqExit(STATS_IRQ_LVD_LVW, start);
 }
 
+CODE_RAM void FTFC_IRQHandler(void)
+{
+	unsigned int start = Stats_IrqEnter(STATS_IRQ_FTFC);
+	/*Flash command done: journal callbacks, next queued command*/
+	Ftfc_IrqHandler();
+	Stats_IrqExit(STATS_IRQ_FTFC, start);
+}
 
+CODE_RAM void FTM0_Ch0_Ch1_IRQHandler(void)
+{
+	unsigned int start = Stats_IrqEnter(STATS_IRQ_FTM0);
+	/*PPS edge: captured by FTM0, timestamped here, taken by the main loop*/
+	Pps_IrqHandler();
+	Stats_IrqExit(STATS_IRQ_FTM0, start);
+}